@@ -1,5 +1,8 @@
 #include "Commands/UnrealMCPBlueprintCommands.h"
 #include "Commands/UnrealMCPCommonUtils.h"
+#include "UnrealMCPBridge.h"
+#include "MCPCommandParams.h"
+#include "MCPJsonKeys.h"
 #include "Editor.h"
 #include "Engine/Blueprint.h"
 #include "Engine/BlueprintGeneratedClass.h"
@@ -98,10 +101,6 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintCommands::HandleCommand(const FString
     {
         return HandleInspectBlueprint(Params);
     }
-    else if (CommandType == TEXT("analyze_blueprint_graph"))
-    {
-        return HandleAnalyzeBlueprintGraph(Params);
-    }
     else if (CommandType == TEXT("set_blueprint_metadata"))
     {
         return HandleSetBlueprintMetadata(Params);
@@ -110,6 +109,26 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintCommands::HandleCommand(const FString
     return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Unknown blueprint command: %s"), *CommandType));
 }
 
+namespace
+{
+    struct FAnalyzeBlueprintGraphParams
+    {
+        FString BlueprintName;
+        FString GraphName;
+    };
+
+    constexpr auto AnalyzeBlueprintGraphSchema = MakeMCPParamSchema(
+        MCPRequired(TEXT("blueprint_name"), &FAnalyzeBlueprintGraphParams::BlueprintName, TEXT("Blueprint asset name or path")),
+        MCPOptional(TEXT("graph_name"), &FAnalyzeBlueprintGraphParams::GraphName, TEXT("Graph to analyze (defaults to the EventGraph)")));
+}
+
+void FUnrealMCPBlueprintCommands::RegisterNativeHandlers(UUnrealMCPBridge& Bridge)
+{
+    Bridge.RegisterStreamingHandler(TEXT("analyze_blueprint_graph"), FMCPStreamingCommandHandler::CreateRaw(this, &FUnrealMCPBlueprintCommands::HandleAnalyzeBlueprintGraph));
+
+    FMCPCommandSchemas::Register(TEXT("analyze_blueprint_graph"), TEXT("Describe the nodes, pins and connections of a Blueprint graph"), AnalyzeBlueprintGraphSchema);
+}
+
 TSharedPtr<FJsonObject> FUnrealMCPBlueprintCommands::HandleCreateBlueprint(const TSharedPtr<FJsonObject>& Params)
 {
     // Get required parameters
@@ -1104,7 +1123,7 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintCommands::HandleSpawnBlueprintActor(c
     }
 
     // Spawn the actor
-    UWorld* World = GEditor->GetEditorWorldContext().World();
+    UWorld* World = FUnrealMCPCommonUtils::GetTargetWorld(/*bPreferPIE=*/ false);
     if (!World)
     {
         return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Failed to get editor world"));
@@ -2024,23 +2043,22 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintCommands::HandleInspectBlueprint(cons
 // Analyze Blueprint Graph — deep graph/node/pin/connection analysis
 // ============================================================
 
-TSharedPtr<FJsonObject> FUnrealMCPBlueprintCommands::HandleAnalyzeBlueprintGraph(const TSharedPtr<FJsonObject>& Params)
+bool FUnrealMCPBlueprintCommands::HandleAnalyzeBlueprintGraph(const FMCPJsonObjectView& Params, FMCPJsonWriter& Writer, FString& OutError)
 {
-    FString BlueprintName;
-    if (!Params->TryGetStringField(TEXT("blueprint_name"), BlueprintName))
+    FAnalyzeBlueprintGraphParams Args;
+    if (!AnalyzeBlueprintGraphSchema.Bind(Params, Args, OutError))
     {
-        return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Missing 'blueprint_name' parameter"));
+        return false;
     }
+    const FString& GraphName = Args.GraphName;
 
-    UBlueprint* Blueprint = FUnrealMCPCommonUtils::FindBlueprint(BlueprintName);
+    UBlueprint* Blueprint = FUnrealMCPCommonUtils::FindBlueprint(Args.BlueprintName);
     if (!Blueprint)
     {
-        return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Blueprint not found: %s"), *BlueprintName));
+        OutError = FString::Printf(TEXT("Blueprint not found: %s"), *Args.BlueprintName);
+        return false;
     }
 
-    FString GraphName;
-    Params->TryGetStringField(TEXT("graph_name"), GraphName);
-
     // Find the requested graph
     UEdGraph* TargetGraph = nullptr;
 
@@ -2089,15 +2107,20 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintCommands::HandleAnalyzeBlueprintGraph
         {
             if (Graph) AvailableGraphs.Add(Graph->GetName());
         }
-        return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(
+        OutError = FString::Printf(
             TEXT("Graph not found: '%s'. Available graphs: [%s]"),
-            *GraphName, *FString::Join(AvailableGraphs, TEXT(", "))));
+            *GraphName, *FString::Join(AvailableGraphs, TEXT(", ")));
+        return false;
     }
 
-    TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
-    ResultObj->SetStringField(TEXT("blueprint"), BlueprintName);
-    ResultObj->SetStringField(TEXT("graph"), TargetGraph->GetName());
-    ResultObj->SetNumberField(TEXT("node_count"), TargetGraph->Nodes.Num());
+    // Streamed: graphs with thousands of pins would otherwise build one FJsonObject per pin.
+    // Same shape as CreateSuccessResponse: { "success": true, "data": { ... } }
+    Writer.BeginObject();
+    Writer.WriteField(MCPKeys::Success, true);
+    Writer.BeginObject(MCPKeys::Data);
+    Writer.WriteField(TEXT("blueprint"), Args.BlueprintName);
+    Writer.WriteField(TEXT("graph"), TargetGraph->GetName());
+    Writer.WriteField(TEXT("node_count"), TargetGraph->Nodes.Num());
 
     // Build a map of node pointer -> stable index for connection referencing
     TMap<UEdGraphNode*, int32> NodeIndexMap;
@@ -2110,75 +2133,80 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintCommands::HandleAnalyzeBlueprintGraph
     }
 
     // ---- Nodes ----
-    TArray<TSharedPtr<FJsonValue>> NodeArray;
-    TArray<TSharedPtr<FJsonValue>> ConnectionArray;
-
+    Writer.BeginArray(TEXT("nodes"));
     for (int32 NodeIdx = 0; NodeIdx < TargetGraph->Nodes.Num(); NodeIdx++)
     {
         UEdGraphNode* Node = TargetGraph->Nodes[NodeIdx];
         if (!Node) continue;
 
-        TSharedPtr<FJsonObject> NodeObj = MakeShared<FJsonObject>();
-        NodeObj->SetNumberField(TEXT("index"), NodeIdx);
-        NodeObj->SetStringField(TEXT("name"), Node->GetNodeTitle(ENodeTitleType::ListView).ToString());
-        NodeObj->SetStringField(TEXT("class"), Node->GetClass()->GetName());
-        NodeObj->SetNumberField(TEXT("pos_x"), Node->NodePosX);
-        NodeObj->SetNumberField(TEXT("pos_y"), Node->NodePosY);
+        Writer.BeginObject();
+        Writer.WriteField(TEXT("index"), NodeIdx);
+        Writer.WriteField(MCPKeys::Name, Node->GetNodeTitle(ENodeTitleType::ListView).ToString());
+        Writer.WriteField(MCPKeys::Class, Node->GetClass()->GetName());
+        Writer.WriteField(TEXT("pos_x"), Node->NodePosX);
+        Writer.WriteField(TEXT("pos_y"), Node->NodePosY);
 
         if (!Node->NodeComment.IsEmpty())
         {
-            NodeObj->SetStringField(TEXT("comment"), Node->NodeComment);
+            Writer.WriteField(TEXT("comment"), Node->NodeComment);
         }
 
         // ---- Pins ----
-        TArray<TSharedPtr<FJsonValue>> PinArray;
-
+        Writer.BeginArray(TEXT("pins"));
         for (UEdGraphPin* Pin : Node->Pins)
         {
             if (!Pin) continue;
 
-            TSharedPtr<FJsonObject> PinObj = MakeShared<FJsonObject>();
-            PinObj->SetStringField(TEXT("name"), Pin->PinName.ToString());
-            PinObj->SetStringField(TEXT("type"), Pin->PinType.PinCategory.ToString());
-            PinObj->SetStringField(TEXT("direction"), Pin->Direction == EGPD_Input ? TEXT("Input") : TEXT("Output"));
-            PinObj->SetBoolField(TEXT("is_connected"), Pin->LinkedTo.Num() > 0);
+            Writer.BeginObject();
+            Writer.WriteField(MCPKeys::Name, Pin->PinName.ToString());
+            Writer.WriteField(MCPKeys::Type, Pin->PinType.PinCategory.ToString());
+            Writer.WriteField(TEXT("direction"), Pin->Direction == EGPD_Input ? TEXT("Input") : TEXT("Output"));
+            Writer.WriteField(TEXT("is_connected"), Pin->LinkedTo.Num() > 0);
 
             if (Pin->PinType.PinSubCategoryObject.IsValid())
             {
-                PinObj->SetStringField(TEXT("sub_type"), Pin->PinType.PinSubCategoryObject->GetName());
+                Writer.WriteField(TEXT("sub_type"), Pin->PinType.PinSubCategoryObject->GetName());
             }
+            Writer.EndObject();
+        }
+        Writer.EndArray();
+        Writer.EndObject();
+    }
+    Writer.EndArray();
 
-            PinArray.Add(MakeShared<FJsonValueObject>(PinObj));
+    // ---- Connections (from output pins only to avoid duplicates) ----
+    // A second walk over the pins keeps the output ordered without buffering connection objects
+    Writer.BeginArray(TEXT("connections"));
+    for (int32 NodeIdx = 0; NodeIdx < TargetGraph->Nodes.Num(); NodeIdx++)
+    {
+        UEdGraphNode* Node = TargetGraph->Nodes[NodeIdx];
+        if (!Node) continue;
 
-            // ---- Connections (from output pins only to avoid duplicates) ----
-            if (Pin->Direction == EGPD_Output)
-            {
-                for (UEdGraphPin* LinkedPin : Pin->LinkedTo)
-                {
-                    if (!LinkedPin || !LinkedPin->GetOwningNode()) continue;
+        for (UEdGraphPin* Pin : Node->Pins)
+        {
+            if (!Pin || Pin->Direction != EGPD_Output) continue;
 
-                    int32* TargetIdx = NodeIndexMap.Find(LinkedPin->GetOwningNode());
-                    if (!TargetIdx) continue;
+            for (UEdGraphPin* LinkedPin : Pin->LinkedTo)
+            {
+                if (!LinkedPin || !LinkedPin->GetOwningNode()) continue;
 
-                    TSharedPtr<FJsonObject> ConnObj = MakeShared<FJsonObject>();
-                    ConnObj->SetNumberField(TEXT("from_node"), NodeIdx);
-                    ConnObj->SetStringField(TEXT("from_pin"), Pin->PinName.ToString());
-                    ConnObj->SetNumberField(TEXT("to_node"), *TargetIdx);
-                    ConnObj->SetStringField(TEXT("to_pin"), LinkedPin->PinName.ToString());
+                int32* TargetIdx = NodeIndexMap.Find(LinkedPin->GetOwningNode());
+                if (!TargetIdx) continue;
 
-                    ConnectionArray.Add(MakeShared<FJsonValueObject>(ConnObj));
-                }
+                Writer.BeginObject();
+                Writer.WriteField(TEXT("from_node"), NodeIdx);
+                Writer.WriteField(TEXT("from_pin"), Pin->PinName.ToString());
+                Writer.WriteField(TEXT("to_node"), *TargetIdx);
+                Writer.WriteField(TEXT("to_pin"), LinkedPin->PinName.ToString());
+                Writer.EndObject();
             }
         }
-
-        NodeObj->SetArrayField(TEXT("pins"), PinArray);
-        NodeArray.Add(MakeShared<FJsonValueObject>(NodeObj));
     }
+    Writer.EndArray();
 
-    ResultObj->SetArrayField(TEXT("nodes"), NodeArray);
-    ResultObj->SetArrayField(TEXT("connections"), ConnectionArray);
-
-    return FUnrealMCPCommonUtils::CreateSuccessResponse(ResultObj);
+    Writer.EndObject();
+    Writer.EndObject();
+    return true;
 }
 
 // ============================================================
@@ -1,11 +1,22 @@
 #include "Commands/UnrealMCPEditorCommands.h"
 #include "Commands/UnrealMCPCommonUtils.h"
+#include "UnrealMCPBridge.h"
+#include "MCPCommandParams.h"
+#include "MCPJsonKeys.h"
+#include "MCPActorIndex.h"
+#include "MCPActorQuery.h"
+#include "MCPLevelJournal.h"
 #include "Editor.h"
 #include "EditorViewportClient.h"
 #include "LevelEditorViewport.h"
-#include "ImageUtils.h"
-#include "HighResScreenshot.h"
+#include "MCPScreenshotCapture.h"
+#include "MCPViewportStream.h"
+#include "MCPMutationSession.h"
+#include "MCPPawnControl.h"
+#include "MCPFrameScanner.h"
+#include "MCPWorldResolver.h"
 #include "Engine/GameViewportClient.h"
+#include "Misc/Base64.h"
 #include "Misc/FileHelper.h"
 #include "GameFramework/Actor.h"
 #include "EngineUtils.h"
@@ -19,6 +30,7 @@
 #include "GameFramework/PlayerStart.h"
 #include "Components/StaticMeshComponent.h"
 #include "Components/SkeletalMeshComponent.h"
+#include "Components/SceneComponent.h"
 #include "EditorSubsystem.h"
 #include "Subsystems/EditorActorSubsystem.h"
 #include "LevelEditor.h"
@@ -35,6 +47,10 @@
 #include "EditorUtilityWidgetBlueprint.h"
 #include "EditorUtilityWidget.h"
 #include "EditorAssetLibrary.h"
+#include "ScopedTransaction.h"
+#include "AI/NavigationSystemBase.h"
+#include "Engine/StaticMesh.h"
+#include "Materials/MaterialInterface.h"
 
 FUnrealMCPEditorCommands::FUnrealMCPEditorCommands()
 {
@@ -42,16 +58,8 @@ FUnrealMCPEditorCommands::FUnrealMCPEditorCommands()
 
 TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleCommand(const FString& CommandType, const TSharedPtr<FJsonObject>& Params)
 {
-    // Actor manipulation commands
-    if (CommandType == TEXT("get_actors_in_level"))
-    {
-        return HandleGetActorsInLevel(Params);
-    }
-    else if (CommandType == TEXT("find_actors_by_name"))
-    {
-        return HandleFindActorsByName(Params);
-    }
-    else if (CommandType == TEXT("spawn_actor") || CommandType == TEXT("create_actor"))
+    // Actor manipulation commands (reads and transforms are registered as native handlers)
+    if (CommandType == TEXT("spawn_actor") || CommandType == TEXT("create_actor"))
     {
         if (CommandType == TEXT("create_actor"))
         {
@@ -63,14 +71,6 @@ TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleCommand(const FString& C
     {
         return HandleDeleteActor(Params);
     }
-    else if (CommandType == TEXT("set_actor_transform"))
-    {
-        return HandleSetActorTransform(Params);
-    }
-    else if (CommandType == TEXT("get_actor_properties"))
-    {
-        return HandleGetActorProperties(Params);
-    }
     else if (CommandType == TEXT("set_actor_property"))
     {
         return HandleSetActorProperty(Params);
@@ -85,10 +85,6 @@ TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleCommand(const FString& C
     {
         return HandleFocusViewport(Params);
     }
-    else if (CommandType == TEXT("take_screenshot"))
-    {
-        return HandleTakeScreenshot(Params);
-    }
     // Phase 5: Editor Enhancements
     else if (CommandType == TEXT("select_actors"))
     {
@@ -126,14 +122,6 @@ TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleCommand(const FString& C
     {
         return HandleGetActorTags(Params);
     }
-    else if (CommandType == TEXT("add_movement_input"))
-    {
-        return HandleAddMovementInput(Params);
-    }
-    else if (CommandType == TEXT("pawn_action"))
-    {
-        return HandlePawnAction(Params);
-    }
 
     // Editor Utility Subsystem
     else if (CommandType == TEXT("run_editor_utility"))
@@ -160,72 +148,459 @@ TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleCommand(const FString& C
     return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Unknown editor command: %s"), *CommandType));
 }
 
-TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleGetActorsInLevel(const TSharedPtr<FJsonObject>& Params)
+namespace
 {
+    struct FGetActorsInLevelParams
+    {
+        FMCPJsonObjectView Filter;
+        TArray<FString> Fields;
+    };
+
+    constexpr auto GetActorsInLevelSchema = MakeMCPParamSchema(
+        MCPOptional(TEXT("filter"), &FGetActorsInLevelParams::Filter, TEXT("class, tags, folder, level, mobility and/or label (wildcard) to match")),
+        MCPOptional(TEXT("fields"), &FGetActorsInLevelParams::Fields, TEXT("Actor fields to return (default: name, class, location, rotation, scale)")));
+
+    struct FFindActorsByNameParams
+    {
+        FString Pattern;
+        FMCPJsonObjectView Filter;
+        TArray<FString> Fields;
+    };
+
+    constexpr auto FindActorsByNameSchema = MakeMCPParamSchema(
+        MCPRequired(TEXT("pattern"), &FFindActorsByNameParams::Pattern, TEXT("Substring matched against actor names and labels")),
+        MCPOptional(TEXT("filter"), &FFindActorsByNameParams::Filter, TEXT("class, tags, folder, level, mobility and/or label (wildcard) to match")),
+        MCPOptional(TEXT("fields"), &FFindActorsByNameParams::Fields, TEXT("Actor fields to return (default: name, class, location, rotation, scale)")));
+
+    struct FSpawnActorsParams
+    {
+        FMCPJsonArrayView Actors;
+    };
+
+    constexpr auto SpawnActorsSchema = MakeMCPParamSchema(
+        MCPRequired(TEXT("actors"), &FSpawnActorsParams::Actors, TEXT("Actor specs: {type, name, label, location, rotation, scale, mesh, material, material_slot, tags, folder}")));
+
+    struct FActorSpawnSpec
+    {
+        FString Type = TEXT("StaticMeshActor");
+        FString Name;
+        FString Label;
+        FVector Location = FVector::ZeroVector;
+        FRotator Rotation = FRotator::ZeroRotator;
+        FVector Scale = FVector::OneVector;
+        FString Mesh;
+        FString Material;
+        int32 MaterialSlot = 0;
+        TArray<FString> Tags;
+        FString Folder;
+    };
+
+    constexpr auto ActorSpawnSpecSchema = MakeMCPParamSchema(
+        MCPOptional(TEXT("type"), &FActorSpawnSpec::Type, TEXT("Actor class, class path or Blueprint name (default StaticMeshActor)")),
+        MCPOptional(TEXT("name"), &FActorSpawnSpec::Name, TEXT("Object name; must be unique in the level")),
+        MCPOptional(TEXT("label"), &FActorSpawnSpec::Label, TEXT("Outliner label")),
+        MCPOptional(TEXT("location"), &FActorSpawnSpec::Location, TEXT("World location")),
+        MCPOptional(TEXT("rotation"), &FActorSpawnSpec::Rotation, TEXT("World rotation")),
+        MCPOptional(TEXT("scale"), &FActorSpawnSpec::Scale, TEXT("3D scale")),
+        MCPOptional(TEXT("mesh"), &FActorSpawnSpec::Mesh, TEXT("Static mesh asset path")),
+        MCPOptional(TEXT("material"), &FActorSpawnSpec::Material, TEXT("Material asset path")),
+        MCPOptional(TEXT("material_slot"), &FActorSpawnSpec::MaterialSlot, TEXT("Material slot index (default 0)")),
+        MCPOptional(TEXT("tags"), &FActorSpawnSpec::Tags, TEXT("Actor tags")),
+        MCPOptional(TEXT("folder"), &FActorSpawnSpec::Folder, TEXT("Outliner folder path")));
+
+    // Validation errors beyond this are summarized rather than listed
+    constexpr int32 MaxReportedSpawnErrors = 20;
+
+    /** Asset by path, accepting both "/Game/X" and "/Game/X.X"; results (including misses) are cached per batch. */
+    template <typename AssetType>
+    AssetType* LoadAssetCached(TMap<FString, AssetType*>& Cache, const FString& Path)
+    {
+        if (AssetType** Cached = Cache.Find(Path))
+        {
+            return *Cached;
+        }
+        AssetType* Asset = LoadObject<AssetType>(nullptr, *Path);
+        if (!Asset && !Path.Contains(TEXT(".")))
+        {
+            Asset = LoadObject<AssetType>(nullptr, *(Path + TEXT(".") + FPaths::GetBaseFilename(Path)));
+        }
+        Cache.Add(Path, Asset);
+        return Asset;
+    }
+
+    /** Apply a spec's mesh and material; false if the actor lacks (or does not yet have) the components for them. */
+    bool ApplySpawnAssets(AActor* Actor, UStaticMesh* Mesh, UMaterialInterface* Material, int32 MaterialSlot)
+    {
+        bool bComplete = true;
+        UStaticMeshComponent* MeshComponent = Actor->FindComponentByClass<UStaticMeshComponent>();
+        if (Mesh)
+        {
+            if (MeshComponent)
+            {
+                MeshComponent->SetStaticMesh(Mesh);
+            }
+            else
+            {
+                bComplete = false;
+            }
+        }
+        if (Material)
+        {
+            UMeshComponent* Target = MeshComponent ? MeshComponent : Actor->FindComponentByClass<UMeshComponent>();
+            if (Target)
+            {
+                Target->SetMaterial(MaterialSlot, Material);
+            }
+            else
+            {
+                bComplete = false;
+            }
+        }
+        return bComplete;
+    }
+
+    struct FSetActorTransformParams
+    {
+        FString Name;
+        TOptional<FVector> Location;
+        TOptional<FRotator> Rotation;
+        TOptional<FVector> Scale;
+    };
+
+    constexpr auto SetActorTransformSchema = MakeMCPParamSchema(
+        MCPRequired(TEXT("name"), &FSetActorTransformParams::Name, TEXT("Actor name or label")),
+        MCPOptional(TEXT("location"), &FSetActorTransformParams::Location, TEXT("New world location")),
+        MCPOptional(TEXT("rotation"), &FSetActorTransformParams::Rotation, TEXT("New world rotation")),
+        MCPOptional(TEXT("scale"), &FSetActorTransformParams::Scale, TEXT("New 3D scale")));
+
+    struct FSetActorTransformsParams
+    {
+        FMCPJsonArrayView Transforms;
+        FString Mode = TEXT("absolute");
+    };
+
+    constexpr auto SetActorTransformsSchema = MakeMCPParamSchema(
+        MCPRequired(TEXT("transforms"), &FSetActorTransformsParams::Transforms, TEXT("Items: {actor, location, rotation, scale, mode}")),
+        MCPOptional(TEXT("mode"), &FSetActorTransformsParams::Mode, TEXT("absolute (default) or relative; items may override")));
+
+    struct FActorTransformItem
+    {
+        FString Actor;
+        FString Name;
+        TOptional<FVector> Location;
+        TOptional<FRotator> Rotation;
+        TOptional<FVector> Scale;
+        FString Mode;
+    };
+
+    constexpr auto ActorTransformItemSchema = MakeMCPParamSchema(
+        MCPOptional(TEXT("actor"), &FActorTransformItem::Actor, TEXT("Actor name or label")),
+        MCPOptional(TEXT("name"), &FActorTransformItem::Name, TEXT("Alias of 'actor'")),
+        MCPOptional(TEXT("location"), &FActorTransformItem::Location, TEXT("Location, or world offset in relative mode")),
+        MCPOptional(TEXT("rotation"), &FActorTransformItem::Rotation, TEXT("Rotation, or rotation applied on top in relative mode")),
+        MCPOptional(TEXT("scale"), &FActorTransformItem::Scale, TEXT("Scale, or scale multiplier in relative mode")),
+        MCPOptional(TEXT("mode"), &FActorTransformItem::Mode, TEXT("absolute or relative (default: the request's mode)")));
+
+    struct FActorNameParams
+    {
+        FString Name;
+    };
+
+    constexpr auto GetActorPropertiesSchema = MakeMCPParamSchema(
+        MCPRequired(TEXT("name"), &FActorNameParams::Name, TEXT("Actor name or label")));
+
+    struct FAddMovementInputParams
+    {
+        FString ActorName;
+        TOptional<FVector> Direction;
+        double X = 0.0;
+        double Y = 0.0;
+        double Z = 0.0;
+        double Scale = 1.0;
+    };
+
+    constexpr auto AddMovementInputSchema = MakeMCPParamSchema(
+        MCPRequired(TEXT("actor_name"), &FAddMovementInputParams::ActorName, TEXT("Pawn to drive")),
+        MCPOptional(TEXT("direction"), &FAddMovementInputParams::Direction, TEXT("World-space input direction")),
+        MCPOptional(TEXT("x"), &FAddMovementInputParams::X, TEXT("Direction X, used when 'direction' is omitted")),
+        MCPOptional(TEXT("y"), &FAddMovementInputParams::Y, TEXT("Direction Y, used when 'direction' is omitted")),
+        MCPOptional(TEXT("z"), &FAddMovementInputParams::Z, TEXT("Direction Z, used when 'direction' is omitted")),
+        MCPOptional(TEXT("scale"), &FAddMovementInputParams::Scale, TEXT("Input scale (default 1.0)")));
+
+    struct FTakeScreenshotParams
+    {
+        FString FilePath;
+        FString Format;
+        int32 MaxSize = 0;
+        int32 Quality = 85;
+        bool bReturnData = false;
+    };
+
+    constexpr auto TakeScreenshotSchema = MakeMCPParamSchema(
+        MCPOptional(TEXT("filepath"), &FTakeScreenshotParams::FilePath, TEXT("Output file (default Saved/Screenshots/MCP_Screenshot)")),
+        MCPOptional(TEXT("format"), &FTakeScreenshotParams::Format, TEXT("png (default) or jpeg")),
+        MCPOptional(TEXT("max_size"), &FTakeScreenshotParams::MaxSize, TEXT("Longest side of the output in pixels; 0 keeps the viewport size")),
+        MCPOptional(TEXT("quality"), &FTakeScreenshotParams::Quality, TEXT("JPEG quality 1-100 (default 85)")),
+        MCPOptional(TEXT("return_data"), &FTakeScreenshotParams::bReturnData, TEXT("Keep the encoded bytes so get_screenshot can return them")));
+
+    struct FGetScreenshotParams
+    {
+        int32 Ticket = 0;
+        bool bIncludeData = false;
+    };
+
+    constexpr auto GetScreenshotSchema = MakeMCPParamSchema(
+        MCPRequired(TEXT("ticket"), &FGetScreenshotParams::Ticket, TEXT("Ticket returned by take_screenshot")),
+        MCPOptional(TEXT("include_data"), &FGetScreenshotParams::bIncludeData, TEXT("Return the image as base64 (needs return_data on the capture)")));
+
+    struct FStartViewportStreamParams
+    {
+        double Fps = 10.0;
+        int32 MaxSize = 512;
+        FString Format = TEXT("jpeg");
+        int32 Quality = 70;
+        int32 TileSize = 64;
+        double DeltaThreshold = 0.3;
+        int32 KeyframeInterval = 60;
+    };
+
+    constexpr auto StartViewportStreamSchema = MakeMCPParamSchema(
+        MCPOptional(TEXT("fps"), &FStartViewportStreamParams::Fps, TEXT("Target frame rate, 0.5-60 (default 10)")),
+        MCPOptional(TEXT("max_size"), &FStartViewportStreamParams::MaxSize, TEXT("Longest side of the frames in pixels; 0 keeps the viewport size (default 512)")),
+        MCPOptional(TEXT("format"), &FStartViewportStreamParams::Format, TEXT("jpeg (default) or png")),
+        MCPOptional(TEXT("quality"), &FStartViewportStreamParams::Quality, TEXT("JPEG quality 1-100 (default 70)")),
+        MCPOptional(TEXT("tile_size"), &FStartViewportStreamParams::TileSize, TEXT("Tile side for delta frames, 16-512 (default 64)")),
+        MCPOptional(TEXT("delta_threshold"), &FStartViewportStreamParams::DeltaThreshold, TEXT("Largest changed-tile fraction sent as a delta (default 0.3; 0 disables deltas)")),
+        MCPOptional(TEXT("keyframe_interval"), &FStartViewportStreamParams::KeyframeInterval, TEXT("Frames between forced full frames (default 60)")));
+
+    struct FStopViewportStreamParams
+    {
+        int32 StreamId = 0;
+    };
+
+    constexpr auto StopViewportStreamSchema = MakeMCPParamSchema(
+        MCPRequired(TEXT("stream_id"), &FStopViewportStreamParams::StreamId, TEXT("Stream id returned by start_viewport_stream")));
+
+    struct FBeginMutationSessionParams
+    {
+        FString Name = TEXT("MCP Edits");
+        double IdleTimeout = 0.0;
+    };
+
+    constexpr auto BeginMutationSessionSchema = MakeMCPParamSchema(
+        MCPOptional(TEXT("name"), &FBeginMutationSessionParams::Name, TEXT("Undo history label of the session's transaction (default \"MCP Edits\")")),
+        MCPOptional(TEXT("idle_timeout"), &FBeginMutationSessionParams::IdleTimeout, TEXT("Seconds without session commands before the session ends (default from MCP Settings)")));
+
+    struct FEndMutationSessionParams
+    {
+        FString SessionId;
+    };
+
+    constexpr auto EndMutationSessionSchema = MakeMCPParamSchema(
+        MCPOptional(TEXT("session_id"), &FEndMutationSessionParams::SessionId, TEXT("Session to end; defaults to the session begun on this connection")));
+
+    struct FOpenPawnControlParams
+    {
+        FString ActorName;
+        int32 TtlMs = 100;
+    };
+
+    constexpr auto OpenPawnControlSchema = MakeMCPParamSchema(
+        MCPRequired(TEXT("actor_name"), &FOpenPawnControlParams::ActorName, TEXT("Name or label of the pawn to drive (PIE)")),
+        MCPOptional(TEXT("ttl_ms"), &FOpenPawnControlParams::TtlMs, TEXT("How long a frame keeps driving the pawn when no newer one arrives, 1-65535 ms (default 100)")));
+
+    struct FClosePawnControlParams
+    {
+        int32 Channel = 0;
+    };
+
+    constexpr auto ClosePawnControlSchema = MakeMCPParamSchema(
+        MCPRequired(TEXT("channel"), &FClosePawnControlParams::Channel, TEXT("Channel id returned by open_pawn_control")));
+
+    struct FPawnActionParams
+    {
+        FString ActorName;
+        FString Action;
+        FVector Velocity = FVector::ZeroVector;
+        bool bXYOverride = false;
+        bool bZOverride = false;
+    };
+
+    constexpr auto PawnActionSchema = MakeMCPParamSchema(
+        MCPRequired(TEXT("actor_name"), &FPawnActionParams::ActorName, TEXT("Pawn or Character to act on")),
+        MCPRequired(TEXT("action"), &FPawnActionParams::Action, TEXT("jump, stop_jumping, crouch, uncrouch or launch")),
+        MCPOptional(TEXT("velocity"), &FPawnActionParams::Velocity, TEXT("Launch velocity (launch only)")),
+        MCPOptional(TEXT("xy_override"), &FPawnActionParams::bXYOverride, TEXT("Replace instead of add horizontal velocity (launch only)")),
+        MCPOptional(TEXT("z_override"), &FPawnActionParams::bZOverride, TEXT("Replace instead of add vertical velocity (launch only)")));
+}
+
+void FUnrealMCPEditorCommands::RegisterNativeHandlers(UUnrealMCPBridge& Bridge)
+{
+    // The polling and RL-loop commands: these run at high rates and only read a few scalar fields
+    Bridge.RegisterStreamingHandler(TEXT("get_actors_in_level"), FMCPStreamingCommandHandler::CreateRaw(this, &FUnrealMCPEditorCommands::HandleGetActorsInLevel));
+    Bridge.RegisterStreamingHandler(TEXT("find_actors_by_name"), FMCPStreamingCommandHandler::CreateRaw(this, &FUnrealMCPEditorCommands::HandleFindActorsByName));
+    Bridge.RegisterNativeHandler(TEXT("set_actor_transform"), FMCPNativeCommandHandler::CreateRaw(this, &FUnrealMCPEditorCommands::HandleSetActorTransform));
+    Bridge.RegisterNativeHandler(TEXT("get_actor_properties"), FMCPNativeCommandHandler::CreateRaw(this, &FUnrealMCPEditorCommands::HandleGetActorProperties));
+    Bridge.RegisterNativeHandler(TEXT("add_movement_input"), FMCPNativeCommandHandler::CreateRaw(this, &FUnrealMCPEditorCommands::HandleAddMovementInput));
+    Bridge.RegisterNativeHandler(TEXT("pawn_action"), FMCPNativeCommandHandler::CreateRaw(this, &FUnrealMCPEditorCommands::HandlePawnAction));
+
+    // Screenshots: capture returns a ticket at once, readback and encoding finish off the game thread
+    Bridge.RegisterNativeHandler(TEXT("take_screenshot"), FMCPNativeCommandHandler::CreateRaw(this, &FUnrealMCPEditorCommands::HandleTakeScreenshot));
+    Bridge.RegisterNativeHandler(TEXT("get_screenshot"), FMCPNativeCommandHandler::CreateRaw(this, &FUnrealMCPEditorCommands::HandleGetScreenshot));
+    Bridge.RegisterNativeHandler(TEXT("start_viewport_stream"), FMCPNativeCommandHandler::CreateRaw(this, &FUnrealMCPEditorCommands::HandleStartViewportStream));
+    Bridge.RegisterNativeHandler(TEXT("stop_viewport_stream"), FMCPNativeCommandHandler::CreateRaw(this, &FUnrealMCPEditorCommands::HandleStopViewportStream));
+    Bridge.RegisterNativeHandler(TEXT("begin_mutation_session"), FMCPNativeCommandHandler::CreateRaw(this, &FUnrealMCPEditorCommands::HandleBeginMutationSession));
+    Bridge.RegisterNativeHandler(TEXT("end_mutation_session"), FMCPNativeCommandHandler::CreateRaw(this, &FUnrealMCPEditorCommands::HandleEndMutationSession));
+    Bridge.RegisterNativeHandler(TEXT("open_pawn_control"), FMCPNativeCommandHandler::CreateRaw(this, &FUnrealMCPEditorCommands::HandleOpenPawnControl));
+    Bridge.RegisterNativeHandler(TEXT("close_pawn_control"), FMCPNativeCommandHandler::CreateRaw(this, &FUnrealMCPEditorCommands::HandleClosePawnControl));
+
+    // Batch commands: a whole array of specs per round trip
+    Bridge.RegisterStreamingHandler(TEXT("spawn_actors"), FMCPStreamingCommandHandler::CreateRaw(this, &FUnrealMCPEditorCommands::HandleSpawnActors));
+    Bridge.RegisterStreamingHandler(TEXT("set_actor_transforms"), FMCPStreamingCommandHandler::CreateRaw(this, &FUnrealMCPEditorCommands::HandleSetActorTransforms));
+
+    FMCPCommandSchemas::Register(TEXT("get_actors_in_level"), TEXT("List actors in the current world, optionally filtered and projected"), GetActorsInLevelSchema);
+    FMCPCommandSchemas::Register(TEXT("find_actors_by_name"), TEXT("Find actors whose name or label contains a pattern"), FindActorsByNameSchema);
+    FMCPCommandSchemas::Register(TEXT("set_actor_transform"), TEXT("Set any of an actor's location, rotation and scale"), SetActorTransformSchema);
+    FMCPCommandSchemas::Register(TEXT("get_actor_properties"), TEXT("Get an actor's transform and editable properties"), GetActorPropertiesSchema);
+    FMCPCommandSchemas::Register(TEXT("add_movement_input"), TEXT("Apply movement input to a pawn (PIE)"), AddMovementInputSchema);
+    FMCPCommandSchemas::Register(TEXT("pawn_action"), TEXT("Trigger a pawn action such as jump or crouch (PIE)"), PawnActionSchema);
+    FMCPCommandSchemas::Register(TEXT("take_screenshot"), TEXT("Start an asynchronous viewport capture; returns a ticket"), TakeScreenshotSchema);
+    FMCPCommandSchemas::Register(TEXT("get_screenshot"), TEXT("State of a take_screenshot ticket, optionally with the image bytes"), GetScreenshotSchema);
+    FMCPCommandSchemas::Register(TEXT("start_viewport_stream"), TEXT("Push encoded viewport frames over this connection at a target rate"), StartViewportStreamSchema);
+    FMCPCommandSchemas::Register(TEXT("stop_viewport_stream"), TEXT("Stop a viewport stream and report its frame counts"), StopViewportStreamSchema);
+    FMCPCommandSchemas::Register(TEXT("begin_mutation_session"), TEXT("Fold the following mutations into one undo transaction"), BeginMutationSessionSchema);
+    FMCPCommandSchemas::Register(TEXT("end_mutation_session"), TEXT("Close a mutation session and report its undo usage"), EndMutationSessionSchema);
+    FMCPCommandSchemas::Register(TEXT("open_pawn_control"), TEXT("Drive a pawn with binary input frames on this connection (PIE)"), OpenPawnControlSchema);
+    FMCPCommandSchemas::Register(TEXT("close_pawn_control"), TEXT("Close a pawn control channel and report its frame counts"), ClosePawnControlSchema);
+    FMCPCommandSchemas::Register(TEXT("spawn_actors"), TEXT("Spawn many actors in one undo transaction"), SpawnActorsSchema);
+    FMCPCommandSchemas::Register(TEXT("set_actor_transforms"), TEXT("Move, rotate or scale many actors in one pass"), SetActorTransformsSchema);
+}
+
+bool FUnrealMCPEditorCommands::HandleGetActorsInLevel(const FMCPJsonObjectView& Params, FMCPJsonWriter& Writer, FString& OutError)
+{
+    FGetActorsInLevelParams Args;
+    FMCPActorFilter Filter;
+    FMCPActorProjection Projection;
+    if (!GetActorsInLevelSchema.Bind(Params, Args, OutError)
+        || !FMCPActorFilter::Parse(Args.Filter, Filter, OutError)
+        || !FMCPActorProjection::Parse(Args.Fields, Projection, OutError))
+    {
+        return false;
+    }
+
     UWorld* World = FUnrealMCPCommonUtils::GetTargetWorld();
     if (!World)
     {
-        return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("No world available"));
+        OutError = TEXT("No world available");
+        return false;
     }
 
-    TArray<TSharedPtr<FJsonValue>> ActorArray;
+    // Streamed: large levels would otherwise build (and then re-walk) one FJsonObject per actor.
+    // The filter runs inside the iteration, so rejected actors never reach the writer.
+    // Unless properties are requested, the walk only copies the projected fields into a
+    // snapshot, and large snapshots are encoded on task threads.
+    const bool bFiltered = !Filter.IsEmpty();
+    const bool bSnapshot = FMCPActorSnapshot::CanSnapshot(Projection);
+    FMCPActorSnapshot Snapshot(Projection);
+    int32 TotalActors = 0;
+    int32 Count = 0;
+    Writer.BeginObject();
+    Writer.BeginArray(MCPKeys::Actors);
     for (TActorIterator<AActor> It(World); It; ++It)
     {
         AActor* Actor = *It;
-        if (Actor)
+        if (!Actor)
         {
-            ActorArray.Add(FUnrealMCPCommonUtils::ActorToJson(Actor));
+            continue;
         }
-    }
-
-    TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
-    ResultObj->SetArrayField(TEXT("actors"), ActorArray);
-    ResultObj->SetStringField(TEXT("world"), World->GetMapName());
-    ResultObj->SetBoolField(TEXT("is_pie"), World->WorldType == EWorldType::PIE);
-
-    return ResultObj;
+        TotalActors++;
+        if (bFiltered && !Filter.Matches(Actor))
+        {
+            continue;
+        }
+        if (bSnapshot)
+        {
+            Snapshot.Add(Actor);
+        }
+        else
+        {
+            Writer.BeginObject();
+            Projection.WriteFields(Writer, Actor);
+            Writer.EndObject();
+        }
+        Count++;
+    }
+    Snapshot.WriteElements(Writer);
+    Writer.EndArray();
+    Writer.WriteField(MCPKeys::Count, Count);
+    Writer.WriteField(TEXT("total_actors_in_world"), TotalActors);
+    Writer.WriteField(MCPKeys::World, World->GetMapName());
+    Writer.WriteField(MCPKeys::IsPie, World->WorldType == EWorldType::PIE);
+    // Baseline for get_level_changes
+    Writer.WriteField(TEXT("journal_id"), FMCPLevelJournal::Get().GetJournalId());
+    Writer.WriteField(TEXT("version"), FMCPLevelJournal::Get().GetVersion());
+    Writer.EndObject();
+
+    return true;
 }
 
-TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleFindActorsByName(const TSharedPtr<FJsonObject>& Params)
+bool FUnrealMCPEditorCommands::HandleFindActorsByName(const FMCPJsonObjectView& Params, FMCPJsonWriter& Writer, FString& OutError)
 {
-    FString Pattern;
-    if (!Params->TryGetStringField(TEXT("pattern"), Pattern))
+    FFindActorsByNameParams Args;
+    FMCPActorFilter Filter;
+    FMCPActorProjection Projection;
+    if (!FindActorsByNameSchema.Bind(Params, Args, OutError)
+        || !FMCPActorFilter::Parse(Args.Filter, Filter, OutError)
+        || !FMCPActorProjection::Parse(Args.Fields, Projection, OutError))
     {
-        return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Missing 'pattern' parameter"));
+        return false;
     }
+    const FString& Pattern = Args.Pattern;
 
     UWorld* World = FUnrealMCPCommonUtils::GetTargetWorld();
     if (!World)
     {
-        return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("No world available"));
+        OutError = TEXT("No world available");
+        return false;
     }
 
     // Count total actors for diagnostics
+    const bool bFiltered = !Filter.IsEmpty();
     int32 TotalActors = 0;
-    TArray<TSharedPtr<FJsonValue>> MatchingActors;
+    int32 Count = 0;
+    Writer.BeginObject();
+    Writer.BeginArray(MCPKeys::Actors);
     for (TActorIterator<AActor> It(World); It; ++It)
     {
         AActor* Actor = *It;
-        if (Actor)
+        if (!Actor)
         {
-            TotalActors++;
-            if (Actor->GetName().Contains(Pattern) || Actor->GetActorLabel().Contains(Pattern))
-            {
-                MatchingActors.Add(FUnrealMCPCommonUtils::ActorToJson(Actor));
-            }
+            continue;
         }
-    }
-
-    TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
-    ResultObj->SetArrayField(TEXT("actors"), MatchingActors);
-    ResultObj->SetNumberField(TEXT("count"), MatchingActors.Num());
-    ResultObj->SetNumberField(TEXT("total_actors_in_world"), TotalActors);
-    ResultObj->SetStringField(TEXT("world"), World->GetMapName());
-    ResultObj->SetNumberField(TEXT("world_type_id"), (int32)World->WorldType);
-    ResultObj->SetBoolField(TEXT("is_pie"), World->WorldType == EWorldType::PIE);
-    ResultObj->SetStringField(TEXT("pattern"), Pattern);
-
-    return ResultObj;
+        TotalActors++;
+        if (!Actor->GetName().Contains(Pattern) && !Actor->GetActorLabel().Contains(Pattern))
+        {
+            continue;
+        }
+        if (bFiltered && !Filter.Matches(Actor))
+        {
+            continue;
+        }
+        Writer.BeginObject();
+        Projection.WriteFields(Writer, Actor);
+        Writer.EndObject();
+        Count++;
+    }
+    Writer.EndArray();
+    Writer.WriteField(MCPKeys::Count, Count);
+    Writer.WriteField(TEXT("total_actors_in_world"), TotalActors);
+    Writer.WriteField(MCPKeys::World, World->GetMapName());
+    Writer.WriteField(TEXT("world_type_id"), (int32)World->WorldType);
+    Writer.WriteField(MCPKeys::IsPie, World->WorldType == EWorldType::PIE);
+    Writer.WriteField(TEXT("pattern"), Pattern);
+    Writer.EndObject();
+
+    return true;
 }
 
 TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleSpawnActor(const TSharedPtr<FJsonObject>& Params)
@@ -264,7 +639,7 @@ TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleSpawnActor(const TShared
 
     // Create the actor based on type
     AActor* NewActor = nullptr;
-    UWorld* World = GEditor->GetEditorWorldContext().World();
+    UWorld* World = FUnrealMCPCommonUtils::GetTargetWorld(/*bPreferPIE=*/ false);
 
     if (!World)
     {
@@ -272,14 +647,9 @@ TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleSpawnActor(const TShared
     }
 
     // Check if an actor with this name already exists
-    TArray<AActor*> AllActors;
-    UGameplayStatics::GetAllActorsOfClass(World, AActor::StaticClass(), AllActors);
-    for (AActor* Actor : AllActors)
+    if (FMCPActorIndex::Get().IsNameInUse(World, ActorName, /*bIncludeLabels=*/ false))
     {
-        if (Actor && Actor->GetName() == ActorName)
-        {
-            return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Actor with name '%s' already exists"), *ActorName));
-        }
+        return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Actor with name '%s' already exists"), *ActorName));
     }
 
     FActorSpawnParameters SpawnParams;
@@ -354,6 +724,181 @@ TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleSpawnActor(const TShared
     return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Failed to create actor"));
 }
 
+bool FUnrealMCPEditorCommands::HandleSpawnActors(const FMCPJsonObjectView& Params, FMCPJsonWriter& Writer, FString& OutError)
+{
+    FSpawnActorsParams Args;
+    if (!SpawnActorsSchema.Bind(Params, Args, OutError))
+    {
+        return false;
+    }
+
+    UWorld* World = FUnrealMCPCommonUtils::GetTargetWorld(/*bPreferPIE=*/ false);
+    if (!World)
+    {
+        OutError = TEXT("Failed to get editor world");
+        return false;
+    }
+
+    struct FResolvedSpawn
+    {
+        FActorSpawnSpec Spec;
+        UClass* Class = nullptr;
+        UStaticMesh* Mesh = nullptr;
+        UMaterialInterface* Material = nullptr;
+    };
+
+    // Resolve every spec before spawning anything, so a bad spec leaves the level untouched.
+    // Classes and assets repeat heavily in generated layouts, so lookups are cached per batch.
+    TArray<FResolvedSpawn> Spawns;
+    Spawns.Reserve(Args.Actors.Num());
+    TMap<FString, UClass*> Classes;
+    TMap<FString, UStaticMesh*> Meshes;
+    TMap<FString, UMaterialInterface*> Materials;
+    TSet<FString> BatchNames;
+    TArray<FString> Errors;
+    int32 NumErrors = 0;
+    auto AddError = [&Errors, &NumErrors](int32 SpecIndex, const FString& Message)
+    {
+        if (NumErrors++ < MaxReportedSpawnErrors)
+        {
+            Errors.Add(FString::Printf(TEXT("actors[%d]: %s"), SpecIndex, *Message));
+        }
+    };
+
+    int32 SpecIndex = 0;
+    for (const FMCPJsonValueView Value : Args.Actors)
+    {
+        const int32 ThisIndex = SpecIndex++;
+        FResolvedSpawn& Spawn = Spawns.AddDefaulted_GetRef();
+
+        FMCPJsonObjectView SpecObject;
+        FString SpecError;
+        if (!Value.TryGetObject(SpecObject))
+        {
+            AddError(ThisIndex, TEXT("must be an object"));
+            continue;
+        }
+        if (!ActorSpawnSpecSchema.Bind(SpecObject, Spawn.Spec, SpecError))
+        {
+            AddError(ThisIndex, SpecError);
+            continue;
+        }
+        const FActorSpawnSpec& Spec = Spawn.Spec;
+
+        UClass** CachedClass = Classes.Find(Spec.Type);
+        Spawn.Class = CachedClass ? *CachedClass : Classes.Add(Spec.Type, FUnrealMCPCommonUtils::FindActorClass(Spec.Type));
+        if (!Spawn.Class || Spawn.Class->HasAnyClassFlags(CLASS_Abstract))
+        {
+            AddError(ThisIndex, FString::Printf(TEXT("unknown or abstract actor type '%s'"), *Spec.Type));
+        }
+        if (!Spec.Mesh.IsEmpty() && !(Spawn.Mesh = LoadAssetCached(Meshes, Spec.Mesh)))
+        {
+            AddError(ThisIndex, FString::Printf(TEXT("static mesh not found: %s"), *Spec.Mesh));
+        }
+        if (!Spec.Material.IsEmpty() && !(Spawn.Material = LoadAssetCached(Materials, Spec.Material)))
+        {
+            AddError(ThisIndex, FString::Printf(TEXT("material not found: %s"), *Spec.Material));
+        }
+        if (!Spec.Name.IsEmpty())
+        {
+            bool bDuplicateInBatch = false;
+            BatchNames.Add(Spec.Name, &bDuplicateInBatch);
+            if (bDuplicateInBatch || FMCPActorIndex::Get().IsNameInUse(World, Spec.Name, /*bIncludeLabels=*/ false))
+            {
+                AddError(ThisIndex, FString::Printf(TEXT("actor with name '%s' already exists"), *Spec.Name));
+            }
+        }
+    }
+
+    if (NumErrors > 0)
+    {
+        if (NumErrors > Errors.Num())
+        {
+            Errors.Add(FString::Printf(TEXT("... and %d more"), NumErrors - Errors.Num()));
+        }
+        OutError = FString::Printf(TEXT("No actors spawned: %s"), *FString::Join(Errors, TEXT("; ")));
+        return false;
+    }
+
+    const double StartTime = FPlatformTime::Seconds();
+    int32 NumSpawned = 0;
+    TArray<TPair<int32, FString>, TInlineAllocator<4>> Warnings;
+
+    Writer.BeginObject();
+    Writer.BeginArray(MCPKeys::Actors);
+    {
+        // One undo step for the whole batch, and navigation rebuilds held until the batch is in
+        const FScopedTransaction Transaction(NSLOCTEXT("UnrealMCP", "SpawnActors", "Spawn Actors"));
+        FNavigationLockContext NavigationLock(World, ENavigationLockReason::Unknown);
+
+        for (int32 Index = 0; Index < Spawns.Num(); ++Index)
+        {
+            const FResolvedSpawn& Spawn = Spawns[Index];
+            const FActorSpawnSpec& Spec = Spawn.Spec;
+
+            FActorSpawnParameters SpawnParams;
+            if (!Spec.Name.IsEmpty())
+            {
+                SpawnParams.Name = *Spec.Name;
+            }
+
+            // Runs before the actor's components are registered, so render and physics state is
+            // created once with the final mesh and material instead of being rebuilt per property
+            bool bAssetsApplied = false;
+            SpawnParams.CustomPreSpawnInitalization = [&Spawn, &bAssetsApplied](AActor* Actor)
+            {
+                for (const FString& Tag : Spawn.Spec.Tags)
+                {
+                    Actor->Tags.AddUnique(FName(*Tag));
+                }
+                bAssetsApplied = ApplySpawnAssets(Actor, Spawn.Mesh, Spawn.Material, Spawn.Spec.MaterialSlot);
+            };
+
+            const FTransform Transform(Spec.Rotation, Spec.Location, Spec.Scale);
+            AActor* NewActor = World->SpawnActor(Spawn.Class, &Transform, SpawnParams);
+            if (!NewActor)
+            {
+                Warnings.Emplace(Index, TEXT("spawn failed"));
+                continue;
+            }
+
+            // Blueprint components only exist once construction has run
+            if (!bAssetsApplied && !ApplySpawnAssets(NewActor, Spawn.Mesh, Spawn.Material, Spec.MaterialSlot))
+            {
+                Warnings.Emplace(Index, TEXT("actor has no mesh component for the requested mesh or material"));
+            }
+            if (!Spec.Label.IsEmpty())
+            {
+                NewActor->SetActorLabel(Spec.Label);
+            }
+            if (!Spec.Folder.IsEmpty())
+            {
+                NewActor->SetFolderPath(FName(*Spec.Folder));
+            }
+
+            Writer.WriteValue(NewActor->GetName());
+            NumSpawned++;
+        }
+    }
+    Writer.EndArray();
+    Writer.WriteField(MCPKeys::Count, NumSpawned);
+    Writer.BeginArray(TEXT("warnings"));
+    for (const TPair<int32, FString>& Warning : Warnings)
+    {
+        Writer.BeginObject();
+        Writer.WriteField(TEXT("index"), Warning.Key);
+        Writer.WriteField(MCPKeys::Message, Warning.Value);
+        Writer.EndObject();
+    }
+    Writer.EndArray();
+    Writer.WriteField(TEXT("elapsed_ms"), (FPlatformTime::Seconds() - StartTime) * 1000.0);
+    Writer.WriteField(MCPKeys::World, World->GetMapName());
+    Writer.EndObject();
+
+    GEditor->RedrawLevelEditingViewports();
+    return true;
+}
+
 TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleDeleteActor(const TSharedPtr<FJsonObject>& Params)
 {
     FString ActorName;
@@ -376,55 +921,225 @@ TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleDeleteActor(const TShare
     return ResultObj;
 }
 
-TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleSetActorTransform(const TSharedPtr<FJsonObject>& Params)
+TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleSetActorTransform(const FMCPJsonObjectView& Params)
 {
-    FString ActorName;
-    if (!Params->TryGetStringField(TEXT("name"), ActorName))
+    FSetActorTransformParams Args;
+    FString ParamError;
+    if (!SetActorTransformSchema.Bind(Params, Args, ParamError))
     {
-        return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Missing 'name' parameter"));
+        return FUnrealMCPCommonUtils::CreateErrorResponse(ParamError);
     }
 
-    AActor* TargetActor = FUnrealMCPCommonUtils::FindActorByName(ActorName);
+    AActor* TargetActor = FUnrealMCPCommonUtils::FindActorByName(Args.Name);
     if (!TargetActor)
     {
-        return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Actor not found: %s"), *ActorName));
+        return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Actor not found: %s"), *Args.Name));
     }
 
     // Get transform parameters
     FTransform NewTransform = TargetActor->GetTransform();
 
-    if (Params->HasField(TEXT("location")))
+    if (Args.Location.IsSet())
     {
-        NewTransform.SetLocation(FUnrealMCPCommonUtils::GetVectorFromJson(Params, TEXT("location")));
+        NewTransform.SetLocation(Args.Location.GetValue());
     }
-    if (Params->HasField(TEXT("rotation")))
+    if (Args.Rotation.IsSet())
     {
-        NewTransform.SetRotation(FQuat(FUnrealMCPCommonUtils::GetRotatorFromJson(Params, TEXT("rotation"))));
+        NewTransform.SetRotation(FQuat(Args.Rotation.GetValue()));
     }
-    if (Params->HasField(TEXT("scale")))
+    if (Args.Scale.IsSet())
     {
-        NewTransform.SetScale3D(FUnrealMCPCommonUtils::GetVectorFromJson(Params, TEXT("scale")));
+        NewTransform.SetScale3D(Args.Scale.GetValue());
     }
 
     // Set the new transform
     TargetActor->SetActorTransform(NewTransform);
+    GEngine->BroadcastOnActorMoved(TargetActor);
 
     // Return updated actor info
     return FUnrealMCPCommonUtils::ActorToJsonObject(TargetActor, true);
 }
 
-TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleGetActorProperties(const TSharedPtr<FJsonObject>& Params)
+bool FUnrealMCPEditorCommands::HandleSetActorTransforms(const FMCPJsonObjectView& Params, FMCPJsonWriter& Writer, FString& OutError)
 {
-    FString ActorName;
-    if (!Params->TryGetStringField(TEXT("name"), ActorName))
+    FSetActorTransformsParams Args;
+    if (!SetActorTransformsSchema.Bind(Params, Args, OutError))
     {
-        return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Missing 'name' parameter"));
+        return false;
     }
 
-    AActor* TargetActor = FUnrealMCPCommonUtils::FindActorByName(ActorName);
+    UWorld* World = FUnrealMCPCommonUtils::GetTargetWorld();
+    if (!World)
+    {
+        OutError = TEXT("No world available");
+        return false;
+    }
+
+    struct FResolvedMove
+    {
+        AActor* Actor;
+        FTransform Transform;
+    };
+
+    // Parse every item and compute its final transform before touching the world, so a
+    // malformed request changes nothing and each actor is moved exactly once
+    TArray<FResolvedMove> Moves;
+    Moves.Reserve(Args.Transforms.Num());
+    TMap<AActor*, int32> MoveIndexByActor;
+    TArray<FString> Missing;
+    TArray<FString> Errors;
+    int32 ItemIndex = 0;
+    for (const FMCPJsonValueView Value : Args.Transforms)
+    {
+        const int32 ThisIndex = ItemIndex++;
+        FMCPJsonObjectView ItemObject;
+        FActorTransformItem Item;
+        FString ItemError;
+        if (!Value.TryGetObject(ItemObject))
+        {
+            Errors.Add(FString::Printf(TEXT("transforms[%d]: must be an object"), ThisIndex));
+            continue;
+        }
+        if (!ActorTransformItemSchema.Bind(ItemObject, Item, ItemError))
+        {
+            Errors.Add(FString::Printf(TEXT("transforms[%d]: %s"), ThisIndex, *ItemError));
+            continue;
+        }
+
+        const FString& ActorName = Item.Actor.IsEmpty() ? Item.Name : Item.Actor;
+        const FString& Mode = Item.Mode.IsEmpty() ? Args.Mode : Item.Mode;
+        const bool bRelative = Mode == TEXT("relative");
+        if (ActorName.IsEmpty())
+        {
+            Errors.Add(FString::Printf(TEXT("transforms[%d]: missing 'actor'"), ThisIndex));
+            continue;
+        }
+        if (!bRelative && Mode != TEXT("absolute"))
+        {
+            Errors.Add(FString::Printf(TEXT("transforms[%d]: invalid mode '%s' (use absolute or relative)"), ThisIndex, *Mode));
+            continue;
+        }
+
+        AActor* Actor = FUnrealMCPCommonUtils::FindActorByName(ActorName);
+        if (!Actor || !Actor->GetRootComponent())
+        {
+            Missing.Add(ActorName);
+            continue;
+        }
+
+        // Repeated actors compose onto the pending transform rather than the current one
+        int32* ExistingIndex = MoveIndexByActor.Find(Actor);
+        FTransform NewTransform = ExistingIndex ? Moves[*ExistingIndex].Transform : Actor->GetActorTransform();
+        if (bRelative)
+        {
+            if (Item.Location.IsSet())
+            {
+                NewTransform.AddToTranslation(Item.Location.GetValue());
+            }
+            if (Item.Rotation.IsSet())
+            {
+                NewTransform.SetRotation(FQuat(Item.Rotation.GetValue()) * NewTransform.GetRotation());
+            }
+            if (Item.Scale.IsSet())
+            {
+                NewTransform.SetScale3D(NewTransform.GetScale3D() * Item.Scale.GetValue());
+            }
+        }
+        else
+        {
+            if (Item.Location.IsSet())
+            {
+                NewTransform.SetLocation(Item.Location.GetValue());
+            }
+            if (Item.Rotation.IsSet())
+            {
+                NewTransform.SetRotation(FQuat(Item.Rotation.GetValue()));
+            }
+            if (Item.Scale.IsSet())
+            {
+                NewTransform.SetScale3D(Item.Scale.GetValue());
+            }
+        }
+
+        if (ExistingIndex)
+        {
+            Moves[*ExistingIndex].Transform = NewTransform;
+        }
+        else
+        {
+            MoveIndexByActor.Add(Actor, Moves.Num());
+            Moves.Add(FResolvedMove{ Actor, NewTransform });
+        }
+    }
+
+    if (Errors.Num() > 0)
+    {
+        OutError = FString::Printf(TEXT("No actors moved: %s"), *FString::Join(Errors, TEXT("; ")));
+        return false;
+    }
+
+    const double StartTime = FPlatformTime::Seconds();
+    {
+        // Editor moves are one undo step; PIE moves are not transacted
+        const bool bTransact = World->WorldType == EWorldType::Editor;
+        const FScopedTransaction Transaction(NSLOCTEXT("UnrealMCP", "SetActorTransforms", "Set Actor Transforms"), bTransact);
+        FNavigationLockContext NavigationLock(World, ENavigationLockReason::Unknown);
+
+        for (const FResolvedMove& Move : Moves)
+        {
+            if (bTransact)
+            {
+                Move.Actor->Modify();
+                Move.Actor->GetRootComponent()->Modify();
+            }
+
+            // One transform write per actor: the scene proxy only marks its render transform
+            // dirty and is sent once at end of frame, and teleporting sets each physics body once
+            // without sweeps or velocity changes
+            FScopedMovementUpdate ScopedMovement(Move.Actor->GetRootComponent(), EScopedUpdate::DeferredUpdates);
+            Move.Actor->SetActorTransform(Move.Transform, /*bSweep=*/ false, nullptr, ETeleportType::TeleportPhysics);
+        }
+    }
+
+    // Listeners (the level journal, the spatial index) hear about each actor once, after all moves
+    for (const FResolvedMove& Move : Moves)
+    {
+        GEngine->BroadcastOnActorMoved(Move.Actor);
+    }
+
+    if (GEditor && Moves.Num() > 0)
+    {
+        GEditor->RedrawLevelEditingViewports();
+    }
+
+    Writer.BeginObject();
+    Writer.WriteField(MCPKeys::Count, Moves.Num());
+    Writer.BeginArray(TEXT("missing"));
+    for (const FString& Name : Missing)
+    {
+        Writer.WriteValue(Name);
+    }
+    Writer.EndArray();
+    Writer.WriteField(TEXT("elapsed_ms"), (FPlatformTime::Seconds() - StartTime) * 1000.0);
+    Writer.WriteField(MCPKeys::World, World->GetMapName());
+    Writer.WriteField(MCPKeys::IsPie, World->WorldType == EWorldType::PIE);
+    Writer.EndObject();
+    return true;
+}
+
+TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleGetActorProperties(const FMCPJsonObjectView& Params)
+{
+    FActorNameParams Args;
+    FString ParamError;
+    if (!GetActorPropertiesSchema.Bind(Params, Args, ParamError))
+    {
+        return FUnrealMCPCommonUtils::CreateErrorResponse(ParamError);
+    }
+
+    AActor* TargetActor = FUnrealMCPCommonUtils::FindActorByName(Args.Name);
     if (!TargetActor)
     {
-        return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Actor not found: %s"), *ActorName));
+        return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Actor not found: %s"), *Args.Name));
     }
 
     return FUnrealMCPCommonUtils::ActorToJsonObject(TargetActor, true);
@@ -463,6 +1178,13 @@ TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleSetActorProperty(const T
     FString ErrorMessage;
     if (FUnrealMCPCommonUtils::SetObjectProperty(TargetActor, PropertyName, PropertyValue, ErrorMessage))
     {
+        // Tell listeners such as the level journal; components get PostEditChangeProperty below
+        if (FProperty* ChangedProp = FindFProperty<FProperty>(TargetActor->GetClass(), *PropertyName))
+        {
+            FPropertyChangedEvent PropEvent(ChangedProp);
+            FCoreUObjectDelegates::OnObjectPropertyChanged.Broadcast(TargetActor, PropEvent);
+        }
+
         // Property set successfully on the actor
         TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
         ResultObj->SetStringField(TEXT("actor"), ActorName);
@@ -609,13 +1331,10 @@ TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleSpawnBlueprintActor(cons
     }
 
     // Check if an actor with this name already exists (check both internal name and label)
-    for (TActorIterator<AActor> It(World); It; ++It)
+    if (FMCPActorIndex::Get().IsNameInUse(World, ActorName, /*bIncludeLabels=*/ true))
     {
-        if (It->GetName() == ActorName || It->GetActorLabel() == ActorName)
-        {
-            return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(
-                TEXT("Actor with name '%s' already exists. Use a different name or delete the existing actor first."), *ActorName));
-        }
+        return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(
+            TEXT("Actor with name '%s' already exists. Use a different name or delete the existing actor first."), *ActorName));
     }
 
     FTransform SpawnTransform;
@@ -671,7 +1390,8 @@ TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleFocusViewport(const TSha
     }
 
     // Get the active viewport
-    FLevelEditorViewportClient* ViewportClient = (FLevelEditorViewportClient*)GEditor->GetActiveViewport()->GetClient();
+    FViewport* ActiveViewport = GEditor->GetActiveViewport();
+    FLevelEditorViewportClient* ViewportClient = ActiveViewport ? (FLevelEditorViewportClient*)ActiveViewport->GetClient() : nullptr;
     if (!ViewportClient)
     {
         return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Failed to get active viewport"));
@@ -713,114 +1433,288 @@ TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleFocusViewport(const TSha
     return ResultObj;
 }
 
-TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleTakeScreenshot(const TSharedPtr<FJsonObject>& Params)
+TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleTakeScreenshot(const FMCPJsonObjectView& Params)
 {
-    // Get file path parameter (optional - defaults to temp directory)
-    FString FilePath;
-    if (!Params->TryGetStringField(TEXT("filepath"), FilePath) || FilePath.IsEmpty())
+    FTakeScreenshotParams Args;
+    FString ParamError;
+    FMCPScreenshotRequest Request;
+    if (!TakeScreenshotSchema.Bind(Params, Args, ParamError)
+        || !FMCPImageEncoder::ParseFormat(Args.Format, Request.Format, ParamError))
     {
-        FilePath = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("Screenshots"), TEXT("MCP_Screenshot.png"));
+        return FUnrealMCPCommonUtils::CreateErrorResponse(ParamError);
     }
 
-    // Ensure the file path has a proper extension
-    if (!FilePath.EndsWith(TEXT(".png")))
+    // Get file path parameter (optional - defaults to the project's Saved directory)
+    FString FilePath = Args.FilePath;
+    if (FilePath.IsEmpty())
     {
-        FilePath += TEXT(".png");
+        FilePath = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("Screenshots"), TEXT("MCP_Screenshot"));
     }
 
-    // Ensure directory exists
-    FString Directory = FPaths::GetPath(FilePath);
-    if (!Directory.IsEmpty())
+    // Ensure the file path has an extension matching the format
+    const FString Extension = FPaths::GetExtension(FilePath, true);
+    const bool bJpegExtension = Extension.Equals(TEXT(".jpg"), ESearchCase::IgnoreCase) || Extension.Equals(TEXT(".jpeg"), ESearchCase::IgnoreCase);
+    if (Request.Format == EMCPImageFormat::Jpeg ? !bJpegExtension : !Extension.Equals(TEXT(".png"), ESearchCase::IgnoreCase))
     {
-        IFileManager::Get().MakeDirectory(*Directory, true);
+        FilePath += FMCPImageEncoder::GetExtension(Request.Format);
     }
 
-    bool bIsPIE = GEditor && GEditor->IsPlayingSessionInEditor();
-    FString ViewportSource = TEXT("unknown");
-    FViewport* Viewport = nullptr;
+    FString ViewportSource;
+    bool bIsPIE = false;
+    FViewport* Viewport = FMCPScreenshotCapture::FindViewport(ViewportSource, bIsPIE);
+    if (!Viewport)
+    {
+        return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("No viewport available for screenshot"));
+    }
 
-    // During PIE, capture the game viewport
-    if (bIsPIE)
+    // The GPU copy is only queued here; get_screenshot reports when the file is written
+    Request.FilePath = FilePath;
+    Request.MaxSize = FMath::Max(0, Args.MaxSize);
+    Request.Quality = Args.Quality;
+    Request.bKeepData = Args.bReturnData;
+    FString CaptureError;
+    const int32 Ticket = FMCPScreenshotCapture::Get().Start(Viewport, Request, CaptureError);
+    if (Ticket == INDEX_NONE)
     {
-        if (GEngine && GEngine->GameViewport && GEngine->GameViewport->Viewport)
-        {
-            Viewport = GEngine->GameViewport->Viewport;
-            ViewportSource = TEXT("PIE_GameViewport");
-        }
+        return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("%s (source: %s)"), *CaptureError, *ViewportSource));
     }
 
-    // For editor mode, get the active level editor viewport (the 3D perspective view)
-    if (!Viewport)
+    const FIntPoint SourceSize = Viewport->GetSizeXY();
+    const FIntPoint OutputSize = FMCPImageEncoder::FitSize(SourceSize, Request.MaxSize);
+    TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
+    ResultObj->SetNumberField(TEXT("ticket"), Ticket);
+    ResultObj->SetStringField(MCPKeyStrings::Status, TEXT("pending"));
+    ResultObj->SetStringField(TEXT("filepath"), FilePath);
+    ResultObj->SetNumberField(TEXT("source_width"), SourceSize.X);
+    ResultObj->SetNumberField(TEXT("source_height"), SourceSize.Y);
+    ResultObj->SetNumberField(TEXT("width"), OutputSize.X);
+    ResultObj->SetNumberField(TEXT("height"), OutputSize.Y);
+    ResultObj->SetBoolField(TEXT("is_pie"), bIsPIE);
+    ResultObj->SetStringField(TEXT("viewport_source"), ViewportSource);
+    return FUnrealMCPCommonUtils::CreateSuccessResponse(ResultObj);
+}
+
+TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleGetScreenshot(const FMCPJsonObjectView& Params)
+{
+    FGetScreenshotParams Args;
+    FString ParamError;
+    if (!GetScreenshotSchema.Bind(Params, Args, ParamError))
+    {
+        return FUnrealMCPCommonUtils::CreateErrorResponse(ParamError);
+    }
+
+    FMCPScreenshotResult Result;
+    if (!FMCPScreenshotCapture::Get().GetResult(Args.Ticket, Result, Args.bIncludeData))
     {
-        FLevelEditorModule& LevelEditorModule = FModuleManager::GetModuleChecked<FLevelEditorModule>(TEXT("LevelEditor"));
-        TSharedPtr<SLevelViewport> ActiveLevelViewport = LevelEditorModule.GetFirstActiveLevelViewport();
-        if (ActiveLevelViewport.IsValid())
+        return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Unknown or expired screenshot ticket: %d"), Args.Ticket));
+    }
+    if (Result.State == EMCPScreenshotState::Failed)
+    {
+        return FUnrealMCPCommonUtils::CreateErrorResponse(Result.Error);
+    }
+
+    const bool bDone = Result.State == EMCPScreenshotState::Done;
+    TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
+    ResultObj->SetNumberField(TEXT("ticket"), Args.Ticket);
+    ResultObj->SetStringField(MCPKeyStrings::Status, bDone ? TEXT("done") : TEXT("pending"));
+    ResultObj->SetStringField(TEXT("filepath"), Result.FilePath);
+    ResultObj->SetStringField(TEXT("format"), Result.Format == EMCPImageFormat::Jpeg ? TEXT("jpeg") : TEXT("png"));
+    ResultObj->SetNumberField(TEXT("source_width"), Result.SourceSize.X);
+    ResultObj->SetNumberField(TEXT("source_height"), Result.SourceSize.Y);
+    if (bDone)
+    {
+        ResultObj->SetNumberField(TEXT("width"), Result.Size.X);
+        ResultObj->SetNumberField(TEXT("height"), Result.Size.Y);
+        ResultObj->SetNumberField(TEXT("bytes"), (double)Result.Bytes);
+        ResultObj->SetNumberField(TEXT("elapsed_ms"), Result.ElapsedMs);
+        if (Args.bIncludeData && Result.Data.Num() > 0)
         {
-            FLevelEditorViewportClient& ViewportClient = ActiveLevelViewport->GetLevelViewportClient();
-            Viewport = ViewportClient.Viewport;
-            ViewportSource = TEXT("LevelEditor_ActiveViewport");
+            ResultObj->SetStringField(TEXT("image_base64"), FBase64::Encode(Result.Data.GetData(), (uint32)Result.Data.Num()));
         }
     }
+    return FUnrealMCPCommonUtils::CreateSuccessResponse(ResultObj);
+}
 
-    // Last resort fallback
-    if (!Viewport && GEditor && GEditor->GetActiveViewport())
+TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleStartViewportStream(const FMCPJsonObjectView& Params)
+{
+    FStartViewportStreamParams Args;
+    FString ParamError;
+    FMCPViewportStreamConfig Config;
+    if (!StartViewportStreamSchema.Bind(Params, Args, ParamError)
+        || !FMCPImageEncoder::ParseFormat(Args.Format, Config.Format, ParamError))
     {
-        Viewport = GEditor->GetActiveViewport();
-        ViewportSource = TEXT("Editor_ActiveViewport");
+        return FUnrealMCPCommonUtils::CreateErrorResponse(ParamError);
     }
 
-    if (!Viewport)
+    // Frames go back over the connection that asked for them
+    UUnrealMCPBridge* Bridge = UUnrealMCPBridge::Get();
+    const TSharedPtr<FMCPClientConnection, ESPMode::ThreadSafe> Connection = Bridge ? Bridge->GetCommandConnection() : nullptr;
+    if (!Connection.IsValid())
     {
-        return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("No viewport available for screenshot"));
+        return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("start_viewport_stream must be sent over a socket connection that stays open"));
     }
 
-    int32 Width = Viewport->GetSizeXY().X;
-    int32 Height = Viewport->GetSizeXY().Y;
+    Config.Fps = FMath::Clamp(Args.Fps, 0.5, 60.0);
+    Config.MaxSize = FMath::Max(0, Args.MaxSize);
+    Config.Quality = Args.Quality;
+    Config.TileSize = FMath::Clamp(Args.TileSize, 16, 512);
+    Config.DeltaThreshold = FMath::Clamp(Args.DeltaThreshold, 0.0, 1.0);
+    Config.KeyframeInterval = FMath::Max(1, Args.KeyframeInterval);
+    const int32 StreamId = FMCPViewportStream::Get().Start(Connection, Config);
+
+    TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
+    ResultObj->SetNumberField(TEXT("stream_id"), StreamId);
+    ResultObj->SetNumberField(TEXT("fps"), Config.Fps);
+    ResultObj->SetNumberField(TEXT("max_size"), Config.MaxSize);
+    ResultObj->SetStringField(TEXT("format"), Config.Format == EMCPImageFormat::Jpeg ? TEXT("jpeg") : TEXT("png"));
+    ResultObj->SetNumberField(TEXT("tile_size"), Config.TileSize);
+    ResultObj->SetStringField(MCPKeyStrings::Message, TEXT("Frames follow on this connection as {\"type\": \"viewport_frame\"} messages"));
+    return FUnrealMCPCommonUtils::CreateSuccessResponse(ResultObj);
+}
 
-    if (Width <= 0 || Height <= 0)
+TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleStopViewportStream(const FMCPJsonObjectView& Params)
+{
+    FStopViewportStreamParams Args;
+    FString ParamError;
+    if (!StopViewportStreamSchema.Bind(Params, Args, ParamError))
     {
-        return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(
-            TEXT("Viewport has invalid size: %dx%d (source: %s)"), Width, Height, *ViewportSource));
+        return FUnrealMCPCommonUtils::CreateErrorResponse(ParamError);
     }
 
-    FlushRenderingCommands();
+    FMCPViewportStreamStats Stats;
+    if (!FMCPViewportStream::Get().Stop(Args.StreamId, Stats))
+    {
+        return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("No active viewport stream: %d"), Args.StreamId));
+    }
 
-    TArray<FColor> Bitmap;
-    FIntRect ViewportRect(0, 0, Width, Height);
-    FReadSurfaceDataFlags ReadFlags(RCM_UNorm);
-    ReadFlags.SetLinearToGamma(false);
+    TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
+    ResultObj->SetNumberField(TEXT("stream_id"), Args.StreamId);
+    ResultObj->SetNumberField(TEXT("sent"), Stats.Sent);
+    ResultObj->SetNumberField(TEXT("deltas"), Stats.Deltas);
+    ResultObj->SetNumberField(TEXT("duplicates"), Stats.Duplicates);
+    ResultObj->SetNumberField(TEXT("skipped"), Stats.Skipped);
+    return FUnrealMCPCommonUtils::CreateSuccessResponse(ResultObj);
+}
 
-    if (!Viewport->ReadPixels(Bitmap, ReadFlags, ViewportRect))
+TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleBeginMutationSession(const FMCPJsonObjectView& Params)
+{
+    FBeginMutationSessionParams Args;
+    FString Error;
+    if (!BeginMutationSessionSchema.Bind(Params, Args, Error))
     {
-        return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(
-            TEXT("ReadPixels failed for viewport %dx%d (source: %s)"), Width, Height, *ViewportSource));
+        return FUnrealMCPCommonUtils::CreateErrorResponse(Error);
     }
 
-    // Force alpha to 255 - viewport ReadPixels returns A=0 which makes
-    // the PNG fully transparent (appears white). UE's own screenshot code
-    // (UGameViewportClient::ProcessScreenShots) does the same fix.
-    for (FColor& Pixel : Bitmap)
+    UUnrealMCPBridge* Bridge = UUnrealMCPBridge::Get();
+    FString SessionId;
+    if (!FMCPMutationSessions::Get().Begin(Args.Name, Args.IdleTimeout, Bridge ? Bridge->GetCommandConnection() : nullptr, SessionId, Error))
     {
-        Pixel.A = 255;
+        return FUnrealMCPCommonUtils::CreateErrorResponse(Error);
     }
 
-    TArray64<uint8> CompressedBitmap;
-    FImageUtils::PNGCompressImageArray(Width, Height, Bitmap, CompressedBitmap);
+    TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
+    ResultObj->SetStringField(TEXT("session_id"), SessionId);
+    ResultObj->SetStringField(MCPKeyStrings::Name, Args.Name);
+    ResultObj->SetStringField(MCPKeyStrings::Message,
+        TEXT("Send \"mutation_session\": session_id with each request, or keep using this connection"));
+    return FUnrealMCPCommonUtils::CreateSuccessResponse(ResultObj);
+}
 
-    if (FFileHelper::SaveArrayToFile(CompressedBitmap, *FilePath))
+TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleEndMutationSession(const FMCPJsonObjectView& Params)
+{
+    FEndMutationSessionParams Args;
+    FString Error;
+    if (!EndMutationSessionSchema.Bind(Params, Args, Error))
     {
-        TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
-        ResultObj->SetStringField(TEXT("filepath"), FilePath);
-        ResultObj->SetNumberField(TEXT("width"), Width);
-        ResultObj->SetNumberField(TEXT("height"), Height);
-        ResultObj->SetBoolField(TEXT("is_pie"), bIsPIE);
-        ResultObj->SetStringField(TEXT("viewport_source"), ViewportSource);
-        return FUnrealMCPCommonUtils::CreateSuccessResponse(ResultObj);
+        return FUnrealMCPCommonUtils::CreateErrorResponse(Error);
     }
-    else
+
+    UUnrealMCPBridge* Bridge = UUnrealMCPBridge::Get();
+    FMCPMutationSessionStats Stats;
+    if (!FMCPMutationSessions::Get().End(Args.SessionId, Bridge ? Bridge->GetCommandConnection().Get() : nullptr, Stats, Error))
+    {
+        return FUnrealMCPCommonUtils::CreateErrorResponse(Error);
+    }
+
+    TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
+    ResultObj->SetStringField(MCPKeyStrings::Name, Stats.Name);
+    ResultObj->SetNumberField(TEXT("commands"), Stats.Commands);
+    ResultObj->SetNumberField(TEXT("transactions"), Stats.Transactions);
+    ResultObj->SetNumberField(TEXT("undo_bytes"), static_cast<double>(Stats.UndoBytes));
+    ResultObj->SetNumberField(TEXT("duration_seconds"), Stats.DurationSeconds);
+    return FUnrealMCPCommonUtils::CreateSuccessResponse(ResultObj);
+}
+
+TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleOpenPawnControl(const FMCPJsonObjectView& Params)
+{
+    FOpenPawnControlParams Args;
+    FString ParamError;
+    if (!OpenPawnControlSchema.Bind(Params, Args, ParamError))
+    {
+        return FUnrealMCPCommonUtils::CreateErrorResponse(ParamError);
+    }
+
+    // Input frames arrive on the connection that opened the channel, and acks go back on it
+    UUnrealMCPBridge* Bridge = UUnrealMCPBridge::Get();
+    const TSharedPtr<FMCPClientConnection, ESPMode::ThreadSafe> Connection = Bridge ? Bridge->GetCommandConnection() : nullptr;
+    if (!Connection.IsValid())
+    {
+        return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("open_pawn_control must be sent over a socket connection that stays open"));
+    }
+    if (!FMCPWorldResolver::Get().GetPIEWorld())
+    {
+        return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Pawn control needs a running PIE session"));
+    }
+
+    AActor* Actor = FUnrealMCPCommonUtils::FindActorByName(Args.ActorName);
+    if (!Actor)
+    {
+        return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Actor not found: %s"), *Args.ActorName));
+    }
+    APawn* Pawn = Cast<APawn>(Actor);
+    if (!Pawn)
+    {
+        return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Actor '%s' is not a Pawn (class: %s)"), *Args.ActorName, *Actor->GetClass()->GetName()));
+    }
+
+    const uint16 TtlMs = static_cast<uint16>(FMath::Clamp(Args.TtlMs, 1, 65535));
+    const uint16 Channel = FMCPPawnControl::Get().Open(Pawn, Connection, TtlMs);
+
+    TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
+    ResultObj->SetNumberField(TEXT("channel"), Channel);
+    ResultObj->SetStringField(TEXT("actor"), Pawn->GetName());
+    ResultObj->SetNumberField(TEXT("ttl_ms"), TtlMs);
+    ResultObj->SetBoolField(TEXT("has_controller"), Pawn->GetController() != nullptr);
+    ResultObj->SetNumberField(TEXT("input_frame_bytes"), MCPBinaryFrameHeaderBytes + FMCPPawnInput::PayloadBytes);
+    ResultObj->SetStringField(MCPKeyStrings::Message,
+        TEXT("Send binary PawnInput frames on this connection; see the README for the layout"));
+    return FUnrealMCPCommonUtils::CreateSuccessResponse(ResultObj);
+}
+
+TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleClosePawnControl(const FMCPJsonObjectView& Params)
+{
+    FClosePawnControlParams Args;
+    FString ParamError;
+    if (!ClosePawnControlSchema.Bind(Params, Args, ParamError))
+    {
+        return FUnrealMCPCommonUtils::CreateErrorResponse(ParamError);
+    }
+
+    FMCPPawnControlStats Stats;
+    if (Args.Channel <= 0 || Args.Channel > MAX_uint16 || !FMCPPawnControl::Get().Close(static_cast<uint16>(Args.Channel), Stats))
     {
-        return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Failed to save screenshot to: %s"), *FilePath));
+        return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("No open pawn control channel: %d"), Args.Channel));
     }
+
+    TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
+    ResultObj->SetNumberField(TEXT("channel"), Args.Channel);
+    ResultObj->SetNumberField(TEXT("received"), Stats.Received);
+    ResultObj->SetNumberField(TEXT("applied"), Stats.Applied);
+    ResultObj->SetNumberField(TEXT("stale"), Stats.Stale);
+    ResultObj->SetNumberField(TEXT("superseded"), Stats.Superseded);
+    ResultObj->SetNumberField(TEXT("malformed"), Stats.Malformed);
+    ResultObj->SetNumberField(TEXT("acks_dropped"), Stats.AcksDropped);
+    return FUnrealMCPCommonUtils::CreateSuccessResponse(ResultObj);
 }
 
 // ============================================================
@@ -896,7 +1790,7 @@ TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleDuplicateActor(const TSh
 	FString NewName;
 	Params->TryGetStringField(TEXT("new_name"), NewName);
 
-	UWorld* World = GEditor->GetEditorWorldContext().World();
+	UWorld* World = FUnrealMCPCommonUtils::GetTargetWorld(/*bPreferPIE=*/ false);
 	if (!World) return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("No editor world"));
 
 	// Find source actor (editor world only - can't duplicate PIE actors)
@@ -1214,13 +2108,15 @@ TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleGetActorTags(const TShar
 // PIE / RL Tools
 // ============================================================
 
-TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleAddMovementInput(const TSharedPtr<FJsonObject>& Params)
+TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleAddMovementInput(const FMCPJsonObjectView& Params)
 {
-	FString ActorName;
-	if (!Params->TryGetStringField(TEXT("actor_name"), ActorName))
+	FAddMovementInputParams Args;
+	FString ParamError;
+	if (!AddMovementInputSchema.Bind(Params, Args, ParamError))
 	{
-		return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Missing 'actor_name' parameter"));
+		return FUnrealMCPCommonUtils::CreateErrorResponse(ParamError);
 	}
+	const FString& ActorName = Args.ActorName;
 
 	AActor* Actor = FUnrealMCPCommonUtils::FindActorByName(ActorName);
 	if (!Actor)
@@ -1234,26 +2130,10 @@ TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleAddMovementInput(const T
 		return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Actor '%s' is not a Pawn (class: %s)"), *ActorName, *Actor->GetClass()->GetName()));
 	}
 
-	// Get direction vector
-	FVector Direction(0.f, 0.f, 0.f);
-	if (Params->HasField(TEXT("direction")))
-	{
-		Direction = FUnrealMCPCommonUtils::GetVectorFromJson(Params, TEXT("direction"));
-	}
-	else
-	{
-		// Accept individual axis floats for convenience
-		double X = 0, Y = 0, Z = 0;
-		Params->TryGetNumberField(TEXT("x"), X);
-		Params->TryGetNumberField(TEXT("y"), Y);
-		Params->TryGetNumberField(TEXT("z"), Z);
-		Direction = FVector(X, Y, Z);
-	}
-
-	double Scale = 1.0;
-	Params->TryGetNumberField(TEXT("scale"), Scale);
+	// Direction vector, or individual axis floats for convenience
+	const FVector Direction = Args.Direction.Get(FVector(Args.X, Args.Y, Args.Z));
 
-	Pawn->AddMovementInput(Direction, Scale);
+	Pawn->AddMovementInput(Direction, Args.Scale);
 
 	// Return current state after input
 	TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
@@ -1281,19 +2161,16 @@ TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleAddMovementInput(const T
 	return FUnrealMCPCommonUtils::CreateSuccessResponse(ResultObj);
 }
 
-TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandlePawnAction(const TSharedPtr<FJsonObject>& Params)
+TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandlePawnAction(const FMCPJsonObjectView& Params)
 {
-	FString ActorName;
-	if (!Params->TryGetStringField(TEXT("actor_name"), ActorName))
+	FPawnActionParams Args;
+	FString ParamError;
+	if (!PawnActionSchema.Bind(Params, Args, ParamError))
 	{
-		return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Missing 'actor_name' parameter"));
-	}
-
-	FString Action;
-	if (!Params->TryGetStringField(TEXT("action"), Action))
-	{
-		return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Missing 'action' parameter"));
+		return FUnrealMCPCommonUtils::CreateErrorResponse(ParamError);
 	}
+	const FString& ActorName = Args.ActorName;
+	const FString& Action = Args.Action;
 
 	AActor* Actor = FUnrealMCPCommonUtils::FindActorByName(ActorName);
 	if (!Actor)
@@ -1350,14 +2227,9 @@ TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandlePawnAction(const TShared
 	else if (Action == TEXT("launch"))
 	{
 		// Launch with a velocity vector — useful for applying impulses
-		FVector LaunchVelocity(0, 0, 0);
-		if (Params->HasField(TEXT("velocity")))
-		{
-			LaunchVelocity = FUnrealMCPCommonUtils::GetVectorFromJson(Params, TEXT("velocity"));
-		}
-		bool bXYOverride = false, bZOverride = false;
-		Params->TryGetBoolField(TEXT("xy_override"), bXYOverride);
-		Params->TryGetBoolField(TEXT("z_override"), bZOverride);
+		const FVector& LaunchVelocity = Args.Velocity;
+		const bool bXYOverride = Args.bXYOverride;
+		const bool bZOverride = Args.bZOverride;
 
 		if (Character)
 		{
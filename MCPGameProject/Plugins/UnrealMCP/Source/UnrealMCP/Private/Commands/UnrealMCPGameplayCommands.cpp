@@ -123,7 +123,7 @@ TSharedPtr<FJsonObject> FUnrealMCPGameplayCommands::HandleSetDefaultGameMode(con
 	DiagInfo += FString::Printf(TEXT("Resolved path: %s. "), *ResolvedClassPath);
 
 	// Set on world settings for the current level
-	UWorld* World = GEditor->GetEditorWorldContext().World();
+	UWorld* World = FUnrealMCPCommonUtils::GetTargetWorld(/*bPreferPIE=*/ false);
 	if (World)
 	{
 		AWorldSettings* WorldSettings = World->GetWorldSettings();
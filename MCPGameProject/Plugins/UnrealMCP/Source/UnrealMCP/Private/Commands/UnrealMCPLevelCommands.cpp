@@ -11,6 +11,24 @@
 #include "Misc/Guid.h"
 #include "HAL/PlatformFileManager.h"
 #include "UObject/GarbageCollection.h"
+#include "UnrealMCPBridge.h"
+#include "MCPCommandParams.h"
+#include "MCPActorQuery.h"
+#include "MCPJsonKeys.h"
+#include "MCPLevelJournal.h"
+#include "MCPWorldResolver.h"
+#include "ScopedTransaction.h"
+#include "EngineUtils.h"
+#include "Engine/Selection.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/StaticMeshActor.h"
+#include "Components/StaticMeshComponent.h"
+#include "Components/HierarchicalInstancedStaticMeshComponent.h"
+#include "Engine/CollisionProfile.h"
+#include "UObject/UnrealType.h"
+#include "Components/LightComponent.h"
+#include "Async/ParallelFor.h"
+#include "Materials/MaterialInterface.h"
 
 FUnrealMCPLevelCommands::FUnrealMCPLevelCommands()
 {
@@ -70,6 +88,323 @@ TSharedPtr<FJsonObject> FUnrealMCPLevelCommands::HandleCommand(const FString& Co
 	return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Unknown level command: %s"), *CommandType));
 }
 
+namespace
+{
+	struct FConsolidateToInstancesParams
+	{
+		FString Scope;
+		FMCPJsonObjectView Filter;
+		int32 MinGroupSize = 2;
+		bool bHierarchical = true;
+		FString NamePrefix = TEXT("Instances");
+		bool bDryRun = false;
+	};
+
+	constexpr auto ConsolidateToInstancesSchema = MakeMCPParamSchema(
+		MCPOptional(TEXT("scope"), &FConsolidateToInstancesParams::Scope, TEXT("selection or level (default: selection, or level when a filter is given)")),
+		MCPOptional(TEXT("filter"), &FConsolidateToInstancesParams::Filter, TEXT("Actor filter (class, tags, folder, level, mobility, label) narrowing the scope")),
+		MCPOptional(TEXT("min_group_size"), &FConsolidateToInstancesParams::MinGroupSize, TEXT("Smallest group worth converting (default 2)")),
+		MCPOptional(TEXT("hierarchical"), &FConsolidateToInstancesParams::bHierarchical, TEXT("Use HISM (default) instead of plain ISM")),
+		MCPOptional(TEXT("name_prefix"), &FConsolidateToInstancesParams::NamePrefix, TEXT("Label prefix for the created actors (default Instances)")),
+		MCPOptional(TEXT("dry_run"), &FConsolidateToInstancesParams::bDryRun, TEXT("Only report the groups that would be created")));
+
+	struct FGetLevelChangesParams
+	{
+		double SinceVersion = 0.0;
+		FString JournalId;
+	};
+
+	constexpr auto GetLevelChangesSchema = MakeMCPParamSchema(
+		MCPRequired(TEXT("since_version"), &FGetLevelChangesParams::SinceVersion, TEXT("Version from the last full listing or get_level_changes call")),
+		MCPOptional(TEXT("journal_id"), &FGetLevelChangesParams::JournalId, TEXT("journal_id that version came from; a mismatch means resync")));
+
+	struct FGetLevelStatsParams
+	{
+		FMCPJsonObjectView Filter;
+		int32 GridSize = 8;
+		int32 Top = 20;
+	};
+
+	constexpr auto GetLevelStatsSchema = MakeMCPParamSchema(
+		MCPOptional(TEXT("filter"), &FGetLevelStatsParams::Filter, TEXT("Actor filter (class, tags, folder, level, mobility, label) limiting what is counted")),
+		MCPOptional(TEXT("grid_size"), &FGetLevelStatsParams::GridSize, TEXT("Cells per side of the XY density grid (default 8, max 64)")),
+		MCPOptional(TEXT("top"), &FGetLevelStatsParams::Top, TEXT("Entries kept in each ranked list (default 20)")));
+
+	struct FLevelChangeFlagName
+	{
+		EMCPLevelChange Flag;
+		const TCHAR* Name;
+	};
+
+	const FLevelChangeFlagName LevelChangeFlagNames[] =
+	{
+		{ EMCPLevelChange::Added, TEXT("added") },
+		{ EMCPLevelChange::Removed, TEXT("removed") },
+		{ EMCPLevelChange::Transform, TEXT("transform") },
+		{ EMCPLevelChange::Renamed, TEXT("renamed") },
+		{ EMCPLevelChange::Property, TEXT("property") },
+	};
+
+	/** Every journal entry for one actor inside the requested window, merged. */
+	struct FActorDelta
+	{
+		const FMCPLevelJournal::FChange* Latest = nullptr;
+		EMCPLevelChange Changes = EMCPLevelChange::None;
+		FString OldName;
+		TArray<FString> Properties;
+	};
+
+	/**
+	 * Everything that must match for two mesh actors to render as instances of one component.
+	 * The rendering settings are copied onto the instanced component; any other setting that
+	 * differs from the component template keeps the actor out (see HasOnlyKeyedOverrides).
+	 */
+	struct FInstanceGroupKey
+	{
+		ULevel* Level = nullptr;
+		UStaticMesh* Mesh = nullptr;
+		TArray<UMaterialInterface*, TInlineAllocator<4>> Materials;
+		FName CollisionProfile;
+		EComponentMobility::Type Mobility = EComponentMobility::Static;
+		bool bVisible = true;
+		bool bHiddenInGame = false;
+		bool bCastShadow = true;
+		bool bCastDynamicShadow = true;
+		bool bCastStaticShadow = true;
+		bool bNeverDistanceCull = false;
+		float MaxDrawDistance = 0.0f;
+
+		/** Overridden light map resolution; 0 keeps the mesh's own. */
+		int32 LightMapResolution = 0;
+
+		bool operator==(const FInstanceGroupKey& Other) const
+		{
+			return Level == Other.Level && Mesh == Other.Mesh && Materials == Other.Materials
+				&& CollisionProfile == Other.CollisionProfile && Mobility == Other.Mobility
+				&& bVisible == Other.bVisible && bHiddenInGame == Other.bHiddenInGame
+				&& bCastShadow == Other.bCastShadow && bCastDynamicShadow == Other.bCastDynamicShadow
+				&& bCastStaticShadow == Other.bCastStaticShadow && bNeverDistanceCull == Other.bNeverDistanceCull
+				&& MaxDrawDistance == Other.MaxDrawDistance && LightMapResolution == Other.LightMapResolution;
+		}
+
+		friend uint32 GetTypeHash(const FInstanceGroupKey& Key)
+		{
+			uint32 Hash = HashCombine(GetTypeHash(Key.Level), GetTypeHash(Key.Mesh));
+			for (UMaterialInterface* Material : Key.Materials)
+			{
+				Hash = HashCombine(Hash, GetTypeHash(Material));
+			}
+			const uint32 Flags = (uint32)Key.bVisible | ((uint32)Key.bHiddenInGame << 1) | ((uint32)Key.bCastShadow << 2)
+				| ((uint32)Key.bCastDynamicShadow << 3) | ((uint32)Key.bCastStaticShadow << 4) | ((uint32)Key.bNeverDistanceCull << 5)
+				| ((uint32)Key.Mobility << 8);
+			Hash = HashCombine(HashCombine(Hash, GetTypeHash(Key.CollisionProfile)), Flags);
+			return HashCombine(HashCombine(Hash, GetTypeHash(Key.MaxDrawDistance)), GetTypeHash(Key.LightMapResolution));
+		}
+	};
+
+	/** Editable component properties that become instance transforms or FInstanceGroupKey fields. */
+	const TSet<FName>& GetKeyedComponentProperties()
+	{
+		static const TSet<FName> Names = {
+			TEXT("RelativeLocation"), TEXT("RelativeRotation"), TEXT("RelativeScale3D"),
+			TEXT("StaticMesh"), TEXT("OverrideMaterials"), TEXT("BodyInstance"), TEXT("Mobility"),
+			TEXT("bVisible"), TEXT("bHiddenInGame"), TEXT("CastShadow"), TEXT("bCastDynamicShadow"), TEXT("bCastStaticShadow"),
+			TEXT("bNeverDistanceCull"), TEXT("LDMaxDrawDistance"), TEXT("bOverrideLightMapRes"), TEXT("OverriddenLightMapRes")
+		};
+		return Names;
+	}
+
+	/** Body instance properties the collision profile decides; everything else in it is a physics override. */
+	const TSet<FName>& GetProfileBodyProperties()
+	{
+		static const TSet<FName> Names = {
+			TEXT("CollisionProfileName"), TEXT("CollisionEnabled"), TEXT("ObjectType"), TEXT("CollisionResponses")
+		};
+		return Names;
+	}
+
+	/** Editable, user-set properties: derived (EditConst) and transient values may differ per actor without meaning anything. */
+	bool IsComparableSetting(const FProperty* Property)
+	{
+		return Property->HasAnyPropertyFlags(CPF_Edit) && !Property->HasAnyPropertyFlags(CPF_EditConst | CPF_Transient | CPF_Deprecated);
+	}
+
+	/**
+	 * True when Component differs from its template only in settings FInstanceGroupKey carries
+	 * over. Custom primitive data, distance culling minimums, painted vertex colors, physics
+	 * overrides and the like cannot be reproduced per instance, so those actors are left alone.
+	 */
+	bool HasOnlyKeyedOverrides(const UStaticMeshComponent* Component)
+	{
+		const UStaticMeshComponent* Template = Cast<UStaticMeshComponent>(Component->GetArchetype());
+		if (!Template)
+		{
+			return false;
+		}
+
+		const TSet<FName>& KeyedProperties = GetKeyedComponentProperties();
+		for (TFieldIterator<FProperty> It(Component->GetClass()); It; ++It)
+		{
+			if (IsComparableSetting(*It) && !KeyedProperties.Contains(It->GetFName())
+				&& !It->Identical_InContainer(Component, Template))
+			{
+				return false;
+			}
+		}
+
+		// A Custom profile stores its responses in the body instance, which the key does not hold
+		const bool bCustomCollision = Component->GetCollisionProfileName() == UCollisionProfile::CustomCollisionProfileName;
+		const TSet<FName>& ProfileProperties = GetProfileBodyProperties();
+		for (TFieldIterator<FProperty> It(FBodyInstance::StaticStruct()); It; ++It)
+		{
+			if (IsComparableSetting(*It) && (bCustomCollision || !ProfileProperties.Contains(It->GetFName()))
+				&& !It->Identical_InContainer(&Component->BodyInstance, &Template->BodyInstance))
+			{
+				return false;
+			}
+		}
+
+		for (const FStaticMeshComponentLODInfo& LODInfo : Component->LODData)
+		{
+			if (LODInfo.OverrideVertexColors)
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	/**
+	 * Only plain StaticMeshActors whose whole state is the mesh component are merged: subclasses,
+	 * attached actors and tagged actors carry behaviour or identity an instance cannot keep.
+	 */
+	UStaticMeshComponent* GetConsolidatableComponent(AActor* Actor)
+	{
+		AStaticMeshActor* MeshActor = Cast<AStaticMeshActor>(Actor);
+		if (!MeshActor || MeshActor->GetClass() != AStaticMeshActor::StaticClass() || MeshActor->Tags.Num() > 0
+			|| MeshActor->GetAttachParentActor() || MeshActor->IsChildActor())
+		{
+			return nullptr;
+		}
+		TArray<AActor*> Attached;
+		MeshActor->GetAttachedActors(Attached);
+		UStaticMeshComponent* Component = MeshActor->GetStaticMeshComponent();
+		return (Attached.Num() == 0 && Component && Component->GetStaticMesh()) ? Component : nullptr;
+	}
+
+	/** Dense indices for the distinct objects (classes, meshes) a level snapshot refers to. */
+	template <typename ObjectType>
+	struct FStatsObjectTable
+	{
+		TArray<const ObjectType*> Objects;
+		TMap<const ObjectType*, int32> Indices;
+
+		int32 IndexOf(const ObjectType* Object)
+		{
+			if (const int32* Found = Indices.Find(Object))
+			{
+				return *Found;
+			}
+			const int32 Index = Objects.Add(Object);
+			Indices.Add(Object, Index);
+			return Index;
+		}
+	};
+
+	/** What get_level_stats needs from one component, copied on the game thread. */
+	struct FStatsComponent
+	{
+		int32 ClassIndex = INDEX_NONE;
+		int32 MeshIndex = INDEX_NONE;
+		int32 Instances = 0;
+
+		/** EComponentMobility of a light component, INDEX_NONE for everything else. */
+		int8 LightMobility = INDEX_NONE;
+		bool bTicks = false;
+	};
+
+	struct FStatsActor
+	{
+		int32 ClassIndex = INDEX_NONE;
+		FVector2D Location = FVector2D::ZeroVector;
+		int32 FirstComponent = 0;
+		int32 NumComponents = 0;
+		bool bTicks = false;
+	};
+
+	/** Counts over a range of the snapshot; chunks are summed after the parallel pass. */
+	struct FStatsTotals
+	{
+		TArray<int32> ActorsPerClass;
+		TArray<int32> ComponentsPerClass;
+		TArray<int64> InstancesPerMesh;
+		TArray<int32> ActorsPerCell;
+		int32 LightsByMobility[3] = { 0, 0, 0 };
+		int32 TickingActors = 0;
+		int32 TickingComponents = 0;
+
+		void Init(int32 NumActorClasses, int32 NumComponentClasses, int32 NumMeshes, int32 NumCells)
+		{
+			ActorsPerClass.SetNumZeroed(NumActorClasses);
+			ComponentsPerClass.SetNumZeroed(NumComponentClasses);
+			InstancesPerMesh.SetNumZeroed(NumMeshes);
+			ActorsPerCell.SetNumZeroed(NumCells);
+		}
+
+		void Merge(const FStatsTotals& Other)
+		{
+			for (int32 Index = 0; Index < ActorsPerClass.Num(); ++Index) { ActorsPerClass[Index] += Other.ActorsPerClass[Index]; }
+			for (int32 Index = 0; Index < ComponentsPerClass.Num(); ++Index) { ComponentsPerClass[Index] += Other.ComponentsPerClass[Index]; }
+			for (int32 Index = 0; Index < InstancesPerMesh.Num(); ++Index) { InstancesPerMesh[Index] += Other.InstancesPerMesh[Index]; }
+			for (int32 Index = 0; Index < ActorsPerCell.Num(); ++Index) { ActorsPerCell[Index] += Other.ActorsPerCell[Index]; }
+			for (int32 Index = 0; Index < 3; ++Index) { LightsByMobility[Index] += Other.LightsByMobility[Index]; }
+			TickingActors += Other.TickingActors;
+			TickingComponents += Other.TickingComponents;
+		}
+	};
+
+	// Actors per parallel aggregation task
+	constexpr int32 LevelStatsChunkSize = 4096;
+
+	/** Indices of the largest Top values, largest first. */
+	template <typename CountType>
+	TArray<int32> RankIndices(const TArray<CountType>& Counts, int32 Top)
+	{
+		TArray<int32> Ranked;
+		for (int32 Index = 0; Index < Counts.Num(); ++Index)
+		{
+			if (Counts[Index] > 0)
+			{
+				Ranked.Add(Index);
+			}
+		}
+		Ranked.Sort([&Counts](int32 A, int32 B) { return Counts[A] > Counts[B]; });
+		if (Ranked.Num() > Top)
+		{
+			Ranked.SetNum(Top);
+		}
+		return Ranked;
+	}
+
+	int32 GetDrawCallsPerMesh(UStaticMesh* Mesh)
+	{
+		return (Mesh && Mesh->GetRenderData() && Mesh->GetRenderData()->LODResources.Num() > 0)
+			? FMath::Max(1, Mesh->GetRenderData()->LODResources[0].Sections.Num())
+			: 1;
+	}
+}
+
+void FUnrealMCPLevelCommands::RegisterNativeHandlers(UUnrealMCPBridge& Bridge)
+{
+	Bridge.RegisterNativeHandler(TEXT("consolidate_to_instances"), FMCPNativeCommandHandler::CreateRaw(this, &FUnrealMCPLevelCommands::HandleConsolidateToInstances));
+	Bridge.RegisterStreamingHandler(TEXT("get_level_changes"), FMCPStreamingCommandHandler::CreateRaw(this, &FUnrealMCPLevelCommands::HandleGetLevelChanges));
+	Bridge.RegisterStreamingHandler(TEXT("get_level_stats"), FMCPStreamingCommandHandler::CreateRaw(this, &FUnrealMCPLevelCommands::HandleGetLevelStats));
+
+	FMCPCommandSchemas::Register(TEXT("consolidate_to_instances"), TEXT("Replace groups of identical StaticMeshActors with one instanced mesh actor each"), ConsolidateToInstancesSchema);
+	FMCPCommandSchemas::Register(TEXT("get_level_changes"), TEXT("Actor changes since a journal version, or a resync marker"), GetLevelChangesSchema);
+	FMCPCommandSchemas::Register(TEXT("get_level_stats"), TEXT("Counts, mesh cost, lights, ticking and density of the current level"), GetLevelStatsSchema);
+}
+
 TSharedPtr<FJsonObject> FUnrealMCPLevelCommands::HandleNewLevel(const TSharedPtr<FJsonObject>& Params)
 {
 	ULevelEditorSubsystem* LevelEditorSubsystem = GEditor->GetEditorSubsystem<ULevelEditorSubsystem>();
@@ -144,7 +479,7 @@ TSharedPtr<FJsonObject> FUnrealMCPLevelCommands::HandleLoadLevel(const TSharedPt
 
 	// Record the old world name so we can verify the level actually changed
 	FString OldLevelName;
-	if (UWorld* OldWorld = GEditor->GetEditorWorldContext().World())
+	if (UWorld* OldWorld = FUnrealMCPCommonUtils::GetTargetWorld(/*bPreferPIE=*/ false))
 	{
 		OldLevelName = OldWorld->GetMapName();
 	}
@@ -249,7 +584,7 @@ TSharedPtr<FJsonObject> FUnrealMCPLevelCommands::HandleLoadLevel(const TSharedPt
 	}
 
 	// Verify the level actually changed by checking the new world
-	UWorld* NewWorld = GEditor->GetEditorWorldContext().World();
+	UWorld* NewWorld = FUnrealMCPCommonUtils::GetTargetWorld(/*bPreferPIE=*/ false);
 	FString NewLevelName = NewWorld ? NewWorld->GetMapName() : TEXT("unknown");
 	FString NewLevelPath = NewWorld ? NewWorld->GetPathName() : TEXT("unknown");
 
@@ -296,7 +631,7 @@ TSharedPtr<FJsonObject> FUnrealMCPLevelCommands::HandleSaveAllLevels(const TShar
 
 TSharedPtr<FJsonObject> FUnrealMCPLevelCommands::HandleGetCurrentLevel(const TSharedPtr<FJsonObject>& Params)
 {
-	UWorld* World = GEditor->GetEditorWorldContext().World();
+	UWorld* World = FUnrealMCPCommonUtils::GetTargetWorld(/*bPreferPIE=*/ false);
 	if (!World)
 	{
 		return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("No editor world available"));
@@ -409,7 +744,7 @@ TSharedPtr<FJsonObject> FUnrealMCPLevelCommands::HandleExecuteConsoleCommand(con
 	if (GEditor)
 	{
 		FMCPOutputDevice OutputDevice;
-		GEditor->Exec(GEditor->GetEditorWorldContext().World(), *Command, OutputDevice);
+		GEditor->Exec(FUnrealMCPCommonUtils::GetTargetWorld(/*bPreferPIE=*/ false), *Command, OutputDevice);
 		Output = OutputDevice.CapturedOutput;
 	}
 
@@ -462,7 +797,7 @@ TSharedPtr<FJsonObject> FUnrealMCPLevelCommands::HandleBuildLighting(const TShar
 
 TSharedPtr<FJsonObject> FUnrealMCPLevelCommands::HandleSetWorldSettings(const TSharedPtr<FJsonObject>& Params)
 {
-	UWorld* World = GEditor->GetEditorWorldContext().World();
+	UWorld* World = FUnrealMCPCommonUtils::GetTargetWorld(/*bPreferPIE=*/ false);
 	if (!World)
 	{
 		return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("No editor world available"));
@@ -637,3 +972,538 @@ TSharedPtr<FJsonObject> FUnrealMCPLevelCommands::HandleExecutePython(const TShar
 	ResultObj->SetBoolField(TEXT("executed"), Status == TEXT("success"));
 	return FUnrealMCPCommonUtils::CreateSuccessResponse(ResultObj);
 }
+
+TSharedPtr<FJsonObject> FUnrealMCPLevelCommands::HandleConsolidateToInstances(const FMCPJsonObjectView& Params)
+{
+	FConsolidateToInstancesParams Args;
+	FMCPActorFilter Filter;
+	FString ParamError;
+	if (!ConsolidateToInstancesSchema.Bind(Params, Args, ParamError) || !FMCPActorFilter::Parse(Args.Filter, Filter, ParamError))
+	{
+		return FUnrealMCPCommonUtils::CreateErrorResponse(ParamError);
+	}
+	if (Args.Scope.IsEmpty())
+	{
+		Args.Scope = Filter.IsEmpty() ? TEXT("selection") : TEXT("level");
+	}
+	if (Args.Scope != TEXT("selection") && Args.Scope != TEXT("level"))
+	{
+		return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Invalid scope '%s' (use selection or level)"), *Args.Scope));
+	}
+	const int32 MinGroupSize = FMath::Max(Args.MinGroupSize, 2);
+
+	UWorld* World = FUnrealMCPCommonUtils::GetTargetWorld(/*bPreferPIE=*/ false);
+	if (!World)
+	{
+		return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Failed to get editor world"));
+	}
+	if (FMCPWorldResolver::Get().GetPIEWorld())
+	{
+		return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Cannot consolidate actors while Play-In-Editor is active"));
+	}
+
+	// Gather candidates from the scope
+	TArray<AActor*> Candidates;
+	if (Args.Scope == TEXT("selection"))
+	{
+		for (FSelectionIterator It(*GEditor->GetSelectedActors()); It; ++It)
+		{
+			if (AActor* Actor = Cast<AActor>(*It))
+			{
+				Candidates.Add(Actor);
+			}
+		}
+	}
+	else
+	{
+		for (TActorIterator<AStaticMeshActor> It(World); It; ++It)
+		{
+			Candidates.Add(*It);
+		}
+	}
+
+	// Group by everything that has to be shared for the actors to become one instanced draw
+	TMap<FInstanceGroupKey, TArray<UStaticMeshComponent*>> Groups;
+	int32 NumSkipped = 0;
+	for (AActor* Actor : Candidates)
+	{
+		UStaticMeshComponent* Component = GetConsolidatableComponent(Actor);
+		if (!Component || (!Filter.IsEmpty() && !Filter.Matches(Actor)) || !HasOnlyKeyedOverrides(Component))
+		{
+			NumSkipped++;
+			continue;
+		}
+
+		FInstanceGroupKey Key;
+		Key.Level = Actor->GetLevel();
+		Key.Mesh = Component->GetStaticMesh();
+		for (int32 Slot = 0; Slot < Component->GetNumMaterials(); ++Slot)
+		{
+			Key.Materials.Add(Component->GetMaterial(Slot));
+		}
+		Key.CollisionProfile = Component->GetCollisionProfileName();
+		Key.Mobility = Component->Mobility;
+		Key.bVisible = Component->GetVisibleFlag();
+		Key.bHiddenInGame = Component->bHiddenInGame || Actor->IsHidden();
+		Key.bCastShadow = Component->CastShadow;
+		Key.bCastDynamicShadow = Component->bCastDynamicShadow;
+		Key.bCastStaticShadow = Component->bCastStaticShadow;
+		Key.bNeverDistanceCull = Component->bNeverDistanceCull;
+		Key.MaxDrawDistance = Component->LDMaxDrawDistance;
+		Key.LightMapResolution = Component->bOverrideLightMapRes ? Component->OverriddenLightMapRes : 0;
+		Groups.FindOrAdd(MoveTemp(Key)).Add(Component);
+	}
+
+	// Groups too small to convert are left as they are
+	for (auto It = Groups.CreateIterator(); It; ++It)
+	{
+		if (It->Value.Num() < MinGroupSize)
+		{
+			NumSkipped += It->Value.Num();
+			It.RemoveCurrent();
+		}
+	}
+
+	int32 ActorsBefore = 0;
+	int32 DrawCallsBefore = 0;
+	int32 DrawCallsAfter = 0;
+	int32 ActorsCreated = 0;
+	TArray<TSharedPtr<FJsonValue>> GroupsJson;
+
+	TOptional<FScopedTransaction> Transaction;
+	if (!Args.bDryRun && Groups.Num() > 0)
+	{
+		Transaction.Emplace(NSLOCTEXT("UnrealMCP", "ConsolidateToInstances", "Consolidate To Instances"));
+	}
+
+	for (TPair<FInstanceGroupKey, TArray<UStaticMeshComponent*>>& Group : Groups)
+	{
+		const FInstanceGroupKey& Key = Group.Key;
+		TArray<UStaticMeshComponent*>& Components = Group.Value;
+		const int32 SectionsPerMesh = GetDrawCallsPerMesh(Key.Mesh);
+
+		// Instances are stored relative to the group's centroid, so the new actor sits where the group is
+		TArray<FTransform> Transforms;
+		Transforms.Reserve(Components.Num());
+		FVector Pivot = FVector::ZeroVector;
+		for (UStaticMeshComponent* Component : Components)
+		{
+			Transforms.Add(Component->GetComponentTransform());
+			Pivot += Component->GetComponentLocation();
+		}
+		Pivot /= Components.Num();
+
+		TSharedPtr<FJsonObject> GroupJson = MakeShared<FJsonObject>();
+		GroupJson->SetStringField(TEXT("mesh"), Key.Mesh->GetPathName());
+		GroupJson->SetNumberField(TEXT("instances"), Components.Num());
+		GroupJson->SetNumberField(TEXT("sections"), SectionsPerMesh);
+
+		if (!Args.bDryRun)
+		{
+			AActor* FirstActor = Components[0]->GetOwner();
+			FActorSpawnParameters SpawnParams;
+			SpawnParams.OverrideLevel = Key.Level;
+			AActor* HostActor = World->SpawnActor<AActor>(AActor::StaticClass(), FTransform(Pivot), SpawnParams);
+			if (!HostActor)
+			{
+				GroupJson->SetStringField(TEXT("error"), TEXT("Failed to spawn the instance actor"));
+				GroupsJson.Add(MakeShared<FJsonValueObject>(GroupJson));
+				continue;
+			}
+
+			UInstancedStaticMeshComponent* InstanceComponent = Args.bHierarchical
+				? NewObject<UHierarchicalInstancedStaticMeshComponent>(HostActor, TEXT("Instances"), RF_Transactional)
+				: NewObject<UInstancedStaticMeshComponent>(HostActor, TEXT("Instances"), RF_Transactional);
+			InstanceComponent->SetMobility(Key.Mobility);
+			InstanceComponent->SetStaticMesh(Key.Mesh);
+			for (int32 Slot = 0; Slot < Key.Materials.Num(); ++Slot)
+			{
+				InstanceComponent->SetMaterial(Slot, Key.Materials[Slot]);
+			}
+			InstanceComponent->SetCollisionProfileName(Key.CollisionProfile);
+			InstanceComponent->SetVisibility(Key.bVisible);
+			InstanceComponent->SetHiddenInGame(Key.bHiddenInGame);
+			InstanceComponent->SetCastShadow(Key.bCastShadow);
+			InstanceComponent->bCastDynamicShadow = Key.bCastDynamicShadow;
+			InstanceComponent->bCastStaticShadow = Key.bCastStaticShadow;
+			InstanceComponent->bNeverDistanceCull = Key.bNeverDistanceCull;
+			if (Key.MaxDrawDistance > 0.0f)
+			{
+				// Each actor was culled on its own distance, so cull per instance rather than by the group's bounds
+				InstanceComponent->SetCullDistances((int32)Key.MaxDrawDistance, (int32)Key.MaxDrawDistance);
+			}
+			InstanceComponent->bOverrideLightMapRes = Key.LightMapResolution > 0;
+			InstanceComponent->OverriddenLightMapRes = Key.LightMapResolution;
+			HostActor->SetRootComponent(InstanceComponent);
+			HostActor->AddInstanceComponent(InstanceComponent);
+			InstanceComponent->SetWorldTransform(FTransform(Pivot));
+			InstanceComponent->RegisterComponent();
+
+			// One bulk add: the HISM cluster tree is built once rather than per instance
+			InstanceComponent->AddInstances(Transforms, /*bShouldReturnIndices=*/ false, /*bWorldSpace=*/ true);
+
+			HostActor->SetActorLabel(FString::Printf(TEXT("%s_%s"), *Args.NamePrefix, *Key.Mesh->GetName()));
+			HostActor->SetFolderPath(FirstActor->GetFolderPath());
+
+			for (UStaticMeshComponent* Component : Components)
+			{
+				World->EditorDestroyActor(Component->GetOwner(), /*bShouldModifyLevel=*/ true);
+			}
+
+			GroupJson->SetStringField(TEXT("actor"), HostActor->GetActorLabel());
+		}
+		ActorsBefore += Components.Num();
+		DrawCallsBefore += SectionsPerMesh * Components.Num();
+		DrawCallsAfter += SectionsPerMesh;
+		ActorsCreated++;
+		GroupsJson.Add(MakeShared<FJsonValueObject>(GroupJson));
+	}
+
+	if (!Args.bDryRun && ActorsCreated > 0)
+	{
+		GEditor->RedrawLevelEditingViewports();
+	}
+
+	TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
+	ResultObj->SetArrayField(TEXT("groups"), GroupsJson);
+	ResultObj->SetBoolField(TEXT("dry_run"), Args.bDryRun);
+	ResultObj->SetNumberField(TEXT("actors_before"), ActorsBefore);
+	ResultObj->SetNumberField(TEXT("actors_after"), ActorsCreated);
+	ResultObj->SetNumberField(TEXT("actors_removed"), ActorsBefore - ActorsCreated);
+	// Base pass estimate: one draw per LOD0 section per actor before, per component after
+	ResultObj->SetNumberField(TEXT("draw_calls_before"), DrawCallsBefore);
+	ResultObj->SetNumberField(TEXT("draw_calls_after"), DrawCallsAfter);
+	ResultObj->SetNumberField(TEXT("skipped_actors"), NumSkipped);
+	return FUnrealMCPCommonUtils::CreateSuccessResponse(ResultObj);
+}
+
+bool FUnrealMCPLevelCommands::HandleGetLevelChanges(const FMCPJsonObjectView& Params, FMCPJsonWriter& Writer, FString& OutError)
+{
+	FGetLevelChangesParams Args;
+	if (!GetLevelChangesSchema.Bind(Params, Args, OutError))
+	{
+		return false;
+	}
+
+	UWorld* World = FUnrealMCPCommonUtils::GetTargetWorld();
+	if (!World)
+	{
+		OutError = TEXT("No world available");
+		return false;
+	}
+
+	const FMCPLevelJournal& Journal = FMCPLevelJournal::Get();
+	const int64 SinceVersion = (int64)Args.SinceVersion;
+	TArray<const FMCPLevelJournal::FChange*> Changes;
+	const bool bSameJournal = Args.JournalId.IsEmpty() || Args.JournalId == Journal.GetJournalId();
+	const bool bInSync = bSameJournal && SinceVersion >= 0 && Journal.GetChangesSince(World, SinceVersion, Changes);
+
+	// One entry per actor, in order of its latest change, carrying its current state
+	TArray<FActorDelta> Deltas;
+	TMap<TObjectKey<AActor>, int32> DeltaIndexByActor;
+	for (const FMCPLevelJournal::FChange* Change : Changes)
+	{
+		int32& Index = DeltaIndexByActor.FindOrAdd(Change->ActorKey, INDEX_NONE);
+		if (Index == INDEX_NONE)
+		{
+			Index = Deltas.AddDefaulted();
+		}
+		FActorDelta& Delta = Deltas[Index];
+		Delta.Latest = Change;
+		Delta.Changes |= Change->Type;
+		if (Change->Type == EMCPLevelChange::Renamed && Delta.OldName.IsEmpty())
+		{
+			Delta.OldName = Change->Detail;
+		}
+		else if (Change->Type == EMCPLevelChange::Property)
+		{
+			Delta.Properties.AddUnique(Change->Detail);
+		}
+	}
+	Deltas.Sort([](const FActorDelta& A, const FActorDelta& B) { return A.Latest->Version < B.Latest->Version; });
+
+	Writer.BeginObject();
+	Writer.WriteField(TEXT("journal_id"), Journal.GetJournalId());
+	Writer.WriteField(TEXT("version"), Journal.GetVersion());
+	Writer.WriteField(TEXT("since_version"), SinceVersion);
+	Writer.WriteField(TEXT("resync_required"), !bInSync);
+	Writer.BeginArray(TEXT("changes"));
+	for (const FActorDelta& Delta : Deltas)
+	{
+		// A removed actor may be gone or pending kill; either way only its identity is reported
+		AActor* Actor = Delta.Latest->Actor.Get();
+		const bool bRemoved = Delta.Latest->Type == EMCPLevelChange::Removed || !IsValid(Actor);
+
+		Writer.BeginObject();
+		Writer.WriteField(TEXT("version"), Delta.Latest->Version);
+		Writer.BeginArray(TEXT("changes"));
+		for (const FLevelChangeFlagName& Flag : LevelChangeFlagNames)
+		{
+			if (EnumHasAnyFlags(Delta.Changes, Flag.Flag))
+			{
+				Writer.WriteValue(Flag.Name);
+			}
+		}
+		Writer.EndArray();
+		Writer.WriteField(TEXT("removed"), bRemoved);
+		if (bRemoved)
+		{
+			Writer.WriteField(MCPKeys::Name, Delta.Latest->Name);
+			Writer.WriteField(MCPKeys::Label, Delta.Latest->Label);
+		}
+		else
+		{
+			FUnrealMCPCommonUtils::WriteActorFields(Writer, Actor);
+			Writer.WriteField(MCPKeys::Label, Actor->GetActorLabel());
+		}
+		if (!Delta.OldName.IsEmpty())
+		{
+			Writer.WriteField(TEXT("old_name"), Delta.OldName);
+		}
+		if (Delta.Properties.Num() > 0)
+		{
+			Writer.BeginArray(MCPKeys::Properties);
+			for (const FString& Property : Delta.Properties)
+			{
+				Writer.WriteValue(Property);
+			}
+			Writer.EndArray();
+		}
+		Writer.EndObject();
+	}
+	Writer.EndArray();
+	Writer.WriteField(MCPKeys::Count, Deltas.Num());
+	Writer.WriteField(MCPKeys::World, World->GetMapName());
+	Writer.WriteField(MCPKeys::IsPie, World->WorldType == EWorldType::PIE);
+	Writer.EndObject();
+	return true;
+}
+
+bool FUnrealMCPLevelCommands::HandleGetLevelStats(const FMCPJsonObjectView& Params, FMCPJsonWriter& Writer, FString& OutError)
+{
+	FGetLevelStatsParams Args;
+	FMCPActorFilter Filter;
+	if (!GetLevelStatsSchema.Bind(Params, Args, OutError)
+		|| !FMCPActorFilter::Parse(Args.Filter, Filter, OutError))
+	{
+		return false;
+	}
+	const int32 GridSize = FMath::Clamp(Args.GridSize, 1, 64);
+	const int32 Top = FMath::Max(1, Args.Top);
+
+	UWorld* World = FUnrealMCPCommonUtils::GetTargetWorld();
+	if (!World)
+	{
+		OutError = TEXT("No world available");
+		return false;
+	}
+
+	// Game thread: copy what the report needs into flat arrays, resolving classes and meshes to indices
+	const double StartTime = FPlatformTime::Seconds();
+	const bool bFiltered = !Filter.IsEmpty();
+	FStatsObjectTable<UClass> ActorClasses;
+	FStatsObjectTable<UClass> ComponentClasses;
+	FStatsObjectTable<UStaticMesh> Meshes;
+	TArray<FStatsActor> Actors;
+	TArray<FStatsComponent> Components;
+	FBox2D Bounds(ForceInit);
+	TInlineComponentArray<UActorComponent*> ActorComponents;
+	for (TActorIterator<AActor> It(World); It; ++It)
+	{
+		AActor* Actor = *It;
+		if (!Actor || (bFiltered && !Filter.Matches(Actor)))
+		{
+			continue;
+		}
+
+		FStatsActor& Entry = Actors.AddDefaulted_GetRef();
+		Entry.ClassIndex = ActorClasses.IndexOf(Actor->GetClass());
+		Entry.Location = FVector2D(Actor->GetActorLocation());
+		Entry.bTicks = Actor->PrimaryActorTick.bCanEverTick && Actor->IsActorTickEnabled();
+		Bounds += Entry.Location;
+
+		Actor->GetComponents(ActorComponents);
+		Entry.FirstComponent = Components.Num();
+		Entry.NumComponents = ActorComponents.Num();
+		for (UActorComponent* Component : ActorComponents)
+		{
+			FStatsComponent& ComponentEntry = Components.AddDefaulted_GetRef();
+			ComponentEntry.ClassIndex = ComponentClasses.IndexOf(Component->GetClass());
+			ComponentEntry.bTicks = Component->PrimaryComponentTick.bCanEverTick && Component->IsComponentTickEnabled();
+			if (const UStaticMeshComponent* MeshComponent = Cast<UStaticMeshComponent>(Component))
+			{
+				if (const UStaticMesh* Mesh = MeshComponent->GetStaticMesh())
+				{
+					const UInstancedStaticMeshComponent* InstancedComponent = Cast<UInstancedStaticMeshComponent>(MeshComponent);
+					ComponentEntry.MeshIndex = Meshes.IndexOf(Mesh);
+					ComponentEntry.Instances = InstancedComponent ? InstancedComponent->GetInstanceCount() : 1;
+				}
+			}
+			else if (const ULightComponent* Light = Cast<ULightComponent>(Component))
+			{
+				ComponentEntry.LightMobility = (int8)Light->Mobility.GetValue();
+			}
+		}
+	}
+	const double SnapshotMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+	// Cells cover the actors' XY bounds; a degenerate extent gets one unit so every actor lands in a cell
+	const FVector2D BoundsMin = Bounds.bIsValid ? Bounds.Min : FVector2D::ZeroVector;
+	const FVector2D BoundsMax = Bounds.bIsValid ? Bounds.Max : FVector2D::ZeroVector;
+	const FVector2D CellSize = FVector2D(
+		FMath::Max(BoundsMax.X - BoundsMin.X, 1.0) / GridSize,
+		FMath::Max(BoundsMax.Y - BoundsMin.Y, 1.0) / GridSize);
+
+	// Parallel: each chunk of actors fills its own totals, summed afterwards
+	const int32 NumChunks = FMath::Max(1, FMath::DivideAndRoundUp(Actors.Num(), LevelStatsChunkSize));
+	TArray<FStatsTotals> ChunkTotals;
+	ChunkTotals.SetNum(NumChunks);
+	ParallelFor(NumChunks, [&](int32 ChunkIndex)
+	{
+		FStatsTotals& Totals = ChunkTotals[ChunkIndex];
+		Totals.Init(ActorClasses.Objects.Num(), ComponentClasses.Objects.Num(), Meshes.Objects.Num(), GridSize * GridSize);
+		const int32 Begin = ChunkIndex * LevelStatsChunkSize;
+		const int32 End = FMath::Min(Begin + LevelStatsChunkSize, Actors.Num());
+		for (int32 ActorIndex = Begin; ActorIndex < End; ++ActorIndex)
+		{
+			const FStatsActor& Actor = Actors[ActorIndex];
+			Totals.ActorsPerClass[Actor.ClassIndex]++;
+			Totals.TickingActors += Actor.bTicks ? 1 : 0;
+
+			const int32 CellX = FMath::Clamp((int32)((Actor.Location.X - BoundsMin.X) / CellSize.X), 0, GridSize - 1);
+			const int32 CellY = FMath::Clamp((int32)((Actor.Location.Y - BoundsMin.Y) / CellSize.Y), 0, GridSize - 1);
+			Totals.ActorsPerCell[CellY * GridSize + CellX]++;
+
+			for (int32 ComponentIndex = Actor.FirstComponent; ComponentIndex < Actor.FirstComponent + Actor.NumComponents; ++ComponentIndex)
+			{
+				const FStatsComponent& Component = Components[ComponentIndex];
+				Totals.ComponentsPerClass[Component.ClassIndex]++;
+				Totals.TickingComponents += Component.bTicks ? 1 : 0;
+				if (Component.MeshIndex != INDEX_NONE)
+				{
+					Totals.InstancesPerMesh[Component.MeshIndex] += Component.Instances;
+				}
+				if (Component.LightMobility != INDEX_NONE)
+				{
+					Totals.LightsByMobility[FMath::Clamp<int32>(Component.LightMobility, 0, 2)]++;
+				}
+			}
+		}
+	});
+	FStatsTotals Totals = MoveTemp(ChunkTotals[0]);
+	for (int32 ChunkIndex = 1; ChunkIndex < NumChunks; ++ChunkIndex)
+	{
+		Totals.Merge(ChunkTotals[ChunkIndex]);
+	}
+
+	// Mesh cost is read once per distinct mesh rather than per instance
+	TArray<int64> TrianglesPerMesh;
+	TArray<int64> VerticesPerMesh;
+	TrianglesPerMesh.SetNumZeroed(Meshes.Objects.Num());
+	VerticesPerMesh.SetNumZeroed(Meshes.Objects.Num());
+	int64 TotalInstances = 0;
+	int64 TotalTriangles = 0;
+	int64 TotalVertices = 0;
+	TArray<int64> MeshTriangleCost;
+	MeshTriangleCost.SetNumZeroed(Meshes.Objects.Num());
+	for (int32 MeshIndex = 0; MeshIndex < Meshes.Objects.Num(); ++MeshIndex)
+	{
+		const UStaticMesh* Mesh = Meshes.Objects[MeshIndex];
+		const bool bHasLOD0 = Mesh->GetRenderData() && Mesh->GetNumLODs() > 0;
+		TrianglesPerMesh[MeshIndex] = bHasLOD0 ? Mesh->GetNumTriangles(0) : 0;
+		VerticesPerMesh[MeshIndex] = bHasLOD0 ? Mesh->GetNumVertices(0) : 0;
+		MeshTriangleCost[MeshIndex] = TrianglesPerMesh[MeshIndex] * Totals.InstancesPerMesh[MeshIndex];
+		TotalInstances += Totals.InstancesPerMesh[MeshIndex];
+		TotalTriangles += MeshTriangleCost[MeshIndex];
+		TotalVertices += VerticesPerMesh[MeshIndex] * Totals.InstancesPerMesh[MeshIndex];
+	}
+
+	Writer.BeginObject();
+	Writer.WriteField(MCPKeys::World, World->GetMapName());
+	Writer.WriteField(MCPKeys::IsPie, World->WorldType == EWorldType::PIE);
+	Writer.WriteField(TEXT("actor_count"), Actors.Num());
+	Writer.WriteField(TEXT("component_count"), Components.Num());
+	Writer.WriteField(TEXT("ticking_actors"), Totals.TickingActors);
+	Writer.WriteField(TEXT("ticking_components"), Totals.TickingComponents);
+
+	Writer.BeginObject(TEXT("lights"));
+	Writer.WriteField(TEXT("static"), Totals.LightsByMobility[EComponentMobility::Static]);
+	Writer.WriteField(TEXT("stationary"), Totals.LightsByMobility[EComponentMobility::Stationary]);
+	Writer.WriteField(TEXT("movable"), Totals.LightsByMobility[EComponentMobility::Movable]);
+	Writer.EndObject();
+
+	Writer.BeginArray(TEXT("actor_classes"));
+	for (const int32 ClassIndex : RankIndices(Totals.ActorsPerClass, Top))
+	{
+		Writer.BeginObject();
+		Writer.WriteField(MCPKeys::Class, ActorClasses.Objects[ClassIndex]->GetName());
+		Writer.WriteField(MCPKeys::Count, Totals.ActorsPerClass[ClassIndex]);
+		Writer.EndObject();
+	}
+	Writer.EndArray();
+
+	Writer.BeginArray(TEXT("component_classes"));
+	for (const int32 ClassIndex : RankIndices(Totals.ComponentsPerClass, Top))
+	{
+		Writer.BeginObject();
+		Writer.WriteField(MCPKeys::Class, ComponentClasses.Objects[ClassIndex]->GetName());
+		Writer.WriteField(MCPKeys::Count, Totals.ComponentsPerClass[ClassIndex]);
+		Writer.EndObject();
+	}
+	Writer.EndArray();
+
+	// Ranked by triangles drawn across all instances, the usual first thing to cut
+	Writer.BeginObject(TEXT("meshes"));
+	Writer.WriteField(TEXT("distinct"), Meshes.Objects.Num());
+	Writer.WriteField(TEXT("instances"), TotalInstances);
+	Writer.WriteField(TEXT("lod0_triangles"), TotalTriangles);
+	Writer.WriteField(TEXT("lod0_vertices"), TotalVertices);
+	Writer.BeginArray(TEXT("top"));
+	for (const int32 MeshIndex : RankIndices(MeshTriangleCost, Top))
+	{
+		Writer.BeginObject();
+		Writer.WriteField(TEXT("mesh"), Meshes.Objects[MeshIndex]->GetPathName());
+		Writer.WriteField(TEXT("instances"), Totals.InstancesPerMesh[MeshIndex]);
+		Writer.WriteField(TEXT("triangles"), TrianglesPerMesh[MeshIndex]);
+		Writer.WriteField(TEXT("vertices"), VerticesPerMesh[MeshIndex]);
+		Writer.WriteField(TEXT("total_triangles"), MeshTriangleCost[MeshIndex]);
+		Writer.EndObject();
+	}
+	Writer.EndArray();
+	Writer.EndObject();
+
+	// Rows run along +Y, columns along +X, starting at bounds_min
+	Writer.BeginObject(TEXT("density"));
+	Writer.WriteField(TEXT("grid_size"), GridSize);
+	Writer.WriteField(TEXT("bounds_min"), FVector(BoundsMin, 0.0));
+	Writer.WriteField(TEXT("bounds_max"), FVector(BoundsMax, 0.0));
+	Writer.WriteField(TEXT("cell_size"), FVector(CellSize, 0.0));
+	Writer.BeginArray(TEXT("cells"));
+	for (int32 Row = 0; Row < GridSize; ++Row)
+	{
+		Writer.BeginArray();
+		for (int32 Column = 0; Column < GridSize; ++Column)
+		{
+			Writer.WriteValue(Totals.ActorsPerCell[Row * GridSize + Column]);
+		}
+		Writer.EndArray();
+	}
+	Writer.EndArray();
+	Writer.BeginArray(TEXT("hotspots"));
+	for (const int32 CellIndex : RankIndices(Totals.ActorsPerCell, FMath::Min(Top, 5)))
+	{
+		const FVector2D CellMin = BoundsMin + FVector2D((double)(CellIndex % GridSize), (double)(CellIndex / GridSize)) * CellSize;
+		Writer.BeginObject();
+		Writer.WriteField(TEXT("cell_min"), FVector(CellMin, 0.0));
+		Writer.WriteField(TEXT("cell_max"), FVector(CellMin + CellSize, 0.0));
+		Writer.WriteField(MCPKeys::Count, Totals.ActorsPerCell[CellIndex]);
+		Writer.EndObject();
+	}
+	Writer.EndArray();
+	Writer.EndObject();
+
+	Writer.WriteField(TEXT("snapshot_ms"), SnapshotMs);
+	Writer.WriteField(TEXT("elapsed_ms"), (FPlatformTime::Seconds() - StartTime) * 1000.0);
+	Writer.EndObject();
+	return true;
+}
@@ -1,5 +1,6 @@
 #include "Commands/UnrealMCPMaterialCommands.h"
 #include "Commands/UnrealMCPCommonUtils.h"
+#include "MCPActorIndex.h"
 #include "MaterialEditingLibrary.h"
 #include "Materials/Material.h"
 #include "Materials/MaterialInstanceConstant.h"
@@ -652,17 +653,9 @@ TSharedPtr<FJsonObject> FUnrealMCPMaterialCommands::HandleApplyMaterialToActor(c
 	int32 SlotIndex = 0;
 	Params->TryGetNumberField(TEXT("slot_index"), SlotIndex);
 
-	// Find the actor
-	UWorld* World = GEditor->GetEditorWorldContext().World();
-	AActor* Actor = nullptr;
-	for (TActorIterator<AActor> It(World); It; ++It)
-	{
-		if (It->GetActorLabel() == ActorName || It->GetName() == ActorName)
-		{
-			Actor = *It;
-			break;
-		}
-	}
+	// Find the actor in the same world the other actor commands target (PIE while it runs)
+	UWorld* World = FUnrealMCPCommonUtils::GetTargetWorld();
+	AActor* Actor = World ? FMCPActorIndex::Get().FindExact(World, ActorName) : nullptr;
 	if (!Actor)
 	{
 		return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Actor not found: %s"), *ActorName));
@@ -0,0 +1,311 @@
+#include "Commands/UnrealMCPSpatialCommands.h"
+#include "Commands/UnrealMCPCommonUtils.h"
+#include "UnrealMCPBridge.h"
+#include "MCPCommandParams.h"
+#include "MCPJsonKeys.h"
+#include "MCPSpatialIndex.h"
+#include "ConvexVolume.h"
+#include "SceneManagement.h"
+#include "Editor.h"
+#include "LevelEditorViewport.h"
+#include "GameFramework/Actor.h"
+#include "GameFramework/PlayerController.h"
+#include "Camera/PlayerCameraManager.h"
+#include "Engine/GameViewportClient.h"
+
+namespace
+{
+	// Far limit for frustum and nearest queries when the caller gives none
+	constexpr double DefaultMaxDistance = 20000.0;
+
+	struct FBoxQueryParams
+	{
+		FVector Min = FVector::ZeroVector;
+		FVector Max = FVector::ZeroVector;
+		int32 Limit = 0;
+	};
+
+	constexpr auto BoxQuerySchema = MakeMCPParamSchema(
+		MCPRequired(TEXT("min"), &FBoxQueryParams::Min, TEXT("Minimum corner of the box")),
+		MCPRequired(TEXT("max"), &FBoxQueryParams::Max, TEXT("Maximum corner of the box")),
+		MCPOptional(TEXT("limit"), &FBoxQueryParams::Limit, TEXT("Maximum number of actors to return (0 = no limit)")));
+
+	struct FRadiusQueryParams
+	{
+		FVector Center = FVector::ZeroVector;
+		double Radius = 0.0;
+		int32 Limit = 0;
+	};
+
+	constexpr auto RadiusQuerySchema = MakeMCPParamSchema(
+		MCPRequired(TEXT("center"), &FRadiusQueryParams::Center, TEXT("Center of the sphere")),
+		MCPRequired(TEXT("radius"), &FRadiusQueryParams::Radius, TEXT("Sphere radius in world units")),
+		MCPOptional(TEXT("limit"), &FRadiusQueryParams::Limit, TEXT("Maximum number of actors to return, nearest first (0 = no limit)")));
+
+	struct FNearestQueryParams
+	{
+		FVector Location = FVector::ZeroVector;
+		int32 Count = 10;
+		double MaxDistance = DefaultMaxDistance;
+	};
+
+	constexpr auto NearestQuerySchema = MakeMCPParamSchema(
+		MCPRequired(TEXT("location"), &FNearestQueryParams::Location, TEXT("Query point")),
+		MCPOptional(TEXT("count"), &FNearestQueryParams::Count, TEXT("Number of actors to return (default 10)")),
+		MCPOptional(TEXT("max_distance"), &FNearestQueryParams::MaxDistance, TEXT("Ignore actors farther than this (default 20000)")));
+
+	struct FFrustumQueryParams
+	{
+		TOptional<FVector> Location;
+		TOptional<FRotator> Rotation;
+		double Fov = 0.0;
+		double AspectRatio = 0.0;
+		double NearClip = 10.0;
+		double MaxDistance = DefaultMaxDistance;
+		int32 Limit = 0;
+	};
+
+	constexpr auto FrustumQuerySchema = MakeMCPParamSchema(
+		MCPOptional(TEXT("location"), &FFrustumQueryParams::Location, TEXT("Camera location (default: the PIE player camera during PIE, else the editor viewport camera)")),
+		MCPOptional(TEXT("rotation"), &FFrustumQueryParams::Rotation, TEXT("Camera rotation (default: the PIE player camera during PIE, else the editor viewport camera)")),
+		MCPOptional(TEXT("fov"), &FFrustumQueryParams::Fov, TEXT("Horizontal field of view in degrees (default: viewport FOV, or 90)")),
+		MCPOptional(TEXT("aspect_ratio"), &FFrustumQueryParams::AspectRatio, TEXT("Width / height (default: viewport aspect, or 16:9)")),
+		MCPOptional(TEXT("near_clip"), &FFrustumQueryParams::NearClip, TEXT("Near plane distance (default 10)")),
+		MCPOptional(TEXT("max_distance"), &FFrustumQueryParams::MaxDistance, TEXT("Far distance (default 20000)")),
+		MCPOptional(TEXT("limit"), &FFrustumQueryParams::Limit, TEXT("Maximum number of actors to return, nearest first (0 = no limit)")));
+
+	FLevelEditorViewportClient* FindPerspectiveViewportClient()
+	{
+		if (!GEditor)
+		{
+			return nullptr;
+		}
+		for (FLevelEditorViewportClient* Client : GEditor->GetLevelViewportClients())
+		{
+			if (Client && Client->IsPerspective())
+			{
+				return Client;
+			}
+		}
+		return nullptr;
+	}
+
+	void WriteHits(FMCPJsonWriter& Writer, UWorld* World, const TArray<FMCPSpatialHit>& Hits, int32 Limit, bool bWithDistance)
+	{
+		const int32 NumToWrite = Limit > 0 ? FMath::Min(Limit, Hits.Num()) : Hits.Num();
+
+		Writer.BeginObject();
+		Writer.BeginArray(MCPKeys::Actors);
+		for (int32 Index = 0; Index < NumToWrite; ++Index)
+		{
+			Writer.BeginObject();
+			FUnrealMCPCommonUtils::WriteActorFields(Writer, Hits[Index].Actor);
+			if (bWithDistance)
+			{
+				Writer.WriteField(TEXT("distance"), Hits[Index].Distance);
+			}
+			Writer.EndObject();
+		}
+		Writer.EndArray();
+		Writer.WriteField(MCPKeys::Count, NumToWrite);
+		Writer.WriteField(TEXT("total_hits"), Hits.Num());
+		Writer.WriteField(MCPKeys::World, World->GetMapName());
+		Writer.WriteField(MCPKeys::IsPie, World->WorldType == EWorldType::PIE);
+		Writer.EndObject();
+	}
+}
+
+FUnrealMCPSpatialCommands::FUnrealMCPSpatialCommands()
+{
+}
+
+void FUnrealMCPSpatialCommands::RegisterNativeHandlers(UUnrealMCPBridge& Bridge)
+{
+	Bridge.RegisterStreamingHandler(TEXT("get_actors_in_box"), FMCPStreamingCommandHandler::CreateRaw(this, &FUnrealMCPSpatialCommands::HandleGetActorsInBox));
+	Bridge.RegisterStreamingHandler(TEXT("get_actors_in_radius"), FMCPStreamingCommandHandler::CreateRaw(this, &FUnrealMCPSpatialCommands::HandleGetActorsInRadius));
+	Bridge.RegisterStreamingHandler(TEXT("get_nearest_actors"), FMCPStreamingCommandHandler::CreateRaw(this, &FUnrealMCPSpatialCommands::HandleGetNearestActors));
+	Bridge.RegisterStreamingHandler(TEXT("get_actors_in_frustum"), FMCPStreamingCommandHandler::CreateRaw(this, &FUnrealMCPSpatialCommands::HandleGetActorsInFrustum));
+
+	FMCPCommandSchemas::Register(TEXT("get_actors_in_box"), TEXT("List actors whose location lies inside an axis-aligned box"), BoxQuerySchema);
+	FMCPCommandSchemas::Register(TEXT("get_actors_in_radius"), TEXT("List actors within a radius of a point, nearest first"), RadiusQuerySchema);
+	FMCPCommandSchemas::Register(TEXT("get_nearest_actors"), TEXT("List the actors nearest to a point"), NearestQuerySchema);
+	FMCPCommandSchemas::Register(TEXT("get_actors_in_frustum"), TEXT("List actors whose bounds intersect a camera frustum, nearest first"), FrustumQuerySchema);
+}
+
+bool FUnrealMCPSpatialCommands::HandleGetActorsInBox(const FMCPJsonObjectView& Params, FMCPJsonWriter& Writer, FString& OutError)
+{
+	FBoxQueryParams Args;
+	if (!BoxQuerySchema.Bind(Params, Args, OutError))
+	{
+		return false;
+	}
+
+	UWorld* World = FUnrealMCPCommonUtils::GetTargetWorld();
+	if (!World)
+	{
+		OutError = TEXT("No world available");
+		return false;
+	}
+
+	// Accept the corners in either order
+	const FBox Box(Args.Min.ComponentMin(Args.Max), Args.Min.ComponentMax(Args.Max));
+
+	TArray<FMCPSpatialHit> Hits;
+	FMCPSpatialIndex::Get().QueryBox(World, Box, Hits);
+	WriteHits(Writer, World, Hits, Args.Limit, /*bWithDistance=*/ false);
+	return true;
+}
+
+bool FUnrealMCPSpatialCommands::HandleGetActorsInRadius(const FMCPJsonObjectView& Params, FMCPJsonWriter& Writer, FString& OutError)
+{
+	FRadiusQueryParams Args;
+	if (!RadiusQuerySchema.Bind(Params, Args, OutError))
+	{
+		return false;
+	}
+	if (Args.Radius < 0.0)
+	{
+		OutError = TEXT("'radius' must not be negative");
+		return false;
+	}
+
+	UWorld* World = FUnrealMCPCommonUtils::GetTargetWorld();
+	if (!World)
+	{
+		OutError = TEXT("No world available");
+		return false;
+	}
+
+	TArray<FMCPSpatialHit> Hits;
+	FMCPSpatialIndex::Get().QuerySphere(World, Args.Center, Args.Radius, Hits);
+	WriteHits(Writer, World, Hits, Args.Limit, /*bWithDistance=*/ true);
+	return true;
+}
+
+bool FUnrealMCPSpatialCommands::HandleGetNearestActors(const FMCPJsonObjectView& Params, FMCPJsonWriter& Writer, FString& OutError)
+{
+	FNearestQueryParams Args;
+	if (!NearestQuerySchema.Bind(Params, Args, OutError))
+	{
+		return false;
+	}
+	if (Args.Count <= 0)
+	{
+		OutError = TEXT("'count' must be positive");
+		return false;
+	}
+
+	UWorld* World = FUnrealMCPCommonUtils::GetTargetWorld();
+	if (!World)
+	{
+		OutError = TEXT("No world available");
+		return false;
+	}
+
+	TArray<FMCPSpatialHit> Hits;
+	FMCPSpatialIndex::Get().QueryNearest(World, Args.Location, Args.Count, Args.MaxDistance, Hits);
+	WriteHits(Writer, World, Hits, 0, /*bWithDistance=*/ true);
+	return true;
+}
+
+bool FUnrealMCPSpatialCommands::HandleGetActorsInFrustum(const FMCPJsonObjectView& Params, FMCPJsonWriter& Writer, FString& OutError)
+{
+	FFrustumQueryParams Args;
+	if (!FrustumQuerySchema.Bind(Params, Args, OutError))
+	{
+		return false;
+	}
+
+	UWorld* World = FUnrealMCPCommonUtils::GetTargetWorld();
+	if (!World)
+	{
+		OutError = TEXT("No world available");
+		return false;
+	}
+
+	// Anything the caller leaves out comes from the camera of the world being queried:
+	// the local player's view during PIE, the editor perspective viewport otherwise
+	FVector Location;
+	FRotator Rotation;
+	double Fov = Args.Fov;
+	double AspectRatio = Args.AspectRatio;
+	const bool bNeedsCamera = !Args.Location.IsSet() || !Args.Rotation.IsSet() || Fov <= 0.0 || AspectRatio <= 0.0;
+	APlayerController* PlayerController = (bNeedsCamera && World->WorldType == EWorldType::PIE) ? World->GetFirstPlayerController() : nullptr;
+	FLevelEditorViewportClient* ViewportClient = (bNeedsCamera && World->WorldType != EWorldType::PIE)
+		? FindPerspectiveViewportClient()
+		: nullptr;
+	if (PlayerController)
+	{
+		FVector ViewLocation;
+		FRotator ViewRotation;
+		PlayerController->GetPlayerViewPoint(ViewLocation, ViewRotation);
+		Location = Args.Location.Get(ViewLocation);
+		Rotation = Args.Rotation.Get(ViewRotation);
+		if (Fov <= 0.0 && PlayerController->PlayerCameraManager)
+		{
+			Fov = PlayerController->PlayerCameraManager->GetFOVAngle();
+		}
+		if (AspectRatio <= 0.0 && World->GetGameViewport())
+		{
+			FVector2D Size;
+			World->GetGameViewport()->GetViewportSize(Size);
+			AspectRatio = Size.Y > 0.0 ? Size.X / Size.Y : 0.0;
+		}
+	}
+	else if (ViewportClient)
+	{
+		Location = Args.Location.Get(ViewportClient->GetViewLocation());
+		Rotation = Args.Rotation.Get(ViewportClient->GetViewRotation());
+		if (Fov <= 0.0)
+		{
+			Fov = ViewportClient->ViewFOV;
+		}
+		if (AspectRatio <= 0.0 && ViewportClient->Viewport)
+		{
+			const FIntPoint Size = ViewportClient->Viewport->GetSizeXY();
+			AspectRatio = Size.Y > 0 ? (double)Size.X / Size.Y : 0.0;
+		}
+	}
+	else
+	{
+		if (!Args.Location.IsSet() || !Args.Rotation.IsSet())
+		{
+			OutError = TEXT("'location' and 'rotation' are required when no player or editor camera is available");
+			return false;
+		}
+		Location = Args.Location.GetValue();
+		Rotation = Args.Rotation.GetValue();
+	}
+	if (Fov <= 0.0)
+	{
+		Fov = 90.0;
+	}
+	if (AspectRatio <= 0.0)
+	{
+		AspectRatio = 16.0 / 9.0;
+	}
+	if (Fov >= 180.0 || Args.NearClip <= 0.0 || Args.MaxDistance <= Args.NearClip)
+	{
+		OutError = TEXT("Invalid frustum: requires 0 < fov < 180 and 0 < near_clip < max_distance");
+		return false;
+	}
+
+	// Same view basis the renderer uses: X forward in world space becomes Z in view space
+	const FMatrix ViewRotationMatrix = FInverseRotationMatrix(Rotation) * FMatrix(
+		FPlane(0, 0, 1, 0),
+		FPlane(1, 0, 0, 0),
+		FPlane(0, 1, 0, 0),
+		FPlane(0, 0, 0, 1));
+	const FMatrix ViewMatrix = FTranslationMatrix(-Location) * ViewRotationMatrix;
+	const float HalfFovRadians = FMath::DegreesToRadians((float)Fov) * 0.5f;
+	const FMatrix ProjectionMatrix = FReversedZPerspectiveMatrix(HalfFovRadians, HalfFovRadians, 1.0f, (float)AspectRatio, (float)Args.NearClip, (float)Args.NearClip);
+
+	// The far limit is applied as a distance test, which also bounds the octree search
+	FConvexVolume Frustum;
+	GetViewFrustumBounds(Frustum, ViewMatrix * ProjectionMatrix, /*bUseNearPlane=*/ true);
+
+	TArray<FMCPSpatialHit> Hits;
+	FMCPSpatialIndex::Get().QueryFrustum(World, Frustum, Location, Args.MaxDistance, Hits);
+	WriteHits(Writer, World, Hits, Args.Limit, /*bWithDistance=*/ true);
+	return true;
+}
@@ -0,0 +1,406 @@
+#include "MCPActorIndex.h"
+#include "Algo/BinarySearch.h"
+#include "Editor.h"
+#include "Engine/Level.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "GameFramework/Actor.h"
+#include "Misc/CoreDelegates.h"
+#include "UObject/UObjectGlobals.h"
+
+namespace
+{
+	bool NameEquals(const AActor* Actor, const FString& Name)
+	{
+		return Actor->GetName().Equals(Name, ESearchCase::IgnoreCase);
+	}
+
+	bool LabelEquals(const AActor* Actor, const FString& Label)
+	{
+		return Actor->GetActorLabel().Equals(Label, ESearchCase::IgnoreCase);
+	}
+
+	bool IsIndexable(const AActor* Actor)
+	{
+		return Actor && !Actor->IsTemplate() && Actor->GetWorld() != nullptr;
+	}
+}
+
+FMCPActorIndex& FMCPActorIndex::Get()
+{
+	static FMCPActorIndex Instance;
+	return Instance;
+}
+
+void FMCPActorIndex::Initialize()
+{
+	if (bInitialized || !GEngine)
+	{
+		return;
+	}
+	bInitialized = true;
+
+	ActorAddedHandle = GEngine->OnLevelActorAdded().AddRaw(this, &FMCPActorIndex::OnActorAdded);
+	ActorDeletedHandle = GEngine->OnLevelActorDeleted().AddRaw(this, &FMCPActorIndex::OnActorDeleted);
+	LabelChangedHandle = FCoreDelegates::OnActorLabelChanged.AddRaw(this, &FMCPActorIndex::OnActorLabelChanged);
+	ObjectRenamedHandle = FCoreUObjectDelegates::OnObjectRenamed.AddRaw(this, &FMCPActorIndex::OnObjectRenamed);
+	LevelAddedHandle = FWorldDelegates::LevelAddedToWorld.AddRaw(this, &FMCPActorIndex::OnLevelChanged);
+	LevelRemovedHandle = FWorldDelegates::LevelRemovedFromWorld.AddRaw(this, &FMCPActorIndex::OnLevelChanged);
+	WorldCleanupHandle = FWorldDelegates::OnWorldCleanup.AddRaw(this, &FMCPActorIndex::OnWorldCleanup);
+	UndoRedoHandle = FEditorDelegates::PostUndoRedo.AddRaw(this, &FMCPActorIndex::OnUndoRedo);
+}
+
+void FMCPActorIndex::Shutdown()
+{
+	if (!bInitialized)
+	{
+		return;
+	}
+	bInitialized = false;
+
+	if (GEngine)
+	{
+		GEngine->OnLevelActorAdded().Remove(ActorAddedHandle);
+		GEngine->OnLevelActorDeleted().Remove(ActorDeletedHandle);
+	}
+	FCoreDelegates::OnActorLabelChanged.Remove(LabelChangedHandle);
+	FCoreUObjectDelegates::OnObjectRenamed.Remove(ObjectRenamedHandle);
+	FWorldDelegates::LevelAddedToWorld.Remove(LevelAddedHandle);
+	FWorldDelegates::LevelRemovedFromWorld.Remove(LevelRemovedHandle);
+	FWorldDelegates::OnWorldCleanup.Remove(WorldCleanupHandle);
+	FEditorDelegates::PostUndoRedo.Remove(UndoRedoHandle);
+
+	Worlds.Empty();
+}
+
+AActor* FMCPActorIndex::FindExact(UWorld* World, const FString& NameOrLabel)
+{
+	// Second pass only runs after a stale hit forced a rebuild
+	for (int32 Attempt = 0; Attempt < 2; ++Attempt)
+	{
+		FWorldIndex* Index = GetIndex(World);
+		if (!Index)
+		{
+			return nullptr;
+		}
+
+		AActor* Actor = FirstValid(Index->ByName.Find(NameOrLabel));
+		if (Actor && NameEquals(Actor, NameOrLabel))
+		{
+			return Actor;
+		}
+		if (!Actor)
+		{
+			Actor = FirstValid(Index->ByLabel.Find(NameOrLabel));
+			if (!Actor)
+			{
+				return nullptr;
+			}
+			if (LabelEquals(Actor, NameOrLabel))
+			{
+				return Actor;
+			}
+		}
+		InvalidateWorld(World);
+	}
+	return nullptr;
+}
+
+AActor* FMCPActorIndex::FindPartial(UWorld* World, const FString& Fragment)
+{
+	if (Fragment.IsEmpty())
+	{
+		return nullptr;
+	}
+
+	const FString Needle = Fragment.ToLower();
+	for (int32 Attempt = 0; Attempt < 2; ++Attempt)
+	{
+		FWorldIndex* Index = GetIndex(World);
+		if (!Index)
+		{
+			return nullptr;
+		}
+		if (Index->bSortedKeysDirty)
+		{
+			RebuildSortedKeys(*Index);
+		}
+
+		const TArray<TPair<FString, TWeakObjectPtr<AActor>>>& Sorted = Index->SortedKeys;
+		AActor* Candidate = nullptr;
+
+		// Prefix matches are a contiguous run starting at the lower bound
+		int32 Position = Algo::LowerBoundBy(Sorted, Needle, [](const TPair<FString, TWeakObjectPtr<AActor>>& Entry) -> const FString& { return Entry.Key; },
+			[](const FString& A, const FString& B) { return A.Compare(B, ESearchCase::CaseSensitive) < 0; });
+		for (; Position < Sorted.Num() && Sorted[Position].Key.StartsWith(Needle, ESearchCase::CaseSensitive); ++Position)
+		{
+			if (AActor* Actor = Sorted[Position].Value.Get())
+			{
+				Candidate = Actor;
+				break;
+			}
+		}
+
+		// Infix matches still need a pass, but over cached strings rather than the world's actors
+		if (!Candidate)
+		{
+			for (const TPair<FString, TWeakObjectPtr<AActor>>& Entry : Sorted)
+			{
+				if (Entry.Key.Contains(Needle, ESearchCase::CaseSensitive))
+				{
+					if (AActor* Actor = Entry.Value.Get())
+					{
+						Candidate = Actor;
+						break;
+					}
+				}
+			}
+		}
+
+		if (!Candidate)
+		{
+			return nullptr;
+		}
+		if (Candidate->GetName().Contains(Fragment) || Candidate->GetActorLabel().Contains(Fragment))
+		{
+			return Candidate;
+		}
+		InvalidateWorld(World);
+	}
+	return nullptr;
+}
+
+bool FMCPActorIndex::IsNameInUse(UWorld* World, const FString& Name, bool bIncludeLabels)
+{
+	for (int32 Attempt = 0; Attempt < 2; ++Attempt)
+	{
+		FWorldIndex* Index = GetIndex(World);
+		if (!Index)
+		{
+			return false;
+		}
+
+		bool bStale = false;
+		if (AActor* Actor = FirstValid(Index->ByName.Find(Name)))
+		{
+			if (NameEquals(Actor, Name))
+			{
+				return true;
+			}
+			bStale = true;
+		}
+		if (bIncludeLabels && !bStale)
+		{
+			if (AActor* Actor = FirstValid(Index->ByLabel.Find(Name)))
+			{
+				if (LabelEquals(Actor, Name))
+				{
+					return true;
+				}
+				bStale = true;
+			}
+		}
+		if (!bStale)
+		{
+			return false;
+		}
+		InvalidateWorld(World);
+	}
+	return false;
+}
+
+int32 FMCPActorIndex::Num(UWorld* World)
+{
+	FWorldIndex* Index = GetIndex(World);
+	return Index ? Index->Keys.Num() : 0;
+}
+
+void FMCPActorIndex::Invalidate()
+{
+	Worlds.Empty();
+}
+
+FMCPActorIndex::FWorldIndex* FMCPActorIndex::GetIndex(UWorld* World)
+{
+	if (!World)
+	{
+		return nullptr;
+	}
+
+	if (FWorldIndex* Existing = Worlds.Find(World))
+	{
+		return Existing;
+	}
+
+	FWorldIndex& Index = Worlds.Add(World);
+	BuildIndex(World, Index);
+	return &Index;
+}
+
+void FMCPActorIndex::BuildIndex(UWorld* World, FWorldIndex& Index)
+{
+	const double StartTime = FPlatformTime::Seconds();
+
+	for (TActorIterator<AActor> It(World); It; ++It)
+	{
+		if (AActor* Actor = *It)
+		{
+			AddActor(Index, Actor);
+		}
+	}
+
+	UE_LOG(LogTemp, Verbose, TEXT("MCPActorIndex: Indexed %d actors in %s (%.1f ms)"),
+		Index.Keys.Num(), *World->GetMapName(), (FPlatformTime::Seconds() - StartTime) * 1000.0);
+}
+
+void FMCPActorIndex::AddActor(FWorldIndex& Index, AActor* Actor)
+{
+	if (Index.Keys.Contains(Actor))
+	{
+		RemoveActor(Index, Actor);
+	}
+
+	FIndexedKeys Keys{ Actor->GetName(), Actor->GetActorLabel() };
+	Index.ByName.FindOrAdd(Keys.Name).Add(Actor);
+	if (!Keys.Label.IsEmpty())
+	{
+		Index.ByLabel.FindOrAdd(Keys.Label).Add(Actor);
+	}
+	Index.Keys.Add(Actor, MoveTemp(Keys));
+	Index.bSortedKeysDirty = true;
+}
+
+void FMCPActorIndex::RemoveActor(FWorldIndex& Index, AActor* Actor)
+{
+	FIndexedKeys Keys;
+	if (!Index.Keys.RemoveAndCopyValue(Actor, Keys))
+	{
+		return;
+	}
+
+	auto RemoveFrom = [Actor](TMap<FString, FActorList>& Map, const FString& Key)
+	{
+		if (FActorList* List = Map.Find(Key))
+		{
+			List->RemoveAll([Actor](const TWeakObjectPtr<AActor>& Entry) { return !Entry.IsValid() || Entry.Get() == Actor; });
+			if (List->Num() == 0)
+			{
+				Map.Remove(Key);
+			}
+		}
+	};
+	RemoveFrom(Index.ByName, Keys.Name);
+	if (!Keys.Label.IsEmpty())
+	{
+		RemoveFrom(Index.ByLabel, Keys.Label);
+	}
+	Index.bSortedKeysDirty = true;
+}
+
+void FMCPActorIndex::RebuildSortedKeys(FWorldIndex& Index)
+{
+	Index.SortedKeys.Reset(Index.Keys.Num() * 2);
+	for (const TPair<TObjectKey<AActor>, FIndexedKeys>& Pair : Index.Keys)
+	{
+		TWeakObjectPtr<AActor> Actor(Pair.Key.ResolveObjectPtr());
+		if (!Actor.IsValid())
+		{
+			continue;
+		}
+
+		Index.SortedKeys.Emplace(Pair.Value.Name.ToLower(), Actor);
+		if (!Pair.Value.Label.IsEmpty() && !Pair.Value.Label.Equals(Pair.Value.Name, ESearchCase::IgnoreCase))
+		{
+			Index.SortedKeys.Emplace(Pair.Value.Label.ToLower(), Actor);
+		}
+	}
+	Index.SortedKeys.Sort([](const TPair<FString, TWeakObjectPtr<AActor>>& A, const TPair<FString, TWeakObjectPtr<AActor>>& B)
+	{
+		return A.Key.Compare(B.Key, ESearchCase::CaseSensitive) < 0;
+	});
+	Index.bSortedKeysDirty = false;
+}
+
+void FMCPActorIndex::InvalidateWorld(UWorld* World)
+{
+	if (World)
+	{
+		Worlds.Remove(World);
+	}
+}
+
+AActor* FMCPActorIndex::FirstValid(const FActorList* List)
+{
+	if (List)
+	{
+		for (const TWeakObjectPtr<AActor>& Entry : *List)
+		{
+			if (AActor* Actor = Entry.Get())
+			{
+				return Actor;
+			}
+		}
+	}
+	return nullptr;
+}
+
+void FMCPActorIndex::OnActorAdded(AActor* Actor)
+{
+	if (IsIndexable(Actor))
+	{
+		// Worlds that were never queried stay unindexed until they are
+		if (FWorldIndex* Index = Worlds.Find(Actor->GetWorld()))
+		{
+			AddActor(*Index, Actor);
+		}
+	}
+}
+
+void FMCPActorIndex::OnActorDeleted(AActor* Actor)
+{
+	if (Actor)
+	{
+		if (FWorldIndex* Index = Worlds.Find(Actor->GetWorld()))
+		{
+			RemoveActor(*Index, Actor);
+		}
+	}
+}
+
+void FMCPActorIndex::OnActorLabelChanged(AActor* Actor)
+{
+	OnActorAdded(Actor);
+}
+
+void FMCPActorIndex::OnObjectRenamed(UObject* Object, UObject* OldOuter, FName OldName)
+{
+	AActor* Actor = Cast<AActor>(Object);
+	if (!Actor)
+	{
+		return;
+	}
+
+	// A rename can also move the actor to another level (and world)
+	for (TPair<TObjectKey<UWorld>, FWorldIndex>& Pair : Worlds)
+	{
+		RemoveActor(Pair.Value, Actor);
+	}
+	OnActorAdded(Actor);
+}
+
+void FMCPActorIndex::OnLevelChanged(ULevel* Level, UWorld* World)
+{
+	// Streamed levels bring in actors without per-actor notifications
+	InvalidateWorld(World);
+}
+
+void FMCPActorIndex::OnWorldCleanup(UWorld* World, bool bSessionEnded, bool bCleanupResources)
+{
+	InvalidateWorld(World);
+}
+
+void FMCPActorIndex::OnUndoRedo()
+{
+	// Undo can restore or remove actors without the added/deleted broadcasts
+	Invalidate();
+}
@@ -0,0 +1,465 @@
+#include "MCPActorQuery.h"
+#include "MCPJsonKeys.h"
+#include "MCPJsonWriter.h"
+#include "MCPSerializationPlan.h"
+#include "Async/ParallelFor.h"
+#include "Commands/UnrealMCPCommonUtils.h"
+#include "Components/SceneComponent.h"
+#include "Engine/Level.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "Misc/PackageName.h"
+
+namespace
+{
+	struct FActorFieldName
+	{
+		const TCHAR* Name;
+		EMCPActorField Field;
+	};
+
+	const FActorFieldName ActorFieldNames[] =
+	{
+		{ TEXT("name"), EMCPActorField::Name },
+		{ TEXT("label"), EMCPActorField::Label },
+		{ TEXT("class"), EMCPActorField::Class },
+		{ TEXT("location"), EMCPActorField::Location },
+		{ TEXT("rotation"), EMCPActorField::Rotation },
+		{ TEXT("scale"), EMCPActorField::Scale },
+		{ TEXT("tags"), EMCPActorField::Tags },
+		{ TEXT("folder"), EMCPActorField::Folder },
+		{ TEXT("level"), EMCPActorField::Level },
+		{ TEXT("mobility"), EMCPActorField::Mobility },
+		{ TEXT("path"), EMCPActorField::Path },
+		{ TEXT("properties"), EMCPActorField::Properties },
+	};
+
+	bool ParseMobility(const FString& Text, EComponentMobility::Type& OutMobility)
+	{
+		if (Text.Equals(TEXT("Static"), ESearchCase::IgnoreCase))
+		{
+			OutMobility = EComponentMobility::Static;
+		}
+		else if (Text.Equals(TEXT("Stationary"), ESearchCase::IgnoreCase))
+		{
+			OutMobility = EComponentMobility::Stationary;
+		}
+		else if (Text.Equals(TEXT("Movable"), ESearchCase::IgnoreCase))
+		{
+			OutMobility = EComponentMobility::Movable;
+		}
+		else
+		{
+			return false;
+		}
+		return true;
+	}
+
+	const TCHAR* MobilityToString(EComponentMobility::Type Mobility)
+	{
+		switch (Mobility)
+		{
+		case EComponentMobility::Static: return TEXT("Static");
+		case EComponentMobility::Stationary: return TEXT("Stationary");
+		default: return TEXT("Movable");
+		}
+	}
+
+	/** Package name of the actor's level without any PIE prefix. */
+	FString GetActorLevelName(const AActor* Actor)
+	{
+		const ULevel* Level = Actor->GetLevel();
+		return Level ? UWorld::RemovePIEPrefix(Level->GetOutermost()->GetName()) : FString();
+	}
+}
+
+bool FMCPActorFilter::Parse(const FMCPJsonObjectView& Filter, FMCPActorFilter& OutFilter, FString& OutError)
+{
+	OutFilter = FMCPActorFilter();
+	if (!Filter.IsValid())
+	{
+		return true;
+	}
+
+	FString ClassName;
+	if (Filter.TryGetStringField(MCPKeys::Class, ClassName) && !ClassName.IsEmpty())
+	{
+		OutFilter.Class = FUnrealMCPCommonUtils::FindActorClass(ClassName);
+		if (!OutFilter.Class)
+		{
+			OutError = FString::Printf(TEXT("Unknown actor class in filter: %s"), *ClassName);
+			return false;
+		}
+	}
+
+	FMCPJsonArrayView Tags;
+	if (Filter.TryGetArrayField(TEXT("tags"), Tags))
+	{
+		for (const FMCPJsonValueView TagValue : Tags)
+		{
+			FString Tag;
+			if (!TagValue.TryGetString(Tag))
+			{
+				OutError = TEXT("'filter.tags' must be an array of strings");
+				return false;
+			}
+			OutFilter.Tags.Add(FName(*Tag));
+		}
+	}
+
+	Filter.TryGetStringField(TEXT("folder"), OutFilter.Folder);
+	OutFilter.Folder.RemoveFromEnd(TEXT("/"));
+
+	Filter.TryGetStringField(TEXT("level"), OutFilter.Level);
+
+	FString MobilityText;
+	if (Filter.TryGetStringField(TEXT("mobility"), MobilityText) && !MobilityText.IsEmpty())
+	{
+		EComponentMobility::Type Mobility;
+		if (!ParseMobility(MobilityText, Mobility))
+		{
+			OutError = FString::Printf(TEXT("Invalid mobility in filter: %s (use Static, Stationary or Movable)"), *MobilityText);
+			return false;
+		}
+		OutFilter.Mobility = Mobility;
+	}
+
+	Filter.TryGetStringField(MCPKeys::Label, OutFilter.LabelPattern);
+	return true;
+}
+
+bool FMCPActorFilter::IsEmpty() const
+{
+	return !Class && Tags.Num() == 0 && Folder.IsEmpty() && Level.IsEmpty() && !Mobility.IsSet() && LabelPattern.IsEmpty();
+}
+
+bool FMCPActorFilter::Matches(const AActor* Actor) const
+{
+	if (Class && !Actor->IsA(Class))
+	{
+		return false;
+	}
+	if (Mobility.IsSet())
+	{
+		const USceneComponent* Root = Actor->GetRootComponent();
+		if (!Root || Root->Mobility != Mobility.GetValue())
+		{
+			return false;
+		}
+	}
+	for (const FName& Tag : Tags)
+	{
+		if (!Actor->ActorHasTag(Tag))
+		{
+			return false;
+		}
+	}
+	if (!Level.IsEmpty())
+	{
+		const FString LevelName = GetActorLevelName(Actor);
+		const bool bMatches = Level.Contains(TEXT("/"))
+			? LevelName.Equals(Level, ESearchCase::IgnoreCase)
+			: FPackageName::GetShortName(LevelName).Equals(Level, ESearchCase::IgnoreCase);
+		if (!bMatches)
+		{
+			return false;
+		}
+	}
+	if (!Folder.IsEmpty())
+	{
+		const FString FolderPath = Actor->GetFolderPath().ToString();
+		if (!FolderPath.StartsWith(Folder, ESearchCase::IgnoreCase)
+			|| (FolderPath.Len() > Folder.Len() && FolderPath[Folder.Len()] != TEXT('/')))
+		{
+			return false;
+		}
+	}
+	if (!LabelPattern.IsEmpty() && !Actor->GetActorLabel().MatchesWildcard(LabelPattern))
+	{
+		return false;
+	}
+	return true;
+}
+
+bool FMCPActorProjection::Parse(const TArray<FString>& FieldNames, FMCPActorProjection& OutProjection, FString& OutError)
+{
+	OutProjection = FMCPActorProjection();
+	if (FieldNames.Num() == 0)
+	{
+		return true;
+	}
+
+	OutProjection.Fields = EMCPActorField::None;
+	for (const FString& FieldName : FieldNames)
+	{
+		const FActorFieldName* Found = nullptr;
+		for (const FActorFieldName& Candidate : ActorFieldNames)
+		{
+			if (FieldName.Equals(Candidate.Name, ESearchCase::IgnoreCase))
+			{
+				Found = &Candidate;
+				break;
+			}
+		}
+		if (!Found)
+		{
+			OutError = FString::Printf(TEXT("Unknown actor field: %s"), *FieldName);
+			return false;
+		}
+		OutProjection.Fields |= Found->Field;
+	}
+	return true;
+}
+
+void FMCPActorProjection::WriteFields(FMCPJsonWriter& Writer, AActor* Actor) const
+{
+	if (Fields == EMCPActorField::Default)
+	{
+		FUnrealMCPCommonUtils::WriteActorFields(Writer, Actor);
+		return;
+	}
+
+	if (EnumHasAnyFlags(Fields, EMCPActorField::Name))
+	{
+		Writer.WriteField(MCPKeys::Name, Actor->GetName());
+	}
+	if (EnumHasAnyFlags(Fields, EMCPActorField::Label))
+	{
+		Writer.WriteField(MCPKeys::Label, Actor->GetActorLabel());
+	}
+	if (EnumHasAnyFlags(Fields, EMCPActorField::Class))
+	{
+		Writer.WriteField(MCPKeys::Class, Actor->GetClass()->GetName());
+	}
+	if (EnumHasAnyFlags(Fields, EMCPActorField::Location))
+	{
+		Writer.WriteField(MCPKeys::Location, Actor->GetActorLocation());
+	}
+	if (EnumHasAnyFlags(Fields, EMCPActorField::Rotation))
+	{
+		Writer.WriteField(MCPKeys::Rotation, Actor->GetActorRotation());
+	}
+	if (EnumHasAnyFlags(Fields, EMCPActorField::Scale))
+	{
+		Writer.WriteField(MCPKeys::Scale, Actor->GetActorScale3D());
+	}
+	if (EnumHasAnyFlags(Fields, EMCPActorField::Tags))
+	{
+		Writer.BeginArray(TEXT("tags"));
+		for (const FName& Tag : Actor->Tags)
+		{
+			Writer.WriteValue(Tag.ToString());
+		}
+		Writer.EndArray();
+	}
+	if (EnumHasAnyFlags(Fields, EMCPActorField::Folder))
+	{
+		Writer.WriteField(TEXT("folder"), Actor->GetFolderPath().ToString());
+	}
+	if (EnumHasAnyFlags(Fields, EMCPActorField::Level))
+	{
+		Writer.WriteField(TEXT("level"), FPackageName::GetShortName(GetActorLevelName(Actor)));
+	}
+	if (EnumHasAnyFlags(Fields, EMCPActorField::Mobility))
+	{
+		const USceneComponent* Root = Actor->GetRootComponent();
+		if (Root)
+		{
+			Writer.WriteField(TEXT("mobility"), MobilityToString(Root->Mobility));
+		}
+		else
+		{
+			Writer.WriteKey(TEXT("mobility"));
+			Writer.WriteNull();
+		}
+	}
+	if (EnumHasAnyFlags(Fields, EMCPActorField::Path))
+	{
+		Writer.WriteField(MCPKeys::Path, Actor->GetPathName());
+	}
+	if (EnumHasAnyFlags(Fields, EMCPActorField::Properties))
+	{
+		// Listings of many actors mostly repeat a few classes, so each plan is reused many times
+		Writer.BeginObject(MCPKeys::Properties);
+		FMCPSerializationPlanCache::Get().Find(Actor->GetClass()).WriteProperties(Writer, Actor);
+		Writer.EndObject();
+	}
+}
+
+// Listings below this size are encoded in place; task dispatch would cost more than it saves
+static constexpr int32 MCPParallelSnapshotMinActors = 4096;
+static constexpr int32 MCPSnapshotChunkSize = 1024;
+
+FMCPActorSnapshot::FMCPActorSnapshot(const FMCPActorProjection& InProjection)
+	: Fields(InProjection.Fields)
+{
+}
+
+bool FMCPActorSnapshot::CanSnapshot(const FMCPActorProjection& Projection)
+{
+	return !EnumHasAnyFlags(Projection.Fields, EMCPActorField::Properties);
+}
+
+void FMCPActorSnapshot::Add(const AActor* Actor)
+{
+	check(IsInGameThread());
+	FEntry& Entry = Entries.AddDefaulted_GetRef();
+	Entry.Name = Actor->GetFName();
+
+	if (EnumHasAnyFlags(Fields, EMCPActorField::Label))
+	{
+		Entry.Label = Actor->GetActorLabel();
+	}
+	if (EnumHasAnyFlags(Fields, EMCPActorField::Class))
+	{
+		const UClass* Class = Actor->GetClass();
+		if (const int32* Found = ClassIndices.Find(Class))
+		{
+			Entry.ClassIndex = *Found;
+		}
+		else
+		{
+			Entry.ClassIndex = ClassNames.Add(Class->GetName());
+			ClassIndices.Add(Class, Entry.ClassIndex);
+		}
+	}
+	if (EnumHasAnyFlags(Fields, EMCPActorField::Location | EMCPActorField::Rotation | EMCPActorField::Scale))
+	{
+		// One root transform read instead of three accessor calls
+		const FTransform Transform = Actor->GetActorTransform();
+		Entry.Location = Transform.GetLocation();
+		Entry.Rotation = Transform.Rotator();
+		Entry.Scale = Transform.GetScale3D();
+	}
+	if (EnumHasAnyFlags(Fields, EMCPActorField::Tags))
+	{
+		Entry.Tags = Actor->Tags;
+	}
+	if (EnumHasAnyFlags(Fields, EMCPActorField::Folder))
+	{
+		Entry.Folder = Actor->GetFolderPath();
+	}
+	if (EnumHasAnyFlags(Fields, EMCPActorField::Level | EMCPActorField::Path))
+	{
+		// Level actors are outered to their level, so a path is the level's path plus the name
+		const ULevel* Level = Actor->GetLevel();
+		if (const int32* Found = LevelIndices.Find(Level))
+		{
+			Entry.LevelIndex = *Found;
+		}
+		else
+		{
+			FLevelInfo& Info = Levels.AddDefaulted_GetRef();
+			Info.ShortName = FPackageName::GetShortName(GetActorLevelName(Actor));
+			Info.PathName = Level ? Level->GetPathName() : FString();
+			Entry.LevelIndex = Levels.Num() - 1;
+			LevelIndices.Add(Level, Entry.LevelIndex);
+		}
+	}
+	if (EnumHasAnyFlags(Fields, EMCPActorField::Mobility))
+	{
+		if (const USceneComponent* Root = Actor->GetRootComponent())
+		{
+			Entry.Mobility = (int8)Root->Mobility.GetValue();
+		}
+	}
+}
+
+void FMCPActorSnapshot::WriteElements(FMCPJsonWriter& Writer) const
+{
+	if (Entries.Num() < MCPParallelSnapshotMinActors)
+	{
+		for (const FEntry& Entry : Entries)
+		{
+			WriteEntry(Writer, Entry);
+		}
+		return;
+	}
+
+	// Each chunk becomes a complete array of its own, then the chunks are spliced in order
+	const int32 NumChunks = FMath::DivideAndRoundUp(Entries.Num(), MCPSnapshotChunkSize);
+	TArray<FMCPJsonWriter> Chunks;
+	Chunks.SetNum(NumChunks);
+	ParallelFor(NumChunks, [this, &Chunks](int32 ChunkIndex)
+	{
+		FMCPJsonWriter& Chunk = Chunks[ChunkIndex];
+		const int32 Begin = ChunkIndex * MCPSnapshotChunkSize;
+		const int32 End = FMath::Min(Begin + MCPSnapshotChunkSize, Entries.Num());
+		Chunk.BeginArray();
+		for (int32 Index = Begin; Index < End; ++Index)
+		{
+			WriteEntry(Chunk, Entries[Index]);
+		}
+		Chunk.EndArray();
+	});
+
+	for (const FMCPJsonWriter& Chunk : Chunks)
+	{
+		Writer.AppendArrayElements(Chunk);
+	}
+}
+
+void FMCPActorSnapshot::WriteEntry(FMCPJsonWriter& Writer, const FEntry& Entry) const
+{
+	// Same field order as FMCPActorProjection::WriteFields
+	Writer.BeginObject();
+	if (EnumHasAnyFlags(Fields, EMCPActorField::Name))
+	{
+		Writer.WriteField(MCPKeys::Name, Entry.Name.ToString());
+	}
+	if (EnumHasAnyFlags(Fields, EMCPActorField::Label))
+	{
+		Writer.WriteField(MCPKeys::Label, Entry.Label);
+	}
+	if (EnumHasAnyFlags(Fields, EMCPActorField::Class))
+	{
+		Writer.WriteField(MCPKeys::Class, ClassNames[Entry.ClassIndex]);
+	}
+	if (EnumHasAnyFlags(Fields, EMCPActorField::Location))
+	{
+		Writer.WriteField(MCPKeys::Location, Entry.Location);
+	}
+	if (EnumHasAnyFlags(Fields, EMCPActorField::Rotation))
+	{
+		Writer.WriteField(MCPKeys::Rotation, Entry.Rotation);
+	}
+	if (EnumHasAnyFlags(Fields, EMCPActorField::Scale))
+	{
+		Writer.WriteField(MCPKeys::Scale, Entry.Scale);
+	}
+	if (EnumHasAnyFlags(Fields, EMCPActorField::Tags))
+	{
+		Writer.BeginArray(TEXT("tags"));
+		for (const FName& Tag : Entry.Tags)
+		{
+			Writer.WriteValue(Tag.ToString());
+		}
+		Writer.EndArray();
+	}
+	if (EnumHasAnyFlags(Fields, EMCPActorField::Folder))
+	{
+		Writer.WriteField(TEXT("folder"), Entry.Folder.ToString());
+	}
+	if (EnumHasAnyFlags(Fields, EMCPActorField::Level))
+	{
+		Writer.WriteField(TEXT("level"), Levels[Entry.LevelIndex].ShortName);
+	}
+	if (EnumHasAnyFlags(Fields, EMCPActorField::Mobility))
+	{
+		if (Entry.Mobility != INDEX_NONE)
+		{
+			Writer.WriteField(TEXT("mobility"), MobilityToString((EComponentMobility::Type)Entry.Mobility));
+		}
+		else
+		{
+			Writer.WriteKey(TEXT("mobility"));
+			Writer.WriteNull();
+		}
+	}
+	if (EnumHasAnyFlags(Fields, EMCPActorField::Path))
+	{
+		const FString& LevelPath = Levels[Entry.LevelIndex].PathName;
+		Writer.WriteField(MCPKeys::Path, LevelPath.IsEmpty() ? Entry.Name.ToString() : LevelPath + TEXT(".") + Entry.Name.ToString());
+	}
+	Writer.EndObject();
+}
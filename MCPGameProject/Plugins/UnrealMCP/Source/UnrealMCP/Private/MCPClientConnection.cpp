@@ -0,0 +1,237 @@
+#include "MCPClientConnection.h"
+#include "Sockets.h"
+#include "SocketSubsystem.h"
+#include "HAL/PlatformProcess.h"
+#include "Misc/ScopeExit.h"
+#include "Misc/ScopeLock.h"
+
+// Bytes read per Recv call
+static constexpr int32 MCPRecvChunkSize = 64 * 1024;
+
+FMCPClientConnection::FMCPClientConnection(TSharedPtr<FSocket> InSocket, int32 InConnectionId)
+	: Socket(InSocket)
+	, ConnectionId(InConnectionId)
+{
+}
+
+FMCPClientConnection::~FMCPClientConnection()
+{
+	// Nobody else holds the connection any more, so nothing can be inside Recv
+	CloseSocket();
+}
+
+void FMCPClientConnection::Close()
+{
+	if (!bClosed.exchange(true))
+	{
+		FScopeLock Lock(&SendLock);
+		ShutdownLocked();
+	}
+}
+
+void FMCPClientConnection::CloseSocket()
+{
+	bClosed.store(true);
+
+	// Senders check the flag under SendLock, so none is inside Send once we hold it
+	FScopeLock Lock(&SendLock);
+	if (Socket.IsValid() && !bSocketReleased)
+	{
+		bSocketReleased = true;
+		Socket->Close();
+	}
+}
+
+bool FMCPClientConnection::ReceiveFrames(TArray<TArray<uint8>>& OutFrames)
+{
+	if (IsClosed() || !Socket.IsValid())
+	{
+		return false;
+	}
+
+	bool bReceivedAny = false;
+	for (;;)
+	{
+		const int32 OldNum = RecvBuffer.Num();
+		RecvBuffer.AddUninitialized(MCPRecvChunkSize);
+
+		int32 BytesRead = 0;
+		const bool bOk = Socket->Recv(RecvBuffer.GetData() + OldNum, MCPRecvChunkSize, BytesRead);
+		RecvBuffer.SetNum(OldNum + FMath::Max(0, BytesRead), EAllowShrinking::No);
+
+		// Stream sockets report a graceful close as failure and "would block" as success with 0 bytes
+		if (!bOk)
+		{
+			const ESocketErrors LastError = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->GetLastErrorCode();
+			if (LastError == SE_EINTR)
+			{
+				break;
+			}
+			UE_LOG(LogTemp, Display, TEXT("MCPClientConnection: Connection %d closed (error %d)"), ConnectionId, (int32)LastError);
+			return false;
+		}
+		if (BytesRead == 0)
+		{
+			break;
+		}
+		bReceivedAny = true;
+		if (BytesRead < MCPRecvChunkSize)
+		{
+			break;
+		}
+	}
+
+	if (!bReceivedAny)
+	{
+		return true;
+	}
+
+	TArray<FMCPFrameRange> Ranges;
+	if (!Scanner.Scan(RecvBuffer, Ranges))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("MCPClientConnection: Connection %d sent an invalid request stream (%s), closing"), ConnectionId, Scanner.GetError());
+		return false;
+	}
+
+	for (const FMCPFrameRange& Range : Ranges)
+	{
+		OutFrames.Emplace(RecvBuffer.GetData() + Range.Start, Range.Num());
+	}
+
+	// Drop everything before the first unfinished frame so the buffer only holds pending bytes
+	const int32 Consumed = Scanner.GetPendingStart();
+	if (Consumed > 0)
+	{
+		RecvBuffer.RemoveAt(0, Consumed, EAllowShrinking::No);
+		Scanner.Consume(Consumed);
+	}
+
+	if (RecvBuffer.Num() > MaxFrameBytes)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("MCPClientConnection: Connection %d exceeded the %d byte frame limit, closing"), ConnectionId, MaxFrameBytes);
+		return false;
+	}
+
+	return true;
+}
+
+bool FMCPClientConnection::SendBytes(const uint8* Data, int32 Num)
+{
+	FScopeLock Lock(&SendLock);
+	if (IsClosed() || !Socket.IsValid())
+	{
+		return false;
+	}
+	return SendRemainingLocked(Data, Num, 0);
+}
+
+EMCPSendResult FMCPClientConnection::TrySendBytes(const uint8* Data, int32 Num)
+{
+	// Someone else is mid-write; waiting for them is exactly what the caller wants to avoid
+	if (!SendLock.TryLock())
+	{
+		return IsClosed() ? EMCPSendResult::Failed : EMCPSendResult::WouldBlock;
+	}
+	ON_SCOPE_EXIT { SendLock.Unlock(); };
+
+	if (IsClosed() || !Socket.IsValid())
+	{
+		return EMCPSendResult::Failed;
+	}
+
+	int32 BytesSent = 0;
+	if (!Socket->Send(Data, Num, BytesSent))
+	{
+		const ESocketErrors LastError = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->GetLastErrorCode();
+		if (LastError == SE_EWOULDBLOCK || LastError == SE_EINTR)
+		{
+			return EMCPSendResult::WouldBlock;
+		}
+		UE_LOG(LogTemp, Warning, TEXT("MCPClientConnection: Send failed on connection %d (error %d)"), ConnectionId, (int32)LastError);
+		return EMCPSendResult::Failed;
+	}
+	if (BytesSent <= 0)
+	{
+		return EMCPSendResult::WouldBlock;
+	}
+	return SendRemainingLocked(Data, Num, BytesSent) ? EMCPSendResult::Sent : EMCPSendResult::Failed;
+}
+
+bool FMCPClientConnection::SendRemainingLocked(const uint8* Data, int32 Num, int32 TotalSent)
+{
+	// The timeout restarts on progress, so large responses to slow readers still go through
+	double Deadline = FPlatformTime::Seconds() + SendTimeoutSeconds;
+	while (TotalSent < Num)
+	{
+		// Close() flags the connection before taking SendLock, so a stuck writer lets it through
+		if (IsClosed())
+		{
+			return false;
+		}
+
+		int32 BytesSent = 0;
+		const bool bSent = Socket->Send(Data + TotalSent, Num - TotalSent, BytesSent);
+		if (!bSent)
+		{
+			const ESocketErrors LastError = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->GetLastErrorCode();
+			if (LastError != SE_EWOULDBLOCK && LastError != SE_EINTR)
+			{
+				UE_LOG(LogTemp, Warning, TEXT("MCPClientConnection: Send failed on connection %d (error %d)"), ConnectionId, (int32)LastError);
+				return false;
+			}
+		}
+		if (!bSent || BytesSent <= 0)
+		{
+			if (FPlatformTime::Seconds() > Deadline)
+			{
+				UE_LOG(LogTemp, Warning, TEXT("MCPClientConnection: Connection %d stopped reading for %.0fs, closing"), ConnectionId, SendTimeoutSeconds);
+				bClosed.store(true);
+				ShutdownLocked();
+				return false;
+			}
+			FPlatformProcess::Sleep(0.001f);
+			continue;
+		}
+		TotalSent += BytesSent;
+		Deadline = FPlatformTime::Seconds() + SendTimeoutSeconds;
+	}
+	return true;
+}
+
+void FMCPClientConnection::ShutdownLocked()
+{
+	// Shutdown wakes a pending Recv but keeps the descriptor, so it cannot be reused under the server thread
+	if (Socket.IsValid() && !bSocketReleased)
+	{
+		Socket->Shutdown(ESocketShutdownMode::ReadWrite);
+	}
+}
+
+bool FMCPClientConnection::SendResponse(TArray<uint8>&& Utf8Response)
+{
+	Utf8Response.Add('\n');
+	return SendBytes(Utf8Response.GetData(), Utf8Response.Num());
+}
+
+bool FMCPClientConnection::EnqueueFrame(TArray<uint8>&& Frame)
+{
+	PendingFrames.Enqueue(MoveTemp(Frame));
+	return !bDraining.exchange(true);
+}
+
+bool FMCPClientConnection::DequeueFrame(TArray<uint8>& OutFrame)
+{
+	return PendingFrames.Dequeue(OutFrame);
+}
+
+bool FMCPClientConnection::FinishDrain()
+{
+	bDraining.store(false);
+
+	// A frame may have been queued after the last Dequeue but before the flag was cleared
+	if (PendingFrames.IsEmpty())
+	{
+		return false;
+	}
+	return !bDraining.exchange(true);
+}
@@ -0,0 +1,121 @@
+#include "MCPCommandParams.h"
+#include "MCPJsonWriter.h"
+
+namespace
+{
+	struct FRegisteredCommand
+	{
+		const TCHAR* Description = TEXT("");
+		TArray<FMCPParamInfo> Params;
+	};
+
+	struct FDescribeCommandsParams
+	{
+		FString Command;
+	};
+
+	constexpr auto DescribeCommandsSchema = MakeMCPParamSchema(
+		MCPOptional(TEXT("command"), &FDescribeCommandsParams::Command, TEXT("Only describe this command")));
+
+	TMap<FString, FRegisteredCommand>& GetRegisteredCommands()
+	{
+		static TMap<FString, FRegisteredCommand> Commands = []()
+		{
+			TMap<FString, FRegisteredCommand> Builtins;
+			FRegisteredCommand& Describe = Builtins.Add(TEXT("describe_commands"));
+			Describe.Description = TEXT("List the parameter schemas of commands that bind typed parameters");
+			DescribeCommandsSchema.Describe(Describe.Params);
+			return Builtins;
+		}();
+		return Commands;
+	}
+}
+
+const TCHAR* LexToString(EMCPParamType Type)
+{
+	switch (Type)
+	{
+	case EMCPParamType::String:      return TEXT("string");
+	case EMCPParamType::Number:      return TEXT("number");
+	case EMCPParamType::Integer:     return TEXT("integer");
+	case EMCPParamType::Bool:        return TEXT("boolean");
+	case EMCPParamType::Vector:      return TEXT("vector");
+	case EMCPParamType::Rotator:     return TEXT("rotator");
+	case EMCPParamType::StringArray: return TEXT("string_array");
+	case EMCPParamType::Object:      return TEXT("object");
+	case EMCPParamType::Array:       return TEXT("array");
+	default:                         return TEXT("unknown");
+	}
+}
+
+const TCHAR* MCPParamTypeExpectation(EMCPParamType Type)
+{
+	switch (Type)
+	{
+	case EMCPParamType::String:      return TEXT("a string");
+	case EMCPParamType::Number:      return TEXT("a number");
+	case EMCPParamType::Integer:     return TEXT("an integer");
+	case EMCPParamType::Bool:        return TEXT("a boolean");
+	case EMCPParamType::Vector:      return TEXT("an array of 3 numbers [x, y, z]");
+	case EMCPParamType::Rotator:     return TEXT("an array of 3 numbers [pitch, yaw, roll]");
+	case EMCPParamType::StringArray: return TEXT("an array of strings");
+	case EMCPParamType::Object:      return TEXT("an object");
+	case EMCPParamType::Array:       return TEXT("an array");
+	default:                         return TEXT("a valid value");
+	}
+}
+
+void FMCPCommandSchemas::Add(const FString& CommandType, const TCHAR* Description, TArray<FMCPParamInfo>&& Params)
+{
+	GetRegisteredCommands().Add(CommandType, FRegisteredCommand{ Description, MoveTemp(Params) });
+}
+
+bool FMCPCommandSchemas::HandleDescribeCommands(const FMCPJsonObjectView& Params, FMCPJsonWriter& Writer, FString& OutError)
+{
+	FDescribeCommandsParams Args;
+	if (!DescribeCommandsSchema.Bind(Params, Args, OutError))
+	{
+		return false;
+	}
+
+	const TMap<FString, FRegisteredCommand>& Commands = GetRegisteredCommands();
+	if (!Args.Command.IsEmpty() && !Commands.Contains(Args.Command))
+	{
+		OutError = FString::Printf(TEXT("No schema registered for command: %s"), *Args.Command);
+		return false;
+	}
+
+	TArray<FString> Names;
+	Commands.GetKeys(Names);
+	Names.Sort();
+
+	Writer.BeginObject();
+	Writer.BeginArray(TEXT("commands"));
+	for (const FString& Name : Names)
+	{
+		if (!Args.Command.IsEmpty() && Name != Args.Command)
+		{
+			continue;
+		}
+
+		const FRegisteredCommand& Command = Commands[Name];
+		Writer.BeginObject();
+		Writer.WriteField(TEXT("name"), Name);
+		Writer.WriteField(TEXT("description"), Command.Description);
+		Writer.BeginArray(TEXT("params"));
+		for (const FMCPParamInfo& Param : Command.Params)
+		{
+			Writer.BeginObject();
+			Writer.WriteField(TEXT("name"), Param.Name);
+			Writer.WriteField(TEXT("type"), LexToString(Param.Type));
+			Writer.WriteField(TEXT("required"), Param.bRequired);
+			Writer.WriteField(TEXT("description"), Param.Description);
+			Writer.EndObject();
+		}
+		Writer.EndArray();
+		Writer.EndObject();
+	}
+	Writer.EndArray();
+	Writer.EndObject();
+	return true;
+}
@@ -0,0 +1,327 @@
+#include "MCPFrameScanner.h"
+
+#if PLATFORM_CPU_X86_FAMILY
+	#include <emmintrin.h>
+	#define MCP_SCANNER_SSE2 1
+	#define MCP_SCANNER_NEON 0
+#elif PLATFORM_CPU_ARM_FAMILY && PLATFORM_ENABLE_VECTORINTRINSICS_NEON
+	#include <arm_neon.h>
+	#define MCP_SCANNER_SSE2 0
+	#define MCP_SCANNER_NEON 1
+#else
+	#define MCP_SCANNER_SSE2 0
+	#define MCP_SCANNER_NEON 0
+#endif
+
+#define MCP_SCANNER_SIMD (MCP_SCANNER_SSE2 || MCP_SCANNER_NEON)
+
+namespace MCPFrameScannerPrivate
+{
+	static constexpr int32 BlockSize = 16;
+
+#if MCP_SCANNER_SIMD
+	/**
+	 * Per-byte flags for one 16-byte block. SSE2 movemask yields one bit per byte;
+	 * the NEON narrowing trick yields four, so positions are scaled by Shift.
+	 */
+	struct FBlockMask
+	{
+		uint64 Bits;
+		int32 Shift;
+
+		bool IsEmpty() const { return Bits == 0; }
+
+		int32 PopFirst()
+		{
+			const int32 Position = static_cast<int32>(FMath::CountTrailingZeros64(Bits)) >> Shift;
+			const uint64 LaneMask = (Shift == 0) ? 1ull : 0xFull;
+			Bits &= ~(LaneMask << (Position << Shift));
+			return Position;
+		}
+	};
+
+	/** Flags quotes, backslashes, brackets and non-ASCII bytes. */
+	FORCEINLINE FBlockMask ClassifyBlock(const uint8* Block)
+	{
+#if MCP_SCANNER_SSE2
+		const __m128i Bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(Block));
+		// '{' / '[' and '}' / ']' differ only in bit 0x20
+		const __m128i Folded = _mm_or_si128(Bytes, _mm_set1_epi8(0x20));
+		const __m128i Structural = _mm_or_si128(
+			_mm_or_si128(_mm_cmpeq_epi8(Bytes, _mm_set1_epi8('"')), _mm_cmpeq_epi8(Bytes, _mm_set1_epi8('\\'))),
+			_mm_or_si128(_mm_cmpeq_epi8(Folded, _mm_set1_epi8('{')), _mm_cmpeq_epi8(Folded, _mm_set1_epi8('}'))));
+		const uint32 Mask = static_cast<uint32>(_mm_movemask_epi8(Structural)) | static_cast<uint32>(_mm_movemask_epi8(Bytes));
+		return { Mask, 0 };
+#else
+		const uint8x16_t Bytes = vld1q_u8(Block);
+		const uint8x16_t Folded = vorrq_u8(Bytes, vdupq_n_u8(0x20));
+		const uint8x16_t Flags = vorrq_u8(
+			vorrq_u8(vceqq_u8(Bytes, vdupq_n_u8('"')), vceqq_u8(Bytes, vdupq_n_u8('\\'))),
+			vorrq_u8(
+				vorrq_u8(vceqq_u8(Folded, vdupq_n_u8('{')), vceqq_u8(Folded, vdupq_n_u8('}'))),
+				vcgeq_u8(Bytes, vdupq_n_u8(0x80))));
+		const uint8x8_t Narrowed = vshrn_n_u16(vreinterpretq_u16_u8(Flags), 4);
+		return { vget_lane_u64(vreinterpret_u64_u8(Narrowed), 0), 2 };
+#endif
+	}
+#endif // MCP_SCANNER_SIMD
+}
+
+bool FMCPFrameScanner::ValidateUtf8Byte(uint8 Byte)
+{
+	if (Utf8Need == 0)
+	{
+		if (Byte < 0x80)
+		{
+			return true;
+		}
+		if (Byte >= 0xC2 && Byte <= 0xDF)
+		{
+			Utf8Need = 1;
+		}
+		else if (Byte == 0xE0)
+		{
+			Utf8Need = 2;
+			Utf8Lower = 0xA0;
+		}
+		else if (Byte == 0xED)
+		{
+			Utf8Need = 2;
+			Utf8Upper = 0x9F;
+		}
+		else if (Byte >= 0xE1 && Byte <= 0xEF)
+		{
+			Utf8Need = 2;
+		}
+		else if (Byte == 0xF0)
+		{
+			Utf8Need = 3;
+			Utf8Lower = 0x90;
+		}
+		else if (Byte >= 0xF1 && Byte <= 0xF3)
+		{
+			Utf8Need = 3;
+		}
+		else if (Byte == 0xF4)
+		{
+			Utf8Need = 3;
+			Utf8Upper = 0x8F;
+		}
+		else
+		{
+			return false;
+		}
+		return true;
+	}
+
+	if (Byte < Utf8Lower || Byte > Utf8Upper)
+	{
+		return false;
+	}
+	Utf8Lower = 0x80;
+	Utf8Upper = 0xBF;
+	--Utf8Need;
+	return true;
+}
+
+FMCPFrameScanner::EByteResult FMCPFrameScanner::ConsumeByte(uint8 Byte, int32 Index, TArray<FMCPFrameRange>& OutFrames)
+{
+	if (!ValidateUtf8Byte(Byte))
+	{
+		Error = TEXT("Invalid UTF-8 in request");
+		return EByteResult::Error;
+	}
+
+	if (FrameStart == INDEX_NONE)
+	{
+		// Between frames: skip separators (and the NUL keep-alive byte older clients send)
+		if (Byte == '{' || Byte == '[')
+		{
+			FrameStart = Index;
+			Depth = 1;
+			return EByteResult::Continue;
+		}
+		if (Byte == ' ' || Byte == '\t' || Byte == '\r' || Byte == '\n' || Byte == '\0')
+		{
+			return EByteResult::Continue;
+		}
+		Error = TEXT("Unexpected data between requests");
+		return EByteResult::Error;
+	}
+
+	if (bInString)
+	{
+		if (bEscape)
+		{
+			bEscape = false;
+		}
+		else if (Byte == '\\')
+		{
+			bEscape = true;
+		}
+		else if (Byte == '"')
+		{
+			bInString = false;
+		}
+		return EByteResult::Continue;
+	}
+
+	switch (Byte)
+	{
+	case '"':
+		bInString = true;
+		break;
+	case '{':
+	case '[':
+		++Depth;
+		break;
+	case '}':
+	case ']':
+		if (--Depth == 0)
+		{
+			OutFrames.Add({ FrameStart, Index + 1 });
+			FrameStart = INDEX_NONE;
+			return EByteResult::FrameClosed;
+		}
+		break;
+	default:
+		break;
+	}
+	return EByteResult::Continue;
+}
+
+int32 FMCPFrameScanner::ScanFrameBlocks(const uint8* Data, int32 Index, int32 Num, TArray<FMCPFrameRange>& OutFrames)
+{
+#if MCP_SCANNER_SIMD
+	using namespace MCPFrameScannerPrivate;
+
+	while (Index + BlockSize <= Num)
+	{
+		FBlockMask Mask = ClassifyBlock(Data + Index);
+
+		// Unflagged bytes are plain ASCII that cannot change framing state, except that
+		// one may be the character consumed by a pending escape, or may interrupt a
+		// multi-byte UTF-8 sequence.
+		int32 Previous = Index - 1;
+		while (!Mask.IsEmpty())
+		{
+			const int32 Position = Index + Mask.PopFirst();
+			if (Position != Previous + 1)
+			{
+				if (Utf8Need != 0)
+				{
+					Error = TEXT("Invalid UTF-8 in request");
+					return INDEX_NONE;
+				}
+				bEscape = false;
+			}
+			Previous = Position;
+
+			const EByteResult Result = ConsumeByte(Data[Position], Position, OutFrames);
+			if (Result == EByteResult::Error)
+			{
+				return INDEX_NONE;
+			}
+			if (Result == EByteResult::FrameClosed)
+			{
+				// Back to the between-frames state; the caller continues byte by byte
+				return Position + 1;
+			}
+		}
+
+		if (Previous != Index + BlockSize - 1)
+		{
+			if (Utf8Need != 0)
+			{
+				Error = TEXT("Invalid UTF-8 in request");
+				return INDEX_NONE;
+			}
+			bEscape = false;
+		}
+		Index += BlockSize;
+	}
+#endif
+	return Index;
+}
+
+int32 FMCPFrameScanner::ScanBinaryFrame(const uint8* Data, int32 Index, int32 Num, TArray<FMCPFrameRange>& OutFrames)
+{
+	if (FrameStart == INDEX_NONE)
+	{
+		FrameStart = Index;
+		bBinaryFrame = true;
+	}
+
+	// Wait for the length, then for the whole payload
+	if (Num - FrameStart < MCPBinaryFrameHeaderBytes)
+	{
+		return Num;
+	}
+	const int32 PayloadBytes = Data[FrameStart + 2] | (Data[FrameStart + 3] << 8);
+	const int32 End = FrameStart + MCPBinaryFrameHeaderBytes + PayloadBytes;
+	if (End > Num)
+	{
+		return Num;
+	}
+
+	OutFrames.Add({ FrameStart, End });
+	FrameStart = INDEX_NONE;
+	bBinaryFrame = false;
+	return End;
+}
+
+bool FMCPFrameScanner::Scan(const TArray<uint8>& Buffer, TArray<FMCPFrameRange>& OutFrames)
+{
+	const uint8* Data = Buffer.GetData();
+	const int32 Num = Buffer.Num();
+
+	int32 Index = ScanOffset;
+	while (Index < Num)
+	{
+		if (bBinaryFrame || (FrameStart == INDEX_NONE && Data[Index] == MCPBinaryFrameMagic))
+		{
+			Index = ScanBinaryFrame(Data, Index, Num, OutFrames);
+			continue;
+		}
+
+		if (FrameStart != INDEX_NONE && bUseSimd)
+		{
+			const int32 Next = ScanFrameBlocks(Data, Index, Num, OutFrames);
+			if (Next == INDEX_NONE)
+			{
+				return false;
+			}
+			if (Next != Index)
+			{
+				Index = Next;
+				continue;
+			}
+		}
+
+		// Between frames, and the sub-block tail of the buffer
+		if (ConsumeByte(Data[Index], Index, OutFrames) == EByteResult::Error)
+		{
+			ScanOffset = Index;
+			return false;
+		}
+		++Index;
+	}
+
+	ScanOffset = Num;
+	return true;
+}
+
+void FMCPFrameScanner::Consume(int32 Count)
+{
+	ScanOffset = FMath::Max(0, ScanOffset - Count);
+	if (FrameStart != INDEX_NONE)
+	{
+		FrameStart -= Count;
+		check(FrameStart >= 0);
+	}
+}
+
+void FMCPFrameScanner::Reset()
+{
+	*this = FMCPFrameScanner();
+}
@@ -0,0 +1,127 @@
+#include "MCPImageEncoder.h"
+#include "IImageWrapper.h"
+#include "IImageWrapperModule.h"
+
+bool FMCPImageEncoder::ParseFormat(const FString& Text, EMCPImageFormat& OutFormat, FString& OutError)
+{
+	if (Text.IsEmpty() || Text.Equals(TEXT("png"), ESearchCase::IgnoreCase))
+	{
+		OutFormat = EMCPImageFormat::Png;
+		return true;
+	}
+	if (Text.Equals(TEXT("jpeg"), ESearchCase::IgnoreCase) || Text.Equals(TEXT("jpg"), ESearchCase::IgnoreCase))
+	{
+		OutFormat = EMCPImageFormat::Jpeg;
+		return true;
+	}
+	if (Text.Equals(TEXT("webp"), ESearchCase::IgnoreCase))
+	{
+		OutError = TEXT("WebP is not available in the engine's image wrappers; use png or jpeg");
+		return false;
+	}
+	OutError = FString::Printf(TEXT("Unknown image format: %s (use png or jpeg)"), *Text);
+	return false;
+}
+
+const TCHAR* FMCPImageEncoder::GetExtension(EMCPImageFormat Format)
+{
+	return Format == EMCPImageFormat::Jpeg ? TEXT(".jpg") : TEXT(".png");
+}
+
+FIntPoint FMCPImageEncoder::FitSize(FIntPoint Source, int32 MaxSize)
+{
+	const int32 LongSide = FMath::Max(Source.X, Source.Y);
+	if (MaxSize <= 0 || LongSide <= MaxSize)
+	{
+		return Source;
+	}
+	const double Scale = (double)MaxSize / LongSide;
+	return FIntPoint(
+		FMath::Max(1, FMath::RoundToInt(Source.X * Scale)),
+		FMath::Max(1, FMath::RoundToInt(Source.Y * Scale)));
+}
+
+void FMCPImageEncoder::ForceOpaque(TArray<FColor>& Pixels)
+{
+	for (FColor& Pixel : Pixels)
+	{
+		Pixel.A = 255;
+	}
+}
+
+void FMCPImageEncoder::Resample(const TArray<FColor>& Source, FIntPoint SourceSize, FIntPoint DestSize, TArray<FColor>& OutPixels)
+{
+	check(Source.Num() == SourceSize.X * SourceSize.Y && DestSize.X > 0 && DestSize.Y > 0);
+	OutPixels.SetNumUninitialized(DestSize.X * DestSize.Y);
+	if (DestSize == SourceSize)
+	{
+		FMemory::Memcpy(OutPixels.GetData(), Source.GetData(), Source.Num() * sizeof(FColor));
+		return;
+	}
+
+	// Integer source spans per destination column, computed once for every row
+	TArray<int32> ColumnStarts;
+	ColumnStarts.SetNumUninitialized(DestSize.X + 1);
+	for (int32 X = 0; X <= DestSize.X; ++X)
+	{
+		ColumnStarts[X] = FMath::Min((int32)((int64)X * SourceSize.X / DestSize.X), SourceSize.X);
+	}
+
+	for (int32 Y = 0; Y < DestSize.Y; ++Y)
+	{
+		const int32 RowBegin = (int32)((int64)Y * SourceSize.Y / DestSize.Y);
+		const int32 RowEnd = FMath::Max(RowBegin + 1, (int32)((int64)(Y + 1) * SourceSize.Y / DestSize.Y));
+		for (int32 X = 0; X < DestSize.X; ++X)
+		{
+			const int32 ColumnBegin = ColumnStarts[X];
+			const int32 ColumnEnd = FMath::Max(ColumnBegin + 1, ColumnStarts[X + 1]);
+			uint32 Sum[4] = { 0, 0, 0, 0 };
+			for (int32 SourceY = RowBegin; SourceY < RowEnd; ++SourceY)
+			{
+				const FColor* Row = Source.GetData() + (int64)SourceY * SourceSize.X;
+				for (int32 SourceX = ColumnBegin; SourceX < ColumnEnd; ++SourceX)
+				{
+					const FColor& Pixel = Row[SourceX];
+					Sum[0] += Pixel.R;
+					Sum[1] += Pixel.G;
+					Sum[2] += Pixel.B;
+					Sum[3] += Pixel.A;
+				}
+			}
+			const uint32 Count = (uint32)((RowEnd - RowBegin) * (ColumnEnd - ColumnBegin));
+			const uint32 Half = Count / 2;
+			OutPixels[Y * DestSize.X + X] = FColor(
+				(uint8)((Sum[0] + Half) / Count),
+				(uint8)((Sum[1] + Half) / Count),
+				(uint8)((Sum[2] + Half) / Count),
+				(uint8)((Sum[3] + Half) / Count));
+		}
+	}
+}
+
+bool FMCPImageEncoder::Encode(IImageWrapperModule& ImageWrapperModule, const TArray<FColor>& Pixels, FIntPoint Size,
+	EMCPImageFormat Format, int32 Quality, TArray64<uint8>& OutBytes, FString& OutError)
+{
+	const EImageFormat WrapperFormat = Format == EMCPImageFormat::Jpeg ? EImageFormat::JPEG : EImageFormat::PNG;
+	TSharedPtr<IImageWrapper> ImageWrapper = ImageWrapperModule.CreateImageWrapper(WrapperFormat);
+	if (!ImageWrapper.IsValid())
+	{
+		OutError = TEXT("Failed to create image encoder");
+		return false;
+	}
+
+	// FColor is laid out as BGRA in memory
+	if (!ImageWrapper->SetRaw(Pixels.GetData(), (int64)Pixels.Num() * sizeof(FColor), Size.X, Size.Y, ERGBFormat::BGRA, 8))
+	{
+		OutError = FString::Printf(TEXT("Image encoder rejected a %dx%d frame"), Size.X, Size.Y);
+		return false;
+	}
+
+	OutBytes = ImageWrapper->GetCompressed(Format == EMCPImageFormat::Jpeg ? FMath::Clamp(Quality, 1, 100) : 0);
+	if (OutBytes.Num() == 0)
+	{
+		OutError = TEXT("Image compression failed");
+		return false;
+	}
+	return true;
+}
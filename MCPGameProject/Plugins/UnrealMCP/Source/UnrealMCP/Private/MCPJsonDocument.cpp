@@ -0,0 +1,785 @@
+#include "MCPJsonDocument.h"
+#include "Dom/JsonObject.h"
+#include "Dom/JsonValue.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
+
+namespace
+{
+	// Parsing (and ToJsonValue) recurse once per level on 128 KB worker stacks;
+	// real requests nest a handful of levels, so deeper input is rejected
+	constexpr int32 MCPJsonMaxDepth = 64;
+
+	FString Utf8ToString(const UTF8CHAR* Data, int32 Len)
+	{
+		if (Len <= 0)
+		{
+			return FString();
+		}
+		FUTF8ToTCHAR Converter(reinterpret_cast<const ANSICHAR*>(Data), Len);
+		return FString(Converter.Length(), Converter.Get());
+	}
+
+	int32 HexValue(uint8 Char)
+	{
+		if (Char >= '0' && Char <= '9') return Char - '0';
+		if (Char >= 'a' && Char <= 'f') return Char - 'a' + 10;
+		if (Char >= 'A' && Char <= 'F') return Char - 'A' + 10;
+		return -1;
+	}
+
+	int32 EncodeUtf8(uint32 CodePoint, uint8* Out)
+	{
+		if (CodePoint < 0x80)
+		{
+			Out[0] = (uint8)CodePoint;
+			return 1;
+		}
+		if (CodePoint < 0x800)
+		{
+			Out[0] = (uint8)(0xC0 | (CodePoint >> 6));
+			Out[1] = (uint8)(0x80 | (CodePoint & 0x3F));
+			return 2;
+		}
+		if (CodePoint < 0x10000)
+		{
+			Out[0] = (uint8)(0xE0 | (CodePoint >> 12));
+			Out[1] = (uint8)(0x80 | ((CodePoint >> 6) & 0x3F));
+			Out[2] = (uint8)(0x80 | (CodePoint & 0x3F));
+			return 3;
+		}
+		Out[0] = (uint8)(0xF0 | (CodePoint >> 18));
+		Out[1] = (uint8)(0x80 | ((CodePoint >> 12) & 0x3F));
+		Out[2] = (uint8)(0x80 | ((CodePoint >> 6) & 0x3F));
+		Out[3] = (uint8)(0x80 | (CodePoint & 0x3F));
+		return 4;
+	}
+}
+
+bool MCPJsonKeyEquals(FUtf8StringView Key, const TCHAR* FieldName)
+{
+	const UTF8CHAR* KeyData = Key.GetData();
+	const int32 KeyLen = Key.Len();
+	int32 Index = 0;
+	for (; FieldName[Index] != 0; ++Index)
+	{
+		const TCHAR Char = FieldName[Index];
+		if (Char > 0x7F || (Index < KeyLen && (uint8)KeyData[Index] > 0x7F))
+		{
+			// Non-ASCII names are rare; compare them the way FJsonObject's FString keys do
+			return Utf8ToString(KeyData, KeyLen).Equals(FieldName, ESearchCase::IgnoreCase);
+		}
+		if (Index >= KeyLen || FChar::ToLower((TCHAR)KeyData[Index]) != FChar::ToLower(Char))
+		{
+			return false;
+		}
+	}
+	return Index == KeyLen;
+}
+
+// ----------------------------------------------------------------------------
+// Parser
+// ----------------------------------------------------------------------------
+
+struct FMCPJsonParser
+{
+	FMCPJsonDocument& Doc;
+	const uint8* Begin;
+	const uint8* Cur;
+	const uint8* End;
+	int32 Depth = 0;
+
+	FMCPJsonParser(FMCPJsonDocument& InDoc, const uint8* InBegin, int32 Num)
+		: Doc(InDoc), Begin(InBegin), Cur(InBegin), End(InBegin + Num)
+	{
+	}
+
+	bool Fail(const TCHAR* Message)
+	{
+		Doc.Error = FString::Printf(TEXT("%s at offset %d"), Message, (int32)(Cur - Begin));
+		return false;
+	}
+
+	void SkipWhitespace()
+	{
+		while (Cur < End && (*Cur == ' ' || *Cur == '\t' || *Cur == '\n' || *Cur == '\r'))
+		{
+			++Cur;
+		}
+	}
+
+	FMCPJsonNode* NewNode()
+	{
+		return new (Doc.Allocate(sizeof(FMCPJsonNode), alignof(FMCPJsonNode))) FMCPJsonNode();
+	}
+
+	bool ParseDocument(const FMCPJsonNode*& OutRoot)
+	{
+		FMCPJsonNode* RootNode = NewNode();
+		SkipWhitespace();
+		if (!ParseValue(*RootNode))
+		{
+			return false;
+		}
+		SkipWhitespace();
+		if (Cur != End)
+		{
+			return Fail(TEXT("Unexpected trailing characters"));
+		}
+		OutRoot = RootNode;
+		return true;
+	}
+
+	bool ParseValue(FMCPJsonNode& Out)
+	{
+		if (Cur >= End)
+		{
+			return Fail(TEXT("Unexpected end of input"));
+		}
+
+		switch (*Cur)
+		{
+		case '{':
+			return ParseObject(Out);
+		case '[':
+			return ParseArray(Out);
+		case '"':
+			Out.Type = EMCPJsonType::String;
+			return ParseString(Out.String, Out.StringLen);
+		case 't':
+			Out.Type = EMCPJsonType::Bool;
+			Out.bBool = true;
+			return ParseLiteral("true", 4);
+		case 'f':
+			Out.Type = EMCPJsonType::Bool;
+			Out.bBool = false;
+			return ParseLiteral("false", 5);
+		case 'n':
+			Out.Type = EMCPJsonType::Null;
+			return ParseLiteral("null", 4);
+		default:
+			if (*Cur == '-' || (*Cur >= '0' && *Cur <= '9'))
+			{
+				Out.Type = EMCPJsonType::Number;
+				return ParseNumber(Out.Number);
+			}
+			return Fail(TEXT("Unexpected character"));
+		}
+	}
+
+	bool ParseLiteral(const char* Text, int32 Len)
+	{
+		if (End - Cur < Len || FMemory::Memcmp(Cur, Text, Len) != 0)
+		{
+			return Fail(TEXT("Invalid literal"));
+		}
+		Cur += Len;
+		return true;
+	}
+
+	bool ParseObject(FMCPJsonNode& Out)
+	{
+		Out.Type = EMCPJsonType::Object;
+		if (++Depth > MCPJsonMaxDepth)
+		{
+			return Fail(TEXT("Nesting too deep"));
+		}
+		++Cur;
+
+		SkipWhitespace();
+		if (Cur < End && *Cur == '}')
+		{
+			++Cur;
+			--Depth;
+			return true;
+		}
+
+		FMCPJsonNode* Tail = nullptr;
+		for (;;)
+		{
+			SkipWhitespace();
+			if (Cur >= End || *Cur != '"')
+			{
+				return Fail(TEXT("Expected member name"));
+			}
+
+			FMCPJsonNode* Child = NewNode();
+			if (!ParseString(Child->Key, Child->KeyLen))
+			{
+				return false;
+			}
+			Child->KeyHash = MCPJsonKeyHash(reinterpret_cast<const uint8*>(Child->Key), Child->KeyLen);
+
+			SkipWhitespace();
+			if (Cur >= End || *Cur != ':')
+			{
+				return Fail(TEXT("Expected ':'"));
+			}
+			++Cur;
+			SkipWhitespace();
+
+			if (!ParseValue(*Child))
+			{
+				return false;
+			}
+
+			if (Tail)
+			{
+				Tail->Next = Child;
+			}
+			else
+			{
+				Out.FirstChild = Child;
+			}
+			Tail = Child;
+			++Out.NumChildren;
+
+			SkipWhitespace();
+			if (Cur < End && *Cur == ',')
+			{
+				++Cur;
+				continue;
+			}
+			if (Cur < End && *Cur == '}')
+			{
+				++Cur;
+				break;
+			}
+			return Fail(TEXT("Expected ',' or '}'"));
+		}
+
+		--Depth;
+		return true;
+	}
+
+	bool ParseArray(FMCPJsonNode& Out)
+	{
+		Out.Type = EMCPJsonType::Array;
+		if (++Depth > MCPJsonMaxDepth)
+		{
+			return Fail(TEXT("Nesting too deep"));
+		}
+		++Cur;
+
+		SkipWhitespace();
+		if (Cur < End && *Cur == ']')
+		{
+			++Cur;
+			--Depth;
+			return true;
+		}
+
+		FMCPJsonNode* Tail = nullptr;
+		for (;;)
+		{
+			SkipWhitespace();
+			FMCPJsonNode* Child = NewNode();
+			if (!ParseValue(*Child))
+			{
+				return false;
+			}
+
+			if (Tail)
+			{
+				Tail->Next = Child;
+			}
+			else
+			{
+				Out.FirstChild = Child;
+			}
+			Tail = Child;
+			++Out.NumChildren;
+
+			SkipWhitespace();
+			if (Cur < End && *Cur == ',')
+			{
+				++Cur;
+				continue;
+			}
+			if (Cur < End && *Cur == ']')
+			{
+				++Cur;
+				break;
+			}
+			return Fail(TEXT("Expected ',' or ']'"));
+		}
+
+		--Depth;
+		return true;
+	}
+
+	bool ParseString(const UTF8CHAR*& OutData, int32& OutLen)
+	{
+		// Cur is on the opening quote. First pass finds the closing quote and whether anything needs decoding.
+		const uint8* Start = ++Cur;
+		bool bHasEscapes = false;
+		while (Cur < End && *Cur != '"')
+		{
+			if (*Cur == '\\')
+			{
+				bHasEscapes = true;
+				if (++Cur >= End)
+				{
+					break;
+				}
+			}
+			else if (*Cur < 0x20)
+			{
+				return Fail(TEXT("Control character in string"));
+			}
+			++Cur;
+		}
+		if (Cur >= End)
+		{
+			return Fail(TEXT("Unterminated string"));
+		}
+
+		const uint8* Stop = Cur++;
+		if (!bHasEscapes)
+		{
+			// Common case: point straight into the frame
+			OutData = reinterpret_cast<const UTF8CHAR*>(Start);
+			OutLen = (int32)(Stop - Start);
+			return true;
+		}
+
+		// Escapes only ever shrink the text, so the raw length bounds the decoded length
+		uint8* Decoded = static_cast<uint8*>(Doc.Allocate((int32)(Stop - Start), 1));
+		int32 DecodedLen = 0;
+		for (const uint8* Src = Start; Src < Stop; )
+		{
+			if (*Src != '\\')
+			{
+				Decoded[DecodedLen++] = *Src++;
+				continue;
+			}
+
+			++Src;
+			switch (*Src++)
+			{
+			case '"':  Decoded[DecodedLen++] = '"'; break;
+			case '\\': Decoded[DecodedLen++] = '\\'; break;
+			case '/':  Decoded[DecodedLen++] = '/'; break;
+			case 'b':  Decoded[DecodedLen++] = '\b'; break;
+			case 'f':  Decoded[DecodedLen++] = '\f'; break;
+			case 'n':  Decoded[DecodedLen++] = '\n'; break;
+			case 'r':  Decoded[DecodedLen++] = '\r'; break;
+			case 't':  Decoded[DecodedLen++] = '\t'; break;
+			case 'u':
+			{
+				uint32 CodePoint = 0;
+				if (!ReadHex4(Src, Stop, CodePoint))
+				{
+					return Fail(TEXT("Invalid \\u escape"));
+				}
+				if (CodePoint >= 0xD800 && CodePoint <= 0xDBFF)
+				{
+					uint32 Low = 0;
+					const uint8* Pair = Src;
+					if (Stop - Pair >= 6 && Pair[0] == '\\' && Pair[1] == 'u')
+					{
+						Pair += 2;
+						if (ReadHex4(Pair, Stop, Low) && Low >= 0xDC00 && Low <= 0xDFFF)
+						{
+							CodePoint = 0x10000 + ((CodePoint - 0xD800) << 10) + (Low - 0xDC00);
+							Src = Pair;
+						}
+						else
+						{
+							CodePoint = 0xFFFD;
+						}
+					}
+					else
+					{
+						CodePoint = 0xFFFD;
+					}
+				}
+				else if (CodePoint >= 0xDC00 && CodePoint <= 0xDFFF)
+				{
+					// Lone low surrogate: replace rather than reject, like the Dom reader
+					CodePoint = 0xFFFD;
+				}
+				DecodedLen += EncodeUtf8(CodePoint, Decoded + DecodedLen);
+				break;
+			}
+			default:
+				return Fail(TEXT("Invalid escape sequence"));
+			}
+		}
+
+		OutData = reinterpret_cast<const UTF8CHAR*>(Decoded);
+		OutLen = DecodedLen;
+		return true;
+	}
+
+	static bool ReadHex4(const uint8*& Src, const uint8* Stop, uint32& OutValue)
+	{
+		if (Stop - Src < 4)
+		{
+			return false;
+		}
+		uint32 Value = 0;
+		for (int32 Index = 0; Index < 4; ++Index)
+		{
+			const int32 Digit = HexValue(Src[Index]);
+			if (Digit < 0)
+			{
+				return false;
+			}
+			Value = (Value << 4) | (uint32)Digit;
+		}
+		Src += 4;
+		OutValue = Value;
+		return true;
+	}
+
+	bool ParseNumber(double& OutNumber)
+	{
+		const uint8* Start = Cur;
+		bool bNegative = false;
+		if (*Cur == '-')
+		{
+			bNegative = true;
+			++Cur;
+		}
+
+		// Integer part: 0 or [1-9][0-9]*
+		if (Cur >= End || *Cur < '0' || *Cur > '9')
+		{
+			return Fail(TEXT("Invalid number"));
+		}
+		uint64 IntegerValue = 0;
+		int32 IntegerDigits = 0;
+		if (*Cur == '0')
+		{
+			++Cur;
+			IntegerDigits = 1;
+		}
+		else
+		{
+			while (Cur < End && *Cur >= '0' && *Cur <= '9')
+			{
+				IntegerValue = IntegerValue * 10 + (*Cur - '0');
+				++IntegerDigits;
+				++Cur;
+			}
+		}
+
+		bool bSimpleInteger = IntegerDigits <= 15;
+		if (Cur < End && *Cur == '.')
+		{
+			bSimpleInteger = false;
+			++Cur;
+			if (Cur >= End || *Cur < '0' || *Cur > '9')
+			{
+				return Fail(TEXT("Invalid number"));
+			}
+			while (Cur < End && *Cur >= '0' && *Cur <= '9')
+			{
+				++Cur;
+			}
+		}
+		if (Cur < End && (*Cur == 'e' || *Cur == 'E'))
+		{
+			bSimpleInteger = false;
+			++Cur;
+			if (Cur < End && (*Cur == '+' || *Cur == '-'))
+			{
+				++Cur;
+			}
+			if (Cur >= End || *Cur < '0' || *Cur > '9')
+			{
+				return Fail(TEXT("Invalid number"));
+			}
+			while (Cur < End && *Cur >= '0' && *Cur <= '9')
+			{
+				++Cur;
+			}
+		}
+
+		if (bSimpleInteger)
+		{
+			// Exact in a double, no conversion call needed
+			OutNumber = bNegative ? -(double)IntegerValue : (double)IntegerValue;
+			return true;
+		}
+
+		// Atod needs a terminator; the frame has none, so copy the token out
+		const int32 Len = (int32)(Cur - Start);
+		ANSICHAR Stack[64];
+		ANSICHAR* Text = Len < UE_ARRAY_COUNT(Stack) ? Stack : static_cast<ANSICHAR*>(Doc.Allocate(Len + 1, 1));
+		FMemory::Memcpy(Text, Start, Len);
+		Text[Len] = 0;
+		OutNumber = FCStringAnsi::Atod(Text);
+		return true;
+	}
+};
+
+// ----------------------------------------------------------------------------
+// FMCPJsonDocument
+// ----------------------------------------------------------------------------
+
+FMCPJsonDocument::FMCPJsonDocument()
+	: Arena(FMemStackBase::EPageSize::Large)
+{
+}
+
+FMCPJsonDocument::~FMCPJsonDocument()
+{
+	// Nodes are trivially destructible; FMemStackBase hands its pages back in one pass
+}
+
+void* FMCPJsonDocument::Allocate(int32 Size, int32 Alignment)
+{
+	ArenaBytes += Size;
+	return Arena.Alloc(FMath::Max(Size, 1), Alignment);
+}
+
+bool FMCPJsonDocument::Parse(TArray<uint8>&& InBuffer)
+{
+	Buffer = MoveTemp(InBuffer);
+	Root = nullptr;
+	Error.Reset();
+
+	FMCPJsonParser Parser(*this, Buffer.GetData(), Buffer.Num());
+	return Parser.ParseDocument(Root);
+}
+
+FMCPJsonObjectView FMCPJsonDocument::GetRootObject() const
+{
+	return FMCPJsonObjectView(Root && Root->Type == EMCPJsonType::Object ? Root : nullptr);
+}
+
+TSharedRef<FMCPJsonDocument, ESPMode::ThreadSafe> FMCPJsonDocument::FromJsonObject(const TSharedPtr<FJsonObject>& JsonObject)
+{
+	FString Text;
+	TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Text);
+	FJsonSerializer::Serialize(JsonObject.IsValid() ? JsonObject.ToSharedRef() : MakeShared<FJsonObject>(), Writer);
+
+	FTCHARToUTF8 Utf8Text(*Text);
+	TArray<uint8> Bytes(reinterpret_cast<const uint8*>(Utf8Text.Get()), Utf8Text.Length());
+
+	TSharedRef<FMCPJsonDocument, ESPMode::ThreadSafe> Document = MakeShared<FMCPJsonDocument, ESPMode::ThreadSafe>();
+	Document->Parse(MoveTemp(Bytes));
+	return Document;
+}
+
+// ----------------------------------------------------------------------------
+// Views
+// ----------------------------------------------------------------------------
+
+bool FMCPJsonValueView::TryGetString(FString& OutString) const
+{
+	if (!Node)
+	{
+		return false;
+	}
+	switch (Node->Type)
+	{
+	case EMCPJsonType::String:
+		OutString = Utf8ToString(Node->String, Node->StringLen);
+		return true;
+	case EMCPJsonType::Number:
+		OutString = FString::SanitizeFloat(Node->Number, 0);
+		return true;
+	case EMCPJsonType::Bool:
+		OutString = Node->bBool ? TEXT("true") : TEXT("false");
+		return true;
+	default:
+		return false;
+	}
+}
+
+bool FMCPJsonValueView::TryGetStringView(FUtf8StringView& OutView) const
+{
+	if (!Node || Node->Type != EMCPJsonType::String)
+	{
+		return false;
+	}
+	OutView = FUtf8StringView(Node->String, Node->StringLen);
+	return true;
+}
+
+bool FMCPJsonValueView::TryGetNumber(double& OutNumber) const
+{
+	if (!Node)
+	{
+		return false;
+	}
+	switch (Node->Type)
+	{
+	case EMCPJsonType::Number:
+		OutNumber = Node->Number;
+		return true;
+	case EMCPJsonType::Bool:
+		OutNumber = Node->bBool ? 1.0 : 0.0;
+		return true;
+	case EMCPJsonType::String:
+	{
+		const FString Value = Utf8ToString(Node->String, Node->StringLen);
+		if (Value.IsNumeric())
+		{
+			OutNumber = FCString::Atod(*Value);
+			return true;
+		}
+		return false;
+	}
+	default:
+		return false;
+	}
+}
+
+bool FMCPJsonValueView::TryGetNumber(float& OutNumber) const
+{
+	double Value = 0.0;
+	if (TryGetNumber(Value))
+	{
+		OutNumber = (float)Value;
+		return true;
+	}
+	return false;
+}
+
+bool FMCPJsonValueView::TryGetNumber(int32& OutNumber) const
+{
+	double Value = 0.0;
+	if (TryGetNumber(Value) && Value >= (double)MIN_int32 && Value <= (double)MAX_int32)
+	{
+		OutNumber = (int32)FMath::RoundHalfFromZero(Value);
+		return true;
+	}
+	return false;
+}
+
+bool FMCPJsonValueView::TryGetNumber(int64& OutNumber) const
+{
+	double Value = 0.0;
+	if (TryGetNumber(Value) && Value >= (double)MIN_int64 && Value <= (double)MAX_int64)
+	{
+		OutNumber = (int64)FMath::RoundHalfFromZero(Value);
+		return true;
+	}
+	return false;
+}
+
+bool FMCPJsonValueView::TryGetBool(bool& OutBool) const
+{
+	if (!Node)
+	{
+		return false;
+	}
+	switch (Node->Type)
+	{
+	case EMCPJsonType::Bool:
+		OutBool = Node->bBool;
+		return true;
+	case EMCPJsonType::Number:
+		OutBool = Node->Number != 0.0;
+		return true;
+	case EMCPJsonType::String:
+		OutBool = Utf8ToString(Node->String, Node->StringLen).ToBool();
+		return true;
+	default:
+		return false;
+	}
+}
+
+bool FMCPJsonValueView::TryGetObject(FMCPJsonObjectView& OutObject) const
+{
+	if (!Node || Node->Type != EMCPJsonType::Object)
+	{
+		return false;
+	}
+	OutObject = FMCPJsonObjectView(Node);
+	return true;
+}
+
+bool FMCPJsonValueView::TryGetArray(FMCPJsonArrayView& OutArray) const
+{
+	if (!Node || Node->Type != EMCPJsonType::Array)
+	{
+		return false;
+	}
+	OutArray = FMCPJsonArrayView(Node);
+	return true;
+}
+
+TSharedPtr<FJsonValue> FMCPJsonValueView::ToJsonValue() const
+{
+	if (!Node)
+	{
+		return MakeShared<FJsonValueNull>();
+	}
+
+	switch (Node->Type)
+	{
+	case EMCPJsonType::Bool:
+		return MakeShared<FJsonValueBoolean>(Node->bBool);
+	case EMCPJsonType::Number:
+		return MakeShared<FJsonValueNumber>(Node->Number);
+	case EMCPJsonType::String:
+		return MakeShared<FJsonValueString>(Utf8ToString(Node->String, Node->StringLen));
+	case EMCPJsonType::Array:
+	{
+		TArray<TSharedPtr<FJsonValue>> Values;
+		Values.Reserve(Node->NumChildren);
+		for (const FMCPJsonNode* Child = Node->FirstChild; Child; Child = Child->Next)
+		{
+			Values.Add(FMCPJsonValueView(Child).ToJsonValue());
+		}
+		return MakeShared<FJsonValueArray>(Values);
+	}
+	case EMCPJsonType::Object:
+		return MakeShared<FJsonValueObject>(FMCPJsonObjectView(Node).ToJsonObject());
+	default:
+		return MakeShared<FJsonValueNull>();
+	}
+}
+
+FMCPJsonValueView FMCPJsonObjectView::FindField(const TCHAR* FieldName) const
+{
+	// No early exit: a repeated name resolves to its last occurrence, as in FJsonObject
+	const FMCPJsonNode* Found = nullptr;
+	if (Node && Node->Type == EMCPJsonType::Object)
+	{
+		for (const FMCPJsonNode* Child = Node->FirstChild; Child; Child = Child->Next)
+		{
+			if (MCPJsonKeyEquals(FUtf8StringView(Child->Key, Child->KeyLen), FieldName))
+			{
+				Found = Child;
+			}
+		}
+	}
+	return FMCPJsonValueView(Found);
+}
+
+FMCPJsonValueView FMCPJsonObjectView::FindField(const FMCPJsonKey& Key) const
+{
+	const FMCPJsonNode* Found = nullptr;
+	if (Node && Node->Type == EMCPJsonType::Object)
+	{
+		for (const FMCPJsonNode* Child = Node->FirstChild; Child; Child = Child->Next)
+		{
+			if (Child->KeyHash == Key.Hash && Child->KeyLen == Key.Len
+				&& FCStringAnsi::Strnicmp(reinterpret_cast<const ANSICHAR*>(Child->Key), reinterpret_cast<const ANSICHAR*>(Key.GetUtf8()), Key.Len) == 0)
+			{
+				Found = Child;
+			}
+		}
+	}
+	return FMCPJsonValueView(Found);
+}
+
+TSharedPtr<FJsonObject> FMCPJsonObjectView::ToJsonObject() const
+{
+	TSharedPtr<FJsonObject> Object = MakeShared<FJsonObject>();
+	if (Node && Node->Type == EMCPJsonType::Object)
+	{
+		for (const FMCPJsonNode* Child = Node->FirstChild; Child; Child = Child->Next)
+		{
+			Object->SetField(Utf8ToString(Child->Key, Child->KeyLen), FMCPJsonValueView(Child).ToJsonValue());
+		}
+	}
+	return Object;
+}
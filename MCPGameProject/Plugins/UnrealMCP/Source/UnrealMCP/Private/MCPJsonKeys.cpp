@@ -0,0 +1,8 @@
+#include "MCPJsonKeys.h"
+
+namespace MCPKeyStrings
+{
+#define MCP_DEFINE_JSON_KEY_STRING(Identifier, Literal) const FString Identifier(TEXT(Literal));
+	MCP_JSON_KEYS(MCP_DEFINE_JSON_KEY_STRING)
+#undef MCP_DEFINE_JSON_KEY_STRING
+}
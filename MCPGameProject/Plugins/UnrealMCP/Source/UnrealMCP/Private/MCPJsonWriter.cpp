@@ -0,0 +1,369 @@
+#include "MCPJsonWriter.h"
+#include "Dom/JsonObject.h"
+#include "Dom/JsonValue.h"
+
+// Characters encoded per buffer growth step in WriteEscaped; bounds the over-reservation
+static constexpr int32 MCPEscapeChunk = 256;
+
+// Worst case output bytes for one TCHAR: a \u00XX escape
+static constexpr int32 MCPMaxBytesPerChar = 6;
+
+void FMCPJsonWriter::BeginValue()
+{
+	if (bAfterKey)
+	{
+		bAfterKey = false;
+		return;
+	}
+	if (Scopes.Num() > 0)
+	{
+		bool& bHasElements = Scopes.Last();
+		if (bHasElements)
+		{
+			Buffer.Add(',');
+		}
+		bHasElements = true;
+	}
+}
+
+void FMCPJsonWriter::AppendAscii(const ANSICHAR* Text, int32 Len)
+{
+	Buffer.Append(reinterpret_cast<const uint8*>(Text), Len);
+}
+
+void FMCPJsonWriter::BeginObject()
+{
+	BeginValue();
+	Buffer.Add('{');
+	Scopes.Add(false);
+}
+
+void FMCPJsonWriter::EndObject()
+{
+	check(Scopes.Num() > 0 && !bAfterKey);
+	Scopes.Pop(EAllowShrinking::No);
+	Buffer.Add('}');
+}
+
+void FMCPJsonWriter::BeginArray()
+{
+	BeginValue();
+	Buffer.Add('[');
+	Scopes.Add(false);
+}
+
+void FMCPJsonWriter::EndArray()
+{
+	check(Scopes.Num() > 0 && !bAfterKey);
+	Scopes.Pop(EAllowShrinking::No);
+	Buffer.Add(']');
+}
+
+void FMCPJsonWriter::WriteKey(const TCHAR* Key)
+{
+	check(!bAfterKey);
+	BeginValue();
+	WriteEscaped(Key, FCString::Strlen(Key));
+	Buffer.Add(':');
+	bAfterKey = true;
+}
+
+void FMCPJsonWriter::WriteKey(const FMCPJsonKey& Key)
+{
+	check(!bAfterKey);
+	BeginValue();
+	Buffer.Append(Key.GetEncodedKey(), Key.GetEncodedKeyLen());
+	bAfterKey = true;
+}
+
+void FMCPJsonWriter::WriteEncodedKey(TConstArrayView<uint8> EncodedKey)
+{
+	check(!bAfterKey);
+	BeginValue();
+	Buffer.Append(EncodedKey.GetData(), EncodedKey.Num());
+	bAfterKey = true;
+}
+
+void FMCPJsonWriter::AppendArrayElements(const FMCPJsonWriter& Elements)
+{
+	check(Elements.IsComplete() && Elements.Buffer.Num() >= 2 && Elements.Buffer[0] == '[');
+	check(Scopes.Num() > 0 && !bAfterKey);
+	const int32 InnerLen = Elements.Buffer.Num() - 2;
+	if (InnerLen == 0)
+	{
+		return;
+	}
+	BeginValue();
+	Buffer.Append(Elements.Buffer.GetData() + 1, InnerLen);
+}
+
+TArray<uint8> FMCPJsonWriter::EncodeKey(const TCHAR* Key)
+{
+	FMCPJsonWriter KeyWriter;
+	KeyWriter.WriteEscaped(Key, FCString::Strlen(Key));
+	KeyWriter.Buffer.Add(':');
+	return KeyWriter.MoveBuffer();
+}
+
+void FMCPJsonWriter::WriteValue(const TCHAR* Value)
+{
+	BeginValue();
+	WriteEscaped(Value, FCString::Strlen(Value));
+}
+
+void FMCPJsonWriter::WriteValue(FUtf8StringView Value)
+{
+	BeginValue();
+	Buffer.Add('"');
+	const uint8* Data = reinterpret_cast<const uint8*>(Value.GetData());
+	const int32 Len = Value.Len();
+	int32 RunStart = 0;
+	for (int32 Index = 0; Index < Len; ++Index)
+	{
+		const uint8 Byte = Data[Index];
+		if (Byte == '"' || Byte == '\\' || Byte < 0x20)
+		{
+			Buffer.Append(Data + RunStart, Index - RunStart);
+			if (Byte == '"' || Byte == '\\')
+			{
+				const uint8 Escape[2] = { '\\', Byte };
+				Buffer.Append(Escape, 2);
+			}
+			else
+			{
+				ANSICHAR Escape[8];
+				const int32 EscapeLen = FCStringAnsi::Snprintf(Escape, UE_ARRAY_COUNT(Escape), "\\u%04x", (uint32)Byte);
+				AppendAscii(Escape, EscapeLen);
+			}
+			RunStart = Index + 1;
+		}
+	}
+	Buffer.Append(Data + RunStart, Len - RunStart);
+	Buffer.Add('"');
+}
+
+void FMCPJsonWriter::WriteValue(double Value)
+{
+	BeginValue();
+	if (!FMath::IsFinite(Value))
+	{
+		// JSON has no NaN/Inf
+		AppendAscii("null", 4);
+		return;
+	}
+
+	ANSICHAR Text[32];
+	int32 Len;
+	if (Value == FMath::FloorToDouble(Value) && FMath::Abs(Value) < 9007199254740992.0)
+	{
+		// Integral and exact: same digits %.17g would produce, without the float formatting cost
+		Len = FCStringAnsi::Snprintf(Text, UE_ARRAY_COUNT(Text), "%lld", (long long)Value);
+	}
+	else
+	{
+		// 17 significant digits round-trip any double, matching TJsonWriter
+		Len = FCStringAnsi::Snprintf(Text, UE_ARRAY_COUNT(Text), "%.17g", Value);
+	}
+	AppendAscii(Text, Len);
+}
+
+void FMCPJsonWriter::WriteValue(int64 Value)
+{
+	BeginValue();
+	ANSICHAR Text[24];
+	const int32 Len = FCStringAnsi::Snprintf(Text, UE_ARRAY_COUNT(Text), "%lld", (long long)Value);
+	AppendAscii(Text, Len);
+}
+
+void FMCPJsonWriter::WriteValue(bool Value)
+{
+	BeginValue();
+	if (Value)
+	{
+		AppendAscii("true", 4);
+	}
+	else
+	{
+		AppendAscii("false", 5);
+	}
+}
+
+void FMCPJsonWriter::WriteNull()
+{
+	BeginValue();
+	AppendAscii("null", 4);
+}
+
+void FMCPJsonWriter::WriteValue(const FVector& Value)
+{
+	BeginArray();
+	WriteValue(Value.X);
+	WriteValue(Value.Y);
+	WriteValue(Value.Z);
+	EndArray();
+}
+
+void FMCPJsonWriter::WriteValue(const FRotator& Value)
+{
+	BeginArray();
+	WriteValue(Value.Pitch);
+	WriteValue(Value.Yaw);
+	WriteValue(Value.Roll);
+	EndArray();
+}
+
+void FMCPJsonWriter::WriteValue(const TSharedPtr<FJsonValue>& Value)
+{
+	if (!Value.IsValid())
+	{
+		WriteNull();
+		return;
+	}
+
+	switch (Value->Type)
+	{
+	case EJson::String:
+		WriteValue(Value->AsString());
+		break;
+	case EJson::Number:
+		WriteValue(Value->AsNumber());
+		break;
+	case EJson::Boolean:
+		WriteValue(Value->AsBool());
+		break;
+	case EJson::Array:
+		BeginArray();
+		for (const TSharedPtr<FJsonValue>& Element : Value->AsArray())
+		{
+			WriteValue(Element);
+		}
+		EndArray();
+		break;
+	case EJson::Object:
+		WriteValue(Value->AsObject());
+		break;
+	default:
+		WriteNull();
+		break;
+	}
+}
+
+void FMCPJsonWriter::WriteValue(const TSharedPtr<FJsonObject>& Value)
+{
+	if (!Value.IsValid())
+	{
+		WriteNull();
+		return;
+	}
+
+	BeginObject();
+	for (const TPair<FString, TSharedPtr<FJsonValue>>& Pair : Value->Values)
+	{
+		WriteKey(*Pair.Key);
+		WriteValue(Pair.Value);
+	}
+	EndObject();
+}
+
+void FMCPJsonWriter::WriteEscaped(const TCHAR* Text, int32 Len)
+{
+	Buffer.Add('"');
+
+	int32 Index = 0;
+	while (Index < Len)
+	{
+		const int32 ChunkEnd = FMath::Min(Len, Index + MCPEscapeChunk);
+		const int32 OldNum = Buffer.Num();
+		// +1 TCHAR of slack: a surrogate pair may straddle the chunk boundary
+		Buffer.AddUninitialized((ChunkEnd - Index + 1) * MCPMaxBytesPerChar);
+		uint8* Out = Buffer.GetData() + OldNum;
+
+		while (Index < ChunkEnd)
+		{
+			uint32 CodePoint = (uint32)Text[Index++];
+			if (CodePoint < 0x80)
+			{
+				switch (CodePoint)
+				{
+				case '"':  *Out++ = '\\'; *Out++ = '"'; break;
+				case '\\': *Out++ = '\\'; *Out++ = '\\'; break;
+				case '\n': *Out++ = '\\'; *Out++ = 'n'; break;
+				case '\r': *Out++ = '\\'; *Out++ = 'r'; break;
+				case '\t': *Out++ = '\\'; *Out++ = 't'; break;
+				case '\b': *Out++ = '\\'; *Out++ = 'b'; break;
+				case '\f': *Out++ = '\\'; *Out++ = 'f'; break;
+				default:
+					if (CodePoint < 0x20)
+					{
+						static const ANSICHAR HexDigits[] = "0123456789abcdef";
+						*Out++ = '\\'; *Out++ = 'u'; *Out++ = '0'; *Out++ = '0';
+						*Out++ = HexDigits[CodePoint >> 4];
+						*Out++ = HexDigits[CodePoint & 0xF];
+					}
+					else
+					{
+						*Out++ = (uint8)CodePoint;
+					}
+					break;
+				}
+				continue;
+			}
+
+			// UTF-16 surrogate pairs (TCHAR is 16-bit on most platforms)
+			if (CodePoint >= 0xD800 && CodePoint <= 0xDBFF)
+			{
+				const uint32 Low = Index < Len ? (uint32)Text[Index] : 0;
+				if (Low >= 0xDC00 && Low <= 0xDFFF)
+				{
+					CodePoint = 0x10000 + ((CodePoint - 0xD800) << 10) + (Low - 0xDC00);
+					++Index;
+				}
+				else
+				{
+					CodePoint = 0xFFFD;
+				}
+			}
+			else if ((CodePoint >= 0xDC00 && CodePoint <= 0xDFFF) || CodePoint > 0x10FFFF)
+			{
+				CodePoint = 0xFFFD;
+			}
+
+			if (CodePoint < 0x800)
+			{
+				*Out++ = (uint8)(0xC0 | (CodePoint >> 6));
+				*Out++ = (uint8)(0x80 | (CodePoint & 0x3F));
+			}
+			else if (CodePoint < 0x10000)
+			{
+				*Out++ = (uint8)(0xE0 | (CodePoint >> 12));
+				*Out++ = (uint8)(0x80 | ((CodePoint >> 6) & 0x3F));
+				*Out++ = (uint8)(0x80 | (CodePoint & 0x3F));
+			}
+			else
+			{
+				*Out++ = (uint8)(0xF0 | (CodePoint >> 18));
+				*Out++ = (uint8)(0x80 | ((CodePoint >> 12) & 0x3F));
+				*Out++ = (uint8)(0x80 | ((CodePoint >> 6) & 0x3F));
+				*Out++ = (uint8)(0x80 | (CodePoint & 0x3F));
+			}
+		}
+
+		Buffer.SetNum((int32)(Out - Buffer.GetData()), EAllowShrinking::No);
+	}
+
+	Buffer.Add('"');
+}
+
+TArray<uint8> FMCPJsonWriter::MoveBuffer()
+{
+	TArray<uint8> Result = MoveTemp(Buffer);
+	Reset();
+	return Result;
+}
+
+void FMCPJsonWriter::Reset()
+{
+	Buffer.Reset();
+	Scopes.Reset();
+	bAfterKey = false;
+}
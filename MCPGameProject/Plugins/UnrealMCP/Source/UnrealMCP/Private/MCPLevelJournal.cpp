@@ -0,0 +1,253 @@
+#include "MCPLevelJournal.h"
+#include "Components/ActorComponent.h"
+#include "Components/SceneComponent.h"
+#include "Editor.h"
+#include "Engine/Level.h"
+#include "GameFramework/Actor.h"
+#include "Misc/CoreDelegates.h"
+#include "Misc/Guid.h"
+#include "UObject/UObjectGlobals.h"
+
+namespace
+{
+	bool IsJournaledWorld(const UWorld* World)
+	{
+		return World && (World->WorldType == EWorldType::Editor || World->WorldType == EWorldType::PIE);
+	}
+
+	bool IsTransformProperty(FName PropertyName)
+	{
+		return PropertyName == USceneComponent::GetRelativeLocationPropertyName()
+			|| PropertyName == USceneComponent::GetRelativeRotationPropertyName()
+			|| PropertyName == USceneComponent::GetRelativeScale3DPropertyName();
+	}
+}
+
+FMCPLevelJournal& FMCPLevelJournal::Get()
+{
+	static FMCPLevelJournal Instance;
+	return Instance;
+}
+
+void FMCPLevelJournal::Initialize(int32 InCapacity)
+{
+	if (bInitialized || !GEngine)
+	{
+		return;
+	}
+	bInitialized = true;
+
+	Capacity = FMath::Max(0, InCapacity);
+	Ring.Reset(Capacity);
+	Head = 0;
+	JournalId = FGuid::NewGuid().ToString(EGuidFormats::DigitsLower);
+
+	ActorAddedHandle = GEngine->OnLevelActorAdded().AddRaw(this, &FMCPLevelJournal::OnActorAdded);
+	ActorDeletedHandle = GEngine->OnLevelActorDeleted().AddRaw(this, &FMCPLevelJournal::OnActorDeleted);
+	ActorMovedHandle = GEngine->OnActorMoved().AddRaw(this, &FMCPLevelJournal::OnActorMoved);
+	LabelChangedHandle = FCoreDelegates::OnActorLabelChanged.AddRaw(this, &FMCPLevelJournal::OnActorLabelChanged);
+	ObjectRenamedHandle = FCoreUObjectDelegates::OnObjectRenamed.AddRaw(this, &FMCPLevelJournal::OnObjectRenamed);
+	PropertyChangedHandle = FCoreUObjectDelegates::OnObjectPropertyChanged.AddRaw(this, &FMCPLevelJournal::OnObjectPropertyChanged);
+	WorldInitHandle = FWorldDelegates::OnPostWorldInitialization.AddRaw(this, &FMCPLevelJournal::OnWorldInitialized);
+	LevelAddedHandle = FWorldDelegates::LevelAddedToWorld.AddRaw(this, &FMCPLevelJournal::OnLevelChanged);
+	LevelRemovedHandle = FWorldDelegates::LevelRemovedFromWorld.AddRaw(this, &FMCPLevelJournal::OnLevelChanged);
+	WorldCleanupHandle = FWorldDelegates::OnWorldCleanup.AddRaw(this, &FMCPLevelJournal::OnWorldCleanup);
+	UndoRedoHandle = FEditorDelegates::PostUndoRedo.AddRaw(this, &FMCPLevelJournal::OnUndoRedo);
+}
+
+void FMCPLevelJournal::Shutdown()
+{
+	if (!bInitialized)
+	{
+		return;
+	}
+	bInitialized = false;
+
+	if (GEngine)
+	{
+		GEngine->OnLevelActorAdded().Remove(ActorAddedHandle);
+		GEngine->OnLevelActorDeleted().Remove(ActorDeletedHandle);
+		GEngine->OnActorMoved().Remove(ActorMovedHandle);
+	}
+	FCoreDelegates::OnActorLabelChanged.Remove(LabelChangedHandle);
+	FCoreUObjectDelegates::OnObjectRenamed.Remove(ObjectRenamedHandle);
+	FCoreUObjectDelegates::OnObjectPropertyChanged.Remove(PropertyChangedHandle);
+	FWorldDelegates::OnPostWorldInitialization.Remove(WorldInitHandle);
+	FWorldDelegates::LevelAddedToWorld.Remove(LevelAddedHandle);
+	FWorldDelegates::LevelRemovedFromWorld.Remove(LevelRemovedHandle);
+	FWorldDelegates::OnWorldCleanup.Remove(WorldCleanupHandle);
+	FEditorDelegates::PostUndoRedo.Remove(UndoRedoHandle);
+
+	Ring.Empty();
+	Head = 0;
+}
+
+bool FMCPLevelJournal::GetChangesSince(UWorld* World, int64 SinceVersion, TArray<const FChange*>& OutChanges) const
+{
+	OutChanges.Reset();
+	if (Capacity == 0 || SinceVersion > Version || SinceVersion < DroppedVersion || SinceVersion < EpochVersion)
+	{
+		return false;
+	}
+
+	// Oldest entry is at Head once the ring is full, at 0 before that
+	const int32 Num = Ring.Num();
+	const int32 Start = Num < Capacity ? 0 : Head;
+	const TObjectKey<UWorld> WorldKey(World);
+	for (int32 Offset = 0; Offset < Num; ++Offset)
+	{
+		const FChange& Change = Ring[(Start + Offset) % Num];
+		if (Change.Version > SinceVersion && Change.World == WorldKey)
+		{
+			OutChanges.Add(&Change);
+		}
+	}
+	return true;
+}
+
+void FMCPLevelJournal::Record(EMCPLevelChange Type, AActor* Actor, const FString& Detail)
+{
+	if (Capacity == 0 || !IsJournaled(Actor))
+	{
+		return;
+	}
+
+	++Version;
+
+	// Repeats of the newest change (a drag, a slider, a label set during spawn) just move it forward
+	if (Ring.Num() > 0)
+	{
+		FChange& Newest = Ring[(Head + Ring.Num() - 1) % Ring.Num()];
+		if (Newest.Type == Type && Newest.ActorKey == TObjectKey<AActor>(Actor)
+			&& (Type != EMCPLevelChange::Property || Newest.Detail == Detail))
+		{
+			Newest.Version = Version;
+			Newest.Label = Actor->GetActorLabel();
+			return;
+		}
+	}
+
+	FChange Change;
+	Change.Version = Version;
+	Change.Type = Type;
+	Change.World = Actor->GetWorld();
+	Change.ActorKey = Actor;
+	Change.Actor = Actor;
+	Change.Name = Actor->GetName();
+	Change.Label = Actor->GetActorLabel();
+	Change.Detail = Detail;
+
+	if (Ring.Num() < Capacity)
+	{
+		Ring.Add(MoveTemp(Change));
+		Head = Ring.Num() % Capacity;
+	}
+	else
+	{
+		DroppedVersion = Ring[Head].Version;
+		Ring[Head] = MoveTemp(Change);
+		Head = (Head + 1) % Capacity;
+	}
+}
+
+void FMCPLevelJournal::StartEpoch()
+{
+	// The ring is kept: it still answers clients that have not fallen behind the epoch
+	EpochVersion = ++Version;
+}
+
+bool FMCPLevelJournal::IsJournaled(const AActor* Actor)
+{
+	return Actor && !Actor->IsTemplate() && !Actor->HasAnyFlags(RF_Transient) && IsJournaledWorld(Actor->GetWorld());
+}
+
+void FMCPLevelJournal::OnActorAdded(AActor* Actor)
+{
+	Record(EMCPLevelChange::Added, Actor);
+}
+
+void FMCPLevelJournal::OnActorDeleted(AActor* Actor)
+{
+	Record(EMCPLevelChange::Removed, Actor);
+}
+
+void FMCPLevelJournal::OnActorMoved(AActor* Actor)
+{
+	Record(EMCPLevelChange::Transform, Actor);
+}
+
+void FMCPLevelJournal::OnActorLabelChanged(AActor* Actor)
+{
+	Record(EMCPLevelChange::Renamed, Actor);
+}
+
+void FMCPLevelJournal::OnObjectRenamed(UObject* Object, UObject* OldOuter, FName OldName)
+{
+	if (AActor* Actor = Cast<AActor>(Object))
+	{
+		Record(EMCPLevelChange::Renamed, Actor, OldName.ToString());
+	}
+}
+
+void FMCPLevelJournal::OnObjectPropertyChanged(UObject* Object, FPropertyChangedEvent& Event)
+{
+	// Interactive changes (slider drags) are followed by a final ValueSet
+	if (!Object || Event.ChangeType == EPropertyChangeType::Interactive)
+	{
+		return;
+	}
+
+	AActor* Actor = Cast<AActor>(Object);
+	if (!Actor)
+	{
+		if (UActorComponent* Component = Cast<UActorComponent>(Object))
+		{
+			Actor = Component->GetOwner();
+		}
+	}
+	if (!Actor)
+	{
+		return;
+	}
+
+	const FName PropertyName = Event.GetMemberPropertyName();
+	if (IsTransformProperty(PropertyName))
+	{
+		Record(EMCPLevelChange::Transform, Actor);
+	}
+	else
+	{
+		Record(EMCPLevelChange::Property, Actor, PropertyName.ToString());
+	}
+}
+
+void FMCPLevelJournal::OnWorldInitialized(UWorld* World, const UWorld::InitializationValues Values)
+{
+	if (IsJournaledWorld(World))
+	{
+		StartEpoch();
+	}
+}
+
+void FMCPLevelJournal::OnLevelChanged(ULevel* Level, UWorld* World)
+{
+	// Streamed levels bring in actors without per-actor notifications
+	if (IsJournaledWorld(World))
+	{
+		StartEpoch();
+	}
+}
+
+void FMCPLevelJournal::OnWorldCleanup(UWorld* World, bool bSessionEnded, bool bCleanupResources)
+{
+	if (IsJournaledWorld(World))
+	{
+		StartEpoch();
+	}
+}
+
+void FMCPLevelJournal::OnUndoRedo()
+{
+	// Undo can restore or remove actors without the added/deleted broadcasts
+	StartEpoch();
+}
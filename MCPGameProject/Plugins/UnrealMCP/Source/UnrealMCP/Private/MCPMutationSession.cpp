@@ -0,0 +1,367 @@
+#include "MCPMutationSession.h"
+#include "MCPClientConnection.h"
+#include "MCPWorldResolver.h"
+#include "Editor.h"
+#include "Editor/Transactor.h"
+#include "Editor/TransBuffer.h"
+#include "Framework/Application/IInputProcessor.h"
+#include "Framework/Application/SlateApplication.h"
+#include "Misc/Guid.h"
+#include "UObject/UObjectGlobals.h"
+
+namespace MCPMutationSessionPrivate
+{
+	/** Sees user input before Slate routes it, so a gizmo drag or details edit starts after the session transaction closed. */
+	class FInputWatcher : public IInputProcessor
+	{
+	public:
+		explicit FInputWatcher(TFunction<void()> InOnInput) : OnInput(MoveTemp(InOnInput)) {}
+
+		virtual void Tick(const float DeltaTime, FSlateApplication& SlateApp, TSharedRef<ICursor> Cursor) override {}
+
+		virtual bool HandleKeyDownEvent(FSlateApplication& SlateApp, const FKeyEvent& InKeyEvent) override
+		{
+			OnInput();
+			return false;
+		}
+
+		virtual bool HandleMouseButtonDownEvent(FSlateApplication& SlateApp, const FPointerEvent& MouseEvent) override
+		{
+			OnInput();
+			return false;
+		}
+
+		virtual const TCHAR* GetDebugName() const override { return TEXT("MCPMutationSessions"); }
+
+	private:
+		TFunction<void()> OnInput;
+	};
+}
+
+FMCPMutationSessions& FMCPMutationSessions::Get()
+{
+	static FMCPMutationSessions Instance;
+	return Instance;
+}
+
+void FMCPMutationSessions::Initialize(int64 InMaxUndoBytes, double InDefaultIdleSeconds)
+{
+	if (bInitialized)
+	{
+		return;
+	}
+	bInitialized = true;
+
+	MaxUndoBytes = FMath::Max<int64>(1, InMaxUndoBytes);
+	DefaultIdleSeconds = FMath::Max(0.1, InDefaultIdleSeconds);
+
+	TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FMCPMutationSessions::Tick), 0.25f);
+
+	// These reset or take over the undo buffer, which must not happen with a transaction open
+	PreBeginPIEHandle = FEditorDelegates::PreBeginPIE.AddRaw(this, &FMCPMutationSessions::OnPreBeginPIE);
+	MapLoadHandle = FEditorDelegates::OnMapLoad.AddLambda([this](const FString& Filename, FCanLoadMap& OutCanLoadMap)
+	{
+		CloseTransaction();
+	});
+	AssetsPreDeleteHandle = FEditorDelegates::OnAssetsPreDelete.AddRaw(this, &FMCPMutationSessions::OnAssetsPreDelete);
+
+	// Edits made by hand between session commands must not be recorded into the session's transaction
+	ObjectModifiedHandle = FCoreUObjectDelegates::OnObjectModified.AddRaw(this, &FMCPMutationSessions::OnObjectModified);
+	ObjectPropertyChangedHandle = FCoreUObjectDelegates::OnObjectPropertyChanged.AddRaw(this, &FMCPMutationSessions::OnObjectPropertyChanged);
+	if (FSlateApplication::IsInitialized())
+	{
+		InputWatcher = MakeShared<MCPMutationSessionPrivate::FInputWatcher>([this]() { OnOutsideEdit(); });
+		FSlateApplication::Get().RegisterInputPreProcessor(InputWatcher);
+	}
+}
+
+void FMCPMutationSessions::Shutdown()
+{
+	if (!bInitialized)
+	{
+		return;
+	}
+	bInitialized = false;
+
+	EndSession(TEXT("shutdown"));
+
+	FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+	FEditorDelegates::PreBeginPIE.Remove(PreBeginPIEHandle);
+	FEditorDelegates::OnMapLoad.Remove(MapLoadHandle);
+	FEditorDelegates::OnAssetsPreDelete.Remove(AssetsPreDeleteHandle);
+	FCoreUObjectDelegates::OnObjectModified.Remove(ObjectModifiedHandle);
+	FCoreUObjectDelegates::OnObjectPropertyChanged.Remove(ObjectPropertyChangedHandle);
+	if (InputWatcher.IsValid() && FSlateApplication::IsInitialized())
+	{
+		FSlateApplication::Get().UnregisterInputPreProcessor(InputWatcher);
+	}
+	InputWatcher.Reset();
+}
+
+bool FMCPMutationSessions::Begin(const FString& Name, double IdleSeconds, const TSharedPtr<FMCPClientConnection, ESPMode::ThreadSafe>& Owner,
+	FString& OutSessionId, FString& OutError)
+{
+	check(IsInGameThread());
+	if (Session.IsSet())
+	{
+		OutError = FString::Printf(TEXT("Mutation session '%s' is already open; end it first"), *Session->Name);
+		return false;
+	}
+	if (!GEditor || !GEditor->Trans)
+	{
+		OutError = TEXT("Mutation sessions need the editor transaction buffer");
+		return false;
+	}
+
+	FSession& NewSession = Session.Emplace();
+	NewSession.Id = FGuid::NewGuid().ToString(EGuidFormats::DigitsLower);
+	NewSession.Name = Name;
+	NewSession.Owner = Owner;
+	NewSession.IdleSeconds = IdleSeconds > 0.0 ? IdleSeconds : DefaultIdleSeconds;
+	NewSession.StartTime = NewSession.LastActivity = FPlatformTime::Seconds();
+	NewSession.Stats.Name = Name;
+
+	UE_LOG(LogTemp, Display, TEXT("MCPMutationSessions: Began '%s' (%s, idle %.1fs)"), *Name, *NewSession.Id, NewSession.IdleSeconds);
+	OutSessionId = NewSession.Id;
+	return true;
+}
+
+bool FMCPMutationSessions::End(const FString& SessionId, const FMCPClientConnection* Origin, FMCPMutationSessionStats& OutStats, FString& OutError)
+{
+	check(IsInGameThread());
+	if (!IsMember(SessionId, Origin))
+	{
+		OutError = SessionId.IsEmpty()
+			? FString(TEXT("No mutation session is open on this connection"))
+			: FString::Printf(TEXT("No open mutation session: %s"), *SessionId);
+		return false;
+	}
+
+	CloseTransaction();
+	OutStats = Session->Stats;
+	OutStats.DurationSeconds = FPlatformTime::Seconds() - Session->StartTime;
+	EndSession(TEXT("ended"));
+	return true;
+}
+
+void FMCPMutationSessions::BeginCommand(const FString& CommandType, const FString& SessionId, const FMCPClientConnection* Origin)
+{
+	bInCommand = false;
+	bOpenedByCommand = false;
+	if (!Session.IsSet())
+	{
+		return;
+	}
+
+	if (!IsMember(SessionId, Origin) || IsBarrier(CommandType))
+	{
+		CloseTransaction();
+		return;
+	}
+
+	bInCommand = true;
+	Session->Stats.Commands++;
+	if (TransactionIndex == INDEX_NONE)
+	{
+		OpenTransaction();
+		bOpenedByCommand = TransactionIndex != INDEX_NONE;
+	}
+}
+
+void FMCPMutationSessions::EndCommand()
+{
+	if (!bInCommand || !Session.IsSet())
+	{
+		bInCommand = false;
+		return;
+	}
+	bInCommand = false;
+	Session->LastActivity = FPlatformTime::Seconds();
+
+	if (TransactionIndex == INDEX_NONE)
+	{
+		return;
+	}
+
+	const int64 BufferBytes = GetUndoBufferBytes();
+	if (BufferBytes >= MaxUndoBytes)
+	{
+		// Old entries can only be dropped once the open transaction is finished
+		UE_LOG(LogTemp, Display, TEXT("MCPMutationSessions: '%s' reached the undo cap (%lld bytes in the undo buffer); starting a new transaction"),
+			*Session->Name, BufferBytes);
+		CloseTransaction();
+		TrimUndoBuffer();
+	}
+	else if (bOpenedByCommand && GetOpenTransactionBytes() == 0)
+	{
+		// A read between mutations should not leave an empty undo entry behind
+		CloseTransaction();
+	}
+	bOpenedByCommand = false;
+}
+
+bool FMCPMutationSessions::IsBarrier(const FString& CommandType)
+{
+	static const TSet<FString> BarrierCommands = {
+		TEXT("new_level"),
+		TEXT("load_level"),
+		TEXT("play_in_editor"),
+		TEXT("stop_play_in_editor"),
+		TEXT("execute_console_command"),
+		TEXT("execute_python"),
+		TEXT("build_lighting"),
+		TEXT("delete_asset_file"),
+		TEXT("rename_asset"),
+		TEXT("import_asset"),
+		TEXT("begin_mutation_session"),
+		TEXT("end_mutation_session")
+	};
+	return BarrierCommands.Contains(CommandType);
+}
+
+bool FMCPMutationSessions::IsMember(const FString& SessionId, const FMCPClientConnection* Origin) const
+{
+	if (!Session.IsSet())
+	{
+		return false;
+	}
+	if (!SessionId.IsEmpty())
+	{
+		return SessionId == Session->Id;
+	}
+	return Origin && Session->Owner.Pin().Get() == Origin;
+}
+
+void FMCPMutationSessions::OpenTransaction()
+{
+	if (!GEditor || !GEditor->Trans || FMCPWorldResolver::Get().GetPIEWorld())
+	{
+		return;
+	}
+
+	const int32 Part = Session->Stats.Transactions + 1;
+	const FText Description = Part == 1
+		? FText::FromString(Session->Name)
+		: FText::FromString(FString::Printf(TEXT("%s (%d)"), *Session->Name, Part));
+	TransactionIndex = GEditor->BeginTransaction(TEXT("UnrealMCP"), Description, nullptr);
+	Session->Stats.Transactions++;
+}
+
+void FMCPMutationSessions::CloseTransaction()
+{
+	if (TransactionIndex == INDEX_NONE)
+	{
+		return;
+	}
+
+	const int64 Bytes = GetOpenTransactionBytes();
+	if (Bytes == 0)
+	{
+		GEditor->CancelTransaction(TransactionIndex);
+		if (Session.IsSet())
+		{
+			Session->Stats.Transactions--;
+		}
+	}
+	else
+	{
+		GEditor->EndTransaction();
+		if (Session.IsSet())
+		{
+			Session->Stats.UndoBytes += Bytes;
+		}
+	}
+	TransactionIndex = INDEX_NONE;
+	bOpenedByCommand = false;
+}
+
+int64 FMCPMutationSessions::GetOpenTransactionBytes() const
+{
+	const UTransactor* Trans = GEditor ? GEditor->Trans.Get() : nullptr;
+	if (!Trans || TransactionIndex == INDEX_NONE || TransactionIndex >= Trans->GetQueueLength())
+	{
+		return 0;
+	}
+	const FTransaction* Transaction = Trans->GetTransaction(TransactionIndex);
+	return Transaction ? static_cast<int64>(Transaction->DataSize()) : 0;
+}
+
+int64 FMCPMutationSessions::GetUndoBufferBytes() const
+{
+	const UTransBuffer* TransBuffer = GEditor ? Cast<UTransBuffer>(GEditor->Trans) : nullptr;
+	return TransBuffer ? static_cast<int64>(TransBuffer->GetUndoSize()) : GetOpenTransactionBytes();
+}
+
+void FMCPMutationSessions::TrimUndoBuffer()
+{
+	UTransBuffer* TransBuffer = GEditor ? Cast<UTransBuffer>(GEditor->Trans) : nullptr;
+	if (!TransBuffer || TransactionIndex != INDEX_NONE || TransBuffer->IsActive())
+	{
+		return;
+	}
+
+	// Same purge the engine applies against its own limit: oldest first, never the redo tail or the newest entry
+	int32 Dropped = 0;
+	while (static_cast<int64>(TransBuffer->GetUndoSize()) > MaxUndoBytes
+		&& TransBuffer->UndoBuffer.Num() - TransBuffer->UndoCount > 1)
+	{
+		TransBuffer->UndoBuffer.RemoveAt(0);
+		++Dropped;
+	}
+	if (Dropped > 0)
+	{
+		UE_LOG(LogTemp, Display, TEXT("MCPMutationSessions: Dropped the %d oldest undo entries to stay under %lld bytes"), Dropped, MaxUndoBytes);
+		TransBuffer->OnUndoBufferChanged().Broadcast();
+	}
+}
+
+void FMCPMutationSessions::EndSession(const TCHAR* Reason)
+{
+	if (!Session.IsSet())
+	{
+		return;
+	}
+
+	CloseTransaction();
+	UE_LOG(LogTemp, Display, TEXT("MCPMutationSessions: '%s' %s after %d commands in %d transactions (%lld undo bytes)"),
+		*Session->Name, Reason, Session->Stats.Commands, Session->Stats.Transactions, Session->Stats.UndoBytes);
+	Session.Reset();
+}
+
+bool FMCPMutationSessions::Tick(float DeltaTime)
+{
+	if (Session.IsSet() && FPlatformTime::Seconds() - Session->LastActivity > Session->IdleSeconds)
+	{
+		EndSession(TEXT("went idle"));
+	}
+	return true;
+}
+
+void FMCPMutationSessions::OnPreBeginPIE(bool bIsSimulating)
+{
+	CloseTransaction();
+}
+
+void FMCPMutationSessions::OnAssetsPreDelete(const TArray<UObject*>& Objects)
+{
+	CloseTransaction();
+}
+
+void FMCPMutationSessions::OnOutsideEdit()
+{
+	// Session commands modify objects too; only edits between them belong to someone else
+	if (!bInCommand && TransactionIndex != INDEX_NONE && !GIsTransacting)
+	{
+		CloseTransaction();
+	}
+}
+
+void FMCPMutationSessions::OnObjectModified(UObject* Object)
+{
+	OnOutsideEdit();
+}
+
+void FMCPMutationSessions::OnObjectPropertyChanged(UObject* Object, FPropertyChangedEvent& Event)
+{
+	OnOutsideEdit();
+}
@@ -0,0 +1,419 @@
+#include "MCPPawnControl.h"
+#include "MCPClientConnection.h"
+#include "MCPFrameScanner.h"
+#include "Editor.h"
+#include "Engine/World.h"
+#include "GameFramework/Character.h"
+#include "GameFramework/Controller.h"
+#include "GameFramework/Pawn.h"
+#include "Tasks/Task.h"
+
+static_assert(PLATFORM_LITTLE_ENDIAN, "The binary frame layout is little-endian and copied as-is");
+
+namespace
+{
+	constexpr int32 AckPayloadBytes = 44;
+
+	template <typename T>
+	T ReadLE(const uint8*& Cursor)
+	{
+		T Value;
+		FMemory::Memcpy(&Value, Cursor, sizeof(T));
+		Cursor += sizeof(T);
+		return Value;
+	}
+
+	template <typename T>
+	void AppendLE(TArray<uint8>& Out, T Value)
+	{
+		Out.Append(reinterpret_cast<const uint8*>(&Value), sizeof(T));
+	}
+}
+
+bool FMCPPawnInput::Decode(const uint8* Payload, int32 Num, FMCPPawnInput& OutInput)
+{
+	if (Num != PayloadBytes)
+	{
+		return false;
+	}
+
+	const uint8* Cursor = Payload;
+	OutInput.Channel = ReadLE<uint16>(Cursor);
+	OutInput.Buttons = static_cast<EMCPPawnButtons>(ReadLE<uint16>(Cursor));
+	OutInput.Sequence = ReadLE<uint32>(Cursor);
+	OutInput.Move.X = ReadLE<float>(Cursor);
+	OutInput.Move.Y = ReadLE<float>(Cursor);
+	OutInput.Move.Z = ReadLE<float>(Cursor);
+	OutInput.YawRate = ReadLE<float>(Cursor);
+	OutInput.PitchRate = ReadLE<float>(Cursor);
+	OutInput.TtlMs = ReadLE<uint16>(Cursor);
+
+	// NaN input would poison the pawn's transform
+	return !OutInput.Move.ContainsNaN() && FMath::IsFinite(OutInput.YawRate) && FMath::IsFinite(OutInput.PitchRate);
+}
+
+FMCPPawnControl& FMCPPawnControl::Get()
+{
+	static FMCPPawnControl Instance;
+	return Instance;
+}
+
+void FMCPPawnControl::Initialize()
+{
+	if (bInitialized)
+	{
+		return;
+	}
+	bInitialized = true;
+
+	WorldTickStartHandle = FWorldDelegates::OnWorldTickStart.AddRaw(this, &FMCPPawnControl::OnWorldTickStart);
+	EndPIEHandle = FEditorDelegates::EndPIE.AddRaw(this, &FMCPPawnControl::OnEndPIE);
+}
+
+void FMCPPawnControl::Shutdown()
+{
+	if (!bInitialized)
+	{
+		return;
+	}
+	bInitialized = false;
+
+	FWorldDelegates::OnWorldTickStart.Remove(WorldTickStartHandle);
+	FEditorDelegates::EndPIE.Remove(EndPIEHandle);
+
+	// Ack tasks hold their channel and connection and never wait on the socket, so nothing to join
+	FScopeLock ScopeLock(&Lock);
+	Channels.Empty();
+}
+
+uint16 FMCPPawnControl::Open(APawn* Pawn, const TSharedPtr<FMCPClientConnection, ESPMode::ThreadSafe>& Connection, uint16 DefaultTtlMs)
+{
+	check(IsInGameThread());
+	FScopeLock ScopeLock(&Lock);
+
+	// Ids wrap; 0 is never handed out so a zeroed frame cannot drive anything
+	uint16 Id = NextChannelId;
+	while (Id == 0 || Channels.Contains(Id))
+	{
+		++Id;
+	}
+	NextChannelId = Id + 1;
+
+	TSharedRef<FChannel, ESPMode::ThreadSafe> Channel = MakeShared<FChannel, ESPMode::ThreadSafe>();
+	Channel->Id = Id;
+	Channel->Pawn = Pawn;
+	Channel->Connection = Connection;
+	Channel->ConnectionKey = Connection.Get();
+	Channel->DefaultTtlMs = DefaultTtlMs;
+	Channels.Add(Id, Channel);
+
+	UE_LOG(LogTemp, Display, TEXT("MCPPawnControl: Opened channel %d for %s on connection %d (ttl %d ms)"),
+		Id, *Pawn->GetName(), Connection->GetConnectionId(), DefaultTtlMs);
+	return Id;
+}
+
+bool FMCPPawnControl::Close(uint16 Channel, FMCPPawnControlStats& OutStats)
+{
+	check(IsInGameThread());
+	TSharedPtr<FChannel, ESPMode::ThreadSafe> Closed;
+	{
+		FScopeLock ScopeLock(&Lock);
+		const TSharedRef<FChannel, ESPMode::ThreadSafe>* Found = Channels.Find(Channel);
+		if (!Found)
+		{
+			return false;
+		}
+		Closed = *Found;
+		Channels.Remove(Channel);
+		OutStats = Closed->Stats;
+		OutStats.AcksDropped = Closed->AcksDropped.load();
+	}
+
+	// Let go of anything the agent was holding
+	if (APawn* Pawn = Closed->Pawn.Get())
+	{
+		if (ACharacter* Character = Cast<ACharacter>(Pawn))
+		{
+			Character->StopJumping();
+			Character->UnCrouch();
+		}
+	}
+
+	UE_LOG(LogTemp, Display, TEXT("MCPPawnControl: Closed channel %d (%d received, %d applied, %d stale, %d superseded)"),
+		Channel, OutStats.Received, OutStats.Applied, OutStats.Stale, OutStats.Superseded);
+	return true;
+}
+
+void FMCPPawnControl::Submit(FMCPClientConnection& Connection, const TArray<uint8>& Frame)
+{
+	if (Frame.Num() < MCPBinaryFrameHeaderBytes + static_cast<int32>(sizeof(uint16))
+		|| static_cast<EMCPBinaryFrameType>(Frame[1]) != EMCPBinaryFrameType::PawnInput)
+	{
+		return;
+	}
+
+	const uint8* Payload = Frame.GetData() + MCPBinaryFrameHeaderBytes;
+	const int32 PayloadNum = Frame.Num() - MCPBinaryFrameHeaderBytes;
+
+	FMCPPawnInput Input;
+	const bool bValid = FMCPPawnInput::Decode(Payload, PayloadNum, Input);
+	const uint16 ChannelId = bValid ? Input.Channel : static_cast<uint16>(Payload[0] | (Payload[1] << 8));
+	Input.ReceivedTime = FPlatformTime::Seconds();
+
+	FScopeLock ScopeLock(&Lock);
+	const TSharedRef<FChannel, ESPMode::ThreadSafe>* Found = Channels.Find(ChannelId);
+
+	// A channel is only driven by the connection that opened it
+	if (!Found || (*Found)->ConnectionKey != &Connection)
+	{
+		return;
+	}
+
+	FChannel& Channel = Found->Get();
+	Channel.Stats.Received++;
+	if (!bValid)
+	{
+		Channel.Stats.Malformed++;
+		return;
+	}
+	if (Channel.bHasSequence && Input.Sequence <= Channel.NewestSequence)
+	{
+		Channel.Stats.Stale++;
+		return;
+	}
+	if (Channel.Pending.IsSet())
+	{
+		Channel.Stats.Superseded++;
+	}
+
+	Channel.Pending = Input;
+	Channel.NewestSequence = Input.Sequence;
+	Channel.bHasSequence = true;
+}
+
+void FMCPPawnControl::OnWorldTickStart(UWorld* World, ELevelTick TickType, float DeltaSeconds)
+{
+	if (!World || World->WorldType != EWorldType::PIE)
+	{
+		return;
+	}
+
+	struct FTickWork
+	{
+		TSharedRef<FChannel, ESPMode::ThreadSafe> Channel;
+		TSharedPtr<FMCPClientConnection, ESPMode::ThreadSafe> Connection;
+		TOptional<FMCPPawnInput> NewFrame;
+		uint32 Dropped = 0;
+	};
+	TArray<FTickWork> Work;
+
+	{
+		FScopeLock ScopeLock(&Lock);
+		if (Channels.Num() == 0)
+		{
+			return;
+		}
+
+		for (auto It = Channels.CreateIterator(); It; ++It)
+		{
+			FChannel& Channel = It.Value().Get();
+			TSharedPtr<FMCPClientConnection, ESPMode::ThreadSafe> Connection = Channel.Connection.Pin();
+			if (!Connection.IsValid() || Connection->IsClosed())
+			{
+				UE_LOG(LogTemp, Display, TEXT("MCPPawnControl: Dropped channel %d, its connection closed"), Channel.Id);
+				It.RemoveCurrent();
+				continue;
+			}
+
+			APawn* Pawn = Channel.Pawn.Get();
+			if (!Pawn)
+			{
+				// Tell the agent once why its inputs stopped having an effect
+				QueueAck(Channel, 1, Channel.NewestSequence, Channel.Stats.Stale + Channel.Stats.Superseded, nullptr);
+				FlushAck(It.Value(), Connection);
+				UE_LOG(LogTemp, Display, TEXT("MCPPawnControl: Dropped channel %d, its pawn is gone"), Channel.Id);
+				It.RemoveCurrent();
+				continue;
+			}
+			if (Pawn->GetWorld() != World)
+			{
+				continue;
+			}
+
+			FTickWork& Entry = Work.Emplace_GetRef(FTickWork{ It.Value(), Connection });
+			if (Channel.Pending.IsSet())
+			{
+				Entry.NewFrame = MoveTemp(Channel.Pending);
+				Channel.Pending.Reset();
+				Channel.Stats.Applied++;
+			}
+			Entry.Dropped = static_cast<uint32>(Channel.Stats.Stale + Channel.Stats.Superseded);
+		}
+	}
+
+	for (FTickWork& Entry : Work)
+	{
+		FChannel& Channel = Entry.Channel.Get();
+		const bool bNewFrame = Entry.NewFrame.IsSet();
+		if (bNewFrame)
+		{
+			Channel.Current = MoveTemp(Entry.NewFrame);
+		}
+		if (APawn* Pawn = Channel.Pawn.Get())
+		{
+			ApplyInput(Channel, *Pawn, DeltaSeconds, bNewFrame, Entry.Dropped);
+		}
+
+		// Also retries an ack the socket could not take on an earlier tick
+		FlushAck(Entry.Channel, Entry.Connection);
+	}
+}
+
+void FMCPPawnControl::ApplyInput(FChannel& Channel, APawn& Pawn, float DeltaSeconds, bool bNewFrame, uint32 Dropped)
+{
+	if (!Channel.Current.IsSet())
+	{
+		return;
+	}
+
+	// A frame drives the pawn until its ttl runs out, so an agent that stops sending stops its pawn
+	const FMCPPawnInput& Input = Channel.Current.GetValue();
+	const uint16 TtlMs = Input.TtlMs > 0 ? Input.TtlMs : Channel.DefaultTtlMs;
+	const bool bExpired = FPlatformTime::Seconds() - Input.ReceivedTime > TtlMs / 1000.0;
+	const EMCPPawnButtons Buttons = bExpired ? EMCPPawnButtons::None : Input.Buttons;
+
+	if (ACharacter* Character = Cast<ACharacter>(&Pawn))
+	{
+		const EMCPPawnButtons Changed = Buttons ^ Channel.HeldButtons;
+		if (EnumHasAnyFlags(Changed, EMCPPawnButtons::Jump))
+		{
+			if (EnumHasAnyFlags(Buttons, EMCPPawnButtons::Jump))
+			{
+				Character->Jump();
+			}
+			else
+			{
+				Character->StopJumping();
+			}
+		}
+		if (EnumHasAnyFlags(Changed, EMCPPawnButtons::Crouch))
+		{
+			if (EnumHasAnyFlags(Buttons, EMCPPawnButtons::Crouch))
+			{
+				Character->Crouch();
+			}
+			else
+			{
+				Character->UnCrouch();
+			}
+		}
+	}
+	Channel.HeldButtons = Buttons;
+
+	if (bExpired)
+	{
+		Channel.Current.Reset();
+		return;
+	}
+
+	if (!Input.Move.IsNearlyZero())
+	{
+		Pawn.AddMovementInput(FVector(Input.Move));
+	}
+
+	AController* Controller = Pawn.GetController();
+	if (Controller && (Input.YawRate != 0.0f || Input.PitchRate != 0.0f))
+	{
+		FRotator Rotation = Controller->GetControlRotation();
+		Rotation.Yaw = FRotator::NormalizeAxis(Rotation.Yaw + Input.YawRate * DeltaSeconds);
+		Rotation.Pitch = FMath::ClampAngle(Rotation.Pitch + Input.PitchRate * DeltaSeconds, -89.0f, 89.0f);
+		Controller->SetControlRotation(Rotation);
+	}
+
+	if (bNewFrame)
+	{
+		QueueAck(Channel, 0, Input.Sequence, Dropped, &Pawn);
+	}
+}
+
+void FMCPPawnControl::QueueAck(FChannel& Channel, uint16 Status, uint32 Sequence, uint32 Dropped, const APawn* Pawn)
+{
+	const FVector3f Location = Pawn ? FVector3f(Pawn->GetActorLocation()) : FVector3f::ZeroVector;
+	const FVector3f Velocity = Pawn ? FVector3f(Pawn->GetVelocity()) : FVector3f::ZeroVector;
+
+	TArray<uint8> OutAcks;
+	OutAcks.Reserve(MCPBinaryFrameHeaderBytes + AckPayloadBytes);
+	AppendLE<uint8>(OutAcks, MCPBinaryFrameMagic);
+	AppendLE<uint8>(OutAcks, static_cast<uint8>(EMCPBinaryFrameType::PawnInputAck));
+	AppendLE<uint16>(OutAcks, AckPayloadBytes);
+	AppendLE<uint16>(OutAcks, Channel.Id);
+	AppendLE<uint16>(OutAcks, Status);
+	AppendLE<uint32>(OutAcks, Sequence);
+	AppendLE<uint64>(OutAcks, GFrameCounter);
+	AppendLE<uint32>(OutAcks, Dropped);
+	AppendLE<float>(OutAcks, Location.X);
+	AppendLE<float>(OutAcks, Location.Y);
+	AppendLE<float>(OutAcks, Location.Z);
+	AppendLE<float>(OutAcks, Velocity.X);
+	AppendLE<float>(OutAcks, Velocity.Y);
+	AppendLE<float>(OutAcks, Velocity.Z);
+	check(OutAcks.Num() == MCPBinaryFrameHeaderBytes + AckPayloadBytes);
+
+	// Only the newest ack matters to the agent; an older one still waiting is dropped
+	FScopeLock ScopeLock(&Channel.AckLock);
+	if (Channel.PendingAck.Num() > 0)
+	{
+		Channel.AcksDropped++;
+	}
+	Channel.PendingAck = MoveTemp(OutAcks);
+}
+
+void FMCPPawnControl::FlushAck(const TSharedRef<FChannel, ESPMode::ThreadSafe>& Channel, const TSharedPtr<FMCPClientConnection, ESPMode::ThreadSafe>& Connection)
+{
+	{
+		FScopeLock ScopeLock(&Channel->AckLock);
+		if (Channel->PendingAck.Num() == 0)
+		{
+			return;
+		}
+	}
+	if (!Connection.IsValid() || Channel->bAckSending.exchange(true))
+	{
+		return;
+	}
+
+	UE::Tasks::Launch(UE_SOURCE_LOCATION, [Channel, Connection]()
+	{
+		TArray<uint8> Bytes;
+		{
+			FScopeLock ScopeLock(&Channel->AckLock);
+			Bytes = MoveTemp(Channel->PendingAck);
+			Channel->PendingAck.Reset();
+		}
+
+		if (Bytes.Num() > 0 && Connection->TrySendBytes(Bytes.GetData(), Bytes.Num()) == EMCPSendResult::WouldBlock)
+		{
+			// Keep it for the next tick unless a newer ack has already replaced it
+			FScopeLock ScopeLock(&Channel->AckLock);
+			if (Channel->PendingAck.Num() == 0)
+			{
+				Channel->PendingAck = MoveTemp(Bytes);
+			}
+			else
+			{
+				Channel->AcksDropped++;
+			}
+		}
+		Channel->bAckSending.store(false);
+	});
+}
+
+void FMCPPawnControl::OnEndPIE(bool bIsSimulating)
+{
+	FScopeLock ScopeLock(&Lock);
+	if (Channels.Num() > 0)
+	{
+		UE_LOG(LogTemp, Display, TEXT("MCPPawnControl: PIE ended, closing %d channel(s)"), Channels.Num());
+		Channels.Empty();
+	}
+}
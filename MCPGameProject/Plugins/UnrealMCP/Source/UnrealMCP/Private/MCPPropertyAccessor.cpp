@@ -0,0 +1,763 @@
+#include "MCPPropertyAccessor.h"
+#include "Editor.h"
+#include "Engine/Blueprint.h"
+#include "Misc/Paths.h"
+#include "UObject/Class.h"
+#include "UObject/UnrealType.h"
+
+namespace
+{
+	// Beyond this many compiled paths the cache is assumed to be fed generated paths and starts over
+	constexpr int32 MaxCachedAccessors = 4096;
+
+	// Scalar setters
+
+	bool SetBool(FProperty* Property, void* ValueAddr, const TSharedPtr<FJsonValue>& Value, const FString& PropertyName, FString& OutError)
+	{
+		static_cast<FBoolProperty*>(Property)->SetPropertyValue(ValueAddr, Value->AsBool());
+		return true;
+	}
+
+	bool SetInt(FProperty* Property, void* ValueAddr, const TSharedPtr<FJsonValue>& Value, const FString& PropertyName, FString& OutError)
+	{
+		static_cast<FIntProperty*>(Property)->SetPropertyValue(ValueAddr, static_cast<int32>(Value->AsNumber()));
+		return true;
+	}
+
+	bool SetFloat(FProperty* Property, void* ValueAddr, const TSharedPtr<FJsonValue>& Value, const FString& PropertyName, FString& OutError)
+	{
+		static_cast<FFloatProperty*>(Property)->SetPropertyValue(ValueAddr, static_cast<float>(Value->AsNumber()));
+		return true;
+	}
+
+	bool SetDouble(FProperty* Property, void* ValueAddr, const TSharedPtr<FJsonValue>& Value, const FString& PropertyName, FString& OutError)
+	{
+		static_cast<FDoubleProperty*>(Property)->SetPropertyValue(ValueAddr, Value->AsNumber());
+		return true;
+	}
+
+	bool SetString(FProperty* Property, void* ValueAddr, const TSharedPtr<FJsonValue>& Value, const FString& PropertyName, FString& OutError)
+	{
+		static_cast<FStrProperty*>(Property)->SetPropertyValue(ValueAddr, Value->AsString());
+		return true;
+	}
+
+	bool SetName(FProperty* Property, void* ValueAddr, const TSharedPtr<FJsonValue>& Value, const FString& PropertyName, FString& OutError)
+	{
+		static_cast<FNameProperty*>(Property)->SetPropertyValue(ValueAddr, FName(*Value->AsString()));
+		return true;
+	}
+
+	// Enum setters
+
+	/** Resolve a JSON enum value (number, numeric string, "Value" or "EEnum::Value") to its integer value. */
+	bool ResolveEnumValue(const UEnum* EnumDef, const TSharedPtr<FJsonValue>& Value, const FString& PropertyName, int64& OutValue, FString& OutError)
+	{
+		if (Value->Type == EJson::Number)
+		{
+			OutValue = static_cast<int64>(Value->AsNumber());
+			return true;
+		}
+
+		FString EnumValueName = Value->AsString();
+		if (EnumValueName.IsNumeric())
+		{
+			OutValue = FCString::Atoi64(*EnumValueName);
+			return true;
+		}
+
+		// Handle qualified enum names (e.g., "Player0" or "EAutoReceiveInput::Player0")
+		if (EnumValueName.Contains(TEXT("::")))
+		{
+			EnumValueName.Split(TEXT("::"), nullptr, &EnumValueName);
+		}
+
+		OutValue = EnumDef->GetValueByNameString(EnumValueName);
+		if (OutValue == INDEX_NONE)
+		{
+			// Try with full name as fallback
+			OutValue = EnumDef->GetValueByNameString(Value->AsString());
+		}
+		if (OutValue != INDEX_NONE)
+		{
+			UE_LOG(LogTemp, Display, TEXT("Setting enum property %s to name value: %s -> %lld"), *PropertyName, *EnumValueName, OutValue);
+			return true;
+		}
+
+		// Log all possible enum values for debugging
+		UE_LOG(LogTemp, Warning, TEXT("Could not find enum value for '%s'. Available options:"), *EnumValueName);
+		for (int32 i = 0; i < EnumDef->NumEnums(); i++)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("  - %s (value: %lld)"), *EnumDef->GetNameStringByIndex(i), EnumDef->GetValueByIndex(i));
+		}
+		OutError = FString::Printf(TEXT("Could not find enum value for '%s'"), *EnumValueName);
+		return false;
+	}
+
+	bool IsEnumJsonValue(const TSharedPtr<FJsonValue>& Value, FProperty* Property, const FString& PropertyName, FString& OutError)
+	{
+		if (Value->Type == EJson::Number || Value->Type == EJson::String)
+		{
+			return true;
+		}
+		OutError = FString::Printf(TEXT("Unsupported property type: %s for property %s"), *Property->GetClass()->GetName(), *PropertyName);
+		return false;
+	}
+
+	bool SetByte(FProperty* Property, void* ValueAddr, const TSharedPtr<FJsonValue>& Value, const FString& PropertyName, FString& OutError)
+	{
+		static_cast<FByteProperty*>(Property)->SetPropertyValue(ValueAddr, static_cast<uint8>(Value->AsNumber()));
+		return true;
+	}
+
+	/** TEnumAsByte property. */
+	bool SetByteEnum(FProperty* Property, void* ValueAddr, const TSharedPtr<FJsonValue>& Value, const FString& PropertyName, FString& OutError)
+	{
+		FByteProperty* ByteProp = static_cast<FByteProperty*>(Property);
+		int64 EnumValue;
+		if (!IsEnumJsonValue(Value, Property, PropertyName, OutError)
+			|| !ResolveEnumValue(ByteProp->GetIntPropertyEnum(), Value, PropertyName, EnumValue, OutError))
+		{
+			return false;
+		}
+		ByteProp->SetPropertyValue(ValueAddr, static_cast<uint8>(EnumValue));
+		return true;
+	}
+
+	bool SetEnum(FProperty* Property, void* ValueAddr, const TSharedPtr<FJsonValue>& Value, const FString& PropertyName, FString& OutError)
+	{
+		FEnumProperty* EnumProp = static_cast<FEnumProperty*>(Property);
+		int64 EnumValue;
+		if (!IsEnumJsonValue(Value, Property, PropertyName, OutError)
+			|| !ResolveEnumValue(EnumProp->GetEnum(), Value, PropertyName, EnumValue, OutError))
+		{
+			return false;
+		}
+		EnumProp->GetUnderlyingProperty()->SetIntPropertyValue(ValueAddr, EnumValue);
+		return true;
+	}
+
+	// Object and class setters
+
+	UObject* LoadObjectForProperty(UClass* PropertyClass, const FString& AssetPath)
+	{
+		UObject* LoadedObject = StaticLoadObject(PropertyClass, nullptr, *AssetPath);
+
+		// Try "Package.ObjectName" format if direct path fails
+		if (!LoadedObject && !AssetPath.Contains(TEXT(".")))
+		{
+			const FString BaseName = FPaths::GetBaseFilename(AssetPath);
+			LoadedObject = StaticLoadObject(PropertyClass, nullptr, *(AssetPath + TEXT(".") + BaseName));
+		}
+		if (LoadedObject)
+		{
+			return LoadedObject;
+		}
+
+		// Try loading as UObject (less restrictive class filter) and check compatibility
+		UObject* AnyObject = StaticLoadObject(UObject::StaticClass(), nullptr, *AssetPath);
+		if (!AnyObject && !AssetPath.Contains(TEXT(".")))
+		{
+			const FString BaseName = FPaths::GetBaseFilename(AssetPath);
+			AnyObject = StaticLoadObject(UObject::StaticClass(), nullptr, *(AssetPath + TEXT(".") + BaseName));
+		}
+		if (AnyObject && AnyObject->IsA(PropertyClass))
+		{
+			return AnyObject;
+		}
+
+		// If it's a Blueprint, try getting the GeneratedClass for TSubclassOf/UClass* properties
+		UBlueprint* BP = Cast<UBlueprint>(AnyObject);
+		if (BP && BP->GeneratedClass && BP->GeneratedClass->IsChildOf(PropertyClass))
+		{
+			return BP->GeneratedClass;
+		}
+		return nullptr;
+	}
+
+	bool SetObject(FProperty* Property, void* ValueAddr, const TSharedPtr<FJsonValue>& Value, const FString& PropertyName, FString& OutError)
+	{
+		FObjectProperty* ObjectProp = static_cast<FObjectProperty*>(Property);
+		const FString AssetPath = Value->AsString();
+		UObject* LoadedObject = LoadObjectForProperty(ObjectProp->PropertyClass, AssetPath);
+		if (!LoadedObject)
+		{
+			OutError = FString::Printf(TEXT("Failed to load asset '%s' for property %s (expected type: %s)"),
+				*AssetPath, *PropertyName, *ObjectProp->PropertyClass->GetName());
+			return false;
+		}
+
+		ObjectProp->SetObjectPropertyValue(ValueAddr, LoadedObject);
+		UE_LOG(LogTemp, Display, TEXT("Set object property %s to %s (loaded: %s)"), *PropertyName, *AssetPath, *LoadedObject->GetPathName());
+		return true;
+	}
+
+	bool SetClass(FProperty* Property, void* ValueAddr, const TSharedPtr<FJsonValue>& Value, const FString& PropertyName, FString& OutError)
+	{
+		FClassProperty* ClassProp = static_cast<FClassProperty*>(Property);
+		const FString ClassPath = Value->AsString();
+
+		// 1. Try exact path as UClass (e.g. "/Script/Engine.Character" or "/Game/Path/BP_Name.BP_Name_C")
+		UClass* LoadedClass = LoadObject<UClass>(nullptr, *ClassPath);
+
+		// 2. If not found and doesn't end with _C, try appending _C (Blueprint generated class convention)
+		if (!LoadedClass && !ClassPath.EndsWith(TEXT("_C")))
+		{
+			LoadedClass = LoadObject<UClass>(nullptr, *(ClassPath + TEXT("_C")));
+
+			// Also try "Path.Path_C" format (when only package path given like "/Game/Path/BP_Name")
+			if (!LoadedClass)
+			{
+				const FString BaseName = FPaths::GetBaseFilename(ClassPath);
+				LoadedClass = LoadObject<UClass>(nullptr, *(ClassPath + TEXT(".") + BaseName + TEXT("_C")));
+			}
+		}
+
+		// 3. Try loading as Blueprint asset and getting its GeneratedClass
+		if (!LoadedClass)
+		{
+			FString BlueprintPath = ClassPath;
+			BlueprintPath.RemoveFromEnd(TEXT("_C"));
+			UBlueprint* BP = LoadObject<UBlueprint>(nullptr, *BlueprintPath);
+			if (!BP)
+			{
+				const FString BaseName = FPaths::GetBaseFilename(BlueprintPath);
+				BP = LoadObject<UBlueprint>(nullptr, *(BlueprintPath + TEXT(".") + BaseName));
+			}
+			if (BP && BP->GeneratedClass)
+			{
+				LoadedClass = BP->GeneratedClass;
+			}
+		}
+
+		// 4. Try FindFirstObject as last resort (for already-loaded classes by short name)
+		if (!LoadedClass)
+		{
+			LoadedClass = FindFirstObject<UClass>(*ClassPath);
+		}
+
+		if (!LoadedClass)
+		{
+			OutError = FString::Printf(TEXT("Failed to load class '%s' for property %s. Try full path like '/Game/Path/BP_Name' or '/Script/Module.ClassName'"),
+				*ClassPath, *PropertyName);
+			return false;
+		}
+		if (ClassProp->MetaClass && !LoadedClass->IsChildOf(ClassProp->MetaClass))
+		{
+			OutError = FString::Printf(TEXT("Class '%s' is not a %s (required by property %s)"),
+				*LoadedClass->GetName(), *ClassProp->MetaClass->GetName(), *PropertyName);
+			return false;
+		}
+
+		ClassProp->SetObjectPropertyValue(ValueAddr, LoadedClass);
+		UE_LOG(LogTemp, Display, TEXT("Set class property %s to %s (resolved: %s)"), *PropertyName, *ClassPath, *LoadedClass->GetPathName());
+		return true;
+	}
+
+	bool SetSoftObject(FProperty* Property, void* ValueAddr, const TSharedPtr<FJsonValue>& Value, const FString& PropertyName, FString& OutError)
+	{
+		const FString AssetPath = Value->AsString();
+		static_cast<FSoftObjectProperty*>(Property)->SetPropertyValue(ValueAddr, FSoftObjectPtr(FSoftObjectPath(AssetPath)));
+		UE_LOG(LogTemp, Display, TEXT("Set soft object property %s to %s"), *PropertyName, *AssetPath);
+		return true;
+	}
+
+	// Struct setters
+
+	bool ReadNumbers(const TSharedPtr<FJsonValue>& Value, int32 MinCount, int32 MaxCount, double* OutNumbers, int32& OutCount)
+	{
+		if (Value->Type != EJson::Array)
+		{
+			return false;
+		}
+		const TArray<TSharedPtr<FJsonValue>>& Arr = Value->AsArray();
+		if (Arr.Num() < MinCount || Arr.Num() > MaxCount)
+		{
+			return false;
+		}
+		for (int32 Index = 0; Index < Arr.Num(); ++Index)
+		{
+			OutNumbers[Index] = Arr[Index]->AsNumber();
+		}
+		OutCount = Arr.Num();
+		return true;
+	}
+
+	bool SetVector(FProperty* Property, void* ValueAddr, const TSharedPtr<FJsonValue>& Value, const FString& PropertyName, FString& OutError)
+	{
+		double N[3];
+		int32 Count;
+		if (!ReadNumbers(Value, 3, 3, N, Count))
+		{
+			OutError = FString::Printf(TEXT("FVector property %s requires array of 3 numbers [x,y,z]"), *PropertyName);
+			return false;
+		}
+		*static_cast<FVector*>(ValueAddr) = FVector(N[0], N[1], N[2]);
+		return true;
+	}
+
+	bool SetRotator(FProperty* Property, void* ValueAddr, const TSharedPtr<FJsonValue>& Value, const FString& PropertyName, FString& OutError)
+	{
+		double N[3];
+		int32 Count;
+		if (!ReadNumbers(Value, 3, 3, N, Count))
+		{
+			OutError = FString::Printf(TEXT("FRotator property %s requires array of 3 numbers [pitch,yaw,roll]"), *PropertyName);
+			return false;
+		}
+		*static_cast<FRotator*>(ValueAddr) = FRotator(N[0], N[1], N[2]);
+		return true;
+	}
+
+	bool SetColor(FProperty* Property, void* ValueAddr, const TSharedPtr<FJsonValue>& Value, const FString& PropertyName, FString& OutError)
+	{
+		double N[4];
+		int32 Count;
+		if (!ReadNumbers(Value, 3, 4, N, Count))
+		{
+			OutError = FString::Printf(TEXT("FColor property %s requires array of 3-4 numbers [R,G,B] or [R,G,B,A]"), *PropertyName);
+			return false;
+		}
+		*static_cast<FColor*>(ValueAddr) = FColor((uint8)N[0], (uint8)N[1], (uint8)N[2], Count >= 4 ? (uint8)N[3] : 255);
+		return true;
+	}
+
+	bool SetLinearColor(FProperty* Property, void* ValueAddr, const TSharedPtr<FJsonValue>& Value, const FString& PropertyName, FString& OutError)
+	{
+		double N[4];
+		int32 Count;
+		if (!ReadNumbers(Value, 3, 4, N, Count))
+		{
+			OutError = FString::Printf(TEXT("FLinearColor property %s requires array of 3-4 numbers [R,G,B] or [R,G,B,A]"), *PropertyName);
+			return false;
+		}
+		*static_cast<FLinearColor*>(ValueAddr) = FLinearColor(N[0], N[1], N[2], Count >= 4 ? N[3] : 1.0f);
+		return true;
+	}
+
+	bool SetVector2D(FProperty* Property, void* ValueAddr, const TSharedPtr<FJsonValue>& Value, const FString& PropertyName, FString& OutError)
+	{
+		double N[2];
+		int32 Count;
+		if (!ReadNumbers(Value, 2, 2, N, Count))
+		{
+			OutError = FString::Printf(TEXT("FVector2D property %s requires array of 2 numbers [x,y]"), *PropertyName);
+			return false;
+		}
+		*static_cast<FVector2D*>(ValueAddr) = FVector2D(N[0], N[1]);
+		return true;
+	}
+
+	bool SetTransform(FProperty* Property, void* ValueAddr, const TSharedPtr<FJsonValue>& Value, const FString& PropertyName, FString& OutError)
+	{
+		if (Value->Type != EJson::Object)
+		{
+			OutError = FString::Printf(TEXT("FTransform property %s requires object with location/rotation/scale arrays"), *PropertyName);
+			return false;
+		}
+
+		const TSharedPtr<FJsonObject> Obj = Value->AsObject();
+		FTransform Transform;
+		double N[3];
+		int32 Count;
+		if (Obj->HasField(TEXT("location")) && ReadNumbers(Obj->Values.FindRef(TEXT("location")), 3, 3, N, Count))
+		{
+			Transform.SetLocation(FVector(N[0], N[1], N[2]));
+		}
+		if (Obj->HasField(TEXT("rotation")) && ReadNumbers(Obj->Values.FindRef(TEXT("rotation")), 3, 3, N, Count))
+		{
+			Transform.SetRotation(FQuat(FRotator(N[0], N[1], N[2])));
+		}
+		if (Obj->HasField(TEXT("scale")) && ReadNumbers(Obj->Values.FindRef(TEXT("scale")), 3, 3, N, Count))
+		{
+			Transform.SetScale3D(FVector(N[0], N[1], N[2]));
+		}
+		*static_cast<FTransform*>(ValueAddr) = Transform;
+		return true;
+	}
+
+	// Array setters: the element store is picked once, the array is resized and filled per call
+
+	typedef void (*FElementStore)(FProperty* Inner, void* ElementAddr, const TSharedPtr<FJsonValue>& Value);
+
+	template <typename PropertyType, typename ValueType>
+	void StoreElement(FProperty* Inner, void* ElementAddr, const TSharedPtr<FJsonValue>& Value);
+
+	template <> void StoreElement<FNameProperty, FName>(FProperty* Inner, void* ElementAddr, const TSharedPtr<FJsonValue>& Value)
+	{
+		static_cast<FNameProperty*>(Inner)->SetPropertyValue(ElementAddr, FName(*Value->AsString()));
+	}
+	template <> void StoreElement<FStrProperty, FString>(FProperty* Inner, void* ElementAddr, const TSharedPtr<FJsonValue>& Value)
+	{
+		static_cast<FStrProperty*>(Inner)->SetPropertyValue(ElementAddr, Value->AsString());
+	}
+	template <> void StoreElement<FIntProperty, int32>(FProperty* Inner, void* ElementAddr, const TSharedPtr<FJsonValue>& Value)
+	{
+		static_cast<FIntProperty*>(Inner)->SetPropertyValue(ElementAddr, static_cast<int32>(Value->AsNumber()));
+	}
+	template <> void StoreElement<FFloatProperty, float>(FProperty* Inner, void* ElementAddr, const TSharedPtr<FJsonValue>& Value)
+	{
+		static_cast<FFloatProperty*>(Inner)->SetPropertyValue(ElementAddr, static_cast<float>(Value->AsNumber()));
+	}
+	template <> void StoreElement<FDoubleProperty, double>(FProperty* Inner, void* ElementAddr, const TSharedPtr<FJsonValue>& Value)
+	{
+		static_cast<FDoubleProperty*>(Inner)->SetPropertyValue(ElementAddr, Value->AsNumber());
+	}
+	template <> void StoreElement<FBoolProperty, bool>(FProperty* Inner, void* ElementAddr, const TSharedPtr<FJsonValue>& Value)
+	{
+		static_cast<FBoolProperty*>(Inner)->SetPropertyValue(ElementAddr, Value->AsBool());
+	}
+
+	template <typename PropertyType, typename ValueType>
+	bool SetScalarArray(FProperty* Property, void* ValueAddr, const TSharedPtr<FJsonValue>& Value, const FString& PropertyName, FString& OutError)
+	{
+		if (Value->Type != EJson::Array)
+		{
+			OutError = FString::Printf(TEXT("ArrayProperty %s requires a JSON array value"), *PropertyName);
+			return false;
+		}
+
+		FArrayProperty* ArrayProp = static_cast<FArrayProperty*>(Property);
+		const TArray<TSharedPtr<FJsonValue>>& JsonArray = Value->AsArray();
+		FScriptArrayHelper ArrayHelper(ArrayProp, ValueAddr);
+		ArrayHelper.Resize(JsonArray.Num());
+		for (int32 i = 0; i < JsonArray.Num(); i++)
+		{
+			StoreElement<PropertyType, ValueType>(ArrayProp->Inner, ArrayHelper.GetRawPtr(i), JsonArray[i]);
+		}
+		UE_LOG(LogTemp, Display, TEXT("Set array property %s with %d elements"), *PropertyName, JsonArray.Num());
+		return true;
+	}
+
+	/** TArray<UObject*>, e.g. OverrideMaterials; "", "null" and "None" entries are stored as null. */
+	bool SetObjectArray(FProperty* Property, void* ValueAddr, const TSharedPtr<FJsonValue>& Value, const FString& PropertyName, FString& OutError)
+	{
+		if (Value->Type != EJson::Array)
+		{
+			OutError = FString::Printf(TEXT("ArrayProperty %s requires a JSON array value"), *PropertyName);
+			return false;
+		}
+
+		FArrayProperty* ArrayProp = static_cast<FArrayProperty*>(Property);
+		FObjectProperty* InnerObjProp = static_cast<FObjectProperty*>(ArrayProp->Inner);
+		const TArray<TSharedPtr<FJsonValue>>& JsonArray = Value->AsArray();
+		FScriptArrayHelper ArrayHelper(ArrayProp, ValueAddr);
+		ArrayHelper.Resize(JsonArray.Num());
+		for (int32 i = 0; i < JsonArray.Num(); i++)
+		{
+			const FString AssetPath = JsonArray[i]->AsString();
+			if (AssetPath.IsEmpty() || AssetPath == TEXT("null") || AssetPath == TEXT("None"))
+			{
+				InnerObjProp->SetObjectPropertyValue(ArrayHelper.GetRawPtr(i), nullptr);
+				continue;
+			}
+
+			UObject* LoadedObject = StaticLoadObject(InnerObjProp->PropertyClass, nullptr, *AssetPath);
+			if (!LoadedObject && !AssetPath.Contains(TEXT(".")))
+			{
+				const FString BaseName = FPaths::GetBaseFilename(AssetPath);
+				LoadedObject = StaticLoadObject(InnerObjProp->PropertyClass, nullptr, *(AssetPath + TEXT(".") + BaseName));
+			}
+			if (!LoadedObject)
+			{
+				OutError = FString::Printf(TEXT("Failed to load asset '%s' at array index %d for property %s (expected type: %s)"),
+					*AssetPath, i, *PropertyName, *InnerObjProp->PropertyClass->GetName());
+				return false;
+			}
+			InnerObjProp->SetObjectPropertyValue(ArrayHelper.GetRawPtr(i), LoadedObject);
+		}
+		UE_LOG(LogTemp, Display, TEXT("Set array<UObject*> property %s with %d elements"), *PropertyName, JsonArray.Num());
+		return true;
+	}
+
+	/** Pick the setter for a leaf property once; nullptr (with a message) when its type is unsupported. */
+	FMCPPropertySetter SelectSetter(FProperty* Property, const FString& PropertyName, FString& OutError)
+	{
+		if (Property->IsA<FBoolProperty>())
+		{
+			return &SetBool;
+		}
+		if (Property->IsA<FIntProperty>())
+		{
+			return &SetInt;
+		}
+		if (Property->IsA<FFloatProperty>())
+		{
+			return &SetFloat;
+		}
+		if (Property->IsA<FDoubleProperty>())
+		{
+			return &SetDouble;
+		}
+		if (Property->IsA<FStrProperty>())
+		{
+			return &SetString;
+		}
+		if (Property->IsA<FNameProperty>())
+		{
+			return &SetName;
+		}
+		if (FByteProperty* ByteProp = CastField<FByteProperty>(Property))
+		{
+			return ByteProp->GetIntPropertyEnum() ? &SetByteEnum : &SetByte;
+		}
+		if (FEnumProperty* EnumProp = CastField<FEnumProperty>(Property))
+		{
+			if (EnumProp->GetEnum() && EnumProp->GetUnderlyingProperty())
+			{
+				return &SetEnum;
+			}
+		}
+		// Class before object: FClassProperty is an FObjectProperty
+		if (Property->IsA<FClassProperty>())
+		{
+			return &SetClass;
+		}
+		if (Property->IsA<FObjectProperty>())
+		{
+			return &SetObject;
+		}
+		// Covers FSoftClassProperty, which stores the same soft path
+		if (Property->IsA<FSoftObjectProperty>())
+		{
+			return &SetSoftObject;
+		}
+		if (FStructProperty* StructProp = CastField<FStructProperty>(Property))
+		{
+			const UScriptStruct* Struct = StructProp->Struct;
+			if (Struct == TBaseStructure<FVector>::Get())
+			{
+				return &SetVector;
+			}
+			if (Struct == TBaseStructure<FRotator>::Get())
+			{
+				return &SetRotator;
+			}
+			if (Struct == TBaseStructure<FColor>::Get())
+			{
+				return &SetColor;
+			}
+			if (Struct == TBaseStructure<FLinearColor>::Get())
+			{
+				return &SetLinearColor;
+			}
+			if (Struct == TBaseStructure<FTransform>::Get())
+			{
+				return &SetTransform;
+			}
+			if (Struct == TBaseStructure<FVector2D>::Get())
+			{
+				return &SetVector2D;
+			}
+			OutError = FString::Printf(TEXT("Unsupported struct type: %s for property %s"), *Struct->GetName(), *PropertyName);
+			return nullptr;
+		}
+		if (FArrayProperty* ArrayProp = CastField<FArrayProperty>(Property))
+		{
+			FProperty* InnerProp = ArrayProp->Inner;
+			if (InnerProp->IsA<FNameProperty>())
+			{
+				return &SetScalarArray<FNameProperty, FName>;
+			}
+			if (InnerProp->IsA<FStrProperty>())
+			{
+				return &SetScalarArray<FStrProperty, FString>;
+			}
+			if (InnerProp->IsA<FIntProperty>())
+			{
+				return &SetScalarArray<FIntProperty, int32>;
+			}
+			if (InnerProp->IsA<FFloatProperty>())
+			{
+				return &SetScalarArray<FFloatProperty, float>;
+			}
+			if (InnerProp->IsA<FDoubleProperty>())
+			{
+				return &SetScalarArray<FDoubleProperty, double>;
+			}
+			if (InnerProp->IsA<FBoolProperty>())
+			{
+				return &SetScalarArray<FBoolProperty, bool>;
+			}
+			if (InnerProp->IsA<FObjectProperty>())
+			{
+				return &SetObjectArray;
+			}
+			OutError = FString::Printf(TEXT("Unsupported array inner type: %s for property %s"), *InnerProp->GetClass()->GetName(), *PropertyName);
+			return nullptr;
+		}
+
+		OutError = FString::Printf(TEXT("Unsupported property type: %s for property %s"), *Property->GetClass()->GetName(), *PropertyName);
+		return nullptr;
+	}
+}
+
+FMCPPropertyAccessorCache& FMCPPropertyAccessorCache::Get()
+{
+	static FMCPPropertyAccessorCache Instance;
+	return Instance;
+}
+
+void FMCPPropertyAccessorCache::Initialize()
+{
+	if (bInitialized)
+	{
+		return;
+	}
+	bInitialized = true;
+
+	if (GEditor)
+	{
+		BlueprintCompiledHandle = GEditor->OnBlueprintCompiled().AddRaw(this, &FMCPPropertyAccessorCache::OnBlueprintCompiled);
+	}
+	ObjectsReinstancedHandle = FCoreUObjectDelegates::OnObjectsReinstanced.AddRaw(this, &FMCPPropertyAccessorCache::OnObjectsReinstanced);
+	ReloadCompleteHandle = FCoreUObjectDelegates::ReloadCompleteDelegate.AddRaw(this, &FMCPPropertyAccessorCache::OnReloadComplete);
+}
+
+void FMCPPropertyAccessorCache::Shutdown()
+{
+	if (!bInitialized)
+	{
+		return;
+	}
+	bInitialized = false;
+
+	if (GEditor)
+	{
+		GEditor->OnBlueprintCompiled().Remove(BlueprintCompiledHandle);
+	}
+	FCoreUObjectDelegates::OnObjectsReinstanced.Remove(ObjectsReinstancedHandle);
+	FCoreUObjectDelegates::ReloadCompleteDelegate.Remove(ReloadCompleteHandle);
+
+	Accessors.Empty();
+}
+
+const FMCPPropertyAccessor& FMCPPropertyAccessorCache::Find(UClass* Class, const FString& Path)
+{
+	FAccessorKey Key{ Class, Path };
+	if (const FMCPPropertyAccessor* Existing = Accessors.Find(Key))
+	{
+		return *Existing;
+	}
+
+	if (Accessors.Num() >= MaxCachedAccessors)
+	{
+		Accessors.Reset();
+	}
+	FMCPPropertyAccessor& Accessor = Accessors.Add(MoveTemp(Key));
+	Compile(Class, Path, Accessor);
+	return Accessor;
+}
+
+bool FMCPPropertyAccessorCache::SetValue(UObject* Object, const FString& Path, const TSharedPtr<FJsonValue>& Value, FString& OutError)
+{
+	if (!Object)
+	{
+		OutError = TEXT("Invalid object");
+		return false;
+	}
+	if (!Value.IsValid())
+	{
+		OutError = FString::Printf(TEXT("Missing value for property %s"), *Path);
+		return false;
+	}
+
+	// Each object hop continues with the referenced object's own accessor
+	const FMCPPropertyAccessor* Accessor = &Find(Object->GetClass(), Path);
+	void* Container = Object;
+	for (;;)
+	{
+		if (!Accessor->Error.IsEmpty())
+		{
+			OutError = Accessor->Error;
+			return false;
+		}
+		for (FProperty* Hop : Accessor->StructHops)
+		{
+			Container = Hop->ContainerPtrToValuePtr<void>(Container);
+		}
+		if (!Accessor->ObjectHop)
+		{
+			break;
+		}
+
+		UObject* Referenced = Accessor->ObjectHop->GetObjectPropertyValue_InContainer(Container);
+		if (!Referenced)
+		{
+			OutError = FString::Printf(TEXT("%s is None on %s"), *Accessor->ObjectHop->GetName(), *Object->GetName());
+			return false;
+		}
+		// Copied: compiling the next accessor can grow the map under the current one
+		const FString RemainingPath = Accessor->RemainingPath;
+		Object = Referenced;
+		Container = Referenced;
+		Accessor = &Find(Referenced->GetClass(), RemainingPath);
+	}
+
+	// Notify the object that it's about to be modified (enables undo/redo tracking)
+	Object->Modify();
+	return Accessor->Setter(Accessor->Leaf, Accessor->Leaf->ContainerPtrToValuePtr<void>(Container), Value, Path, OutError);
+}
+
+void FMCPPropertyAccessorCache::Invalidate()
+{
+	Accessors.Empty();
+}
+
+void FMCPPropertyAccessorCache::Compile(UClass* Class, const FString& Path, FMCPPropertyAccessor& OutAccessor)
+{
+	TArray<FString> Segments;
+	Path.ParseIntoArray(Segments, TEXT("."));
+
+	const UStruct* Struct = Class;
+	for (int32 Index = 0; Index < Segments.Num(); ++Index)
+	{
+		FProperty* Property = Struct->FindPropertyByName(FName(*Segments[Index]));
+		if (!Property)
+		{
+			OutAccessor.Error = FString::Printf(TEXT("Property not found: %s"), *Path);
+			return;
+		}
+
+		if (Index == Segments.Num() - 1)
+		{
+			OutAccessor.Leaf = Property;
+			OutAccessor.Setter = SelectSetter(Property, Path, OutAccessor.Error);
+			return;
+		}
+
+		if (FStructProperty* StructProp = CastField<FStructProperty>(Property))
+		{
+			OutAccessor.StructHops.Add(StructProp);
+			Struct = StructProp->Struct;
+		}
+		else if (FObjectPropertyBase* ObjectProp = CastField<FObjectPropertyBase>(Property))
+		{
+			OutAccessor.ObjectHop = ObjectProp;
+			OutAccessor.RemainingPath = FString::Join(MakeArrayView(Segments).RightChop(Index + 1), TEXT("."));
+			return;
+		}
+		else
+		{
+			OutAccessor.Error = FString::Printf(TEXT("Property %s in path %s has no members"), *Segments[Index], *Path);
+			return;
+		}
+	}
+
+	OutAccessor.Error = FString::Printf(TEXT("Property not found: %s"), *Path);
+}
+
+void FMCPPropertyAccessorCache::OnBlueprintCompiled()
+{
+	Invalidate();
+}
+
+void FMCPPropertyAccessorCache::OnObjectsReinstanced(const TMap<UObject*, UObject*>& OldToNew)
+{
+	Invalidate();
+}
+
+void FMCPPropertyAccessorCache::OnReloadComplete(EReloadCompleteReason Reason)
+{
+	Invalidate();
+}
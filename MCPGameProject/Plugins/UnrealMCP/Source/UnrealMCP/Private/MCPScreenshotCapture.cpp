@@ -0,0 +1,354 @@
+#include "MCPScreenshotCapture.h"
+#include "MCPWorldResolver.h"
+#include "IImageWrapperModule.h"
+#include "Editor.h"
+#include "Engine/GameViewportClient.h"
+#include "HAL/FileManager.h"
+#include "LevelEditor.h"
+#include "LevelEditorViewport.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Modules/ModuleManager.h"
+#include "RenderingThread.h"
+#include "RHIGPUReadback.h"
+#include "SLevelViewport.h"
+#include "Tasks/Task.h"
+#include "UnrealClient.h"
+
+// Tickets kept for get_screenshot; older ones expire
+static constexpr int32 MCPMaxScreenshotResults = 32;
+
+FMCPScreenshotCapture& FMCPScreenshotCapture::Get()
+{
+	static FMCPScreenshotCapture Instance;
+	return Instance;
+}
+
+void FMCPScreenshotCapture::Initialize()
+{
+	if (bInitialized)
+	{
+		return;
+	}
+	bInitialized = true;
+
+	// Loaded here so encode tasks never touch the module manager off the game thread
+	ImageWrapperModule = &FModuleManager::LoadModuleChecked<IImageWrapperModule>(TEXT("ImageWrapper"));
+	TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FMCPScreenshotCapture::Tick));
+}
+
+void FMCPScreenshotCapture::Shutdown()
+{
+	if (!bInitialized)
+	{
+		return;
+	}
+	bInitialized = false;
+
+	FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+
+	// Queued copies and polls hold references to their captures; let them drain before the readbacks go away
+	FlushRenderingCommands();
+	Pending.Empty();
+}
+
+int32 FMCPScreenshotCapture::Start(FViewport* Viewport, const FMCPScreenshotRequest& Request, FString& OutError)
+{
+	check(IsInGameThread());
+	const int32 Ticket = NextTicket++;
+	const double StartTime = FPlatformTime::Seconds();
+
+	// Recorded first: a capture that fails on the render thread completes the ticket right away
+	{
+		FScopeLock Lock(&ResultsLock);
+		FMCPScreenshotResult& Result = Results.Add(Ticket);
+		Result.FilePath = Request.FilePath;
+		Result.SourceSize = Viewport->GetSizeXY();
+		Result.Format = Request.Format;
+		ResultOrder.Add(Ticket);
+		while (ResultOrder.Num() > MCPMaxScreenshotResults)
+		{
+			Results.Remove(ResultOrder[0]);
+			ResultOrder.RemoveAt(0, 1, EAllowShrinking::No);
+		}
+	}
+
+	const bool bQueued = ReadViewport(Viewport,
+		[this, Ticket, Request, StartTime](TArray<FColor>&& Pixels, FIntPoint Size, const FString& Error)
+		{
+			if (!Error.IsEmpty())
+			{
+				FMCPScreenshotResult Failed;
+				Failed.State = EMCPScreenshotState::Failed;
+				Failed.Error = Error;
+				Complete(Ticket, MoveTemp(Failed));
+				return;
+			}
+			UE::Tasks::Launch(UE_SOURCE_LOCATION, [this, Ticket, Request, Size, StartTime, Pixels = MoveTemp(Pixels)]() mutable
+			{
+				Encode(Ticket, Request, Size, StartTime, MoveTemp(Pixels));
+			});
+		},
+		OutError);
+	if (!bQueued)
+	{
+		FScopeLock Lock(&ResultsLock);
+		Results.Remove(Ticket);
+		ResultOrder.Remove(Ticket);
+		return INDEX_NONE;
+	}
+	return Ticket;
+}
+
+bool FMCPScreenshotCapture::ReadViewport(FViewport* Viewport, FMCPPixelsCallback OnPixels, FString& OutError)
+{
+	check(IsInGameThread());
+	if (!bInitialized)
+	{
+		OutError = TEXT("Screenshot capture is not initialized");
+		return false;
+	}
+
+	const FIntPoint Size = Viewport->GetSizeXY();
+	if (Size.X <= 0 || Size.Y <= 0)
+	{
+		OutError = FString::Printf(TEXT("Viewport has invalid size: %dx%d"), Size.X, Size.Y);
+		return false;
+	}
+
+	TSharedRef<FCapture, ESPMode::ThreadSafe> Capture = MakeShared<FCapture, ESPMode::ThreadSafe>();
+	Capture->SourceSize = Size;
+	Capture->Readback = MakeUnique<FRHIGPUTextureReadback>(TEXT("MCPViewportReadback"));
+	Capture->OnPixels = MoveTemp(OnPixels);
+
+	// Queued behind the viewport's pending draws, so the copy sees the latest frame without a flush
+	ENQUEUE_RENDER_COMMAND(MCPCaptureViewport)(
+		[Capture, Viewport](FRHICommandListImmediate& RHICmdList)
+		{
+			FRHITexture* Texture = Viewport->GetRenderTargetTexture().GetReference();
+			if (!Texture)
+			{
+				Capture->bDone = true;
+				Capture->OnPixels(TArray<FColor>(), Capture->SourceSize, TEXT("Viewport has no render target to capture"));
+				return;
+			}
+			Capture->PixelFormat = Texture->GetFormat();
+			Capture->Readback->EnqueueCopy(RHICmdList, Texture, FIntVector::ZeroValue, 0, FIntVector(Capture->SourceSize.X, Capture->SourceSize.Y, 1));
+		});
+
+	Pending.Add(Capture);
+	return true;
+}
+
+FViewport* FMCPScreenshotCapture::FindViewport(FString& OutSource, bool& bOutIsPIE)
+{
+	bOutIsPIE = FMCPWorldResolver::Get().GetPIEWorld() != nullptr;
+	OutSource = TEXT("unknown");
+
+	// During PIE, capture the game viewport
+	if (bOutIsPIE && GEngine && GEngine->GameViewport && GEngine->GameViewport->Viewport)
+	{
+		OutSource = TEXT("PIE_GameViewport");
+		return GEngine->GameViewport->Viewport;
+	}
+
+	// For editor mode, get the active level editor viewport (the 3D perspective view)
+	if (FLevelEditorModule* LevelEditorModule = FModuleManager::GetModulePtr<FLevelEditorModule>(TEXT("LevelEditor")))
+	{
+		TSharedPtr<SLevelViewport> ActiveLevelViewport = LevelEditorModule->GetFirstActiveLevelViewport();
+		if (ActiveLevelViewport.IsValid() && ActiveLevelViewport->GetLevelViewportClient().Viewport)
+		{
+			OutSource = TEXT("LevelEditor_ActiveViewport");
+			return ActiveLevelViewport->GetLevelViewportClient().Viewport;
+		}
+	}
+
+	// Last resort fallback
+	if (GEditor && GEditor->GetActiveViewport())
+	{
+		OutSource = TEXT("Editor_ActiveViewport");
+		return GEditor->GetActiveViewport();
+	}
+	return nullptr;
+}
+
+bool FMCPScreenshotCapture::GetResult(int32 Ticket, FMCPScreenshotResult& OutResult, bool bIncludeData) const
+{
+	FScopeLock Lock(&ResultsLock);
+	const FMCPScreenshotResult* Result = Results.Find(Ticket);
+	if (!Result)
+	{
+		return false;
+	}
+	OutResult.State = Result->State;
+	OutResult.FilePath = Result->FilePath;
+	OutResult.SourceSize = Result->SourceSize;
+	OutResult.Size = Result->Size;
+	OutResult.Format = Result->Format;
+	OutResult.Bytes = Result->Bytes;
+	OutResult.Error = Result->Error;
+	OutResult.ElapsedMs = Result->ElapsedMs;
+	if (bIncludeData)
+	{
+		OutResult.Data = Result->Data;
+	}
+	return true;
+}
+
+bool FMCPScreenshotCapture::Tick(float DeltaTime)
+{
+	Pending.RemoveAll([](const TSharedRef<FCapture, ESPMode::ThreadSafe>& Capture) { return Capture->bDone.load(); });
+
+	for (const TSharedRef<FCapture, ESPMode::ThreadSafe>& Capture : Pending)
+	{
+		// One outstanding poll per capture; readiness is checked where the readback lives
+		if (Capture->bPollQueued.exchange(true))
+		{
+			continue;
+		}
+		ENQUEUE_RENDER_COMMAND(MCPPollScreenshot)(
+			[Capture](FRHICommandListImmediate& RHICmdList)
+			{
+				if (Capture->bDone || !Capture->Readback->IsReady())
+				{
+					Capture->bPollQueued = false;
+					return;
+				}
+
+				TArray<FColor> Pixels;
+				FString Error;
+				if (!ReadPixels(*Capture->Readback, Capture->SourceSize, Capture->PixelFormat, Pixels, Error))
+				{
+					Pixels.Reset();
+				}
+				Capture->Readback.Reset();
+				Capture->bDone = true;
+				Capture->OnPixels(MoveTemp(Pixels), Capture->SourceSize, Error);
+			});
+	}
+	return true;
+}
+
+bool FMCPScreenshotCapture::ReadPixels(FRHIGPUTextureReadback& Readback, FIntPoint Size, EPixelFormat PixelFormat, TArray<FColor>& OutPixels, FString& OutError)
+{
+	int32 RowPitchInPixels = 0;
+	const uint8* Data = static_cast<const uint8*>(Readback.Lock(RowPitchInPixels));
+	if (!Data)
+	{
+		OutError = TEXT("Failed to map the screenshot readback");
+		return false;
+	}
+
+	OutPixels.SetNumUninitialized(Size.X * Size.Y);
+	bool bSupported = true;
+	for (int32 Y = 0; Y < Size.Y && bSupported; ++Y)
+	{
+		FColor* Dest = OutPixels.GetData() + (int64)Y * Size.X;
+		switch (PixelFormat)
+		{
+		case PF_B8G8R8A8:
+			FMemory::Memcpy(Dest, Data + (int64)Y * RowPitchInPixels * 4, Size.X * sizeof(FColor));
+			break;
+		case PF_R8G8B8A8:
+		{
+			const uint8* Row = Data + (int64)Y * RowPitchInPixels * 4;
+			for (int32 X = 0; X < Size.X; ++X)
+			{
+				Dest[X] = FColor(Row[X * 4], Row[X * 4 + 1], Row[X * 4 + 2], Row[X * 4 + 3]);
+			}
+			break;
+		}
+		case PF_A2B10G10R10:
+		{
+			const uint32* Row = reinterpret_cast<const uint32*>(Data + (int64)Y * RowPitchInPixels * 4);
+			for (int32 X = 0; X < Size.X; ++X)
+			{
+				const uint32 Packed = Row[X];
+				Dest[X] = FColor((uint8)((Packed >> 2) & 0xFF), (uint8)((Packed >> 12) & 0xFF), (uint8)((Packed >> 22) & 0xFF), 255);
+			}
+			break;
+		}
+		case PF_FloatRGBA:
+		{
+			const FFloat16Color* Row = reinterpret_cast<const FFloat16Color*>(Data + (int64)Y * RowPitchInPixels * 8);
+			for (int32 X = 0; X < Size.X; ++X)
+			{
+				Dest[X] = FLinearColor(Row[X]).ToFColor(true);
+			}
+			break;
+		}
+		default:
+			bSupported = false;
+			break;
+		}
+	}
+	Readback.Unlock();
+
+	if (!bSupported)
+	{
+		OutError = FString::Printf(TEXT("Unsupported viewport pixel format: %s"), GetPixelFormatString(PixelFormat));
+		return false;
+	}
+	return true;
+}
+
+void FMCPScreenshotCapture::Encode(int32 Ticket, const FMCPScreenshotRequest& Request, FIntPoint SourceSize, double StartTime, TArray<FColor> Pixels)
+{
+	FMCPScreenshotResult Result;
+	Result.FilePath = Request.FilePath;
+	Result.SourceSize = SourceSize;
+	Result.Format = Request.Format;
+	Result.Size = FMCPImageEncoder::FitSize(SourceSize, Request.MaxSize);
+
+	FMCPImageEncoder::ForceOpaque(Pixels);
+	if (Result.Size != SourceSize)
+	{
+		TArray<FColor> Resampled;
+		FMCPImageEncoder::Resample(Pixels, SourceSize, Result.Size, Resampled);
+		Pixels = MoveTemp(Resampled);
+	}
+
+	TArray64<uint8> Encoded;
+	if (!FMCPImageEncoder::Encode(*ImageWrapperModule, Pixels, Result.Size, Request.Format, Request.Quality, Encoded, Result.Error))
+	{
+		Result.State = EMCPScreenshotState::Failed;
+	}
+	else
+	{
+		const FString Directory = FPaths::GetPath(Request.FilePath);
+		if (!Directory.IsEmpty())
+		{
+			IFileManager::Get().MakeDirectory(*Directory, true);
+		}
+		if (!FFileHelper::SaveArrayToFile(Encoded, *Request.FilePath))
+		{
+			Result.State = EMCPScreenshotState::Failed;
+			Result.Error = FString::Printf(TEXT("Failed to save screenshot to: %s"), *Request.FilePath);
+		}
+		else
+		{
+			Result.State = EMCPScreenshotState::Done;
+			Result.Bytes = Encoded.Num();
+			if (Request.bKeepData)
+			{
+				Result.Data = MoveTemp(Encoded);
+			}
+		}
+	}
+
+	Result.ElapsedMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+	Complete(Ticket, MoveTemp(Result));
+}
+
+void FMCPScreenshotCapture::Complete(int32 Ticket, FMCPScreenshotResult&& Result)
+{
+	FScopeLock Lock(&ResultsLock);
+	if (FMCPScreenshotResult* Existing = Results.Find(Ticket))
+	{
+		// Keep what Start recorded when a failure arrives before the encode step filled it in
+		Result.FilePath = Existing->FilePath;
+		Result.SourceSize = Existing->SourceSize;
+		Result.Format = Existing->Format;
+		*Existing = MoveTemp(Result);
+	}
+}
@@ -0,0 +1,421 @@
+#include "MCPSerializationPlan.h"
+#include "MCPJsonWriter.h"
+#include "Dom/JsonValue.h"
+#include "Editor.h"
+#include "UObject/Class.h"
+#include "UObject/UnrealType.h"
+
+namespace
+{
+	// Bool, numbers and strings
+
+	TSharedPtr<FJsonValue> BoolToJson(const FProperty* Property, const void* ValuePtr)
+	{
+		return MakeShared<FJsonValueBoolean>(static_cast<const FBoolProperty*>(Property)->GetPropertyValue(ValuePtr));
+	}
+	void WriteBool(FMCPJsonWriter& Writer, const FProperty* Property, const void* ValuePtr)
+	{
+		Writer.WriteValue(static_cast<const FBoolProperty*>(Property)->GetPropertyValue(ValuePtr));
+	}
+
+	TSharedPtr<FJsonValue> IntToJson(const FProperty* Property, const void* ValuePtr)
+	{
+		return MakeShared<FJsonValueNumber>(*static_cast<const int32*>(ValuePtr));
+	}
+	void WriteInt(FMCPJsonWriter& Writer, const FProperty* Property, const void* ValuePtr)
+	{
+		Writer.WriteValue(*static_cast<const int32*>(ValuePtr));
+	}
+
+	TSharedPtr<FJsonValue> FloatToJson(const FProperty* Property, const void* ValuePtr)
+	{
+		return MakeShared<FJsonValueNumber>(*static_cast<const float*>(ValuePtr));
+	}
+	void WriteFloat(FMCPJsonWriter& Writer, const FProperty* Property, const void* ValuePtr)
+	{
+		Writer.WriteValue((double)*static_cast<const float*>(ValuePtr));
+	}
+
+	TSharedPtr<FJsonValue> DoubleToJson(const FProperty* Property, const void* ValuePtr)
+	{
+		return MakeShared<FJsonValueNumber>(*static_cast<const double*>(ValuePtr));
+	}
+	void WriteDouble(FMCPJsonWriter& Writer, const FProperty* Property, const void* ValuePtr)
+	{
+		Writer.WriteValue(*static_cast<const double*>(ValuePtr));
+	}
+
+	TSharedPtr<FJsonValue> ByteToJson(const FProperty* Property, const void* ValuePtr)
+	{
+		return MakeShared<FJsonValueNumber>(*static_cast<const uint8*>(ValuePtr));
+	}
+	void WriteByte(FMCPJsonWriter& Writer, const FProperty* Property, const void* ValuePtr)
+	{
+		Writer.WriteValue((int32)*static_cast<const uint8*>(ValuePtr));
+	}
+
+	TSharedPtr<FJsonValue> StrToJson(const FProperty* Property, const void* ValuePtr)
+	{
+		return MakeShared<FJsonValueString>(*static_cast<const FString*>(ValuePtr));
+	}
+	void WriteStr(FMCPJsonWriter& Writer, const FProperty* Property, const void* ValuePtr)
+	{
+		Writer.WriteValue(*static_cast<const FString*>(ValuePtr));
+	}
+
+	TSharedPtr<FJsonValue> NameToJson(const FProperty* Property, const void* ValuePtr)
+	{
+		return MakeShared<FJsonValueString>(static_cast<const FName*>(ValuePtr)->ToString());
+	}
+	void WriteName(FMCPJsonWriter& Writer, const FProperty* Property, const void* ValuePtr)
+	{
+		Writer.WriteValue(static_cast<const FName*>(ValuePtr)->ToString());
+	}
+
+	TSharedPtr<FJsonValue> TextToJson(const FProperty* Property, const void* ValuePtr)
+	{
+		return MakeShared<FJsonValueString>(static_cast<const FText*>(ValuePtr)->ToString());
+	}
+	void WriteText(FMCPJsonWriter& Writer, const FProperty* Property, const void* ValuePtr)
+	{
+		Writer.WriteValue(static_cast<const FText*>(ValuePtr)->ToString());
+	}
+
+	// Enums, written by value name
+
+	FString EnumPropertyToString(const FProperty* Property, const void* ValuePtr)
+	{
+		const FEnumProperty* EnumProp = static_cast<const FEnumProperty*>(Property);
+		const UEnum* Enum = EnumProp->GetEnum();
+		const int64 EnumValue = EnumProp->GetUnderlyingProperty()->GetSignedIntPropertyValue(ValuePtr);
+		return Enum ? Enum->GetNameStringByValue(EnumValue) : FString::Printf(TEXT("%lld"), EnumValue);
+	}
+	TSharedPtr<FJsonValue> EnumToJson(const FProperty* Property, const void* ValuePtr)
+	{
+		return MakeShared<FJsonValueString>(EnumPropertyToString(Property, ValuePtr));
+	}
+	void WriteEnum(FMCPJsonWriter& Writer, const FProperty* Property, const void* ValuePtr)
+	{
+		Writer.WriteValue(EnumPropertyToString(Property, ValuePtr));
+	}
+
+	FString ByteEnumToString(const FProperty* Property, const void* ValuePtr)
+	{
+		return static_cast<const FByteProperty*>(Property)->Enum->GetNameStringByValue(*static_cast<const uint8*>(ValuePtr));
+	}
+	TSharedPtr<FJsonValue> ByteEnumToJson(const FProperty* Property, const void* ValuePtr)
+	{
+		return MakeShared<FJsonValueString>(ByteEnumToString(Property, ValuePtr));
+	}
+	void WriteByteEnum(FMCPJsonWriter& Writer, const FProperty* Property, const void* ValuePtr)
+	{
+		Writer.WriteValue(ByteEnumToString(Property, ValuePtr));
+	}
+
+	// Object references, written as paths
+
+	FString ObjectPathToString(const FProperty* Property, const void* ValuePtr)
+	{
+		const UObject* Object = static_cast<const FObjectPropertyBase*>(Property)->GetObjectPropertyValue(ValuePtr);
+		return Object ? Object->GetPathName() : FString(TEXT("None"));
+	}
+	TSharedPtr<FJsonValue> ObjectToJson(const FProperty* Property, const void* ValuePtr)
+	{
+		return MakeShared<FJsonValueString>(ObjectPathToString(Property, ValuePtr));
+	}
+	void WriteObject(FMCPJsonWriter& Writer, const FProperty* Property, const void* ValuePtr)
+	{
+		Writer.WriteValue(ObjectPathToString(Property, ValuePtr));
+	}
+
+	TSharedPtr<FJsonValue> SoftObjectToJson(const FProperty* Property, const void* ValuePtr)
+	{
+		return MakeShared<FJsonValueString>(static_cast<const FSoftObjectPtr*>(ValuePtr)->ToString());
+	}
+	void WriteSoftObject(FMCPJsonWriter& Writer, const FProperty* Property, const void* ValuePtr)
+	{
+		Writer.WriteValue(static_cast<const FSoftObjectPtr*>(ValuePtr)->ToString());
+	}
+
+	// Math structs, written as number arrays
+
+	TSharedPtr<FJsonValue> NumbersToJson(std::initializer_list<double> Numbers)
+	{
+		TArray<TSharedPtr<FJsonValue>> Values;
+		Values.Reserve(Numbers.size());
+		for (double Number : Numbers)
+		{
+			Values.Add(MakeShared<FJsonValueNumber>(Number));
+		}
+		return MakeShared<FJsonValueArray>(MoveTemp(Values));
+	}
+	void WriteNumbers(FMCPJsonWriter& Writer, std::initializer_list<double> Numbers)
+	{
+		Writer.BeginArray();
+		for (double Number : Numbers)
+		{
+			Writer.WriteValue(Number);
+		}
+		Writer.EndArray();
+	}
+
+	TSharedPtr<FJsonValue> VectorToJson(const FProperty* Property, const void* ValuePtr)
+	{
+		const FVector& Vec = *static_cast<const FVector*>(ValuePtr);
+		return NumbersToJson({ Vec.X, Vec.Y, Vec.Z });
+	}
+	void WriteVector(FMCPJsonWriter& Writer, const FProperty* Property, const void* ValuePtr)
+	{
+		Writer.WriteValue(*static_cast<const FVector*>(ValuePtr));
+	}
+
+	TSharedPtr<FJsonValue> RotatorToJson(const FProperty* Property, const void* ValuePtr)
+	{
+		const FRotator& Rot = *static_cast<const FRotator*>(ValuePtr);
+		return NumbersToJson({ Rot.Pitch, Rot.Yaw, Rot.Roll });
+	}
+	void WriteRotator(FMCPJsonWriter& Writer, const FProperty* Property, const void* ValuePtr)
+	{
+		Writer.WriteValue(*static_cast<const FRotator*>(ValuePtr));
+	}
+
+	TSharedPtr<FJsonValue> ColorToJson(const FProperty* Property, const void* ValuePtr)
+	{
+		const FColor& Color = *static_cast<const FColor*>(ValuePtr);
+		return NumbersToJson({ (double)Color.R, (double)Color.G, (double)Color.B, (double)Color.A });
+	}
+	void WriteColor(FMCPJsonWriter& Writer, const FProperty* Property, const void* ValuePtr)
+	{
+		const FColor& Color = *static_cast<const FColor*>(ValuePtr);
+		WriteNumbers(Writer, { (double)Color.R, (double)Color.G, (double)Color.B, (double)Color.A });
+	}
+
+	TSharedPtr<FJsonValue> LinearColorToJson(const FProperty* Property, const void* ValuePtr)
+	{
+		const FLinearColor& Color = *static_cast<const FLinearColor*>(ValuePtr);
+		return NumbersToJson({ Color.R, Color.G, Color.B, Color.A });
+	}
+	void WriteLinearColor(FMCPJsonWriter& Writer, const FProperty* Property, const void* ValuePtr)
+	{
+		const FLinearColor& Color = *static_cast<const FLinearColor*>(ValuePtr);
+		WriteNumbers(Writer, { Color.R, Color.G, Color.B, Color.A });
+	}
+
+	// Everything else, as the property's exported text
+
+	FString ExportPropertyText(const FProperty* Property, const void* ValuePtr)
+	{
+		FString ExportedText;
+		Property->ExportTextItem_Direct(ExportedText, ValuePtr, nullptr, nullptr, PPF_None);
+		return ExportedText;
+	}
+	TSharedPtr<FJsonValue> ExportToJson(const FProperty* Property, const void* ValuePtr)
+	{
+		return MakeShared<FJsonValueString>(ExportPropertyText(Property, ValuePtr));
+	}
+	void WriteExport(FMCPJsonWriter& Writer, const FProperty* Property, const void* ValuePtr)
+	{
+		Writer.WriteValue(ExportPropertyText(Property, ValuePtr));
+	}
+
+	const FMCPPropertyWriter BoolWriter = { &BoolToJson, &WriteBool };
+	const FMCPPropertyWriter IntWriter = { &IntToJson, &WriteInt };
+	const FMCPPropertyWriter FloatWriter = { &FloatToJson, &WriteFloat };
+	const FMCPPropertyWriter DoubleWriter = { &DoubleToJson, &WriteDouble };
+	const FMCPPropertyWriter ByteWriter = { &ByteToJson, &WriteByte };
+	const FMCPPropertyWriter StrWriter = { &StrToJson, &WriteStr };
+	const FMCPPropertyWriter NameWriter = { &NameToJson, &WriteName };
+	const FMCPPropertyWriter TextWriter = { &TextToJson, &WriteText };
+	const FMCPPropertyWriter EnumWriter = { &EnumToJson, &WriteEnum };
+	const FMCPPropertyWriter ByteEnumWriter = { &ByteEnumToJson, &WriteByteEnum };
+	const FMCPPropertyWriter ObjectWriter = { &ObjectToJson, &WriteObject };
+	const FMCPPropertyWriter SoftObjectWriter = { &SoftObjectToJson, &WriteSoftObject };
+	const FMCPPropertyWriter VectorWriter = { &VectorToJson, &WriteVector };
+	const FMCPPropertyWriter RotatorWriter = { &RotatorToJson, &WriteRotator };
+	const FMCPPropertyWriter ColorWriter = { &ColorToJson, &WriteColor };
+	const FMCPPropertyWriter LinearColorWriter = { &LinearColorToJson, &WriteLinearColor };
+	const FMCPPropertyWriter ExportWriter = { &ExportToJson, &WriteExport };
+
+	const FMCPPropertyWriter* SelectWriter(const FProperty* Property)
+	{
+		if (Property->IsA<FBoolProperty>())
+		{
+			return &BoolWriter;
+		}
+		if (Property->IsA<FIntProperty>())
+		{
+			return &IntWriter;
+		}
+		if (Property->IsA<FFloatProperty>())
+		{
+			return &FloatWriter;
+		}
+		if (Property->IsA<FDoubleProperty>())
+		{
+			return &DoubleWriter;
+		}
+		if (Property->IsA<FStrProperty>())
+		{
+			return &StrWriter;
+		}
+		if (Property->IsA<FNameProperty>())
+		{
+			return &NameWriter;
+		}
+		if (Property->IsA<FTextProperty>())
+		{
+			return &TextWriter;
+		}
+		if (Property->IsA<FEnumProperty>())
+		{
+			return &EnumWriter;
+		}
+		if (const FByteProperty* ByteProp = CastField<FByteProperty>(Property))
+		{
+			return ByteProp->IsEnum() ? &ByteEnumWriter : &ByteWriter;
+		}
+		// Also covers FClassProperty
+		if (Property->IsA<FObjectProperty>())
+		{
+			return &ObjectWriter;
+		}
+		// Also covers FSoftClassProperty
+		if (Property->IsA<FSoftObjectProperty>())
+		{
+			return &SoftObjectWriter;
+		}
+		if (const FStructProperty* StructProp = CastField<FStructProperty>(Property))
+		{
+			if (StructProp->Struct == TBaseStructure<FVector>::Get())
+			{
+				return &VectorWriter;
+			}
+			if (StructProp->Struct == TBaseStructure<FRotator>::Get())
+			{
+				return &RotatorWriter;
+			}
+			if (StructProp->Struct == TBaseStructure<FColor>::Get())
+			{
+				return &ColorWriter;
+			}
+			if (StructProp->Struct == TBaseStructure<FLinearColor>::Get())
+			{
+				return &LinearColorWriter;
+			}
+		}
+		return &ExportWriter;
+	}
+}
+
+void FMCPSerializationPlan::WriteProperties(FMCPJsonWriter& Writer, const UObject* Object) const
+{
+	const uint8* Base = reinterpret_cast<const uint8*>(Object);
+	for (const FMCPSerializedProperty& Entry : Properties)
+	{
+		Writer.WriteEncodedKey(Entry.EncodedKey);
+		Entry.Writer->Write(Writer, Entry.Property, Base + Entry.Offset);
+	}
+}
+
+void FMCPSerializationPlan::ToJsonObject(const UObject* Object, FJsonObject& OutObject) const
+{
+	const uint8* Base = reinterpret_cast<const uint8*>(Object);
+	OutObject.Values.Reserve(OutObject.Values.Num() + Properties.Num());
+	for (const FMCPSerializedProperty& Entry : Properties)
+	{
+		OutObject.SetField(Entry.Name, Entry.Writer->ToJson(Entry.Property, Base + Entry.Offset));
+	}
+}
+
+FMCPSerializationPlanCache& FMCPSerializationPlanCache::Get()
+{
+	static FMCPSerializationPlanCache Instance;
+	return Instance;
+}
+
+void FMCPSerializationPlanCache::Initialize()
+{
+	if (bInitialized)
+	{
+		return;
+	}
+	bInitialized = true;
+
+	if (GEditor)
+	{
+		BlueprintCompiledHandle = GEditor->OnBlueprintCompiled().AddRaw(this, &FMCPSerializationPlanCache::OnBlueprintCompiled);
+	}
+	ObjectsReinstancedHandle = FCoreUObjectDelegates::OnObjectsReinstanced.AddRaw(this, &FMCPSerializationPlanCache::OnObjectsReinstanced);
+	ReloadCompleteHandle = FCoreUObjectDelegates::ReloadCompleteDelegate.AddRaw(this, &FMCPSerializationPlanCache::OnReloadComplete);
+}
+
+void FMCPSerializationPlanCache::Shutdown()
+{
+	if (!bInitialized)
+	{
+		return;
+	}
+	bInitialized = false;
+
+	if (GEditor)
+	{
+		GEditor->OnBlueprintCompiled().Remove(BlueprintCompiledHandle);
+	}
+	FCoreUObjectDelegates::OnObjectsReinstanced.Remove(ObjectsReinstancedHandle);
+	FCoreUObjectDelegates::ReloadCompleteDelegate.Remove(ReloadCompleteHandle);
+
+	Plans.Empty();
+}
+
+const FMCPSerializationPlan& FMCPSerializationPlanCache::Find(const UClass* Class)
+{
+	TUniquePtr<FMCPSerializationPlan>& Plan = Plans.FindOrAdd(Class);
+	if (!Plan)
+	{
+		Plan = MakeUnique<FMCPSerializationPlan>();
+		Build(Class, *Plan);
+	}
+	return *Plan;
+}
+
+void FMCPSerializationPlanCache::Invalidate()
+{
+	Plans.Empty();
+}
+
+void FMCPSerializationPlanCache::Build(const UClass* Class, FMCPSerializationPlan& OutPlan)
+{
+	for (TFieldIterator<FProperty> PropIt(Class); PropIt; ++PropIt)
+	{
+		const FProperty* Property = *PropIt;
+
+		// Only include properties that are visible or editable in the editor, skipping deprecated and transient ones
+		if (!Property->HasAnyPropertyFlags(CPF_Edit | CPF_EditConst | CPF_BlueprintVisible)
+			|| Property->HasAnyPropertyFlags(CPF_Deprecated | CPF_Transient))
+		{
+			continue;
+		}
+
+		FMCPSerializedProperty& Entry = OutPlan.Properties.AddDefaulted_GetRef();
+		Entry.Property = Property;
+		Entry.Offset = Property->GetOffset_ForInternal();
+		Entry.Name = Property->GetName();
+		Entry.EncodedKey = FMCPJsonWriter::EncodeKey(*Entry.Name);
+		Entry.Writer = SelectWriter(Property);
+	}
+}
+
+void FMCPSerializationPlanCache::OnBlueprintCompiled()
+{
+	Invalidate();
+}
+
+void FMCPSerializationPlanCache::OnObjectsReinstanced(const TMap<UObject*, UObject*>& OldToNew)
+{
+	Invalidate();
+}
+
+void FMCPSerializationPlanCache::OnReloadComplete(EReloadCompleteReason Reason)
+{
+	Invalidate();
+}
@@ -1,22 +1,23 @@
 #include "MCPServerRunnable.h"
+#include "MCPClientConnection.h"
+#include "MCPPawnControl.h"
 #include "UnrealMCPBridge.h"
 #include "Sockets.h"
 #include "SocketSubsystem.h"
 #include "Interfaces/IPv4/IPv4Address.h"
-#include "Dom/JsonObject.h"
-#include "Dom/JsonValue.h"
-#include "Serialization/JsonSerializer.h"
-#include "Serialization/JsonReader.h"
-#include "JsonObjectConverter.h"
-#include "Misc/ScopeLock.h"
-#include "HAL/PlatformTime.h"
+#include "MCPJsonWriter.h"
+#include "MCPJsonKeys.h"
+#include "Async/Async.h"
+#include "HAL/PlatformProcess.h"
+#include "Misc/QueuedThreadPool.h"
 
-// Buffer size for receiving data
-const int32 MCPRecvBufferSize = 8192;
+// Socket buffer size for accepted clients
+static constexpr int32 MCPSocketBufferSize = 256 * 1024;
 
 FMCPServerRunnable::FMCPServerRunnable(UUnrealMCPBridge* InBridge, TSharedPtr<FSocket> InListenerSocket)
     : Bridge(InBridge)
     , ListenerSocket(InListenerSocket)
+    , NextConnectionId(1)
     , bRunning(true)
 {
     UE_LOG(LogTemp, Display, TEXT("MCPServerRunnable: Created server runnable"));
@@ -24,7 +25,7 @@ FMCPServerRunnable::FMCPServerRunnable(UUnrealMCPBridge* InBridge, TSharedPtr<FS
 
 FMCPServerRunnable::~FMCPServerRunnable()
 {
-    // Note: We don't delete the sockets here as they're owned by the bridge
+    // Note: We don't delete the listener socket here as it's owned by the bridge
 }
 
 bool FMCPServerRunnable::Init()
@@ -35,132 +36,56 @@ bool FMCPServerRunnable::Init()
 uint32 FMCPServerRunnable::Run()
 {
     UE_LOG(LogTemp, Display, TEXT("MCPServerRunnable: Server thread starting..."));
-    
+
+    TArray<TArray<uint8>> Frames;
     while (bRunning)
     {
-        // UE_LOG(LogTemp, Display, TEXT("MCPServerRunnable: Waiting for client connection..."));
-        
-        bool bPending = false;
-        if (ListenerSocket->HasPendingConnection(bPending) && bPending)
+        AcceptPendingConnections();
+
+        bool bActivity = false;
+        for (int32 Index = Connections.Num() - 1; Index >= 0; --Index)
         {
-            UE_LOG(LogTemp, Display, TEXT("MCPServerRunnable: Client connection pending, accepting..."));
-            
-            ClientSocket = MakeShareable(
-                ListenerSocket->Accept(TEXT("MCPClient")),
-                [](FSocket* Socket) {
-                    if (Socket)
-                    {
-                        ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->DestroySocket(Socket);
-                    }
-                }
-            );
-            if (ClientSocket.IsValid())
-            {
-                UE_LOG(LogTemp, Display, TEXT("MCPServerRunnable: Client connection accepted"));
-                
-                // Set socket options to improve connection stability
-                ClientSocket->SetNoDelay(true);
-                int32 SocketBufferSize = 65536;  // 64KB buffer
-                ClientSocket->SetSendBufferSize(SocketBufferSize, SocketBufferSize);
-                ClientSocket->SetReceiveBufferSize(SocketBufferSize, SocketBufferSize);
-                
-                uint8 Buffer[8192];
-                while (bRunning)
-                {
-                    int32 BytesRead = 0;
-                    if (ClientSocket->Recv(Buffer, sizeof(Buffer), BytesRead))
-                    {
-                        if (BytesRead == 0)
-                        {
-                            UE_LOG(LogTemp, Display, TEXT("MCPServerRunnable: Client disconnected (zero bytes)"));
-                            break;
-                        }
+            TSharedPtr<FMCPClientConnection, ESPMode::ThreadSafe> Connection = Connections[Index];
 
-                        // Convert received data to string
-                        Buffer[BytesRead] = '\0';
-                        FString ReceivedText = UTF8_TO_TCHAR(Buffer);
-                        UE_LOG(LogTemp, Display, TEXT("MCPServerRunnable: Received: %s"), *ReceivedText);
+            Frames.Reset();
+            const bool bOpen = Connection->ReceiveFrames(Frames);
+            for (TArray<uint8>& Frame : Frames)
+            {
+                bActivity = true;
 
-                        // Parse JSON
-                        TSharedPtr<FJsonObject> JsonObject;
-                        TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(ReceivedText);
-                        
-                        if (FJsonSerializer::Deserialize(Reader, JsonObject))
-                        {
-                            // Get command type
-                            FString CommandType;
-                            if (JsonObject->TryGetStringField(TEXT("type"), CommandType))
-                            {
-                                // Execute command
-                                FString Response = Bridge->ExecuteCommand(CommandType, JsonObject->GetObjectField(TEXT("params")));
-                                
-                                // Log response for debugging
-                                UE_LOG(LogTemp, Display, TEXT("MCPServerRunnable: Sending response: %s"), *Response);
-                                
-                                // Send response - use proper UTF-8 byte length (not TCHAR count)
-                                auto Utf8Response = StringCast<ANSICHAR>(*Response);
-                                int32 Utf8Len = FCStringAnsi::Strlen(Utf8Response.Get());
-                                int32 BytesSent = 0;
-                                if (!ClientSocket->Send((const uint8*)Utf8Response.Get(), Utf8Len, BytesSent))
-                                {
-                                    UE_LOG(LogTemp, Warning, TEXT("MCPServerRunnable: Failed to send response"));
-                                }
-                                else {
-                                    UE_LOG(LogTemp, Display, TEXT("MCPServerRunnable: Response sent successfully, bytes: %d"), BytesSent);
-                                }
-                            }
-                            else
-                            {
-                                UE_LOG(LogTemp, Warning, TEXT("MCPServerRunnable: Missing 'type' field in command"));
-                            }
-                        }
-                        else
-                        {
-                            UE_LOG(LogTemp, Warning, TEXT("MCPServerRunnable: Failed to parse JSON from: %s"), *ReceivedText);
-                        }
-                    }
-                    else
-                    {
-                        int32 LastError = (int32)ISocketSubsystem::Get()->GetLastErrorCode();
-                        // Don't break the connection for WouldBlock error, which is normal for non-blocking sockets
-                        bool bShouldBreak = true;
-                        
-                        // Check for "would block" error which isn't a real error for non-blocking sockets
-                        if (LastError == SE_EWOULDBLOCK) 
-                        {
-                            UE_LOG(LogTemp, Verbose, TEXT("MCPServerRunnable: Socket would block, continuing..."));
-                            bShouldBreak = false;
-                            // Small sleep to prevent tight loop when no data
-                            FPlatformProcess::Sleep(0.01f);
-                        }
-                        // Check for other transient errors we might want to tolerate
-                        else if (LastError == SE_EINTR) // Interrupted system call
-                        {
-                            UE_LOG(LogTemp, Warning, TEXT("MCPServerRunnable: Socket read interrupted, continuing..."));
-                            bShouldBreak = false;
-                        }
-                        else 
-                        {
-                            UE_LOG(LogTemp, Warning, TEXT("MCPServerRunnable: Client disconnected or error. Last error code: %d"), LastError);
-                        }
-                        
-                        if (bShouldBreak)
-                        {
-                            break;
-                        }
-                    }
+                // Binary control frames carry no response; they skip the request queue entirely
+                if (Frame.Num() > 0 && Frame[0] == MCPBinaryFrameMagic)
+                {
+                    FMCPPawnControl::Get().Submit(*Connection, Frame);
+                    continue;
+                }
+                if (Connection->EnqueueFrame(MoveTemp(Frame)))
+                {
+                    ScheduleDrain(Connection);
                 }
             }
-            else
+
+            if (!bOpen)
             {
-                UE_LOG(LogTemp, Warning, TEXT("MCPServerRunnable: Failed to accept client connection"));
+                // Queued frames still run (and populate the idempotency cache); only the socket goes away
+                Connection->CloseSocket();
+                Connections.RemoveAtSwap(Index);
             }
         }
-        
-        // Small sleep to prevent tight loop
-        FPlatformProcess::Sleep(0.1f);
+
+        // Stay responsive while clients are connected, back off when idle
+        if (!bActivity)
+        {
+            FPlatformProcess::Sleep(Connections.Num() > 0 ? 0.001f : 0.01f);
+        }
     }
-    
+
+    for (const TSharedPtr<FMCPClientConnection, ESPMode::ThreadSafe>& Connection : Connections)
+    {
+        Connection->CloseSocket();
+    }
+    Connections.Empty();
+
     UE_LOG(LogTemp, Display, TEXT("MCPServerRunnable: Server thread stopping"));
     return 0;
 }
@@ -174,161 +99,138 @@ void FMCPServerRunnable::Exit()
 {
 }
 
-void FMCPServerRunnable::HandleClientConnection(TSharedPtr<FSocket> InClientSocket)
+void FMCPServerRunnable::AcceptPendingConnections()
 {
-    if (!InClientSocket.IsValid())
+    bool bPending = false;
+    while (ListenerSocket->HasPendingConnection(bPending) && bPending)
     {
-        UE_LOG(LogTemp, Error, TEXT("MCPServerRunnable: Invalid client socket passed to HandleClientConnection"));
-        return;
-    }
-
-    UE_LOG(LogTemp, Display, TEXT("MCPServerRunnable: Starting to handle client connection"));
-    
-    // Set socket options for better connection stability
-    InClientSocket->SetNonBlocking(false);
-    UE_LOG(LogTemp, Display, TEXT("MCPServerRunnable: Set socket to blocking mode"));
-    
-    // Properly read full message with timeout
-    const int32 MaxBufferSize = 4096;
-    uint8 Buffer[MaxBufferSize];
-    FString MessageBuffer;
-    
-    UE_LOG(LogTemp, Display, TEXT("MCPServerRunnable: Starting message receive loop"));
-    
-    while (bRunning && InClientSocket.IsValid())
-    {
-        // Log socket state
-        bool bIsConnected = InClientSocket->GetConnectionState() == SCS_Connected;
-        UE_LOG(LogTemp, Display, TEXT("MCPServerRunnable: Socket state - Connected: %s"), 
-               bIsConnected ? TEXT("true") : TEXT("false"));
-        
-        // Log pending data status before receive
-        uint32 PendingDataSize = 0;
-        bool HasPendingData = InClientSocket->HasPendingData(PendingDataSize);
-        UE_LOG(LogTemp, Display, TEXT("MCPServerRunnable: Before Recv - HasPendingData=%s, Size=%d"), 
-               HasPendingData ? TEXT("true") : TEXT("false"), PendingDataSize);
-        
-        // Try to receive data with timeout
-        int32 BytesRead = 0;
-        bool bReadSuccess = false;
-        
-        UE_LOG(LogTemp, Display, TEXT("MCPServerRunnable: Attempting to receive data..."));
-        bReadSuccess = InClientSocket->Recv(Buffer, MaxBufferSize, BytesRead, ESocketReceiveFlags::None);
-        
-        UE_LOG(LogTemp, Display, TEXT("MCPServerRunnable: Recv attempt complete - Success=%s, BytesRead=%d"), 
-               bReadSuccess ? TEXT("true") : TEXT("false"), BytesRead);
-        
-        if (BytesRead > 0)
-        {
-            // Log raw data for debugging
-            FString HexData;
-            for (int32 i = 0; i < FMath::Min(BytesRead, 50); ++i)
-            {
-                HexData += FString::Printf(TEXT("%02X "), Buffer[i]);
-            }
-            UE_LOG(LogTemp, Display, TEXT("MCPServerRunnable: Raw data (first 50 bytes hex): %s%s"), 
-                   *HexData, BytesRead > 50 ? TEXT("...") : TEXT(""));
-            
-            // Convert and log received data
-            Buffer[BytesRead] = 0; // Null terminate
-            FString ReceivedData = UTF8_TO_TCHAR(Buffer);
-            UE_LOG(LogTemp, Display, TEXT("MCPServerRunnable: Received data as string: '%s'"), *ReceivedData);
-            
-            // Append to message buffer
-            MessageBuffer.Append(ReceivedData);
-            
-            // Process complete messages (messages are terminated with newline)
-            if (MessageBuffer.Contains(TEXT("\n")))
-            {
-                UE_LOG(LogTemp, Display, TEXT("MCPServerRunnable: Newline detected in buffer, processing messages"));
-                
-                TArray<FString> Messages;
-                MessageBuffer.ParseIntoArray(Messages, TEXT("\n"), true);
-                
-                UE_LOG(LogTemp, Display, TEXT("MCPServerRunnable: Found %d message(s) in buffer"), Messages.Num());
-                
-                // Process all complete messages
-                for (int32 i = 0; i < Messages.Num() - 1; ++i)
+        TSharedPtr<FSocket> ClientSocket = MakeShareable(
+            ListenerSocket->Accept(TEXT("MCPClient")),
+            [](FSocket* Socket) {
+                if (Socket)
                 {
-                    UE_LOG(LogTemp, Display, TEXT("MCPServerRunnable: Processing message %d: '%s'"), 
-                           i + 1, *Messages[i]);
-                    ProcessMessage(InClientSocket, Messages[i]);
+                    ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->DestroySocket(Socket);
                 }
-                
-                // Keep any incomplete message in the buffer
-                MessageBuffer = Messages.Last();
-                UE_LOG(LogTemp, Display, TEXT("MCPServerRunnable: Remaining buffer after processing: %s"), 
-                       *MessageBuffer);
             }
-            else
-            {
-                UE_LOG(LogTemp, Display, TEXT("MCPServerRunnable: No complete message yet (no newline detected)"));
-            }
-        }
-        else if (!bReadSuccess)
+        );
+        if (!ClientSocket.IsValid())
         {
-            UE_LOG(LogTemp, Warning, TEXT("MCPServerRunnable: Connection closed or error occurred - Last error: %d"), 
-                   (int32)ISocketSubsystem::Get()->GetLastErrorCode());
-            break;
+            UE_LOG(LogTemp, Warning, TEXT("MCPServerRunnable: Failed to accept client connection"));
+            return;
         }
-        
-        // Small sleep to prevent tight loop
-        FPlatformProcess::Sleep(0.01f);
+
+        // Set socket options to improve connection stability
+        int32 ActualSize = 0;
+        ClientSocket->SetNonBlocking(true);
+        ClientSocket->SetNoDelay(true);
+        ClientSocket->SetSendBufferSize(MCPSocketBufferSize, ActualSize);
+        ClientSocket->SetReceiveBufferSize(MCPSocketBufferSize, ActualSize);
+
+        const int32 ConnectionId = NextConnectionId++;
+        Connections.Add(MakeShared<FMCPClientConnection, ESPMode::ThreadSafe>(ClientSocket, ConnectionId));
+        UE_LOG(LogTemp, Display, TEXT("MCPServerRunnable: Client connection %d accepted (%d open)"), ConnectionId, Connections.Num());
     }
-    
-    UE_LOG(LogTemp, Display, TEXT("MCPServerRunnable: Exited message receive loop"));
 }
 
-void FMCPServerRunnable::ProcessMessage(TSharedPtr<FSocket> Client, const FString& Message)
+void FMCPServerRunnable::ScheduleDrain(const TSharedPtr<FMCPClientConnection, ESPMode::ThreadSafe>& Connection)
 {
-    UE_LOG(LogTemp, Display, TEXT("MCPServerRunnable: Processing message: %s"), *Message);
-    
-    // Parse message as JSON
-    TSharedPtr<FJsonObject> JsonMessage;
-    TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Message);
-    
-    if (!FJsonSerializer::Deserialize(Reader, JsonMessage) || !JsonMessage.IsValid())
+    UUnrealMCPBridge* LocalBridge = Bridge;
+    FQueuedThreadPool* WorkerPool = Bridge->GetWorkerPool();
+    if (!WorkerPool)
     {
-        UE_LOG(LogTemp, Warning, TEXT("MCPServerRunnable: Failed to parse message as JSON"));
+        // Pool unavailable (shutting down): process inline rather than dropping requests
+        DrainConnection(LocalBridge, Connection);
         return;
     }
-    
-    // Extract command type and parameters using MCP protocol format
-    FString CommandType;
-    TSharedPtr<FJsonObject> Params = MakeShareable(new FJsonObject());
-    
-    if (!JsonMessage->TryGetStringField(TEXT("command"), CommandType))
+
+    AsyncPool(*WorkerPool, [LocalBridge, Connection]()
     {
-        UE_LOG(LogTemp, Warning, TEXT("MCPServerRunnable: Message missing 'command' field"));
-        return;
-    }
-    
-    // Parameters are optional in MCP protocol
-    if (JsonMessage->HasField(TEXT("params")))
+        DrainConnection(LocalBridge, Connection);
+    });
+}
+
+void FMCPServerRunnable::DrainConnection(UUnrealMCPBridge* Bridge, const TSharedPtr<FMCPClientConnection, ESPMode::ThreadSafe>& Connection)
+{
+    do
     {
-        TSharedPtr<FJsonValue> ParamsValue = JsonMessage->TryGetField(TEXT("params"));
-        if (ParamsValue.IsValid() && ParamsValue->Type == EJson::Object)
+        TArray<uint8> Frame;
+        while (Connection->DequeueFrame(Frame))
         {
-            Params = ParamsValue->AsObject();
+            ProcessFrame(Bridge, *Connection, MoveTemp(Frame));
         }
     }
-    
-    UE_LOG(LogTemp, Display, TEXT("MCPServerRunnable: Executing command: %s"), *CommandType);
-    
-    // Execute command
-    FString Response = Bridge->ExecuteCommand(CommandType, Params);
-    
-    // Send response with newline terminator
-    Response += TEXT("\n");
-    int32 BytesSent = 0;
+    while (Connection->FinishDrain());
+}
+
+void FMCPServerRunnable::ProcessFrame(UUnrealMCPBridge* Bridge, FMCPClientConnection& Connection, TArray<uint8>&& Frame)
+{
+    TArray<uint8> Response;
+    FMCPParsedRequest Request;
+    FString ParseError;
+    if (ParseRequest(MoveTemp(Frame), Request, ParseError))
+    {
+        Response = Bridge->ExecuteCommand(Request.CommandType, Request.Document.ToSharedRef(), Request.Params, Request.IdempotencyKey, Connection.AsShared(), Request.MutationSession);
+    }
+    else
+    {
+        UE_LOG(LogTemp, Warning, TEXT("MCPServerRunnable: Rejected request on connection %d: %s"), Connection.GetConnectionId(), *ParseError);
+        Response = MakeErrorResponse(ParseError);
+    }
+
+    if (!Connection.SendResponse(MoveTemp(Response)))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("MCPServerRunnable: Failed to send response on connection %d"), Connection.GetConnectionId());
+    }
+}
+
+bool FMCPServerRunnable::ParseRequest(TArray<uint8>&& Frame, FMCPParsedRequest& OutRequest, FString& OutError)
+{
+    TSharedRef<FMCPJsonDocument, ESPMode::ThreadSafe> Document = MakeShared<FMCPJsonDocument, ESPMode::ThreadSafe>();
+    if (!Document->Parse(MoveTemp(Frame)))
+    {
+        OutError = FString::Printf(TEXT("Invalid JSON request: %s"), *Document->GetError());
+        return false;
+    }
+
+    const FMCPJsonObjectView Root = Document->GetRootObject();
+    if (!Root.IsValid())
+    {
+        OutError = TEXT("Request must be a JSON object");
+        return false;
+    }
 
-    UE_LOG(LogTemp, Display, TEXT("MCPServerRunnable: Sending response: %s"), *Response);
+    if (!Root.TryGetStringField(MCPKeys::Type, OutRequest.CommandType) || OutRequest.CommandType.IsEmpty())
+    {
+        OutError = TEXT("Missing 'type' field in command");
+        return false;
+    }
 
-    // Use proper UTF-8 byte length (not TCHAR character count)
-    auto Utf8Response = StringCast<ANSICHAR>(*Response);
-    int32 Utf8Len = FCStringAnsi::Strlen(Utf8Response.Get());
-    if (!Client->Send((const uint8*)Utf8Response.Get(), Utf8Len, BytesSent))
+    // Parameters are optional, but must be an object when present. A missing object
+    // yields an invalid view, which handlers treat as having no fields.
+    const FMCPJsonValueView ParamsValue = Root.FindField(MCPKeys::Params);
+    if (ParamsValue.IsValid() && !ParamsValue.IsNull() && !ParamsValue.TryGetObject(OutRequest.Params))
     {
-        UE_LOG(LogTemp, Error, TEXT("MCPServerRunnable: Failed to send response"));
+        OutError = TEXT("'params' must be a JSON object");
+        return false;
     }
-} 
\ No newline at end of file
+
+    Root.TryGetStringField(TEXT("idempotency_key"), OutRequest.IdempotencyKey);
+    Root.TryGetStringField(TEXT("mutation_session"), OutRequest.MutationSession);
+    OutRequest.Document = Document;
+    return true;
+}
+
+TArray<uint8> FMCPServerRunnable::MakeErrorResponse(const FString& Message)
+{
+    FMCPJsonWriter Writer;
+    WriteErrorResponse(Writer, Message);
+    return Writer.MoveBuffer();
+}
+
+void FMCPServerRunnable::WriteErrorResponse(FMCPJsonWriter& Writer, const FString& Message)
+{
+    Writer.BeginObject();
+    Writer.WriteField(MCPKeys::Status, TEXT("error"));
+    Writer.WriteField(MCPKeys::Error, Message);
+    Writer.EndObject();
+}
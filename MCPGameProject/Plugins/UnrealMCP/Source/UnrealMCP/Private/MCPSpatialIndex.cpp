@@ -0,0 +1,401 @@
+#include "MCPSpatialIndex.h"
+#include "ConvexVolume.h"
+#include "Editor.h"
+#include "Engine/Level.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "GameFramework/Actor.h"
+
+namespace
+{
+	// Half-size of the root node; actors outside still index correctly, just less tightly
+	constexpr FVector::FReal MCPSpatialWorldExtent = 2097152.0;
+
+	// First radius tried by nearest-neighbour queries before doubling
+	constexpr double MCPNearestStartRadius = 1000.0;
+
+	void SortByDistance(TArray<FMCPSpatialHit>& Hits)
+	{
+		Hits.Sort([](const FMCPSpatialHit& A, const FMCPSpatialHit& B) { return A.Distance < B.Distance; });
+	}
+}
+
+void FMCPSpatialOctreeSemantics::SetElementId(TOctree2<FMCPSpatialElement, FMCPSpatialOctreeSemantics>& Octree, const FMCPSpatialElement& Element, FOctreeElementId2 Id)
+{
+	// Only FMCPSpatialOctree instances are ever created with these semantics
+	static_cast<FMCPSpatialOctree&>(Octree).ElementIds.Add(Element.ActorKey, Id);
+}
+
+FMCPSpatialIndex& FMCPSpatialIndex::Get()
+{
+	static FMCPSpatialIndex Instance;
+	return Instance;
+}
+
+void FMCPSpatialIndex::Initialize()
+{
+	if (bInitialized || !GEngine)
+	{
+		return;
+	}
+	bInitialized = true;
+
+	ActorAddedHandle = GEngine->OnLevelActorAdded().AddRaw(this, &FMCPSpatialIndex::OnActorAdded);
+	ActorDeletedHandle = GEngine->OnLevelActorDeleted().AddRaw(this, &FMCPSpatialIndex::OnActorDeleted);
+	ActorMovedHandle = GEngine->OnActorMoved().AddRaw(this, &FMCPSpatialIndex::OnActorMoved);
+	LevelAddedHandle = FWorldDelegates::LevelAddedToWorld.AddRaw(this, &FMCPSpatialIndex::OnLevelChanged);
+	LevelRemovedHandle = FWorldDelegates::LevelRemovedFromWorld.AddRaw(this, &FMCPSpatialIndex::OnLevelChanged);
+	WorldCleanupHandle = FWorldDelegates::OnWorldCleanup.AddRaw(this, &FMCPSpatialIndex::OnWorldCleanup);
+	UndoRedoHandle = FEditorDelegates::PostUndoRedo.AddRaw(this, &FMCPSpatialIndex::OnUndoRedo);
+}
+
+void FMCPSpatialIndex::Shutdown()
+{
+	if (!bInitialized)
+	{
+		return;
+	}
+	bInitialized = false;
+
+	if (GEngine)
+	{
+		GEngine->OnLevelActorAdded().Remove(ActorAddedHandle);
+		GEngine->OnLevelActorDeleted().Remove(ActorDeletedHandle);
+		GEngine->OnActorMoved().Remove(ActorMovedHandle);
+	}
+	FWorldDelegates::LevelAddedToWorld.Remove(LevelAddedHandle);
+	FWorldDelegates::LevelRemovedFromWorld.Remove(LevelRemovedHandle);
+	FWorldDelegates::OnWorldCleanup.Remove(WorldCleanupHandle);
+	FEditorDelegates::PostUndoRedo.Remove(UndoRedoHandle);
+
+	Invalidate();
+}
+
+void FMCPSpatialIndex::QueryBox(UWorld* World, const FBox& Box, TArray<FMCPSpatialHit>& OutHits)
+{
+	OutHits.Reset();
+	FWorldIndex* Index = GetIndex(World);
+	if (!Index)
+	{
+		return;
+	}
+
+	Index->Octree->FindElementsWithBoundsTest(FBoxCenterAndExtent(Box), [&OutHits, &Box](const FMCPSpatialElement& Element)
+	{
+		if (Box.IsInsideOrOn(Element.Location))
+		{
+			if (AActor* Actor = Element.Actor.Get())
+			{
+				OutHits.Add(FMCPSpatialHit{ Actor, 0.0 });
+			}
+		}
+	});
+}
+
+void FMCPSpatialIndex::QuerySphere(UWorld* World, const FVector& Center, double Radius, TArray<FMCPSpatialHit>& OutHits)
+{
+	OutHits.Reset();
+	FWorldIndex* Index = GetIndex(World);
+	if (!Index)
+	{
+		return;
+	}
+
+	const double RadiusSquared = Radius * Radius;
+	Index->Octree->FindElementsWithBoundsTest(FBoxCenterAndExtent(Center, FVector(Radius)), [&](const FMCPSpatialElement& Element)
+	{
+		const double DistanceSquared = FVector::DistSquared(Center, Element.Location);
+		if (DistanceSquared <= RadiusSquared)
+		{
+			if (AActor* Actor = Element.Actor.Get())
+			{
+				OutHits.Add(FMCPSpatialHit{ Actor, FMath::Sqrt(DistanceSquared) });
+			}
+		}
+	});
+	SortByDistance(OutHits);
+}
+
+void FMCPSpatialIndex::QueryNearest(UWorld* World, const FVector& Point, int32 Count, double MaxDistance, TArray<FMCPSpatialHit>& OutHits)
+{
+	OutHits.Reset();
+	if (Count <= 0 || MaxDistance <= 0.0)
+	{
+		return;
+	}
+
+	// Grow the search sphere until it holds Count actors; everything inside a sphere
+	// of radius R is exact, so the first R that yields Count hits gives the answer
+	const double Limit = FMath::Min(MaxDistance, MCPSpatialWorldExtent * 2.0);
+	double Radius = FMath::Min(MCPNearestStartRadius, Limit);
+	for (;;)
+	{
+		QuerySphere(World, Point, Radius, OutHits);
+		if (OutHits.Num() >= Count || Radius >= Limit)
+		{
+			break;
+		}
+		Radius = FMath::Min(Radius * 2.0, Limit);
+	}
+
+	if (OutHits.Num() > Count)
+	{
+		OutHits.SetNum(Count, EAllowShrinking::No);
+	}
+}
+
+void FMCPSpatialIndex::QueryFrustum(UWorld* World, const FConvexVolume& Frustum, const FVector& Origin, double MaxDistance, TArray<FMCPSpatialHit>& OutHits)
+{
+	OutHits.Reset();
+	FWorldIndex* Index = GetIndex(World);
+	if (!Index)
+	{
+		return;
+	}
+
+	const double MaxDistanceSquared = MaxDistance * MaxDistance;
+	Index->Octree->FindElementsWithBoundsTest(FBoxCenterAndExtent(Origin, FVector(MaxDistance)), [&](const FMCPSpatialElement& Element)
+	{
+		const FBox Box = Element.Bounds.GetBox();
+		if (Box.ComputeSquaredDistanceToPoint(Origin) > MaxDistanceSquared)
+		{
+			return;
+		}
+		if (!Frustum.IntersectBox(FVector(Element.Bounds.Center), FVector(Element.Bounds.Extent)))
+		{
+			return;
+		}
+		if (AActor* Actor = Element.Actor.Get())
+		{
+			OutHits.Add(FMCPSpatialHit{ Actor, FVector::Dist(Origin, Element.Location) });
+		}
+	});
+	SortByDistance(OutHits);
+}
+
+void FMCPSpatialIndex::Invalidate()
+{
+	for (TPair<TObjectKey<UWorld>, FWorldIndex>& Pair : Worlds)
+	{
+		ReleaseWorld(Pair.Value);
+	}
+	Worlds.Empty();
+}
+
+FMCPSpatialIndex::FWorldIndex* FMCPSpatialIndex::GetIndex(UWorld* World)
+{
+	if (!World)
+	{
+		return nullptr;
+	}
+
+	FWorldIndex* Index = Worlds.Find(World);
+	if (!Index)
+	{
+		Index = &Worlds.Add(World);
+		BuildIndex(World, *Index);
+	}
+	FlushDirty(*Index);
+	return Index;
+}
+
+void FMCPSpatialIndex::BuildIndex(UWorld* World, FWorldIndex& Index)
+{
+	const double StartTime = FPlatformTime::Seconds();
+
+	Index.Octree = MakeUnique<FMCPSpatialOctree>(FVector::ZeroVector, MCPSpatialWorldExtent);
+	for (TActorIterator<AActor> It(World); It; ++It)
+	{
+		if (AActor* Actor = *It)
+		{
+			AddActor(Index, Actor);
+		}
+	}
+
+	UE_LOG(LogTemp, Verbose, TEXT("MCPSpatialIndex: Indexed %d actors in %s (%.1f ms)"),
+		Index.Tracked.Num(), *World->GetMapName(), (FPlatformTime::Seconds() - StartTime) * 1000.0);
+}
+
+bool FMCPSpatialIndex::MakeElement(AActor* Actor, FMCPSpatialElement& OutElement)
+{
+	// Actors without a root component have no placement
+	if (!Actor->GetRootComponent())
+	{
+		return false;
+	}
+
+	const FVector Location = Actor->GetActorLocation();
+	FVector Origin;
+	FVector Extent;
+	Actor->GetActorBounds(/*bOnlyCollidingComponents=*/ false, Origin, Extent, /*bIncludeFromChildActors=*/ false);
+
+	FBox Box(Location, Location);
+	if (!Extent.IsNearlyZero())
+	{
+		Box += FBox(Origin - Extent, Origin + Extent);
+	}
+
+	OutElement.ActorKey = Actor;
+	OutElement.Actor = Actor;
+	OutElement.Bounds = FBoxCenterAndExtent(Box);
+	OutElement.Location = Location;
+	return true;
+}
+
+void FMCPSpatialIndex::AddActor(FWorldIndex& Index, AActor* Actor)
+{
+	const TObjectKey<AActor> ActorKey(Actor);
+	FTrackedActor* Existing = Index.Tracked.Find(ActorKey);
+	if (Existing && Existing->Root.Get() == Actor->GetRootComponent())
+	{
+		// Plain move: re-insert the element, keep the transform binding
+		FOctreeElementId2 ElementId;
+		if (Index.Octree->ElementIds.RemoveAndCopyValue(ActorKey, ElementId) && Index.Octree->IsValidElementId(ElementId))
+		{
+			Index.Octree->RemoveElement(ElementId);
+		}
+		FMCPSpatialElement Element;
+		if (MakeElement(Actor, Element))
+		{
+			Index.Octree->AddElement(Element);
+		}
+		return;
+	}
+	if (Existing)
+	{
+		RemoveActor(Index, ActorKey);
+	}
+
+	FMCPSpatialElement Element;
+	if (!MakeElement(Actor, Element))
+	{
+		return;
+	}
+	Index.Octree->AddElement(Element);
+
+	USceneComponent* Root = Actor->GetRootComponent();
+	FTrackedActor& Tracked = Index.Tracked.Add(ActorKey);
+	Tracked.Root = Root;
+	Tracked.TransformHandle = Root->TransformUpdated.AddRaw(this, &FMCPSpatialIndex::OnRootTransformUpdated);
+}
+
+void FMCPSpatialIndex::RemoveActor(FWorldIndex& Index, const TObjectKey<AActor>& ActorKey)
+{
+	FTrackedActor Tracked;
+	if (Index.Tracked.RemoveAndCopyValue(ActorKey, Tracked))
+	{
+		if (USceneComponent* Root = Tracked.Root.Get())
+		{
+			Root->TransformUpdated.Remove(Tracked.TransformHandle);
+		}
+	}
+
+	FOctreeElementId2 ElementId;
+	if (Index.Octree->ElementIds.RemoveAndCopyValue(ActorKey, ElementId) && Index.Octree->IsValidElementId(ElementId))
+	{
+		Index.Octree->RemoveElement(ElementId);
+	}
+	Index.Dirty.Remove(ActorKey);
+}
+
+void FMCPSpatialIndex::FlushDirty(FWorldIndex& Index)
+{
+	if (Index.Dirty.Num() == 0)
+	{
+		return;
+	}
+
+	TSet<TObjectKey<AActor>> Moved = MoveTemp(Index.Dirty);
+	Index.Dirty.Reset();
+	for (const TObjectKey<AActor>& ActorKey : Moved)
+	{
+		AActor* Actor = ActorKey.ResolveObjectPtr();
+		if (Actor)
+		{
+			AddActor(Index, Actor);
+		}
+		else
+		{
+			RemoveActor(Index, ActorKey);
+		}
+	}
+}
+
+void FMCPSpatialIndex::ReleaseWorld(FWorldIndex& Index)
+{
+	for (TPair<TObjectKey<AActor>, FTrackedActor>& Pair : Index.Tracked)
+	{
+		if (USceneComponent* Root = Pair.Value.Root.Get())
+		{
+			Root->TransformUpdated.Remove(Pair.Value.TransformHandle);
+		}
+	}
+	Index.Tracked.Empty();
+	Index.Dirty.Empty();
+	Index.Octree.Reset();
+}
+
+void FMCPSpatialIndex::InvalidateWorld(UWorld* World)
+{
+	if (FWorldIndex* Index = World ? Worlds.Find(World) : nullptr)
+	{
+		ReleaseWorld(*Index);
+		Worlds.Remove(World);
+	}
+}
+
+void FMCPSpatialIndex::OnActorAdded(AActor* Actor)
+{
+	if (Actor && !Actor->IsTemplate())
+	{
+		// Worlds that were never queried stay unindexed until they are
+		if (FWorldIndex* Index = Worlds.Find(Actor->GetWorld()))
+		{
+			Index->Dirty.Add(Actor);
+		}
+	}
+}
+
+void FMCPSpatialIndex::OnActorDeleted(AActor* Actor)
+{
+	if (Actor)
+	{
+		if (FWorldIndex* Index = Worlds.Find(Actor->GetWorld()))
+		{
+			RemoveActor(*Index, Actor);
+		}
+	}
+}
+
+void FMCPSpatialIndex::OnActorMoved(AActor* Actor)
+{
+	// Covers editor moves of actors whose root changed since they were indexed
+	OnActorAdded(Actor);
+}
+
+void FMCPSpatialIndex::OnRootTransformUpdated(USceneComponent* Component, EUpdateTransformFlags UpdateFlags, ETeleportType Teleport)
+{
+	AActor* Actor = Component ? Component->GetOwner() : nullptr;
+	if (Actor)
+	{
+		if (FWorldIndex* Index = Worlds.Find(Actor->GetWorld()))
+		{
+			Index->Dirty.Add(Actor);
+		}
+	}
+}
+
+void FMCPSpatialIndex::OnLevelChanged(ULevel* Level, UWorld* World)
+{
+	InvalidateWorld(World);
+}
+
+void FMCPSpatialIndex::OnWorldCleanup(UWorld* World, bool bSessionEnded, bool bCleanupResources)
+{
+	InvalidateWorld(World);
+}
+
+void FMCPSpatialIndex::OnUndoRedo()
+{
+	Invalidate();
+}
@@ -0,0 +1,322 @@
+#include "MCPViewportStream.h"
+#include "MCPClientConnection.h"
+#include "MCPJsonKeys.h"
+#include "MCPJsonWriter.h"
+#include "MCPScreenshotCapture.h"
+#include "Hash/xxhash.h"
+#include "IImageWrapperModule.h"
+#include "Misc/Base64.h"
+#include "Modules/ModuleManager.h"
+#include "Tasks/Task.h"
+
+namespace
+{
+	const TCHAR* FormatName(EMCPImageFormat Format)
+	{
+		return Format == EMCPImageFormat::Jpeg ? TEXT("jpeg") : TEXT("png");
+	}
+
+	/** Whether any pixel of Rect differs between two frames of the same size. */
+	bool IsTileChanged(const TArray<FColor>& Current, const TArray<FColor>& Previous, int32 Width, const FIntRect& Rect)
+	{
+		const SIZE_T RowBytes = Rect.Width() * sizeof(FColor);
+		for (int32 Y = Rect.Min.Y; Y < Rect.Max.Y; ++Y)
+		{
+			const int64 Offset = (int64)Y * Width + Rect.Min.X;
+			if (FMemory::Memcmp(Current.GetData() + Offset, Previous.GetData() + Offset, RowBytes) != 0)
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
+	void CopyTile(const TArray<FColor>& Pixels, int32 Width, const FIntRect& Rect, TArray<FColor>& OutTile)
+	{
+		OutTile.SetNumUninitialized(Rect.Area());
+		for (int32 Y = Rect.Min.Y; Y < Rect.Max.Y; ++Y)
+		{
+			FMemory::Memcpy(OutTile.GetData() + (int64)(Y - Rect.Min.Y) * Rect.Width(), Pixels.GetData() + (int64)Y * Width + Rect.Min.X, Rect.Width() * sizeof(FColor));
+		}
+	}
+}
+
+FMCPViewportStream& FMCPViewportStream::Get()
+{
+	static FMCPViewportStream Instance;
+	return Instance;
+}
+
+void FMCPViewportStream::Initialize()
+{
+	if (bInitialized)
+	{
+		return;
+	}
+	bInitialized = true;
+
+	ImageWrapperModule = &FModuleManager::LoadModuleChecked<IImageWrapperModule>(TEXT("ImageWrapper"));
+	TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FMCPViewportStream::Tick));
+}
+
+void FMCPViewportStream::Shutdown()
+{
+	if (!bInitialized)
+	{
+		return;
+	}
+	bInitialized = false;
+
+	FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+
+	// Frame tasks hold their own references; marking the streams closed stops them at the next send
+	for (const TPair<int32, TSharedRef<FStream, ESPMode::ThreadSafe>>& Pair : Streams)
+	{
+		Pair.Value->bClosed = true;
+	}
+	Streams.Empty();
+}
+
+int32 FMCPViewportStream::Start(const TSharedPtr<FMCPClientConnection, ESPMode::ThreadSafe>& Connection, const FMCPViewportStreamConfig& Config)
+{
+	check(IsInGameThread());
+	TSharedRef<FStream, ESPMode::ThreadSafe> Stream = MakeShared<FStream, ESPMode::ThreadSafe>();
+	Stream->Id = NextStreamId++;
+	Stream->Config = Config;
+	Stream->Connection = Connection;
+
+	// The first frame waits one interval, so the start response reaches the client first
+	Stream->NextFrameTime = FPlatformTime::Seconds() + 1.0 / Config.Fps;
+	Streams.Add(Stream->Id, Stream);
+
+	UE_LOG(LogTemp, Display, TEXT("MCPViewportStream: Started stream %d on connection %d (%.1f fps, max %d px)"),
+		Stream->Id, Connection->GetConnectionId(), Config.Fps, Config.MaxSize);
+	return Stream->Id;
+}
+
+bool FMCPViewportStream::Stop(int32 StreamId, FMCPViewportStreamStats& OutStats)
+{
+	check(IsInGameThread());
+	TSharedRef<FStream, ESPMode::ThreadSafe>* Found = Streams.Find(StreamId);
+	if (!Found)
+	{
+		return false;
+	}
+
+	FStream& Stream = Found->Get();
+	Stream.bClosed = true;
+	OutStats.Sent = Stream.Sent;
+	OutStats.Deltas = Stream.Deltas;
+	OutStats.Duplicates = Stream.Duplicates;
+	OutStats.Skipped = Stream.Skipped;
+	Streams.Remove(StreamId);
+	return true;
+}
+
+bool FMCPViewportStream::Tick(float DeltaTime)
+{
+	if (Streams.Num() == 0)
+	{
+		return true;
+	}
+
+	const double Now = FPlatformTime::Seconds();
+	FViewport* Viewport = nullptr;
+	bool bViewportResolved = false;
+	for (auto It = Streams.CreateIterator(); It; ++It)
+	{
+		TSharedRef<FStream, ESPMode::ThreadSafe> Stream = It.Value();
+		const TSharedPtr<FMCPClientConnection, ESPMode::ThreadSafe> Connection = Stream->Connection.Pin();
+		if (Stream->bClosed || !Connection.IsValid() || Connection->IsClosed())
+		{
+			UE_LOG(LogTemp, Display, TEXT("MCPViewportStream: Stream %d ended with its connection"), Stream->Id);
+			Stream->bClosed = true;
+			It.RemoveCurrent();
+			continue;
+		}
+		if (Now < Stream->NextFrameTime)
+		{
+			continue;
+		}
+
+		// Keep the cadence, but after a stall start again from now rather than bursting to catch up
+		Stream->NextFrameTime = FMath::Max(Stream->NextFrameTime + 1.0 / Stream->Config.Fps, Now);
+		if (Stream->bBusy)
+		{
+			Stream->Skipped++;
+			continue;
+		}
+
+		if (!bViewportResolved)
+		{
+			FString Source;
+			bool bIsPIE = false;
+			Viewport = FMCPScreenshotCapture::FindViewport(Source, bIsPIE);
+			bViewportResolved = true;
+		}
+		if (!Viewport)
+		{
+			continue;
+		}
+
+		Stream->bBusy = true;
+		FString Error;
+		const bool bQueued = FMCPScreenshotCapture::Get().ReadViewport(Viewport,
+			[this, Stream](TArray<FColor>&& Pixels, FIntPoint Size, const FString& ReadError)
+			{
+				if (!ReadError.IsEmpty())
+				{
+					Stream->bBusy = false;
+					return;
+				}
+				UE::Tasks::Launch(UE_SOURCE_LOCATION, [this, Stream, Size, Pixels = MoveTemp(Pixels)]() mutable
+				{
+					ProcessFrame(*Stream, MoveTemp(Pixels), Size);
+					Stream->bBusy = false;
+				});
+			},
+			Error);
+		if (!bQueued)
+		{
+			Stream->bBusy = false;
+		}
+	}
+	return true;
+}
+
+void FMCPViewportStream::ProcessFrame(FStream& Stream, TArray<FColor> Pixels, FIntPoint SourceSize)
+{
+	if (Stream.bClosed)
+	{
+		return;
+	}
+	const FMCPViewportStreamConfig& Config = Stream.Config;
+
+	FMCPImageEncoder::ForceOpaque(Pixels);
+	const FIntPoint Size = FMCPImageEncoder::FitSize(SourceSize, Config.MaxSize);
+	if (Size != SourceSize)
+	{
+		TArray<FColor> Resampled;
+		FMCPImageEncoder::Resample(Pixels, SourceSize, Size, Resampled);
+		Pixels = MoveTemp(Resampled);
+	}
+
+	// Unchanged frames (an idle editor viewport) cost a hash and nothing on the wire
+	const bool bHasPrevious = Stream.LastPixels.Num() > 0 && Stream.LastSize == Size;
+	const uint64 Hash = FXxHash64::HashBuffer(Pixels.GetData(), Pixels.Num() * sizeof(FColor)).Hash;
+	if (bHasPrevious && Hash == Stream.LastHash)
+	{
+		Stream.Duplicates++;
+		return;
+	}
+
+	TArray<FIntRect> ChangedTiles;
+	bool bKeyframe = !bHasPrevious || Stream.FramesSinceKey + 1 >= Config.KeyframeInterval;
+	if (!bKeyframe)
+	{
+		const int32 TilesX = FMath::DivideAndRoundUp(Size.X, Config.TileSize);
+		const int32 TilesY = FMath::DivideAndRoundUp(Size.Y, Config.TileSize);
+		const int32 MaxChangedTiles = FMath::FloorToInt(TilesX * TilesY * Config.DeltaThreshold);
+		for (int32 TileY = 0; TileY < TilesY && !bKeyframe; ++TileY)
+		{
+			for (int32 TileX = 0; TileX < TilesX; ++TileX)
+			{
+				const FIntRect Rect(
+					TileX * Config.TileSize, TileY * Config.TileSize,
+					FMath::Min((TileX + 1) * Config.TileSize, Size.X), FMath::Min((TileY + 1) * Config.TileSize, Size.Y));
+				if (IsTileChanged(Pixels, Stream.LastPixels, Size.X, Rect))
+				{
+					ChangedTiles.Add(Rect);
+					if (ChangedTiles.Num() > MaxChangedTiles)
+					{
+						bKeyframe = true;
+						break;
+					}
+				}
+			}
+		}
+	}
+
+	FMCPJsonWriter Writer;
+	Writer.BeginObject();
+	Writer.WriteField(MCPKeys::Type, TEXT("viewport_frame"));
+	Writer.WriteField(TEXT("stream_id"), Stream.Id);
+	Writer.WriteField(TEXT("seq"), Stream.Sequence + 1);
+	Writer.WriteField(TEXT("kind"), bKeyframe ? TEXT("key") : TEXT("delta"));
+	Writer.WriteField(TEXT("width"), Size.X);
+	Writer.WriteField(TEXT("height"), Size.Y);
+	Writer.WriteField(TEXT("format"), FormatName(Config.Format));
+	Writer.WriteField(TEXT("skipped"), Stream.Skipped.load());
+
+	TArray64<uint8> Encoded;
+	FString Error;
+	if (bKeyframe)
+	{
+		if (!FMCPImageEncoder::Encode(*ImageWrapperModule, Pixels, Size, Config.Format, Config.Quality, Encoded, Error))
+		{
+			UE_LOG(LogTemp, Warning, TEXT("MCPViewportStream: Stream %d frame dropped: %s"), Stream.Id, *Error);
+			return;
+		}
+		Writer.WriteField(MCPKeys::Data, FBase64::Encode(Encoded.GetData(), (uint32)Encoded.Num()));
+	}
+	else
+	{
+		TArray<FColor> Tile;
+		Writer.BeginArray(TEXT("tiles"));
+		for (const FIntRect& Rect : ChangedTiles)
+		{
+			CopyTile(Pixels, Size.X, Rect, Tile);
+			if (!FMCPImageEncoder::Encode(*ImageWrapperModule, Tile, Rect.Size(), Config.Format, Config.Quality, Encoded, Error))
+			{
+				UE_LOG(LogTemp, Warning, TEXT("MCPViewportStream: Stream %d frame dropped: %s"), Stream.Id, *Error);
+				return;
+			}
+			Writer.BeginObject();
+			Writer.WriteField(TEXT("x"), Rect.Min.X);
+			Writer.WriteField(TEXT("y"), Rect.Min.Y);
+			Writer.WriteField(TEXT("w"), Rect.Width());
+			Writer.WriteField(TEXT("h"), Rect.Height());
+			Writer.WriteField(MCPKeys::Data, FBase64::Encode(Encoded.GetData(), (uint32)Encoded.Num()));
+			Writer.EndObject();
+		}
+		Writer.EndArray();
+	}
+	Writer.EndObject();
+
+	// Never wait on a client that is not reading: the frame is skipped and the
+	// next one is compared against the last frame that actually went out
+	const TSharedPtr<FMCPClientConnection, ESPMode::ThreadSafe> Connection = Stream.Connection.Pin();
+	if (!Connection.IsValid())
+	{
+		Stream.bClosed = true;
+		return;
+	}
+	TArray<uint8> Message = Writer.MoveBuffer();
+	Message.Add('\n');
+	const EMCPSendResult SendResult = Connection->TrySendBytes(Message.GetData(), Message.Num());
+	if (SendResult == EMCPSendResult::WouldBlock)
+	{
+		Stream.Skipped++;
+		return;
+	}
+	if (SendResult == EMCPSendResult::Failed)
+	{
+		Stream.bClosed = true;
+		return;
+	}
+
+	Stream.Sequence++;
+	Stream.Sent++;
+	if (bKeyframe)
+	{
+		Stream.FramesSinceKey = 0;
+	}
+	else
+	{
+		Stream.Deltas++;
+		Stream.FramesSinceKey++;
+	}
+	Stream.LastHash = Hash;
+	Stream.LastSize = Size;
+	Stream.LastPixels = MoveTemp(Pixels);
+}
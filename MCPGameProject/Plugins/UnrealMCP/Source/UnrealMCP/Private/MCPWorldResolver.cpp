@@ -0,0 +1,146 @@
+#include "MCPWorldResolver.h"
+#include "Editor.h"
+#include "Engine/Engine.h"
+
+FMCPWorldResolver& FMCPWorldResolver::Get()
+{
+	static FMCPWorldResolver Instance;
+	return Instance;
+}
+
+void FMCPWorldResolver::Initialize()
+{
+	if (bInitialized)
+	{
+		return;
+	}
+	bInitialized = true;
+	bResolved = false;
+
+	BeginPIEHandle = FEditorDelegates::BeginPIE.AddRaw(this, &FMCPWorldResolver::OnPIEEvent);
+	PostPIEStartedHandle = FEditorDelegates::PostPIEStarted.AddRaw(this, &FMCPWorldResolver::OnPIEEvent);
+	EndPIEHandle = FEditorDelegates::EndPIE.AddRaw(this, &FMCPWorldResolver::OnPIEEvent);
+	ShutdownPIEHandle = FEditorDelegates::ShutdownPIE.AddRaw(this, &FMCPWorldResolver::OnPIEEvent);
+	MapChangeHandle = FEditorDelegates::MapChange.AddRaw(this, &FMCPWorldResolver::OnMapChange);
+	WorldInitHandle = FWorldDelegates::OnPostWorldInitialization.AddRaw(this, &FMCPWorldResolver::OnWorldInitialized);
+	WorldCleanupHandle = FWorldDelegates::OnWorldCleanup.AddRaw(this, &FMCPWorldResolver::OnWorldCleanup);
+}
+
+void FMCPWorldResolver::Shutdown()
+{
+	if (!bInitialized)
+	{
+		return;
+	}
+	bInitialized = false;
+
+	FEditorDelegates::BeginPIE.Remove(BeginPIEHandle);
+	FEditorDelegates::PostPIEStarted.Remove(PostPIEStartedHandle);
+	FEditorDelegates::EndPIE.Remove(EndPIEHandle);
+	FEditorDelegates::ShutdownPIE.Remove(ShutdownPIEHandle);
+	FEditorDelegates::MapChange.Remove(MapChangeHandle);
+	FWorldDelegates::OnPostWorldInitialization.Remove(WorldInitHandle);
+	FWorldDelegates::OnWorldCleanup.Remove(WorldCleanupHandle);
+
+	Invalidate();
+}
+
+UWorld* FMCPWorldResolver::GetTargetWorld()
+{
+	EnsureResolved();
+	if (UWorld* World = PIEWorld.Get())
+	{
+		return World;
+	}
+	return EditorWorld.Get();
+}
+
+UWorld* FMCPWorldResolver::GetEditorWorld()
+{
+	EnsureResolved();
+	return EditorWorld.Get();
+}
+
+UWorld* FMCPWorldResolver::GetPIEWorld()
+{
+	EnsureResolved();
+	return PIEWorld.Get();
+}
+
+void FMCPWorldResolver::Invalidate()
+{
+	EditorWorld.Reset();
+	PIEWorld.Reset();
+	bResolved = false;
+}
+
+void FMCPWorldResolver::EnsureResolved()
+{
+	// Without the delegates there is nothing to invalidate the cache, so resolve every time
+	const bool bStale = EditorWorld.IsStale() || PIEWorld.IsStale() || (PIEWorld.IsValid() && !IsUsable(PIEWorld.Get()));
+	if (!bResolved || bStale || !bInitialized)
+	{
+		Resolve();
+	}
+}
+
+void FMCPWorldResolver::Resolve()
+{
+	EditorWorld.Reset();
+	PIEWorld.Reset();
+	bResolved = true;
+
+	if (!GEditor)
+	{
+		EditorWorld = GWorld;
+		return;
+	}
+
+	EditorWorld = GEditor->GetEditorWorldContext().World();
+	for (const FWorldContext& Context : GEngine->GetWorldContexts())
+	{
+		// Skip PIE worlds being torn down (prevents a crash during PIE teardown)
+		if (Context.WorldType == EWorldType::PIE && IsUsable(Context.World()))
+		{
+			PIEWorld = Context.World();
+			break;
+		}
+	}
+}
+
+bool FMCPWorldResolver::IsTargetType(const UWorld* World)
+{
+	return World && (World->WorldType == EWorldType::Editor || World->WorldType == EWorldType::PIE);
+}
+
+bool FMCPWorldResolver::IsUsable(const UWorld* World)
+{
+	return World && !World->HasAnyFlags(RF_BeginDestroyed) && World->bIsWorldInitialized;
+}
+
+void FMCPWorldResolver::OnPIEEvent(bool bIsSimulating)
+{
+	Invalidate();
+}
+
+void FMCPWorldResolver::OnMapChange(uint32 MapChangeFlags)
+{
+	Invalidate();
+}
+
+void FMCPWorldResolver::OnWorldInitialized(UWorld* World, const UWorld::InitializationValues Values)
+{
+	// Preview and thumbnail worlds come and go constantly and are never a target
+	if (IsTargetType(World))
+	{
+		Invalidate();
+	}
+}
+
+void FMCPWorldResolver::OnWorldCleanup(UWorld* World, bool bSessionEnded, bool bCleanupResources)
+{
+	if (IsTargetType(World))
+	{
+		Invalidate();
+	}
+}
@@ -0,0 +1,207 @@
+#include "MCPFrameScanner.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace MCPFrameScannerTests
+{
+	static TArray<uint8> MakeBytes(const ANSICHAR* Text)
+	{
+		return TArray<uint8>(reinterpret_cast<const uint8*>(Text), FCStringAnsi::Strlen(Text));
+	}
+
+	/** Feed Bytes to a fresh scanner in ChunkSize pieces, as a socket would. Returns false on a protocol error. */
+	static bool ScanInChunks(const TArray<uint8>& Bytes, int32 ChunkSize, bool bUseSimd, TArray<FMCPFrameRange>& OutFrames, bool& bOutOpenFrame)
+	{
+		FMCPFrameScanner Scanner;
+		Scanner.SetUseSimd(bUseSimd);
+		TArray<uint8> Buffer;
+		Buffer.Reserve(Bytes.Num());
+		OutFrames.Reset();
+		for (int32 Offset = 0; Offset < Bytes.Num(); Offset += ChunkSize)
+		{
+			Buffer.Append(Bytes.GetData() + Offset, FMath::Min(ChunkSize, Bytes.Num() - Offset));
+			if (!Scanner.Scan(Buffer, OutFrames))
+			{
+				return false;
+			}
+		}
+		bOutOpenFrame = Scanner.HasOpenFrame();
+		return true;
+	}
+
+	/** A request of roughly TargetBytes: nested params, escapes and some non-ASCII text. */
+	static TArray<uint8> MakeLargeFrame(int32 TargetBytes)
+	{
+		TArray<uint8> Bytes;
+		Bytes.Reserve(TargetBytes + 128);
+		auto Append = [&Bytes](const ANSICHAR* Text)
+		{
+			Bytes.Append(reinterpret_cast<const uint8*>(Text), FCStringAnsi::Strlen(Text));
+		};
+
+		Append("{\"type\":\"execute_python\",\"params\":{\"code\":\"");
+		while (Bytes.Num() < TargetBytes - 64)
+		{
+			Append("print(\\\"caf\xC3\xA9 {x} [y] \xE2\x9C\x93\\\")\\nfor i in range(10): pass\\n");
+		}
+		Append("\",\"nested\":{\"a\":[1,2,{\"b\":\"}\"}]}}}\n");
+		return Bytes;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMCPFrameScannerFramingTest, "UnrealMCP.FrameScanner.Framing",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FMCPFrameScannerFramingTest::RunTest(const FString& Parameters)
+{
+	using namespace MCPFrameScannerTests;
+
+	// Padding long enough that the interesting bytes land inside 16-byte vector blocks
+	const FString Pad = FString::ChrN(40, TEXT('a'));
+	const FTCHARToUTF8 PadUtf8(*Pad);
+	auto Padded = [&PadUtf8](const ANSICHAR* Prefix, const ANSICHAR* Suffix)
+	{
+		TArray<uint8> Bytes = MakeBytes(Prefix);
+		Bytes.Append(reinterpret_cast<const uint8*>(PadUtf8.Get()), PadUtf8.Length());
+		Bytes.Append(MakeBytes(Suffix));
+		return Bytes;
+	};
+
+	struct FCase
+	{
+		const TCHAR* Name;
+		TArray<uint8> Bytes;
+		bool bValid;
+		int32 Frames;
+		bool bOpenFrame;
+	};
+
+	TArray<uint8> Binary = { MCPBinaryFrameMagic, 0x01, 0x03, 0x00, 'x', '}', 0xFF };
+	Binary.Append(MakeBytes("{}"));
+
+	const FCase Cases[] = {
+		{ TEXT("objects and arrays"), MakeBytes("{\"a\":1}{\"b\":\"}\"}\n[1,2]"), true, 3, false },
+		{ TEXT("escaped quote"), MakeBytes("{\"s\":\"a\\\"}{\"}"), true, 1, false },
+		{ TEXT("escaped backslash"), MakeBytes("{\"s\":\"a\\\\\"}{}"), true, 2, false },
+		{ TEXT("multibyte UTF-8"), Padded("{\"t\":\"caf\xC3\xA9 \xE2\x9C\x93 \xF0\x9F\x98\x80", "\"}\r\n\t "), true, 1, false },
+		{ TEXT("unfinished frame"), Padded("{\"a\":[{\"b\":\"", ""), true, 0, true },
+		{ TEXT("binary frame then request"), Binary, true, 2, false },
+		{ TEXT("overlong encoding"), Padded("{\"t\":\"", "\xC0\x80\"}"), false, 0, false },
+		{ TEXT("surrogate"), Padded("{\"t\":\"", "\xED\xA0\x80\"}"), false, 0, false },
+		{ TEXT("invalid lead byte"), Padded("{\"t\":\"", "\xFF\"}"), false, 0, false },
+		{ TEXT("truncated sequence"), Padded("{\"t\":\"\xE2\x9C", "\"}"), false, 0, false },
+		{ TEXT("garbage between frames"), MakeBytes("{}x{}"), false, 0, false },
+	};
+
+	for (const FCase& Case : Cases)
+	{
+		// Reference: scalar path, whole buffer at once
+		TArray<FMCPFrameRange> Expected;
+		bool bExpectedOpen = false;
+		const bool bValid = ScanInChunks(Case.Bytes, Case.Bytes.Num(), false, Expected, bExpectedOpen);
+		TestTrue(FString::Printf(TEXT("%s: %s"), Case.Name, Case.bValid ? TEXT("accepted") : TEXT("rejected")), bValid == Case.bValid);
+		if (!bValid)
+		{
+			// Every chunking and path must reject it too
+			for (const bool bUseSimd : { false, true })
+			{
+				for (const int32 ChunkSize : { 1, 3, 16, Case.Bytes.Num() })
+				{
+					TArray<FMCPFrameRange> Frames;
+					bool bOpen = false;
+					TestFalse(FString::Printf(TEXT("%s: accepted (%s, %d-byte chunks)"), Case.Name, bUseSimd ? TEXT("simd") : TEXT("scalar"), ChunkSize),
+						ScanInChunks(Case.Bytes, ChunkSize, bUseSimd, Frames, bOpen));
+				}
+			}
+			continue;
+		}
+		TestEqual(FString::Printf(TEXT("%s: frames"), Case.Name), Expected.Num(), Case.Frames);
+		TestTrue(FString::Printf(TEXT("%s: open frame"), Case.Name), bExpectedOpen == Case.bOpenFrame);
+
+		// The vector path and any split of the input must cut exactly the same ranges
+		for (const bool bUseSimd : { false, true })
+		{
+			for (const int32 ChunkSize : { 1, 3, 16, Case.Bytes.Num() })
+			{
+				const FString Variant = FString::Printf(TEXT("%s (%s, %d-byte chunks)"), Case.Name, bUseSimd ? TEXT("simd") : TEXT("scalar"), ChunkSize);
+				TArray<FMCPFrameRange> Frames;
+				bool bOpen = false;
+				if (!TestTrue(Variant + TEXT(": valid"), ScanInChunks(Case.Bytes, ChunkSize, bUseSimd, Frames, bOpen)))
+				{
+					continue;
+				}
+				TestTrue(Variant + TEXT(": open frame"), bOpen == bExpectedOpen);
+				if (TestEqual(Variant + TEXT(": frames"), Frames.Num(), Expected.Num()))
+				{
+					for (int32 Index = 0; Index < Frames.Num(); ++Index)
+					{
+						TestTrue(FString::Printf(TEXT("%s: range %d"), *Variant, Index),
+							Frames[Index].Start == Expected[Index].Start && Frames[Index].End == Expected[Index].End);
+					}
+				}
+			}
+		}
+	}
+
+	// Exact ranges for the mixed case: End is exclusive and the newline belongs to no frame
+	TArray<FMCPFrameRange> Frames;
+	bool bOpen = false;
+	if (ScanInChunks(Cases[0].Bytes, 1, true, Frames, bOpen) && TestEqual(TEXT("objects and arrays: frames"), Frames.Num(), 3))
+	{
+		TestTrue(TEXT("first range"), Frames[0].Start == 0 && Frames[0].End == 7);
+		TestTrue(TEXT("second range"), Frames[1].Start == 7 && Frames[1].End == 16);
+		TestTrue(TEXT("third range"), Frames[2].Start == 17 && Frames[2].End == 22);
+	}
+	if (ScanInChunks(Cases[5].Bytes, 1, true, Frames, bOpen) && TestEqual(TEXT("binary frame: frames"), Frames.Num(), 2))
+	{
+		TestTrue(TEXT("binary range keeps the marker"), Frames[0].Start == 0 && Frames[0].End == MCPBinaryFrameHeaderBytes + 3);
+	}
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMCPFrameScannerThroughputTest, "UnrealMCP.FrameScanner.Throughput",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+bool FMCPFrameScannerThroughputTest::RunTest(const FString& Parameters)
+{
+	using namespace MCPFrameScannerTests;
+
+	const int32 Sizes[] = { 1024, 16 * 1024, 256 * 1024, 1024 * 1024, 10 * 1024 * 1024 };
+	const int32 ChunkSize = 64 * 1024;
+
+	for (const int32 Size : Sizes)
+	{
+		const TArray<uint8> Frame = MakeLargeFrame(Size);
+		const int32 Iterations = FMath::Clamp(256 * 1024 * 1024 / Frame.Num(), 3, 10000);
+
+		double Seconds[2] = { 0.0, 0.0 };
+		for (const bool bUseSimd : { false, true })
+		{
+			TArray<FMCPFrameRange> Frames;
+			bool bOpen = false;
+			const double Start = FPlatformTime::Seconds();
+			for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+			{
+				if (!ScanInChunks(Frame, ChunkSize, bUseSimd, Frames, bOpen))
+				{
+					break;
+				}
+			}
+			Seconds[bUseSimd ? 1 : 0] = (FPlatformTime::Seconds() - Start) / Iterations;
+
+			if (TestEqual(FString::Printf(TEXT("%d bytes (%s): frames"), Frame.Num(), bUseSimd ? TEXT("simd") : TEXT("scalar")), Frames.Num(), 1))
+			{
+				TestEqual(FString::Printf(TEXT("%d bytes (%s): frame end"), Frame.Num(), bUseSimd ? TEXT("simd") : TEXT("scalar")), Frames[0].End, Frame.Num() - 1);
+			}
+		}
+
+		const double MegaBytes = Frame.Num() / (1024.0 * 1024.0);
+		AddInfo(FString::Printf(TEXT("%8d bytes  scalar %8.1f MB/s  simd %8.1f MB/s  (%.2fx, %.1f us/frame)"),
+			Frame.Num(), MegaBytes / Seconds[0], MegaBytes / Seconds[1], Seconds[0] / Seconds[1], Seconds[1] * 1e6));
+	}
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
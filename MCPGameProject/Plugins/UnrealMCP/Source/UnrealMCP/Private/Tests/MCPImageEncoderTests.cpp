@@ -0,0 +1,173 @@
+#include "MCPImageEncoder.h"
+#include "IImageWrapper.h"
+#include "IImageWrapperModule.h"
+#include "Misc/AutomationTest.h"
+#include "Modules/ModuleManager.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace MCPImageEncoderTests
+{
+	static constexpr EAutomationTestFlags TestFlags = EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter;
+
+	/** Deterministic pixels with every channel varying, alpha 0 as in a viewport readback. */
+	static TArray<FColor> MakeBitmap(FIntPoint Size)
+	{
+		TArray<FColor> Pixels;
+		Pixels.SetNumUninitialized(Size.X * Size.Y);
+		for (int32 Y = 0; Y < Size.Y; ++Y)
+		{
+			for (int32 X = 0; X < Size.X; ++X)
+			{
+				Pixels[Y * Size.X + X] = FColor((uint8)(X * 7 + Y), (uint8)(Y * 13), (uint8)((X ^ Y) * 5), 0);
+			}
+		}
+		return Pixels;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMCPImageEncoderFitSizeTest, "UnrealMCP.ImageEncoder.FitSize", MCPImageEncoderTests::TestFlags)
+
+bool FMCPImageEncoderFitSizeTest::RunTest(const FString& Parameters)
+{
+	const FIntPoint Sources[] = { { 1920, 1080 }, { 1081, 607 }, { 607, 1081 }, { 1, 4000 }, { 4000, 1 }, { 3, 2 }, { 1, 1 }, { 8191, 3 } };
+	const int32 MaxSizes[] = { 0, 1, 7, 256, 1024, 8192 };
+	for (const FIntPoint Source : Sources)
+	{
+		for (const int32 MaxSize : MaxSizes)
+		{
+			const FIntPoint Fit = FMCPImageEncoder::FitSize(Source, MaxSize);
+			const FString Case = FString::Printf(TEXT("%dx%d max %d"), Source.X, Source.Y, MaxSize);
+			if (MaxSize <= 0 || FMath::Max(Source.X, Source.Y) <= MaxSize)
+			{
+				TestTrue(Case + TEXT(" keeps the source size"), Fit == Source);
+				continue;
+			}
+
+			// Long side capped, short side never below one pixel, aspect kept to within rounding
+			const double Scale = (double)MaxSize / FMath::Max(Source.X, Source.Y);
+			TestEqual(Case + TEXT(" long side"), FMath::Max(Fit.X, Fit.Y), MaxSize);
+			TestTrue(Case + TEXT(" sides are at least 1"), Fit.X >= 1 && Fit.Y >= 1);
+			TestEqual(Case + TEXT(" width"), (double)Fit.X, FMath::Max(1.0, Source.X * Scale), 0.5);
+			TestEqual(Case + TEXT(" height"), (double)Fit.Y, FMath::Max(1.0, Source.Y * Scale), 0.5);
+		}
+	}
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMCPImageEncoderForceOpaqueTest, "UnrealMCP.ImageEncoder.ForceOpaque", MCPImageEncoderTests::TestFlags)
+
+bool FMCPImageEncoderForceOpaqueTest::RunTest(const FString& Parameters)
+{
+	const TArray<FColor> Original = MCPImageEncoderTests::MakeBitmap(FIntPoint(13, 5));
+	TArray<FColor> Pixels = Original;
+	FMCPImageEncoder::ForceOpaque(Pixels);
+	for (int32 Index = 0; Index < Pixels.Num(); ++Index)
+	{
+		FColor Expected = Original[Index];
+		Expected.A = 255;
+		if (!TestEqual(FString::Printf(TEXT("Pixel %d"), Index), Pixels[Index], Expected))
+		{
+			break;
+		}
+	}
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMCPImageEncoderResampleTest, "UnrealMCP.ImageEncoder.Resample", MCPImageEncoderTests::TestFlags)
+
+bool FMCPImageEncoderResampleTest::RunTest(const FString& Parameters)
+{
+	const TPair<FIntPoint, FIntPoint> Cases[] = {
+		{ { 1081, 607 }, { 256, 144 } }, { { 17, 13 }, { 5, 3 } }, { { 1, 997 }, { 1, 31 } }, { { 997, 1 }, { 31, 1 } },
+		{ { 7, 7 }, { 1, 1 } }, { { 2, 2 }, { 1, 1 } }, { { 33, 9 }, { 33, 9 } }, { { 5, 3 }, { 4, 3 } }, { { 12, 6 }, { 4, 3 } } };
+	const FColor FlatColor(10, 200, 77, 255);
+
+	for (const TPair<FIntPoint, FIntPoint>& Case : Cases)
+	{
+		const FIntPoint SourceSize = Case.Key;
+		const FIntPoint DestSize = Case.Value;
+		const FString Name = FString::Printf(TEXT("%dx%d -> %dx%d"), SourceSize.X, SourceSize.Y, DestSize.X, DestSize.Y);
+
+		// A flat color must come through the box filter unchanged
+		TArray<FColor> Flat;
+		Flat.Init(FlatColor, SourceSize.X * SourceSize.Y);
+		TArray<FColor> Out;
+		FMCPImageEncoder::Resample(Flat, SourceSize, DestSize, Out);
+		TestEqual(Name + TEXT(" pixel count"), Out.Num(), DestSize.X * DestSize.Y);
+		TestFalse(Name + TEXT(" changes a flat color"), Out.ContainsByPredicate([&FlatColor](const FColor& Pixel) { return Pixel != FlatColor; }));
+
+		const TArray<FColor> Pattern = MCPImageEncoderTests::MakeBitmap(SourceSize);
+		FMCPImageEncoder::Resample(Pattern, SourceSize, DestSize, Out);
+		if (DestSize == SourceSize)
+		{
+			TestTrue(Name + TEXT(" copies at the same size"), Out == Pattern);
+		}
+		else if (SourceSize.X % DestSize.X == 0 && SourceSize.Y % DestSize.Y == 0)
+		{
+			// Every destination pixel averages an equal block, so the means agree up to per-pixel rounding
+			double SourceMean = 0.0;
+			double DestMean = 0.0;
+			for (const FColor& Pixel : Pattern)
+			{
+				SourceMean += Pixel.R;
+			}
+			for (const FColor& Pixel : Out)
+			{
+				DestMean += Pixel.R;
+			}
+			TestEqual(Name + TEXT(" mean"), DestMean / Out.Num(), SourceMean / Pattern.Num(), 0.5);
+		}
+	}
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMCPImageEncoderEncodeTest, "UnrealMCP.ImageEncoder.Encode", MCPImageEncoderTests::TestFlags)
+
+bool FMCPImageEncoderEncodeTest::RunTest(const FString& Parameters)
+{
+	IImageWrapperModule& ImageWrapperModule = FModuleManager::LoadModuleChecked<IImageWrapperModule>(TEXT("ImageWrapper"));
+	const FIntPoint Sizes[] = { { 1, 1 }, { 1, 7 }, { 333, 1 }, { 17, 13 }, { 1081, 607 } };
+	for (const FIntPoint Size : Sizes)
+	{
+		TArray<FColor> Pixels = MCPImageEncoderTests::MakeBitmap(Size);
+		FMCPImageEncoder::ForceOpaque(Pixels);
+		for (const EMCPImageFormat Format : { EMCPImageFormat::Png, EMCPImageFormat::Jpeg })
+		{
+			const FString Name = FString::Printf(TEXT("%s %dx%d"), FMCPImageEncoder::GetExtension(Format), Size.X, Size.Y);
+			TArray64<uint8> Bytes;
+			FString Error;
+			if (!FMCPImageEncoder::Encode(ImageWrapperModule, Pixels, Size, Format, 85, Bytes, Error))
+			{
+				AddError(FString::Printf(TEXT("%s: %s"), *Name, *Error));
+				continue;
+			}
+
+			const EImageFormat Expected = Format == EMCPImageFormat::Jpeg ? EImageFormat::JPEG : EImageFormat::PNG;
+			TestTrue(Name + TEXT(" container"), ImageWrapperModule.DetectImageFormat(Bytes.GetData(), Bytes.Num()) == Expected);
+
+			TSharedPtr<IImageWrapper> Decoder = ImageWrapperModule.CreateImageWrapper(Expected);
+			TArray64<uint8> Raw;
+			if (!TestTrue(Name + TEXT(" decodes"), Decoder.IsValid() && Decoder->SetCompressed(Bytes.GetData(), Bytes.Num()) && Decoder->GetRaw(ERGBFormat::BGRA, 8, Raw)))
+			{
+				continue;
+			}
+			TestEqual(Name + TEXT(" width"), (int32)Decoder->GetWidth(), Size.X);
+			TestEqual(Name + TEXT(" height"), (int32)Decoder->GetHeight(), Size.Y);
+			if (!TestEqual(Name + TEXT(" raw size"), Raw.Num(), (int64)Pixels.Num() * (int64)sizeof(FColor)))
+			{
+				continue;
+			}
+
+			const FColor* Decoded = reinterpret_cast<const FColor*>(Raw.GetData());
+			TestFalse(Name + TEXT(" has a non-opaque pixel"), MakeArrayView(Decoded, Pixels.Num()).ContainsByPredicate([](const FColor& Pixel) { return Pixel.A != 255; }));
+			if (Format == EMCPImageFormat::Png)
+			{
+				TestTrue(Name + TEXT(" round-trips exactly"), FMemory::Memcmp(Decoded, Pixels.GetData(), Raw.Num()) == 0);
+			}
+		}
+	}
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -62,6 +62,31 @@
 #include "Commands/UnrealMCPAssetCommands.h"
 #include "Commands/UnrealMCPGameplayCommands.h"
 #include "MCPSettings.h"
+#include "MCPJsonWriter.h"
+#include "MCPCommandParams.h"
+#include "MCPJsonKeys.h"
+#include "MCPActorIndex.h"
+#include "MCPSpatialIndex.h"
+#include "MCPLevelJournal.h"
+#include "MCPPropertyAccessor.h"
+#include "MCPSerializationPlan.h"
+#include "MCPScreenshotCapture.h"
+#include "MCPViewportStream.h"
+#include "MCPMutationSession.h"
+#include "MCPWorldResolver.h"
+#include "MCPPawnControl.h"
+#include "Framework/Application/SlateApplication.h"
+#include "Misc/App.h"
+#include "Misc/CommandLine.h"
+#include "Misc/Parse.h"
+#include "Misc/ScopeLock.h"
+#include "Misc/QueuedThreadPool.h"
+#include "Async/TaskGraphInterfaces.h"
+#include "HAL/PlatformProcess.h"
+#include "Editor.h"
+
+// Bridge whose services are running (game thread)
+static UUnrealMCPBridge* GActiveMCPBridge = nullptr;
 
 UUnrealMCPBridge::UUnrealMCPBridge()
 {
@@ -75,6 +100,21 @@ UUnrealMCPBridge::UUnrealMCPBridge()
     AssetCommands = MakeShared<FUnrealMCPAssetCommands>();
     GameplayCommands = MakeShared<FUnrealMCPGameplayCommands>();
     AnimBlueprintCommands = MakeShared<FUnrealMCPAnimBlueprintCommands>();
+    SpatialCommands = MakeShared<FUnrealMCPSpatialCommands>();
+
+    EditorCommands->RegisterNativeHandlers(*this);
+    BlueprintCommands->RegisterNativeHandlers(*this);
+    LevelCommands->RegisterNativeHandlers(*this);
+    SpatialCommands->RegisterNativeHandlers(*this);
+    RegisterStreamingHandler(TEXT("describe_commands"), FMCPStreamingCommandHandler::CreateStatic(&FMCPCommandSchemas::HandleDescribeCommands));
+
+    // A pool launcher passes -McpInstanceId=<label> so instances keep a stable name across restarts
+    InstanceId = FGuid::NewGuid();
+    if (!FParse::Value(FCommandLine::Get(), TEXT("McpInstanceId="), InstanceLabel))
+    {
+        InstanceLabel = InstanceId.ToString(EGuidFormats::DigitsWithHyphensLower);
+    }
+    StartTimeSeconds = FPlatformTime::Seconds();
 }
 
 UUnrealMCPBridge::~UUnrealMCPBridge()
@@ -105,8 +145,11 @@ void UUnrealMCPBridge::Initialize(FSubsystemCollectionBase& Collection)
     Port = static_cast<uint16>(Settings->Port);
     FIPv4Address::Parse(*Settings->BindAddress, ServerAddress);
 
-    // Only auto-start if the setting is enabled
-    if (Settings->bAutoStart)
+    InitializeServices();
+
+    // Only auto-start if the setting is enabled. Commandlets (UnrealMCPServer)
+    // start the server themselves after applying command line overrides.
+    if (Settings->bAutoStart && !IsRunningCommandlet())
     {
         StartServer();
     }
@@ -117,6 +160,151 @@ void UUnrealMCPBridge::Deinitialize()
 {
     UE_LOG(LogTemp, Display, TEXT("UnrealMCPBridge: Shutting down"));
     StopServer();
+    ShutdownServices();
+}
+
+void UUnrealMCPBridge::InitializeServices()
+{
+    if (bServicesInitialized)
+    {
+        return;
+    }
+    bServicesInitialized = true;
+    GActiveMCPBridge = this;
+
+    const UMCPSettings* Settings = GetDefault<UMCPSettings>();
+    FMCPWorldResolver::Get().Initialize();
+    FMCPActorIndex::Get().Initialize();
+    FMCPSpatialIndex::Get().Initialize();
+    FMCPLevelJournal::Get().Initialize(Settings->LevelJournalCapacity);
+    FMCPPropertyAccessorCache::Get().Initialize();
+    FMCPSerializationPlanCache::Get().Initialize();
+    FMCPScreenshotCapture::Get().Initialize();
+    FMCPViewportStream::Get().Initialize();
+    FMCPMutationSessions::Get().Initialize(static_cast<int64>(Settings->MutationSessionUndoLimitMB) * 1024 * 1024, Settings->MutationSessionIdleSeconds);
+    FMCPPawnControl::Get().Initialize();
+}
+
+void UUnrealMCPBridge::ShutdownServices()
+{
+    if (!bServicesInitialized)
+    {
+        return;
+    }
+    bServicesInitialized = false;
+    if (GActiveMCPBridge == this)
+    {
+        GActiveMCPBridge = nullptr;
+    }
+
+    FMCPWorldResolver::Get().Shutdown();
+    FMCPActorIndex::Get().Shutdown();
+    FMCPSpatialIndex::Get().Shutdown();
+    FMCPLevelJournal::Get().Shutdown();
+    FMCPPropertyAccessorCache::Get().Shutdown();
+    FMCPSerializationPlanCache::Get().Shutdown();
+    FMCPMutationSessions::Get().Shutdown();
+    FMCPPawnControl::Get().Shutdown();
+    FMCPViewportStream::Get().Shutdown();
+    FMCPScreenshotCapture::Get().Shutdown();
+}
+
+UUnrealMCPBridge* UUnrealMCPBridge::Get()
+{
+    return GActiveMCPBridge;
+}
+
+void UUnrealMCPBridge::SetServerEndpoint(const FString& BindAddress, int32 InPort)
+{
+    if (!FIPv4Address::Parse(BindAddress, ServerAddress))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("UnrealMCPBridge: Invalid bind address '%s', using 0.0.0.0"), *BindAddress);
+        ServerAddress = FIPv4Address::Any;
+    }
+    Port = static_cast<uint16>(FMath::Clamp(InPort, 1024, 65535));
+}
+
+bool UUnrealMCPBridge::IsHeadless() const
+{
+    return bHeadless || IsRunningCommandlet() || !FSlateApplication::IsInitialized();
+}
+
+TSharedPtr<FJsonObject> UUnrealMCPBridge::BuildInstanceInfo() const
+{
+    TSharedPtr<FJsonObject> Info = MakeShared<FJsonObject>();
+    Info->SetStringField(TEXT("instance_id"), InstanceLabel);
+    Info->SetStringField(TEXT("instance_guid"), InstanceId.ToString(EGuidFormats::DigitsWithHyphensLower));
+    Info->SetNumberField(TEXT("pid"), FPlatformProcess::GetCurrentProcessId());
+    Info->SetNumberField(TEXT("port"), Port);
+    Info->SetBoolField(TEXT("headless"), IsHeadless());
+    Info->SetStringField(TEXT("project"), FApp::GetProjectName());
+
+    UWorld* World = FMCPWorldResolver::Get().GetEditorWorld();
+    Info->SetStringField(TEXT("level"), World ? World->GetOutermost()->GetName() : FString());
+
+    // The get_instance_info request itself is in flight; report the load excluding it
+    TSharedPtr<FJsonObject> Load = MakeShared<FJsonObject>();
+    Load->SetNumberField(TEXT("in_flight"), FMath::Max(0, InFlightCommands.GetValue() - 1));
+    Load->SetNumberField(TEXT("commands_executed"), static_cast<double>(CommandsExecuted.GetValue()));
+    Load->SetNumberField(TEXT("avg_game_thread_ms"), AverageGameThreadMs);
+    Load->SetNumberField(TEXT("uptime_seconds"), FPlatformTime::Seconds() - StartTimeSeconds);
+    Info->SetObjectField(TEXT("load"), Load);
+
+    return Info;
+}
+
+bool UUnrealMCPBridge::TryGetCachedResponse(const FString& IdempotencyKey, const FString& CommandType, TArray<uint8>& OutResponse)
+{
+    FScopeLock Lock(&IdempotencyLock);
+    const FCachedResponse* Cached = IdempotencyCache.FindAndTouch(IdempotencyKey);
+    if (!Cached)
+    {
+        return false;
+    }
+
+    if (Cached->CommandType != CommandType)
+    {
+        // Same key, different command: a client bug, never replay the other command's result
+        OutResponse = FMCPServerRunnable::MakeErrorResponse(FString::Printf(
+            TEXT("Idempotency key '%s' was already used for command '%s'"), *IdempotencyKey, *Cached->CommandType));
+        return true;
+    }
+
+    UE_LOG(LogTemp, Display, TEXT("UnrealMCPBridge: Replaying cached response for %s (key %s)"), *CommandType, *IdempotencyKey);
+    OutResponse = Cached->Response;
+    return true;
+}
+
+void UUnrealMCPBridge::CacheResponse(const FString& IdempotencyKey, const FString& CommandType, const TArray<uint8>& Response)
+{
+    FScopeLock Lock(&IdempotencyLock);
+    if (IdempotencyCache.Max() == 0)
+    {
+        const int32 CacheSize = GetDefault<UMCPSettings>()->IdempotencyCacheSize;
+        if (CacheSize <= 0)
+        {
+            return;
+        }
+        IdempotencyCache.Empty(CacheSize);
+    }
+    IdempotencyCache.Add(IdempotencyKey, FCachedResponse{ CommandType, Response });
+}
+
+bool UUnrealMCPBridge::RequiresViewport(const FString& CommandType)
+{
+    static const TSet<FString> ViewportCommands = {
+        TEXT("focus_viewport"),
+        TEXT("take_screenshot"),
+        TEXT("start_viewport_stream"),
+        TEXT("set_viewport_camera"),
+        TEXT("get_viewport_camera"),
+        TEXT("spawn_editor_utility_tab"),
+        TEXT("close_editor_utility_tab"),
+        TEXT("does_editor_utility_tab_exist"),
+        TEXT("find_editor_utility_widget"),
+        TEXT("play_in_editor")
+    };
+    return ViewportCommands.Contains(CommandType);
 }
 
 // Start the MCP server
@@ -171,6 +359,17 @@ void UUnrealMCPBridge::StartServer()
         return;
     }
 
+    // Workers parse requests and wait on the game thread so the server thread only does socket I/O
+    const int32 NumWorkers = FMath::Clamp(GetDefault<UMCPSettings>()->WorkerThreads, 1, 64);
+    WorkerPool = FQueuedThreadPool::Allocate();
+    if (!WorkerPool->Create(NumWorkers, 128 * 1024, TPri_Normal, TEXT("UnrealMCPWorkerPool")))
+    {
+        UE_LOG(LogTemp, Error, TEXT("UnrealMCPBridge: Failed to create worker pool"));
+        delete WorkerPool;
+        WorkerPool = nullptr;
+        return;
+    }
+
     ListenerSocket = NewListenerSocket;
     bIsRunning = true;
     UE_LOG(LogTemp, Display, TEXT("UnrealMCPBridge: Server started on %s:%d"), *ServerAddress.ToString(), Port);
@@ -208,6 +407,27 @@ void UUnrealMCPBridge::StopServer()
         ServerThread = nullptr;
     }
 
+    // Workers may be blocked waiting for commands queued on the game thread. Run those
+    // before tearing the pool down, unless we are already inside a game-thread task.
+    if (WorkerPool)
+    {
+        if (IsInGameThread() && !FTaskGraphInterface::Get().IsThreadProcessingTasks(ENamedThreads::GameThread))
+        {
+            const double Deadline = FPlatformTime::Seconds() + 10.0;
+            while (InFlightCommands.GetValue() > 0 && FPlatformTime::Seconds() < Deadline)
+            {
+                FTaskGraphInterface::Get().ProcessThreadUntilIdle(ENamedThreads::GameThread);
+                FPlatformProcess::Sleep(0.001f);
+            }
+        }
+        // Whatever is still queued (we may be inside a game-thread task, or the deadline passed)
+        // would keep its worker blocked forever and Destroy() waiting on it
+        CancelPendingCommands();
+        WorkerPool->Destroy();
+        delete WorkerPool;
+        WorkerPool = nullptr;
+    }
+
     // Close sockets - Reset() triggers the custom deleter which calls DestroySocket
     if (ConnectionSocket.IsValid())
     {
@@ -222,41 +442,123 @@ void UUnrealMCPBridge::StopServer()
     UE_LOG(LogTemp, Display, TEXT("UnrealMCPBridge: Server stopped"));
 }
 
+// Execute a command built in-process (no request frame to parse)
+FString UUnrealMCPBridge::ExecuteCommand(const FString& CommandType, const TSharedPtr<FJsonObject>& Params, const FString& IdempotencyKey)
+{
+    const FMCPJsonDocumentRef Document = FMCPJsonDocument::FromJsonObject(Params);
+    const TArray<uint8> Response = ExecuteCommand(CommandType, Document, Document->GetRootObject(), IdempotencyKey);
+    FUTF8ToTCHAR Converter(reinterpret_cast<const ANSICHAR*>(Response.GetData()), Response.Num());
+    return FString(Converter.Length(), Converter.Get());
+}
+
 // Execute a command received from a client
-FString UUnrealMCPBridge::ExecuteCommand(const FString& CommandType, const TSharedPtr<FJsonObject>& Params)
+TArray<uint8> UUnrealMCPBridge::ExecuteCommand(const FString& CommandType, const FMCPJsonDocumentRef& Document, const FMCPJsonObjectView& ParamsView, const FString& IdempotencyKey,
+    const TSharedPtr<FMCPClientConnection, ESPMode::ThreadSafe>& Origin, const FString& MutationSession)
 {
     UE_LOG(LogTemp, Display, TEXT("UnrealMCPBridge: Executing command: %s"), *CommandType);
-    
-    // Create a promise to wait for the result
-    TPromise<FString> Promise;
-    TFuture<FString> Future = Promise.GetFuture();
+
+    // A retried request whose first attempt already completed never reaches the game thread
+    TArray<uint8> CachedResponse;
+    if (!IdempotencyKey.IsEmpty() && TryGetCachedResponse(IdempotencyKey, CommandType, CachedResponse))
+    {
+        return CachedResponse;
+    }
+
+    InFlightCommands.Increment();
+
+    // Create a promise to wait for the result; StopServer can settle it if the game thread never gets to it
+    const TSharedPtr<FPendingCommand, ESPMode::ThreadSafe> Pending = MakeShared<FPendingCommand, ESPMode::ThreadSafe>();
+    TFuture<TArray<uint8>> Future = Pending->Promise.GetFuture();
+    {
+        FScopeLock Lock(&PendingCommandsLock);
+        PendingCommands.Add(Pending);
+    }
     
     // Queue execution on Game Thread
-    AsyncTask(ENamedThreads::GameThread, [this, CommandType, Params, Promise = MoveTemp(Promise)]() mutable
+    AsyncTask(ENamedThreads::GameThread, [this, CommandType, Document, ParamsView, IdempotencyKey, Origin, MutationSession, Pending]() mutable
     {
-        TSharedPtr<FJsonObject> ResponseJson = MakeShareable(new FJsonObject);
+        // Cancelled by StopServer: the client already has its error, so do not run the command
+        if (Pending->IsSettled())
+        {
+            return;
+        }
+
+        // Re-check on the game thread: a retry may have been queued while the original was still running
+        TArray<uint8> CachedResult;
+        if (!IdempotencyKey.IsEmpty() && TryGetCachedResponse(IdempotencyKey, CommandType, CachedResult))
+        {
+            Pending->Settle(MoveTemp(CachedResult));
+            return;
+        }
+
+        // The response envelope is written straight to UTF-8; FJsonObject results are embedded as they are
+        FMCPJsonWriter Writer;
+        const double GameThreadStart = FPlatformTime::Seconds();
+        CommandConnection = Origin;
+
+        // Commands of an open mutation session run inside its shared transaction
+        FMCPMutationSessions::Get().BeginCommand(CommandType, MutationSession, Origin.Get());
+
+        // Only a completed, successful execution is replayed for a retried key;
+        // after an error the retry runs the command again
+        bool bSucceeded = false;
         
         try
         {
             TSharedPtr<FJsonObject> ResultJson;
+
+            // Only the FJsonObject-based handlers pay for materializing the parameters
+            const FMCPNativeCommandHandler* NativeHandler = NativeHandlers.Find(CommandType);
+            const FMCPStreamingCommandHandler* StreamingHandler = NativeHandler ? nullptr : StreamingHandlers.Find(CommandType);
+            const TSharedPtr<FJsonObject> Params = (NativeHandler || StreamingHandler) ? nullptr : ParamsView.ToJsonObject();
+            bool bStreamed = false;
             
             if (CommandType == TEXT("ping"))
             {
                 ResultJson = MakeShareable(new FJsonObject);
-                ResultJson->SetStringField(TEXT("message"), TEXT("pong"));
+                ResultJson->SetStringField(MCPKeyStrings::Message, TEXT("pong"));
+                ResultJson->SetBoolField(TEXT("headless"), IsHeadless());
+            }
+            else if (CommandType == TEXT("get_instance_info"))
+            {
+                ResultJson = BuildInstanceInfo();
+            }
+            // Viewport-dependent commands cannot run without a level editor (commandlet / -nullrhi)
+            else if (IsHeadless() && RequiresViewport(CommandType))
+            {
+                ResultJson = FUnrealMCPCommonUtils::CreateErrorResponse(
+                    FString::Printf(TEXT("Command '%s' requires an editor viewport and is unavailable in headless mode"), *CommandType));
+            }
+            else if (NativeHandler)
+            {
+                ResultJson = NativeHandler->Execute(ParamsView);
+            }
+            else if (StreamingHandler)
+            {
+                // The handler writes the result value in place; on failure its partial output is discarded
+                Writer.BeginObject();
+                Writer.WriteField(MCPKeys::Status, TEXT("success"));
+                Writer.WriteKey(MCPKeys::Result);
+                FString StreamError;
+                if (StreamingHandler->Execute(ParamsView, Writer, StreamError))
+                {
+                    Writer.EndObject();
+                    bSucceeded = true;
+                }
+                else
+                {
+                    Writer.Reset();
+                    FMCPServerRunnable::WriteErrorResponse(Writer, StreamError);
+                }
+                bStreamed = true;
             }
             // Editor Commands (including actor manipulation)
-            else if (CommandType == TEXT("get_actors_in_level") || 
-                     CommandType == TEXT("find_actors_by_name") ||
-                     CommandType == TEXT("spawn_actor") ||
+            else if (CommandType == TEXT("spawn_actor") ||
                      CommandType == TEXT("create_actor") ||
                      CommandType == TEXT("delete_actor") || 
-                     CommandType == TEXT("set_actor_transform") ||
-                     CommandType == TEXT("get_actor_properties") ||
                      CommandType == TEXT("set_actor_property") ||
                      CommandType == TEXT("spawn_blueprint_actor") ||
                      CommandType == TEXT("focus_viewport") ||
-                     CommandType == TEXT("take_screenshot") ||
                      CommandType == TEXT("select_actors") ||
                      CommandType == TEXT("get_selected_actors") ||
                      CommandType == TEXT("duplicate_actor") ||
@@ -266,8 +568,6 @@ FString UUnrealMCPBridge::ExecuteCommand(const FString& CommandType, const TShar
                      CommandType == TEXT("set_actor_material") ||
                      CommandType == TEXT("set_actor_tags") ||
                      CommandType == TEXT("get_actor_tags") ||
-                     CommandType == TEXT("add_movement_input") ||
-                     CommandType == TEXT("pawn_action") ||
                      CommandType == TEXT("run_editor_utility") ||
                      CommandType == TEXT("spawn_editor_utility_tab") ||
                      CommandType == TEXT("close_editor_utility_tab") ||
@@ -288,7 +588,6 @@ FString UUnrealMCPBridge::ExecuteCommand(const FString& CommandType, const TShar
                      CommandType == TEXT("reparent_blueprint_component") ||
                      CommandType == TEXT("remove_blueprint_component") ||
                      CommandType == TEXT("inspect_blueprint") ||
-                     CommandType == TEXT("analyze_blueprint_graph") ||
                      CommandType == TEXT("set_blueprint_metadata"))
             {
                 ResultJson = BlueprintCommands->HandleCommand(CommandType, Params);
@@ -429,56 +728,107 @@ FString UUnrealMCPBridge::ExecuteCommand(const FString& CommandType, const TShar
 
                 if (!bHandledByExtension)
                 {
-                ResponseJson->SetStringField(TEXT("status"), TEXT("error"));
-                ResponseJson->SetStringField(TEXT("error"), FString::Printf(TEXT("Unknown command: %s"), *CommandType));
-
-                FString ResultString;
-                TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&ResultString);
-                FJsonSerializer::Serialize(ResponseJson.ToSharedRef(), Writer);
-                Promise.SetValue(ResultString);
-                return;
+                    ResultJson = FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Unknown command: %s"), *CommandType));
                 }
             }
             
-            // Check if the result contains an error
-            bool bSuccess = true;
-            FString ErrorMessage;
-            
-            if (ResultJson->HasField(TEXT("success")))
+            if (!bStreamed)
             {
-                bSuccess = ResultJson->GetBoolField(TEXT("success"));
-                if (!bSuccess && ResultJson->HasField(TEXT("error")))
+                // Check if the result contains an error
+                bool bSuccess = true;
+                FString ErrorMessage;
+                
+                if (const TSharedPtr<FJsonValue>* SuccessValue = ResultJson->Values.Find(MCPKeyStrings::Success))
                 {
-                    ErrorMessage = ResultJson->GetStringField(TEXT("error"));
+                    bSuccess = (*SuccessValue)->AsBool();
+                    if (!bSuccess)
+                    {
+                        ResultJson->TryGetStringField(MCPKeyStrings::Error, ErrorMessage);
+                    }
+                }
+                
+                if (bSuccess)
+                {
+                    // Set success status and include the result
+                    Writer.BeginObject();
+                    Writer.WriteField(MCPKeys::Status, TEXT("success"));
+                    Writer.WriteField(MCPKeys::Result, ResultJson);
+                    Writer.EndObject();
+                    bSucceeded = true;
+                }
+                else
+                {
+                    // Set error status and include the error message
+                    FMCPServerRunnable::WriteErrorResponse(Writer, ErrorMessage);
                 }
-            }
-            
-            if (bSuccess)
-            {
-                // Set success status and include the result
-                ResponseJson->SetStringField(TEXT("status"), TEXT("success"));
-                ResponseJson->SetObjectField(TEXT("result"), ResultJson);
-            }
-            else
-            {
-                // Set error status and include the error message
-                ResponseJson->SetStringField(TEXT("status"), TEXT("error"));
-                ResponseJson->SetStringField(TEXT("error"), ErrorMessage);
             }
         }
         catch (const std::exception& e)
         {
-            ResponseJson->SetStringField(TEXT("status"), TEXT("error"));
-            ResponseJson->SetStringField(TEXT("error"), UTF8_TO_TCHAR(e.what()));
+            Writer.Reset();
+            FMCPServerRunnable::WriteErrorResponse(Writer, UTF8_TO_TCHAR(e.what()));
         }
         
-        FString ResultString;
-        TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&ResultString);
-        FJsonSerializer::Serialize(ResponseJson.ToSharedRef(), Writer);
-        Promise.SetValue(ResultString);
+        FMCPMutationSessions::Get().EndCommand();
+        CommandConnection.Reset();
+
+        // Exponential moving average of game-thread cost, reported as the pool load metric
+        const double ElapsedMs = (FPlatformTime::Seconds() - GameThreadStart) * 1000.0;
+        AverageGameThreadMs = CommandsExecuted.GetValue() == 0 ? ElapsedMs : AverageGameThreadMs * 0.9 + ElapsedMs * 0.1;
+        CommandsExecuted.Increment();
+
+        TArray<uint8> Response = Writer.MoveBuffer();
+        if (bSucceeded && !IdempotencyKey.IsEmpty())
+        {
+            CacheResponse(IdempotencyKey, CommandType, Response);
+        }
+        Pending->Settle(MoveTemp(Response));
     });
     
-    return Future.Get();
+    TArray<uint8> Result = Future.Get();
+    {
+        FScopeLock Lock(&PendingCommandsLock);
+        PendingCommands.Remove(Pending);
+    }
+    InFlightCommands.Decrement();
+    return Result;
+}
+
+void UUnrealMCPBridge::FPendingCommand::Settle(TArray<uint8>&& Response)
+{
+    if (!bSettled.exchange(true))
+    {
+        Promise.SetValue(MoveTemp(Response));
+    }
+}
+
+void UUnrealMCPBridge::CancelPendingCommands()
+{
+    TArray<TSharedPtr<FPendingCommand, ESPMode::ThreadSafe>> Cancelled;
+    {
+        FScopeLock Lock(&PendingCommandsLock);
+        Cancelled = PendingCommands.Array();
+    }
+    for (const TSharedPtr<FPendingCommand, ESPMode::ThreadSafe>& Pending : Cancelled)
+    {
+        Pending->Settle(FMCPServerRunnable::MakeErrorResponse(TEXT("MCP server stopped before the command could run")));
+    }
+    if (Cancelled.Num() > 0)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("UnrealMCPBridge: Cancelled %d command(s) still waiting for the game thread"), Cancelled.Num());
+    }
+}
+
+void UUnrealMCPBridge::RegisterNativeHandler(const FString& CommandType, FMCPNativeCommandHandler Handler)
+{
+	NativeHandlers.Add(CommandType, Handler);
+	UE_LOG(LogTemp, Display, TEXT("UnrealMCPBridge: Registered native handler for '%s'"), *CommandType);
+}
+
+void UUnrealMCPBridge::RegisterStreamingHandler(const FString& CommandType, FMCPStreamingCommandHandler Handler)
+{
+	StreamingHandlers.Add(CommandType, Handler);
+	UE_LOG(LogTemp, Display, TEXT("UnrealMCPBridge: Registered streaming handler for '%s'"), *CommandType);
 }
 
 void UUnrealMCPBridge::RegisterExtensionHandler(const FString& CommandPrefix, FMCPCommandHandler Handler)
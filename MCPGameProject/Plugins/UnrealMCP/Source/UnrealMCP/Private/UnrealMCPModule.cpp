@@ -35,8 +35,11 @@ void FUnrealMCPModule::StartupModule()
 		);
 	}
 
-	// Register toolbar button after engine is ready
-	FCoreDelegates::OnPostEngineInit.AddRaw(this, &FUnrealMCPModule::ExtendLevelEditorToolbar);
+	// Register toolbar button after engine is ready (no toolbar exists in the headless commandlet)
+	if (!IsRunningCommandlet())
+	{
+		FCoreDelegates::OnPostEngineInit.AddRaw(this, &FUnrealMCPModule::ExtendLevelEditorToolbar);
+	}
 }
 
 void FUnrealMCPModule::ShutdownModule()
@@ -347,26 +350,18 @@ TSharedRef<SWidget> FUnrealMCPModule::CreateControlPanelContent()
 
 bool FUnrealMCPModule::IsServerRunning() const
 {
-	if (GEditor)
+	if (UUnrealMCPBridge* Bridge = UUnrealMCPBridge::Get())
 	{
-		UUnrealMCPBridge* Bridge = GEditor->GetEditorSubsystem<UUnrealMCPBridge>();
-		if (Bridge)
-		{
-			return Bridge->IsRunning();
-		}
+		return Bridge->IsRunning();
 	}
 	return false;
 }
 
 FReply FUnrealMCPModule::OnStartServerClicked()
 {
-	if (GEditor)
+	if (UUnrealMCPBridge* Bridge = UUnrealMCPBridge::Get())
 	{
-		UUnrealMCPBridge* Bridge = GEditor->GetEditorSubsystem<UUnrealMCPBridge>();
-		if (Bridge)
-		{
-			Bridge->StartServer();
-		}
+		Bridge->StartServer();
 	}
 
 	// Refresh toolbar status dot
@@ -380,13 +375,9 @@ FReply FUnrealMCPModule::OnStartServerClicked()
 
 FReply FUnrealMCPModule::OnStopServerClicked()
 {
-	if (GEditor)
+	if (UUnrealMCPBridge* Bridge = UUnrealMCPBridge::Get())
 	{
-		UUnrealMCPBridge* Bridge = GEditor->GetEditorSubsystem<UUnrealMCPBridge>();
-		if (Bridge)
-		{
-			Bridge->StopServer();
-		}
+		Bridge->StopServer();
 	}
 
 	if (UToolMenus* TM = UToolMenus::Get())
@@ -0,0 +1,108 @@
+#include "UnrealMCPServerCommandlet.h"
+#include "UnrealMCPBridge.h"
+#include "MCPSettings.h"
+#include "Editor.h"
+#include "Async/TaskGraphInterfaces.h"
+#include "Containers/Ticker.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/CoreDelegates.h"
+#include "Misc/Parse.h"
+#include "UObject/GarbageCollection.h"
+#include "UObject/Package.h"
+
+// How long the commandlet loop sleeps when there is no game-thread work
+static constexpr float MCPCommandletIdleSleepSeconds = 0.002f;
+
+// Nothing ticks the world in a commandlet, so collect garbage on a timer instead
+static constexpr double MCPCommandletGCIntervalSeconds = 60.0;
+
+UUnrealMCPServerCommandlet::UUnrealMCPServerCommandlet()
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+	ShowErrorCount = false;
+}
+
+int32 UUnrealMCPServerCommandlet::Main(const FString& Params)
+{
+	UE_LOG(LogTemp, Display, TEXT("UnrealMCPServerCommandlet: Starting headless MCP server"));
+
+	// Reuse the editor subsystem when the editor engine created it; otherwise host
+	// a standalone bridge object so the same command router is available.
+	UUnrealMCPBridge* Bridge = UUnrealMCPBridge::Get();
+	bool bOwnsBridge = false;
+	if (!Bridge)
+	{
+		Bridge = NewObject<UUnrealMCPBridge>(GetTransientPackage());
+		Bridge->AddToRoot();
+		bOwnsBridge = true;
+
+		// Initialize() never runs for a bridge that is not a subsystem
+		Bridge->InitializeServices();
+	}
+
+	const UMCPSettings* Settings = GetDefault<UMCPSettings>();
+	FString BindAddress = Settings->BindAddress;
+	int32 Port = Settings->Port;
+	FParse::Value(*Params, TEXT("McpBind="), BindAddress);
+	FParse::Value(*Params, TEXT("McpPort="), Port);
+
+	Bridge->StopServer();
+	Bridge->SetHeadless(true);
+	Bridge->SetServerEndpoint(BindAddress, Port);
+	Bridge->StartServer();
+
+	if (!Bridge->IsRunning())
+	{
+		UE_LOG(LogTemp, Error, TEXT("UnrealMCPServerCommandlet: Failed to start server on %s:%d"), *BindAddress, Port);
+		if (bOwnsBridge)
+		{
+			Bridge->ShutdownServices();
+			Bridge->RemoveFromRoot();
+		}
+		return 1;
+	}
+
+	UE_LOG(LogTemp, Display, TEXT("UnrealMCPServerCommandlet: Serving on %s:%d (request engine exit to stop)"), *BindAddress, Port);
+
+	double LastTime = FPlatformTime::Seconds();
+	double LastGCTime = LastTime;
+
+	while (!IsEngineExitRequested() && Bridge->IsRunning())
+	{
+		const double Now = FPlatformTime::Seconds();
+		const float DeltaTime = static_cast<float>(Now - LastTime);
+		LastTime = Now;
+
+		// Execute commands queued on the game thread by the server/worker threads
+		FTaskGraphInterface::Get().ProcessThreadUntilIdle(ENamedThreads::GameThread);
+
+		// Drive tickers (async loading callbacks, deferred bridge work)
+		FTSTicker::GetCoreTicker().Tick(DeltaTime);
+
+		if (Now - LastGCTime > MCPCommandletGCIntervalSeconds)
+		{
+			CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+			LastGCTime = Now;
+		}
+
+		FPlatformProcess::Sleep(MCPCommandletIdleSleepSeconds);
+	}
+
+	UE_LOG(LogTemp, Display, TEXT("UnrealMCPServerCommandlet: Shutting down"));
+	Bridge->StopServer();
+
+	// Drain anything that was queued while the server was stopping
+	FTaskGraphInterface::Get().ProcessThreadUntilIdle(ENamedThreads::GameThread);
+
+	if (bOwnsBridge)
+	{
+		Bridge->ShutdownServices();
+		Bridge->RemoveFromRoot();
+	}
+
+	return 0;
+}
@@ -2,6 +2,10 @@
 
 #include "CoreMinimal.h"
 #include "Json.h"
+#include "MCPJsonDocument.h"
+#include "MCPJsonWriter.h"
+
+class UUnrealMCPBridge;
 
 /**
  * Handler class for Blueprint-related MCP commands
@@ -14,6 +18,9 @@ public:
     // Handle blueprint commands
     TSharedPtr<FJsonObject> HandleCommand(const FString& CommandType, const TSharedPtr<FJsonObject>& Params);
 
+    // Register the handlers that stream their results (large graph dumps)
+    void RegisterNativeHandlers(UUnrealMCPBridge& Bridge);
+
 private:
     // Specific blueprint command handlers
     TSharedPtr<FJsonObject> HandleCreateBlueprint(const TSharedPtr<FJsonObject>& Params);
@@ -42,6 +49,6 @@ private:
 
     // Blueprint introspection
     TSharedPtr<FJsonObject> HandleInspectBlueprint(const TSharedPtr<FJsonObject>& Params);
-    TSharedPtr<FJsonObject> HandleAnalyzeBlueprintGraph(const TSharedPtr<FJsonObject>& Params);
+    bool HandleAnalyzeBlueprintGraph(const FMCPJsonObjectView& Params, FMCPJsonWriter& Writer, FString& OutError);
     TSharedPtr<FJsonObject> HandleSetBlueprintMetadata(const TSharedPtr<FJsonObject>& Params);
 };
\ No newline at end of file
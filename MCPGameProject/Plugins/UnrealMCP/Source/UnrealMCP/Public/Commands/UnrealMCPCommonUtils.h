@@ -16,6 +16,9 @@ class UK2Node_VariableSet;
 class UK2Node_InputAction;
 class UK2Node_Self;
 class UFunction;
+class UClass;
+class FMCPJsonObjectView;
+class FMCPJsonWriter;
 
 /**
  * Common utilities for UnrealMCP commands
@@ -31,14 +34,22 @@ public:
     static FVector2D GetVector2DFromJson(const TSharedPtr<FJsonObject>& JsonObject, const FString& FieldName);
     static FVector GetVectorFromJson(const TSharedPtr<FJsonObject>& JsonObject, const FString& FieldName);
     static FRotator GetRotatorFromJson(const TSharedPtr<FJsonObject>& JsonObject, const FString& FieldName);
+    static FVector GetVectorFromJson(const FMCPJsonObjectView& JsonObject, const TCHAR* FieldName);
+    static FRotator GetRotatorFromJson(const FMCPJsonObjectView& JsonObject, const TCHAR* FieldName);
     
     // World utilities - PIE-aware
     static UWorld* GetTargetWorld(bool bPreferPIE = true);
     static AActor* FindActorByName(const FString& ActorName, bool bPreferPIE = true);
+    // Actor class by name ("StaticMeshActor", "AStaticMeshActor"), class path, or Blueprint name
+    static UClass* FindActorClass(const FString& ClassName);
 
     // Actor utilities
     static TSharedPtr<FJsonValue> ActorToJson(AActor* Actor);
     static TSharedPtr<FJsonObject> ActorToJsonObject(AActor* Actor, bool bDetailed = false);
+    // Same fields as ActorToJson, written directly to a streaming response
+    static void WriteActorJson(FMCPJsonWriter& Writer, AActor* Actor);
+    // The members of WriteActorJson without the enclosing object, for callers that append their own fields
+    static void WriteActorFields(FMCPJsonWriter& Writer, AActor* Actor);
     
     // Blueprint utilities
     static UBlueprint* FindBlueprint(const FString& BlueprintName);
@@ -57,7 +68,7 @@ public:
     static UEdGraphPin* FindPin(UEdGraphNode* Node, const FString& PinName, EEdGraphPinDirection Direction = EGPD_MAX);
     static UK2Node_Event* FindExistingEventNode(UEdGraph* Graph, const FString& EventName);
 
-    // Property utilities
+    // Property utilities; PropertyName may be a dotted path through structs and object references
     static bool SetObjectProperty(UObject* Object, const FString& PropertyName, 
                                  const TSharedPtr<FJsonValue>& Value, FString& OutErrorMessage);
 }; 
\ No newline at end of file
@@ -2,6 +2,10 @@
 
 #include "CoreMinimal.h"
 #include "Json.h"
+#include "MCPJsonDocument.h"
+#include "MCPJsonWriter.h"
+
+class UUnrealMCPBridge;
 
 /**
  * Handler class for Editor-related MCP commands
@@ -15,14 +19,19 @@ public:
     // Handle editor commands
     TSharedPtr<FJsonObject> HandleCommand(const FString& CommandType, const TSharedPtr<FJsonObject>& Params);
 
+    // Register the handlers that read their parameters straight from the request document
+    void RegisterNativeHandlers(UUnrealMCPBridge& Bridge);
+
 private:
     // Actor manipulation commands
-    TSharedPtr<FJsonObject> HandleGetActorsInLevel(const TSharedPtr<FJsonObject>& Params);
-    TSharedPtr<FJsonObject> HandleFindActorsByName(const TSharedPtr<FJsonObject>& Params);
+    bool HandleGetActorsInLevel(const FMCPJsonObjectView& Params, FMCPJsonWriter& Writer, FString& OutError);
+    bool HandleFindActorsByName(const FMCPJsonObjectView& Params, FMCPJsonWriter& Writer, FString& OutError);
     TSharedPtr<FJsonObject> HandleSpawnActor(const TSharedPtr<FJsonObject>& Params);
+    bool HandleSpawnActors(const FMCPJsonObjectView& Params, FMCPJsonWriter& Writer, FString& OutError);
     TSharedPtr<FJsonObject> HandleDeleteActor(const TSharedPtr<FJsonObject>& Params);
-    TSharedPtr<FJsonObject> HandleSetActorTransform(const TSharedPtr<FJsonObject>& Params);
-    TSharedPtr<FJsonObject> HandleGetActorProperties(const TSharedPtr<FJsonObject>& Params);
+    TSharedPtr<FJsonObject> HandleSetActorTransform(const FMCPJsonObjectView& Params);
+    bool HandleSetActorTransforms(const FMCPJsonObjectView& Params, FMCPJsonWriter& Writer, FString& OutError);
+    TSharedPtr<FJsonObject> HandleGetActorProperties(const FMCPJsonObjectView& Params);
     TSharedPtr<FJsonObject> HandleSetActorProperty(const TSharedPtr<FJsonObject>& Params);
 
     // Blueprint actor spawning
@@ -30,7 +39,14 @@ private:
 
     // Editor viewport commands
     TSharedPtr<FJsonObject> HandleFocusViewport(const TSharedPtr<FJsonObject>& Params);
-    TSharedPtr<FJsonObject> HandleTakeScreenshot(const TSharedPtr<FJsonObject>& Params);
+    TSharedPtr<FJsonObject> HandleTakeScreenshot(const FMCPJsonObjectView& Params);
+    TSharedPtr<FJsonObject> HandleGetScreenshot(const FMCPJsonObjectView& Params);
+    TSharedPtr<FJsonObject> HandleStartViewportStream(const FMCPJsonObjectView& Params);
+    TSharedPtr<FJsonObject> HandleStopViewportStream(const FMCPJsonObjectView& Params);
+    TSharedPtr<FJsonObject> HandleBeginMutationSession(const FMCPJsonObjectView& Params);
+    TSharedPtr<FJsonObject> HandleEndMutationSession(const FMCPJsonObjectView& Params);
+    TSharedPtr<FJsonObject> HandleOpenPawnControl(const FMCPJsonObjectView& Params);
+    TSharedPtr<FJsonObject> HandleClosePawnControl(const FMCPJsonObjectView& Params);
 
     // Phase 5: Editor Enhancements
     TSharedPtr<FJsonObject> HandleSelectActors(const TSharedPtr<FJsonObject>& Params);
@@ -46,8 +62,8 @@ private:
     TSharedPtr<FJsonObject> HandleGetActorTags(const TSharedPtr<FJsonObject>& Params);
 
     // PIE / RL tools
-    TSharedPtr<FJsonObject> HandleAddMovementInput(const TSharedPtr<FJsonObject>& Params);
-    TSharedPtr<FJsonObject> HandlePawnAction(const TSharedPtr<FJsonObject>& Params);
+    TSharedPtr<FJsonObject> HandleAddMovementInput(const FMCPJsonObjectView& Params);
+    TSharedPtr<FJsonObject> HandlePawnAction(const FMCPJsonObjectView& Params);
 
     // Editor Utility Subsystem
     TSharedPtr<FJsonObject> HandleRunEditorUtility(const TSharedPtr<FJsonObject>& Params);
@@ -2,6 +2,10 @@
 
 #include "CoreMinimal.h"
 #include "Json.h"
+#include "MCPJsonDocument.h"
+#include "MCPJsonWriter.h"
+
+class UUnrealMCPBridge;
 
 class UNREALMCP_API FUnrealMCPLevelCommands
 {
@@ -10,6 +14,9 @@ public:
 
 	TSharedPtr<FJsonObject> HandleCommand(const FString& CommandType, const TSharedPtr<FJsonObject>& Params);
 
+	// Register the handlers that read their parameters straight from the request document
+	void RegisterNativeHandlers(UUnrealMCPBridge& Bridge);
+
 private:
 	TSharedPtr<FJsonObject> HandleNewLevel(const TSharedPtr<FJsonObject>& Params);
 	TSharedPtr<FJsonObject> HandleLoadLevel(const TSharedPtr<FJsonObject>& Params);
@@ -23,4 +30,7 @@ private:
 	TSharedPtr<FJsonObject> HandleBuildLighting(const TSharedPtr<FJsonObject>& Params);
 	TSharedPtr<FJsonObject> HandleSetWorldSettings(const TSharedPtr<FJsonObject>& Params);
 	TSharedPtr<FJsonObject> HandleExecutePython(const TSharedPtr<FJsonObject>& Params);
+	TSharedPtr<FJsonObject> HandleConsolidateToInstances(const FMCPJsonObjectView& Params);
+	bool HandleGetLevelChanges(const FMCPJsonObjectView& Params, FMCPJsonWriter& Writer, FString& OutError);
+	bool HandleGetLevelStats(const FMCPJsonObjectView& Params, FMCPJsonWriter& Writer, FString& OutError);
 };
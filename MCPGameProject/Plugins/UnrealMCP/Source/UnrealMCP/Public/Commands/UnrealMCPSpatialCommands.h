@@ -0,0 +1,25 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MCPJsonDocument.h"
+#include "MCPJsonWriter.h"
+
+class UUnrealMCPBridge;
+
+/**
+ * Geometric actor queries (box, radius, nearest, frustum) answered from FMCPSpatialIndex,
+ * so only the hits are serialized instead of every actor in the level.
+ */
+class UNREALMCP_API FUnrealMCPSpatialCommands
+{
+public:
+	FUnrealMCPSpatialCommands();
+
+	void RegisterNativeHandlers(UUnrealMCPBridge& Bridge);
+
+private:
+	bool HandleGetActorsInBox(const FMCPJsonObjectView& Params, FMCPJsonWriter& Writer, FString& OutError);
+	bool HandleGetActorsInRadius(const FMCPJsonObjectView& Params, FMCPJsonWriter& Writer, FString& OutError);
+	bool HandleGetNearestActors(const FMCPJsonObjectView& Params, FMCPJsonWriter& Writer, FString& OutError);
+	bool HandleGetActorsInFrustum(const FMCPJsonObjectView& Params, FMCPJsonWriter& Writer, FString& OutError);
+};
@@ -0,0 +1,96 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectKey.h"
+
+class AActor;
+class UWorld;
+class ULevel;
+class UObject;
+
+/**
+ * Per-world lookup from actor name and label to actor.
+ *
+ * A world is indexed by one full scan the first time it is queried and is then
+ * kept current from the editor's actor added / deleted / renamed / label
+ * delegates. Level streaming, undo and world teardown drop the affected world,
+ * which is re-indexed lazily on its next query. Every hit is re-validated
+ * against the live actor, and a stale hit drops the world as well, so a missed
+ * notification costs one rescan rather than a wrong answer.
+ *
+ * Names and labels compare case-insensitively, like the FString comparisons the
+ * by-name commands used before. Game thread only.
+ */
+class UNREALMCP_API FMCPActorIndex
+{
+public:
+	static FMCPActorIndex& Get();
+
+	/** Hook the editor delegates; called by the bridge subsystem. */
+	void Initialize();
+	void Shutdown();
+
+	/** Actor whose object name or label equals NameOrLabel. */
+	AActor* FindExact(UWorld* World, const FString& NameOrLabel);
+
+	/** Actor whose name or label contains Fragment; prefix matches are found without a scan and preferred. */
+	AActor* FindPartial(UWorld* World, const FString& Fragment);
+
+	/** Whether an actor already uses Name as its object name (and, if bIncludeLabels, as its label). */
+	bool IsNameInUse(UWorld* World, const FString& Name, bool bIncludeLabels);
+
+	/** Number of indexed actors in World (indexes it if needed). */
+	int32 Num(UWorld* World);
+
+	/** Drop every world; each is rebuilt on its next query. */
+	void Invalidate();
+
+private:
+	typedef TArray<TWeakObjectPtr<AActor>, TInlineAllocator<1>> FActorList;
+
+	/** What an actor was indexed under, so renames can remove the old keys. */
+	struct FIndexedKeys
+	{
+		FString Name;
+		FString Label;
+	};
+
+	struct FWorldIndex
+	{
+		TMap<FString, FActorList> ByName;
+		TMap<FString, FActorList> ByLabel;
+		TMap<TObjectKey<AActor>, FIndexedKeys> Keys;
+
+		// Lower-cased name and label keys sorted for prefix search; rebuilt lazily after changes
+		TArray<TPair<FString, TWeakObjectPtr<AActor>>> SortedKeys;
+		bool bSortedKeysDirty = true;
+	};
+
+	FWorldIndex* GetIndex(UWorld* World);
+	void BuildIndex(UWorld* World, FWorldIndex& Index);
+	void AddActor(FWorldIndex& Index, AActor* Actor);
+	void RemoveActor(FWorldIndex& Index, AActor* Actor);
+	void RebuildSortedKeys(FWorldIndex& Index);
+	void InvalidateWorld(UWorld* World);
+
+	static AActor* FirstValid(const FActorList* List);
+
+	void OnActorAdded(AActor* Actor);
+	void OnActorDeleted(AActor* Actor);
+	void OnActorLabelChanged(AActor* Actor);
+	void OnObjectRenamed(UObject* Object, UObject* OldOuter, FName OldName);
+	void OnLevelChanged(ULevel* Level, UWorld* World);
+	void OnWorldCleanup(UWorld* World, bool bSessionEnded, bool bCleanupResources);
+	void OnUndoRedo();
+
+	TMap<TObjectKey<UWorld>, FWorldIndex> Worlds;
+	FDelegateHandle ActorAddedHandle;
+	FDelegateHandle ActorDeletedHandle;
+	FDelegateHandle LabelChangedHandle;
+	FDelegateHandle ObjectRenamedHandle;
+	FDelegateHandle LevelAddedHandle;
+	FDelegateHandle LevelRemovedHandle;
+	FDelegateHandle WorldCleanupHandle;
+	FDelegateHandle UndoRedoHandle;
+	bool bInitialized = false;
+};
@@ -0,0 +1,131 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/EngineTypes.h"
+#include "MCPJsonDocument.h"
+
+class AActor;
+class UClass;
+class ULevel;
+class FMCPJsonWriter;
+
+/**
+ * Actor predicate parsed from a request's "filter" object:
+ *
+ *   {"class": "StaticMeshActor", "tags": ["Enemy"], "folder": "Props/Rocks",
+ *    "level": "Sublevel_A", "mobility": "Movable", "label": "Rock_*"}
+ *
+ * Every member is optional and all given members must match. Class matches
+ * subclasses, tags must all be present, folder matches the folder and its
+ * subfolders, level is the (short or long) package name of the actor's level,
+ * and label is a case-insensitive wildcard (* and ?). Tests run cheapest first
+ * so rejected actors cost no string work where possible.
+ */
+struct UNREALMCP_API FMCPActorFilter
+{
+	UClass* Class = nullptr;
+	TArray<FName> Tags;
+	FString Folder;
+	FString Level;
+	TOptional<EComponentMobility::Type> Mobility;
+	FString LabelPattern;
+
+	/** Parse a "filter" object; an invalid (absent) view gives an empty filter. Returns false with a message on bad input. */
+	static bool Parse(const FMCPJsonObjectView& Filter, FMCPActorFilter& OutFilter, FString& OutError);
+
+	bool IsEmpty() const;
+	bool Matches(const AActor* Actor) const;
+};
+
+/** Actor fields that can be requested through a "fields" projection. */
+enum class EMCPActorField : uint32
+{
+	None = 0,
+	Name = 1 << 0,
+	Label = 1 << 1,
+	Class = 1 << 2,
+	Location = 1 << 3,
+	Rotation = 1 << 4,
+	Scale = 1 << 5,
+	Tags = 1 << 6,
+	Folder = 1 << 7,
+	Level = 1 << 8,
+	Mobility = 1 << 9,
+	Path = 1 << 10,
+
+	/** Editor-visible UPROPERTYs, as get_actor_properties returns them. */
+	Properties = 1 << 11,
+
+	/** What actor listings returned before projections existed. */
+	Default = Name | Class | Location | Rotation | Scale
+};
+ENUM_CLASS_FLAGS(EMCPActorField);
+
+/** Which actor fields a listing writes. */
+struct UNREALMCP_API FMCPActorProjection
+{
+	EMCPActorField Fields = EMCPActorField::Default;
+
+	/** Parse a "fields" list of field names; an empty list means Default. */
+	static bool Parse(const TArray<FString>& FieldNames, FMCPActorProjection& OutProjection, FString& OutError);
+
+	/** Write the selected fields into the object the writer is currently inside. */
+	void WriteFields(FMCPJsonWriter& Writer, AActor* Actor) const;
+};
+
+/**
+ * The projected fields of many actors copied out on the game thread, so the
+ * JSON encoding of a large listing can be spread over task threads. Adding an
+ * actor copies names, transforms and indices into shared class / level tables;
+ * encoding touches no UObject.
+ *
+ * Properties are read through the actor itself and cannot be snapshotted;
+ * CanSnapshot is false for projections that include them.
+ */
+class UNREALMCP_API FMCPActorSnapshot
+{
+public:
+	explicit FMCPActorSnapshot(const FMCPActorProjection& InProjection);
+
+	static bool CanSnapshot(const FMCPActorProjection& Projection);
+
+	/** Copy the projected fields of Actor (game thread). */
+	void Add(const AActor* Actor);
+
+	int32 Num() const { return Entries.Num(); }
+
+	/** Write one object per actor into the array the writer is currently inside; parallel above a few thousand actors. */
+	void WriteElements(FMCPJsonWriter& Writer) const;
+
+private:
+	struct FEntry
+	{
+		FName Name;
+		FString Label;
+		FVector Location = FVector::ZeroVector;
+		FRotator Rotation = FRotator::ZeroRotator;
+		FVector Scale = FVector::OneVector;
+		TArray<FName> Tags;
+		FName Folder;
+		int32 ClassIndex = INDEX_NONE;
+		int32 LevelIndex = INDEX_NONE;
+
+		/** EComponentMobility value, or INDEX_NONE without a root component. */
+		int8 Mobility = INDEX_NONE;
+	};
+
+	struct FLevelInfo
+	{
+		FString ShortName;
+		FString PathName;
+	};
+
+	void WriteEntry(FMCPJsonWriter& Writer, const FEntry& Entry) const;
+
+	EMCPActorField Fields;
+	TArray<FEntry> Entries;
+	TArray<FString> ClassNames;
+	TMap<const UClass*, int32> ClassIndices;
+	TArray<FLevelInfo> Levels;
+	TMap<const ULevel*, int32> LevelIndices;
+};
@@ -0,0 +1,115 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Queue.h"
+#include "HAL/CriticalSection.h"
+#include "MCPFrameScanner.h"
+#include <atomic>
+
+class FSocket;
+
+/** Outcome of FMCPClientConnection::TrySendBytes. */
+enum class EMCPSendResult : uint8
+{
+	Sent,
+
+	/** Nothing was written: the socket buffer is full or another send is in progress. */
+	WouldBlock,
+
+	/** The connection is closed or the send failed. */
+	Failed,
+};
+
+/**
+ * One accepted MCP client socket.
+ *
+ * The server thread reads bytes and splits them into frames; frames are queued
+ * here and drained in order by a single worker at a time, so requests from one
+ * connection execute and answer in the order they were sent while different
+ * connections proceed in parallel.
+ */
+class UNREALMCP_API FMCPClientConnection : public TSharedFromThis<FMCPClientConnection, ESPMode::ThreadSafe>
+{
+public:
+	/** Frames larger than this close the connection */
+	static constexpr int32 MaxFrameBytes = 64 * 1024 * 1024;
+
+	/** A send that has started must finish within this; otherwise the connection is closed */
+	static constexpr double SendTimeoutSeconds = 10.0;
+
+	FMCPClientConnection(TSharedPtr<FSocket> InSocket, int32 InConnectionId);
+	~FMCPClientConnection();
+
+	int32 GetConnectionId() const { return ConnectionId; }
+	bool IsClosed() const { return bClosed.load(); }
+
+	/**
+	 * Mark the connection closed and shut the socket down (any thread). The
+	 * descriptor stays allocated until CloseSocket(), so a Recv running on the
+	 * server thread fails instead of reading from a socket that reused it.
+	 */
+	void Close();
+
+	/** Release the socket descriptor (server thread, once it stops receiving on it). */
+	void CloseSocket();
+
+	/**
+	 * Read whatever the socket has buffered and append complete frames to OutFrames
+	 * (server thread only). Returns false when the peer closed the connection or
+	 * sent something that is not a request stream.
+	 */
+	bool ReceiveFrames(TArray<TArray<uint8>>& OutFrames);
+
+	/**
+	 * Send raw bytes, retrying until all are written (any thread, serialized).
+	 * Gives up when the connection closes or the peer stops reading for
+	 * SendTimeoutSeconds, closing the connection since its stream is cut mid-frame.
+	 */
+	bool SendBytes(const uint8* Data, int32 Num);
+
+	/**
+	 * Send raw bytes only if the socket takes them now (any thread). Once the first
+	 * bytes are accepted the rest is written as in SendBytes, so a frame is either
+	 * sent whole or not at all. For pushed data that can be dropped when the client lags.
+	 */
+	EMCPSendResult TrySendBytes(const uint8* Data, int32 Num);
+
+	/** Send a UTF-8 response followed by the newline frame terminator. */
+	bool SendResponse(TArray<uint8>&& Utf8Response);
+
+	/** Queue a frame for in-order processing. Returns true if the caller must schedule a drain. */
+	bool EnqueueFrame(TArray<uint8>&& Frame);
+
+	/** Pop the next queued frame (drain worker only). */
+	bool DequeueFrame(TArray<uint8>& OutFrame);
+
+	/**
+	 * Called by the drain worker when the queue looked empty. Returns true if the
+	 * worker should keep draining because a frame raced in.
+	 */
+	bool FinishDrain();
+
+private:
+	TSharedPtr<FSocket> Socket;
+	int32 ConnectionId;
+
+	// Server-thread receive state
+	TArray<uint8> RecvBuffer;
+	FMCPFrameScanner Scanner;
+
+	// Complete frames waiting for the drain worker
+	TQueue<TArray<uint8>, EQueueMode::Spsc> PendingFrames;
+	std::atomic<bool> bDraining{ false };
+
+	/** Write Data[TotalSent..Num) with SendLock held, waiting out a full socket up to the send timeout. */
+	bool SendRemainingLocked(const uint8* Data, int32 Num, int32 TotalSent);
+
+	/** Shut the socket down without releasing it (SendLock held). */
+	void ShutdownLocked();
+
+	FCriticalSection SendLock;
+	std::atomic<bool> bClosed{ false };
+
+	/** Set once CloseSocket() has released the descriptor; guarded by SendLock. */
+	bool bSocketReleased = false;
+};
@@ -0,0 +1,355 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MCPJsonDocument.h"
+#include <tuple>
+#include <utility>
+
+class FMCPJsonWriter;
+
+/** Parameter kinds reported by describe_commands. */
+enum class EMCPParamType : uint8
+{
+	String,
+	Number,
+	Integer,
+	Bool,
+	Vector,
+	Rotator,
+	StringArray,
+	Object,
+	Array
+};
+
+/** Schema name of a parameter type ("string", "vector", ...). */
+UNREALMCP_API const TCHAR* LexToString(EMCPParamType Type);
+
+/** Phrase used in binding errors ("a string", "an array of 3 numbers", ...). */
+UNREALMCP_API const TCHAR* MCPParamTypeExpectation(EMCPParamType Type);
+
+/** Runtime description of one parameter. */
+struct FMCPParamInfo
+{
+	const TCHAR* Name;
+	EMCPParamType Type;
+	bool bRequired;
+	const TCHAR* Description;
+};
+
+/**
+ * How a C++ field is read from a request value. Conversions follow the view
+ * accessors (and therefore FJsonObject), so binding accepts what the old
+ * TryGet*Field calls accepted.
+ */
+template <typename T>
+struct TMCPParamTraits;
+
+template <>
+struct TMCPParamTraits<FString>
+{
+	static constexpr EMCPParamType Type = EMCPParamType::String;
+	static bool Read(const FMCPJsonValueView& Value, FString& Out) { return Value.TryGetString(Out); }
+};
+
+template <>
+struct TMCPParamTraits<double>
+{
+	static constexpr EMCPParamType Type = EMCPParamType::Number;
+	static bool Read(const FMCPJsonValueView& Value, double& Out) { return Value.TryGetNumber(Out); }
+};
+
+template <>
+struct TMCPParamTraits<float>
+{
+	static constexpr EMCPParamType Type = EMCPParamType::Number;
+	static bool Read(const FMCPJsonValueView& Value, float& Out) { return Value.TryGetNumber(Out); }
+};
+
+template <>
+struct TMCPParamTraits<int32>
+{
+	static constexpr EMCPParamType Type = EMCPParamType::Integer;
+	static bool Read(const FMCPJsonValueView& Value, int32& Out) { return Value.TryGetNumber(Out); }
+};
+
+template <>
+struct TMCPParamTraits<int64>
+{
+	static constexpr EMCPParamType Type = EMCPParamType::Integer;
+	static bool Read(const FMCPJsonValueView& Value, int64& Out) { return Value.TryGetNumber(Out); }
+};
+
+template <>
+struct TMCPParamTraits<bool>
+{
+	static constexpr EMCPParamType Type = EMCPParamType::Bool;
+	static bool Read(const FMCPJsonValueView& Value, bool& Out) { return Value.TryGetBool(Out); }
+};
+
+/** [x, y, z]; unlike GetVectorFromJson a short or non-numeric array is an error, not a zero vector. */
+template <>
+struct TMCPParamTraits<FVector>
+{
+	static constexpr EMCPParamType Type = EMCPParamType::Vector;
+	static bool Read(const FMCPJsonValueView& Value, FVector& Out)
+	{
+		double Components[3];
+		if (!ReadNumberTriple(Value, Components))
+		{
+			return false;
+		}
+		Out = FVector(Components[0], Components[1], Components[2]);
+		return true;
+	}
+
+	static bool ReadNumberTriple(const FMCPJsonValueView& Value, double (&OutComponents)[3])
+	{
+		FMCPJsonArrayView Array;
+		if (!Value.TryGetArray(Array) || Array.Num() < 3)
+		{
+			return false;
+		}
+		int32 Index = 0;
+		for (const FMCPJsonValueView Element : Array)
+		{
+			if (Index == 3)
+			{
+				break;
+			}
+			if (Element.GetType() != EMCPJsonType::Number || !Element.TryGetNumber(OutComponents[Index++]))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+};
+
+/** [pitch, yaw, roll] */
+template <>
+struct TMCPParamTraits<FRotator>
+{
+	static constexpr EMCPParamType Type = EMCPParamType::Rotator;
+	static bool Read(const FMCPJsonValueView& Value, FRotator& Out)
+	{
+		double Components[3];
+		if (!TMCPParamTraits<FVector>::ReadNumberTriple(Value, Components))
+		{
+			return false;
+		}
+		Out = FRotator(Components[0], Components[1], Components[2]);
+		return true;
+	}
+};
+
+template <>
+struct TMCPParamTraits<TArray<FString>>
+{
+	static constexpr EMCPParamType Type = EMCPParamType::StringArray;
+	static bool Read(const FMCPJsonValueView& Value, TArray<FString>& Out)
+	{
+		FMCPJsonArrayView Array;
+		if (!Value.TryGetArray(Array))
+		{
+			return false;
+		}
+		Out.Reset(Array.Num());
+		for (const FMCPJsonValueView Element : Array)
+		{
+			if (!Element.TryGetString(Out.AddDefaulted_GetRef()))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+};
+
+template <>
+struct TMCPParamTraits<FMCPJsonObjectView>
+{
+	static constexpr EMCPParamType Type = EMCPParamType::Object;
+	static bool Read(const FMCPJsonValueView& Value, FMCPJsonObjectView& Out) { return Value.TryGetObject(Out); }
+};
+
+/** Arrays of objects (batch commands) are bound as views and walked by the handler. */
+template <>
+struct TMCPParamTraits<FMCPJsonArrayView>
+{
+	static constexpr EMCPParamType Type = EMCPParamType::Array;
+	static bool Read(const FMCPJsonValueView& Value, FMCPJsonArrayView& Out) { return Value.TryGetArray(Out); }
+};
+
+/** Optional fields whose presence matters (e.g. "only move if location was given"). */
+template <typename T>
+struct TMCPParamTraits<TOptional<T>>
+{
+	static constexpr EMCPParamType Type = TMCPParamTraits<T>::Type;
+	static bool Read(const FMCPJsonValueView& Value, TOptional<T>& Out)
+	{
+		T Parsed{};
+		if (!TMCPParamTraits<T>::Read(Value, Parsed))
+		{
+			return false;
+		}
+		Out = MoveTemp(Parsed);
+		return true;
+	}
+};
+
+/** One entry of a parameter schema: JSON name, destination member, and documentation. */
+template <typename StructType, typename FieldType>
+struct TMCPParamField
+{
+	const TCHAR* Name;
+	FieldType StructType::* Member;
+	bool bRequired;
+	const TCHAR* Description;
+};
+
+template <typename StructType, typename FieldType>
+constexpr TMCPParamField<StructType, FieldType> MCPRequired(const TCHAR* Name, FieldType StructType::* Member, const TCHAR* Description)
+{
+	return TMCPParamField<StructType, FieldType>{ Name, Member, true, Description };
+}
+
+/** Optional fields keep the value the struct was initialized with when absent or null. */
+template <typename StructType, typename FieldType>
+constexpr TMCPParamField<StructType, FieldType> MCPOptional(const TCHAR* Name, FieldType StructType::* Member, const TCHAR* Description)
+{
+	return TMCPParamField<StructType, FieldType>{ Name, Member, false, Description };
+}
+
+/**
+ * Compile-time parameter schema for a command.
+ *
+ * Bind() walks the request's members once, dispatches each to the matching field
+ * by name, and collects every missing or mistyped parameter into one error
+ * instead of stopping at the first. Describe() exposes the same fields to
+ * describe_commands, so the documentation cannot drift from what is parsed.
+ *
+ *   struct FMyParams { FString Name; TOptional<FVector> Location; };
+ *   static constexpr auto MySchema = MakeMCPParamSchema(
+ *       MCPRequired(TEXT("name"), &FMyParams::Name, TEXT("Actor name")),
+ *       MCPOptional(TEXT("location"), &FMyParams::Location, TEXT("[x, y, z]")));
+ */
+template <typename StructType, typename... FieldTypes>
+class TMCPParamSchema
+{
+public:
+	static constexpr int32 NumFields = sizeof...(FieldTypes);
+	static_assert(NumFields <= 64, "TMCPParamSchema tracks fields in a 64-bit mask");
+
+	constexpr explicit TMCPParamSchema(const TMCPParamField<StructType, FieldTypes>&... InFields)
+		: Fields(InFields...)
+	{
+	}
+
+	/** Fill Out from Params. Returns false with every problem listed in OutError. */
+	bool Bind(const FMCPJsonObjectView& Params, StructType& Out, FString& OutError) const
+	{
+		uint64 PresentMask = 0;
+		TArray<FString, TInlineAllocator<4>> Errors;
+
+		Params.ForEachField([&](FUtf8StringView Key, const FMCPJsonValueView& Value)
+		{
+			// null reads as absent, as with FJsonObject::TryGet*Field
+			if (!Value.IsNull())
+			{
+				BindMember(Key, Value, Out, PresentMask, Errors, std::index_sequence_for<FieldTypes...>());
+			}
+		});
+		CheckRequired(PresentMask, Errors, std::index_sequence_for<FieldTypes...>());
+
+		if (Errors.Num() > 0)
+		{
+			OutError = FString::Join(Errors, TEXT("; "));
+			return false;
+		}
+		return true;
+	}
+
+	void Describe(TArray<FMCPParamInfo>& OutParams) const
+	{
+		DescribeFields(OutParams, std::index_sequence_for<FieldTypes...>());
+	}
+
+private:
+	template <size_t... Indices>
+	void BindMember(FUtf8StringView Key, const FMCPJsonValueView& Value, StructType& Out, uint64& PresentMask, TArray<FString, TInlineAllocator<4>>& Errors, std::index_sequence<Indices...>) const
+	{
+		// Short-circuits at the field whose name matches; unknown members are ignored
+		(void)(TryBindField<Indices>(Key, Value, Out, PresentMask, Errors) || ...);
+	}
+
+	template <size_t Index>
+	bool TryBindField(FUtf8StringView Key, const FMCPJsonValueView& Value, StructType& Out, uint64& PresentMask, TArray<FString, TInlineAllocator<4>>& Errors) const
+	{
+		using FieldType = std::tuple_element_t<Index, std::tuple<FieldTypes...>>;
+		const TMCPParamField<StructType, FieldType>& Field = std::get<Index>(Fields);
+		if (!MCPJsonKeyEquals(Key, Field.Name))
+		{
+			return false;
+		}
+
+		PresentMask |= uint64(1) << Index;
+		if (!TMCPParamTraits<FieldType>::Read(Value, Out.*(Field.Member)))
+		{
+			Errors.Add(FString::Printf(TEXT("'%s' must be %s"), Field.Name, MCPParamTypeExpectation(TMCPParamTraits<FieldType>::Type)));
+		}
+		return true;
+	}
+
+	template <size_t... Indices>
+	void CheckRequired(uint64 PresentMask, TArray<FString, TInlineAllocator<4>>& Errors, std::index_sequence<Indices...>) const
+	{
+		(CheckRequiredField<Indices>(PresentMask, Errors), ...);
+	}
+
+	template <size_t Index>
+	void CheckRequiredField(uint64 PresentMask, TArray<FString, TInlineAllocator<4>>& Errors) const
+	{
+		const auto& Field = std::get<Index>(Fields);
+		if (Field.bRequired && (PresentMask & (uint64(1) << Index)) == 0)
+		{
+			Errors.Add(FString::Printf(TEXT("Missing '%s' parameter"), Field.Name));
+		}
+	}
+
+	template <size_t... Indices>
+	void DescribeFields(TArray<FMCPParamInfo>& OutParams, std::index_sequence<Indices...>) const
+	{
+		(OutParams.Add(FMCPParamInfo{
+			std::get<Indices>(Fields).Name,
+			TMCPParamTraits<std::tuple_element_t<Indices, std::tuple<FieldTypes...>>>::Type,
+			std::get<Indices>(Fields).bRequired,
+			std::get<Indices>(Fields).Description }), ...);
+	}
+
+	std::tuple<TMCPParamField<StructType, FieldTypes>...> Fields;
+};
+
+template <typename StructType, typename... FieldTypes>
+constexpr TMCPParamSchema<StructType, FieldTypes...> MakeMCPParamSchema(const TMCPParamField<StructType, FieldTypes>&... Fields)
+{
+	return TMCPParamSchema<StructType, FieldTypes...>(Fields...);
+}
+
+/** Schemas of descriptor-backed commands, served by describe_commands. Game thread only. */
+class UNREALMCP_API FMCPCommandSchemas
+{
+public:
+	template <typename SchemaType>
+	static void Register(const FString& CommandType, const TCHAR* Description, const SchemaType& Schema)
+	{
+		TArray<FMCPParamInfo> Params;
+		Schema.Describe(Params);
+		Add(CommandType, Description, MoveTemp(Params));
+	}
+
+	/** describe_commands: { "commands": [ { "name", "description", "params": [ ... ] } ] }, optionally filtered by "command". */
+	static bool HandleDescribeCommands(const FMCPJsonObjectView& Params, FMCPJsonWriter& Writer, FString& OutError);
+
+private:
+	static void Add(const FString& CommandType, const TCHAR* Description, TArray<FMCPParamInfo>&& Params);
+};
@@ -0,0 +1,104 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Leading byte of a binary frame. It is a UTF-8 continuation byte, so it can never
+ * start a JSON request; a frame is the marker, a frame type byte, a little-endian
+ * uint16 payload length and the payload.
+ */
+constexpr uint8 MCPBinaryFrameMagic = 0xB1;
+constexpr int32 MCPBinaryFrameHeaderBytes = 4;
+
+/** Byte range [Start, End) of one complete request inside a connection's receive buffer. */
+struct FMCPFrameRange
+{
+	int32 Start = 0;
+	int32 End = 0;
+
+	int32 Num() const { return End - Start; }
+};
+
+/**
+ * Incremental request framer for the MCP socket protocol.
+ *
+ * Requests are JSON objects, optionally separated by newlines. Older clients send
+ * a single object with no terminator, so frames are delimited by tracking
+ * brace depth (ignoring braces inside strings) rather than by looking for '\n'.
+ * The scanner keeps its state between calls and only examines bytes appended
+ * since the previous Scan(), validating UTF-8 as it goes.
+ *
+ * Between requests a client may also send binary frames (MCPBinaryFrameMagic);
+ * they are cut by their length header and passed through unvalidated, with the
+ * marker still in front so the caller can tell them apart.
+ *
+ * Inside a frame, 16-byte blocks are classified with SSE2 (x86) or NEON (ARM):
+ * blocks with no quote, backslash, bracket or non-ASCII byte are skipped
+ * without touching the state machine, and only the flagged bytes of other
+ * blocks are visited.
+ */
+class UNREALMCP_API FMCPFrameScanner
+{
+public:
+	/**
+	 * Scan bytes appended to Buffer since the last call and append the ranges of
+	 * any frames completed by them. Returns false on a protocol error (bytes
+	 * between frames that are neither whitespace nor the start of a JSON
+	 * object/array, or invalid UTF-8); GetError() describes it.
+	 */
+	bool Scan(const TArray<uint8>& Buffer, TArray<FMCPFrameRange>& OutFrames);
+
+	/** Adjust offsets after the caller removed the first Count bytes from the buffer. */
+	void Consume(int32 Count);
+
+	/** Forget all state (new connection). */
+	void Reset();
+
+	/** Offset where the first unfinished frame starts, or the scan position if none is open. */
+	int32 GetPendingStart() const { return FrameStart != INDEX_NONE ? FrameStart : ScanOffset; }
+
+	/** True while a frame has been opened but not closed. */
+	bool HasOpenFrame() const { return FrameStart != INDEX_NONE; }
+
+	/** Reason for the last Scan() failure. */
+	const TCHAR* GetError() const { return Error; }
+
+	/** Disable the vector path (scalar comparison in tests only). */
+	void SetUseSimd(bool bInUseSimd) { bUseSimd = bInUseSimd; }
+
+private:
+	enum class EByteResult : uint8
+	{
+		Continue,
+		FrameClosed,
+		Error
+	};
+
+	/** Run one byte through the framing and UTF-8 state machines. */
+	EByteResult ConsumeByte(uint8 Byte, int32 Index, TArray<FMCPFrameRange>& OutFrames);
+
+	/** Feed one byte to the UTF-8 validator. Returns false if the sequence is invalid. */
+	bool ValidateUtf8Byte(uint8 Byte);
+
+	/** Binary frame starting at (or continuing from) FrameStart. Returns the next index to scan. */
+	int32 ScanBinaryFrame(const uint8* Data, int32 Index, int32 Num, TArray<FMCPFrameRange>& OutFrames);
+
+	/** Vector fast path from Index while a frame is open. Returns the next index to scan, or INDEX_NONE on error. */
+	int32 ScanFrameBlocks(const uint8* Data, int32 Index, int32 Num, TArray<FMCPFrameRange>& OutFrames);
+
+	int32 ScanOffset = 0;
+	int32 FrameStart = INDEX_NONE;
+	int32 Depth = 0;
+	bool bInString = false;
+	bool bEscape = false;
+	bool bBinaryFrame = false;
+
+	// UTF-8 validation carried across Scan() calls: continuation bytes still expected
+	// and the allowed range of the next one (rejects overlongs and surrogates)
+	uint8 Utf8Need = 0;
+	uint8 Utf8Lower = 0x80;
+	uint8 Utf8Upper = 0xBF;
+
+	bool bUseSimd = true;
+	const TCHAR* Error = TEXT("");
+};
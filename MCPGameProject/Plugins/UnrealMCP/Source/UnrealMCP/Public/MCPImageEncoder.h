@@ -0,0 +1,40 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class IImageWrapperModule;
+
+/** Output formats for captured frames. */
+enum class EMCPImageFormat : uint8
+{
+	Png,
+	Jpeg
+};
+
+/**
+ * Pixel work for captured frames: opaque fix-up, downscaling and compression.
+ *
+ * Everything here works on plain FColor arrays and touches no engine state
+ * beyond the image wrapper module, so it runs on worker threads and can be
+ * exercised with synthetic bitmaps.
+ */
+struct UNREALMCP_API FMCPImageEncoder
+{
+	/** Parse "png", "jpeg" or "jpg". Returns false with a message for anything else. */
+	static bool ParseFormat(const FString& Text, EMCPImageFormat& OutFormat, FString& OutError);
+
+	static const TCHAR* GetExtension(EMCPImageFormat Format);
+
+	/** Size that fits Source inside MaxSize x MaxSize keeping the aspect ratio; never upscales. MaxSize <= 0 keeps Source. */
+	static FIntPoint FitSize(FIntPoint Source, int32 MaxSize);
+
+	/** Viewport readbacks carry A=0, which makes a PNG fully transparent. */
+	static void ForceOpaque(TArray<FColor>& Pixels);
+
+	/** Box-filter Source down to DestSize (every source pixel contributes to exactly one area average). */
+	static void Resample(const TArray<FColor>& Source, FIntPoint SourceSize, FIntPoint DestSize, TArray<FColor>& OutPixels);
+
+	/** Compress BGRA8 pixels. Quality applies to JPEG (1-100). */
+	static bool Encode(IImageWrapperModule& ImageWrapperModule, const TArray<FColor>& Pixels, FIntPoint Size,
+		EMCPImageFormat Format, int32 Quality, TArray64<uint8>& OutBytes, FString& OutError);
+};
@@ -0,0 +1,201 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Misc/MemStack.h"
+#include "MCPJsonKeys.h"
+
+class FJsonObject;
+class FJsonValue;
+class FMCPJsonObjectView;
+class FMCPJsonArrayView;
+
+enum class EMCPJsonType : uint8
+{
+	Null,
+	Bool,
+	Number,
+	String,
+	Array,
+	Object
+};
+
+/**
+ * One value in an FMCPJsonDocument. Nodes live in the document's arena; strings
+ * point into the request frame unless they contained escapes, in which case the
+ * decoded bytes are in the arena too. Object members and array elements form a
+ * singly linked list in document order.
+ */
+struct FMCPJsonNode
+{
+	const UTF8CHAR* Key = nullptr;
+	const UTF8CHAR* String = nullptr;
+	const FMCPJsonNode* FirstChild = nullptr;
+	const FMCPJsonNode* Next = nullptr;
+	double Number = 0.0;
+	int32 KeyLen = 0;
+	int32 StringLen = 0;
+	int32 NumChildren = 0;
+	uint32 KeyHash = 0;
+	EMCPJsonType Type = EMCPJsonType::Null;
+	bool bBool = false;
+};
+
+/** Compare a member name from a document against a field name literal, ignoring case like FJsonObject. */
+UNREALMCP_API bool MCPJsonKeyEquals(FUtf8StringView Key, const TCHAR* FieldName);
+
+/** Read-only handle to a node. Conversions follow FJsonValue (numbers and bools read as strings, numeric strings as numbers). */
+class UNREALMCP_API FMCPJsonValueView
+{
+public:
+	FMCPJsonValueView() = default;
+	explicit FMCPJsonValueView(const FMCPJsonNode* InNode) : Node(InNode) {}
+
+	bool IsValid() const { return Node != nullptr; }
+	EMCPJsonType GetType() const { return Node ? Node->Type : EMCPJsonType::Null; }
+	bool IsNull() const { return GetType() == EMCPJsonType::Null; }
+
+	bool TryGetString(FString& OutString) const;
+	bool TryGetNumber(double& OutNumber) const;
+	bool TryGetNumber(float& OutNumber) const;
+	bool TryGetNumber(int32& OutNumber) const;
+	bool TryGetNumber(int64& OutNumber) const;
+	bool TryGetBool(bool& OutBool) const;
+	bool TryGetObject(FMCPJsonObjectView& OutObject) const;
+	bool TryGetArray(FMCPJsonArrayView& OutArray) const;
+
+	/** Zero-copy access to a string value; valid for the lifetime of the document. */
+	bool TryGetStringView(FUtf8StringView& OutView) const;
+
+	/** Materialize as a Dom value for code that still works on FJsonObject. */
+	TSharedPtr<FJsonValue> ToJsonValue() const;
+
+	const FMCPJsonNode* GetNode() const { return Node; }
+
+protected:
+	const FMCPJsonNode* Node = nullptr;
+};
+
+/** Array accessor; elements are visited with a range-for. */
+class UNREALMCP_API FMCPJsonArrayView : public FMCPJsonValueView
+{
+public:
+	FMCPJsonArrayView() = default;
+	explicit FMCPJsonArrayView(const FMCPJsonNode* InNode) : FMCPJsonValueView(InNode) {}
+
+	int32 Num() const { return Node ? Node->NumChildren : 0; }
+
+	struct FIterator
+	{
+		const FMCPJsonNode* Current;
+		FMCPJsonValueView operator*() const { return FMCPJsonValueView(Current); }
+		FIterator& operator++() { Current = Current->Next; return *this; }
+		bool operator!=(const FIterator& Other) const { return Current != Other.Current; }
+	};
+	FIterator begin() const { return FIterator{ Node ? Node->FirstChild : nullptr }; }
+	FIterator end() const { return FIterator{ nullptr }; }
+};
+
+/**
+ * Object accessor mirroring the FJsonObject TryGet*Field calls handlers already use.
+ * Lookups are a linear scan of the members, which beats hashing at request sizes.
+ */
+class UNREALMCP_API FMCPJsonObjectView : public FMCPJsonValueView
+{
+public:
+	FMCPJsonObjectView() = default;
+	explicit FMCPJsonObjectView(const FMCPJsonNode* InNode) : FMCPJsonValueView(InNode) {}
+
+	int32 Num() const { return Node ? Node->NumChildren : 0; }
+
+	/**
+	 * Member lookup with FJsonObject semantics: names match case-insensitively and,
+	 * when a name repeats, the last occurrence wins.
+	 */
+	FMCPJsonValueView FindField(const TCHAR* FieldName) const;
+
+	/** Interned lookup: members are compared by hash first, then by bytes (case-insensitively). */
+	FMCPJsonValueView FindField(const FMCPJsonKey& Key) const;
+
+	/** The accessors below take either a TEXT() literal or an MCPKeys:: key. */
+	template <typename KeyType>
+	bool HasField(const KeyType& Key) const { return FindField(Key).IsValid(); }
+
+	template <typename KeyType>
+	bool TryGetStringField(const KeyType& Key, FString& OutString) const { return FindField(Key).TryGetString(OutString); }
+
+	template <typename KeyType>
+	bool TryGetStringViewField(const KeyType& Key, FUtf8StringView& OutView) const { return FindField(Key).TryGetStringView(OutView); }
+
+	template <typename KeyType, typename NumberType>
+	bool TryGetNumberField(const KeyType& Key, NumberType& OutNumber) const { return FindField(Key).TryGetNumber(OutNumber); }
+
+	template <typename KeyType>
+	bool TryGetBoolField(const KeyType& Key, bool& OutBool) const { return FindField(Key).TryGetBool(OutBool); }
+
+	template <typename KeyType>
+	bool TryGetObjectField(const KeyType& Key, FMCPJsonObjectView& OutObject) const { return FindField(Key).TryGetObject(OutObject); }
+
+	template <typename KeyType>
+	bool TryGetArrayField(const KeyType& Key, FMCPJsonArrayView& OutArray) const { return FindField(Key).TryGetArray(OutArray); }
+
+	/** Visit members in document order. */
+	template <typename FuncType>
+	void ForEachField(FuncType&& Func) const
+	{
+		for (const FMCPJsonNode* Child = Node ? Node->FirstChild : nullptr; Child; Child = Child->Next)
+		{
+			Func(FUtf8StringView(Child->Key, Child->KeyLen), FMCPJsonValueView(Child));
+		}
+	}
+
+	/** Materialize as an FJsonObject (empty object if this view is invalid). */
+	TSharedPtr<FJsonObject> ToJsonObject() const;
+};
+
+/**
+ * Parsed request held in a per-request arena.
+ *
+ * The document owns the frame bytes and a page-based bump allocator for nodes and
+ * decoded strings. Parsing never touches the global allocator beyond arena pages
+ * (which come from the engine's page cache), and destroying the document returns
+ * whole pages, so release cost does not depend on the number of values.
+ */
+class UNREALMCP_API FMCPJsonDocument
+{
+public:
+	FMCPJsonDocument();
+	~FMCPJsonDocument();
+
+	FMCPJsonDocument(const FMCPJsonDocument&) = delete;
+	FMCPJsonDocument& operator=(const FMCPJsonDocument&) = delete;
+
+	/** Parse UTF-8 JSON, taking ownership of the buffer. Returns false with GetError() set on malformed input. */
+	bool Parse(TArray<uint8>&& InBuffer);
+
+	/** Build a document from an existing Dom object (callers that do not come from the socket). */
+	static TSharedRef<FMCPJsonDocument, ESPMode::ThreadSafe> FromJsonObject(const TSharedPtr<FJsonObject>& JsonObject);
+
+	FMCPJsonValueView GetRoot() const { return FMCPJsonValueView(Root); }
+	FMCPJsonObjectView GetRootObject() const;
+
+	const FString& GetError() const { return Error; }
+
+	/** Bytes handed out by the arena (diagnostics). */
+	int32 GetArenaBytes() const { return ArenaBytes; }
+
+private:
+	friend struct FMCPJsonParser;
+
+	void* Allocate(int32 Size, int32 Alignment);
+
+	FMemStackBase Arena;
+	TArray<uint8> Buffer;
+	const FMCPJsonNode* Root = nullptr;
+	FString Error;
+	int32 ArenaBytes = 0;
+};
+
+typedef TSharedRef<FMCPJsonDocument, ESPMode::ThreadSafe> FMCPJsonDocumentRef;
+
+/** Handler that reads its parameters straight from the request document. */
+DECLARE_DELEGATE_RetVal_OneParam(TSharedPtr<FJsonObject>, FMCPNativeCommandHandler, const FMCPJsonObjectView& /*Params*/);
@@ -0,0 +1,103 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * FNV-1a over the UTF-8 bytes of a member name with ASCII letters lowercased, so
+ * that names differing only in case hash alike (member lookup is case-insensitive,
+ * as with FJsonObject); shared by the parser and FMCPJsonKey.
+ */
+constexpr uint32 MCPJsonKeyHash(const uint8* Data, int32 Len)
+{
+	uint32 Hash = 2166136261u;
+	for (int32 Index = 0; Index < Len; ++Index)
+	{
+		const uint8 Byte = (Data[Index] >= 'A' && Data[Index] <= 'Z') ? Data[Index] + ('a' - 'A') : Data[Index];
+		Hash = (Hash ^ Byte) * 16777619u;
+	}
+	return Hash;
+}
+
+/**
+ * Interned JSON member name.
+ *
+ * Built at compile time from an ASCII literal: the hash and the encoded
+ * "name": prefix are computed once, so FMCPJsonWriter copies the key bytes
+ * without escaping or transcoding, and FMCPJsonObjectView rejects members by
+ * hash before comparing any bytes. Names must be ASCII and need no escaping.
+ */
+struct FMCPJsonKey
+{
+	static constexpr int32 MaxLen = 40;
+
+	template <int32 N>
+	constexpr FMCPJsonKey(const TCHAR (&Literal)[N])
+		: Name(Literal)
+		, Len(N - 1)
+	{
+		static_assert(N - 1 <= MaxLen, "FMCPJsonKey names are limited to MaxLen characters");
+		Encoded[0] = '"';
+		for (int32 Index = 0; Index < Len; ++Index)
+		{
+			Encoded[Index + 1] = (uint8)Literal[Index];
+		}
+		Encoded[Len + 1] = '"';
+		Encoded[Len + 2] = ':';
+		Hash = MCPJsonKeyHash(Encoded + 1, Len);
+	}
+
+	/** Raw name bytes, without quotes. */
+	const uint8* GetUtf8() const { return Encoded + 1; }
+
+	/** "name": ready to append to a writer buffer. */
+	const uint8* GetEncodedKey() const { return Encoded; }
+	int32 GetEncodedKeyLen() const { return Len + 3; }
+
+	const TCHAR* Name;
+	int32 Len;
+	uint32 Hash = 0;
+	uint8 Encoded[MaxLen + 3] = {};
+};
+
+/** Field names on the hottest request and response paths. */
+#define MCP_JSON_KEYS(Key) \
+	Key(Name, "name") \
+	Key(Label, "label") \
+	Key(Class, "class") \
+	Key(Location, "location") \
+	Key(Rotation, "rotation") \
+	Key(Scale, "scale") \
+	Key(Success, "success") \
+	Key(Error, "error") \
+	Key(Data, "data") \
+	Key(Status, "status") \
+	Key(Result, "result") \
+	Key(Message, "message") \
+	Key(Type, "type") \
+	Key(Params, "params") \
+	Key(Actors, "actors") \
+	Key(Count, "count") \
+	Key(World, "world") \
+	Key(IsPie, "is_pie") \
+	Key(Path, "path") \
+	Key(Properties, "properties")
+
+/** Compile-time keys for FMCPJsonWriter and FMCPJsonObjectView. */
+namespace MCPKeys
+{
+#define MCP_DECLARE_JSON_KEY(Identifier, Literal) inline constexpr FMCPJsonKey Identifier(TEXT(Literal));
+	MCP_JSON_KEYS(MCP_DECLARE_JSON_KEY)
+#undef MCP_DECLARE_JSON_KEY
+}
+
+/**
+ * The same names as shared FStrings, for code that still builds FJsonObject.
+ * Passing these instead of TEXT() literals skips constructing a temporary
+ * FString for every Set*Field / Get*Field call.
+ */
+namespace MCPKeyStrings
+{
+#define MCP_DECLARE_JSON_KEY_STRING(Identifier, Literal) extern UNREALMCP_API const FString Identifier;
+	MCP_JSON_KEYS(MCP_DECLARE_JSON_KEY_STRING)
+#undef MCP_DECLARE_JSON_KEY_STRING
+}
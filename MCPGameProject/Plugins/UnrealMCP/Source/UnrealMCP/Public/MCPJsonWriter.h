@@ -0,0 +1,118 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MCPJsonDocument.h"
+
+class FJsonObject;
+class FJsonValue;
+
+/**
+ * Forward-only JSON writer that emits UTF-8 straight into a byte buffer.
+ *
+ * Handlers that produce large results write fields as they walk their data, so
+ * the response never exists as an FJsonObject tree and is never re-walked to be
+ * serialized. Commas and nesting are tracked by the writer; callers only pair
+ * Begin/End calls and precede object members with a key.
+ *
+ *   Writer.BeginObject();
+ *   Writer.WriteField(MCPKeys::Name, Actor->GetName());
+ *   Writer.WriteField(TEXT("tick_interval"), Actor->GetActorTickInterval());
+ *   Writer.EndObject();
+ *
+ * Keys from MCPKeys are copied pre-encoded; TEXT() keys are escaped on every call.
+ */
+class UNREALMCP_API FMCPJsonWriter
+{
+public:
+	FMCPJsonWriter() = default;
+	explicit FMCPJsonWriter(int32 InitialCapacity) { Buffer.Reserve(InitialCapacity); }
+
+	void BeginObject();
+	void BeginObject(const TCHAR* Key) { WriteKey(Key); BeginObject(); }
+	void BeginObject(const FMCPJsonKey& Key) { WriteKey(Key); BeginObject(); }
+	void EndObject();
+
+	void BeginArray();
+	void BeginArray(const TCHAR* Key) { WriteKey(Key); BeginArray(); }
+	void BeginArray(const FMCPJsonKey& Key) { WriteKey(Key); BeginArray(); }
+	void EndArray();
+
+	/** Start an object member; the next value written belongs to it. */
+	void WriteKey(const TCHAR* Key);
+	void WriteKey(const FMCPJsonKey& Key);
+
+	/** Start an object member from a key encoded ahead of time by EncodeKey, for keys that are only known at runtime but repeat. */
+	void WriteEncodedKey(TConstArrayView<uint8> EncodedKey);
+
+	/** The escaped "name": bytes WriteKey would emit for Key. */
+	static TArray<uint8> EncodeKey(const TCHAR* Key);
+
+	void WriteValue(const TCHAR* Value);
+	void WriteValue(const FString& Value) { WriteValue(*Value); }
+	void WriteValue(FUtf8StringView Value);
+	void WriteValue(double Value);
+	void WriteValue(int32 Value) { WriteValue((int64)Value); }
+	void WriteValue(int64 Value);
+	void WriteValue(bool Value);
+	void WriteNull();
+
+	/** Vectors and rotators use the [x, y, z] / [pitch, yaw, roll] arrays the handlers accept as input. */
+	void WriteValue(const FVector& Value);
+	void WriteValue(const FRotator& Value);
+
+	/** Embed a Dom value, for results that are still built as FJsonObject. */
+	void WriteValue(const TSharedPtr<FJsonValue>& Value);
+	void WriteValue(const TSharedPtr<FJsonObject>& Value);
+
+	template <typename ValueType>
+	void WriteField(const TCHAR* Key, const ValueType& Value)
+	{
+		WriteKey(Key);
+		WriteValue(Value);
+	}
+
+	template <typename ValueType>
+	void WriteField(const FMCPJsonKey& Key, const ValueType& Value)
+	{
+		WriteKey(Key);
+		WriteValue(Value);
+	}
+
+	/**
+	 * Append the elements of a complete array written by another writer to the
+	 * array this writer is inside, so chunks encoded on other threads can be
+	 * joined without re-encoding.
+	 */
+	void AppendArrayElements(const FMCPJsonWriter& Elements);
+
+	/** Bytes written so far. */
+	const TArray<uint8>& GetBuffer() const { return Buffer; }
+
+	/** Take the output; the writer is left empty and reusable. */
+	TArray<uint8> MoveBuffer();
+
+	/** Drop all output and nesting state, e.g. to replace a partial result with an error. */
+	void Reset();
+
+	/** True when every container opened has been closed. */
+	bool IsComplete() const { return Scopes.Num() == 0 && !bAfterKey; }
+
+private:
+	/** Emit the separator owed before a value or key in the current container. */
+	void BeginValue();
+	void AppendAscii(const ANSICHAR* Text, int32 Len);
+	void WriteEscaped(const TCHAR* Text, int32 Len);
+
+	TArray<uint8> Buffer;
+
+	// One entry per open container: whether it already holds an element
+	TArray<bool, TInlineAllocator<32>> Scopes;
+	bool bAfterKey = false;
+};
+
+/**
+ * Handler that streams its result into the response. It writes exactly one value
+ * (normally an object) and returns true, or returns false with OutError set, in
+ * which case anything it wrote is discarded.
+ */
+DECLARE_DELEGATE_RetVal_ThreeParams(bool, FMCPStreamingCommandHandler, const FMCPJsonObjectView& /*Params*/, FMCPJsonWriter& /*Writer*/, FString& /*OutError*/);
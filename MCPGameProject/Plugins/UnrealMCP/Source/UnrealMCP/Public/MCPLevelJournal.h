@@ -0,0 +1,117 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/World.h"
+#include "UObject/ObjectKey.h"
+
+class AActor;
+class UObject;
+class ULevel;
+struct FPropertyChangedEvent;
+
+/** Kinds of actor change the journal records; values are bit flags so per-actor changes can be merged. */
+enum class EMCPLevelChange : uint8
+{
+	None = 0,
+	Added = 1 << 0,
+	Removed = 1 << 1,
+	Transform = 1 << 2,
+	Renamed = 1 << 3,
+	Property = 1 << 4,
+};
+ENUM_CLASS_FLAGS(EMCPLevelChange);
+
+/**
+ * Monotonically versioned ring buffer of actor changes in editor and PIE worlds.
+ *
+ * Every recorded change bumps the version. A client remembers the version of
+ * its last full listing (get_actors_in_level reports it) and asks only for the
+ * changes after it, so keeping in sync costs O(changes) rather than O(actors).
+ *
+ * Changes come from the editor delegates: actor added / deleted, actor moved
+ * (editor moves and the MCP transform commands), label and object renames, and
+ * object property changes on an actor or its components. Events the journal
+ * cannot describe per actor - level streaming, undo/redo, world setup and
+ * teardown - start a new epoch instead, as does the ring wrapping past a
+ * client's version: such a client is told to resync with a full listing.
+ * Gameplay movement in PIE is not recorded. Game thread only.
+ */
+class UNREALMCP_API FMCPLevelJournal
+{
+public:
+	struct FChange
+	{
+		int64 Version = 0;
+		EMCPLevelChange Type = EMCPLevelChange::None;
+		TObjectKey<UWorld> World;
+		TObjectKey<AActor> ActorKey;
+		TWeakObjectPtr<AActor> Actor;
+		FString Name;
+		FString Label;
+
+		/** Previous name for renames, property name for property changes. */
+		FString Detail;
+	};
+
+	static FMCPLevelJournal& Get();
+
+	/** Hook the editor delegates; Capacity is the number of changes retained (0 disables the journal). */
+	void Initialize(int32 Capacity);
+	void Shutdown();
+
+	/** Version of the newest change. */
+	int64 GetVersion() const { return Version; }
+
+	/** Identifies this journal instance; versions are only comparable within one id. */
+	const FString& GetJournalId() const { return JournalId; }
+
+	/**
+	 * Changes to World with a version above SinceVersion, oldest first. Returns false when they
+	 * cannot be described: the ring has wrapped past SinceVersion, a new epoch started after it,
+	 * or SinceVersion is from the future (another editor session).
+	 */
+	bool GetChangesSince(UWorld* World, int64 SinceVersion, TArray<const FChange*>& OutChanges) const;
+
+private:
+	void Record(EMCPLevelChange Type, AActor* Actor, const FString& Detail = FString());
+	void StartEpoch();
+
+	static bool IsJournaled(const AActor* Actor);
+
+	void OnActorAdded(AActor* Actor);
+	void OnActorDeleted(AActor* Actor);
+	void OnActorMoved(AActor* Actor);
+	void OnActorLabelChanged(AActor* Actor);
+	void OnObjectRenamed(UObject* Object, UObject* OldOuter, FName OldName);
+	void OnObjectPropertyChanged(UObject* Object, FPropertyChangedEvent& Event);
+	void OnWorldInitialized(UWorld* World, const UWorld::InitializationValues Values);
+	void OnLevelChanged(ULevel* Level, UWorld* World);
+	void OnWorldCleanup(UWorld* World, bool bSessionEnded, bool bCleanupResources);
+	void OnUndoRedo();
+
+	// Ring of the newest changes; Head is the next slot written
+	TArray<FChange> Ring;
+	int32 Head = 0;
+	int32 Capacity = 0;
+
+	int64 Version = 0;
+
+	// Clients whose version is below either of these have missed changes
+	int64 DroppedVersion = 0;
+	int64 EpochVersion = 0;
+
+	FString JournalId;
+
+	FDelegateHandle ActorAddedHandle;
+	FDelegateHandle ActorDeletedHandle;
+	FDelegateHandle ActorMovedHandle;
+	FDelegateHandle LabelChangedHandle;
+	FDelegateHandle ObjectRenamedHandle;
+	FDelegateHandle PropertyChangedHandle;
+	FDelegateHandle WorldInitHandle;
+	FDelegateHandle LevelAddedHandle;
+	FDelegateHandle LevelRemovedHandle;
+	FDelegateHandle WorldCleanupHandle;
+	FDelegateHandle UndoRedoHandle;
+	bool bInitialized = false;
+};
@@ -0,0 +1,136 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+
+class FMCPClientConnection;
+class IInputProcessor;
+class UObject;
+struct FPropertyChangedEvent;
+
+/** Counters of one mutation session, reported when it ends. */
+struct FMCPMutationSessionStats
+{
+	FString Name;
+	int32 Commands = 0;
+
+	/** Undo entries the session produced; more than one when it was split. */
+	int32 Transactions = 0;
+
+	/** Undo-buffer bytes recorded by the session's transactions. */
+	int64 UndoBytes = 0;
+	double DurationSeconds = 0.0;
+};
+
+/**
+ * Folds consecutive mutating commands into one named editor transaction.
+ *
+ * Without a session every transacted command is its own undo entry, so a bulk
+ * script that sets thousands of properties leaves thousands of entries behind.
+ * While a session is open, the bridge brackets each of its commands in a single
+ * long-lived transaction: every object is snapshotted once however often it is
+ * modified, and the whole run undoes as one step.
+ *
+ * A command belongs to the session when it carries the session's id in the
+ * request envelope ("mutation_session") or arrives on the connection that
+ * began it. The open transaction is ended, and the next session command starts
+ * another, when:
+ *   - a command from anyone else runs, so their changes stay separate undo entries;
+ *   - a command that resets or cannot share the undo buffer runs (level loads,
+ *     PIE, asset deletes, console and Python commands);
+ *   - the user clicks or presses a key in the editor, or an object is modified
+ *     between session commands, so hand edits never land in the session's entry
+ *     and editor undo works as soon as the user reaches for it;
+ *   - the undo buffer as a whole grows past the undo-memory cap (UMCPSettings),
+ *     in which case its oldest entries are also dropped down to the cap;
+ *   - a map load, PIE start or asset delete begins in the editor itself.
+ * The session itself ends with end_mutation_session or after its idle timeout.
+ *
+ * Game thread only.
+ */
+class UNREALMCP_API FMCPMutationSessions
+{
+public:
+	static FMCPMutationSessions& Get();
+
+	/** Hook the editor delegates and start the idle ticker; called by the bridge subsystem. */
+	void Initialize(int64 InMaxUndoBytes, double InDefaultIdleSeconds);
+	void Shutdown();
+
+	/** Open a session. Fails while another session is open. IdleSeconds <= 0 uses the default. */
+	bool Begin(const FString& Name, double IdleSeconds, const TSharedPtr<FMCPClientConnection, ESPMode::ThreadSafe>& Owner,
+		FString& OutSessionId, FString& OutError);
+
+	/** End the session with SessionId; an empty id ends the session owned by Origin. */
+	bool End(const FString& SessionId, const FMCPClientConnection* Origin, FMCPMutationSessionStats& OutStats, FString& OutError);
+
+	/** Bracket one dispatched command; called by the bridge around every command. */
+	void BeginCommand(const FString& CommandType, const FString& SessionId, const FMCPClientConnection* Origin);
+	void EndCommand();
+
+	bool IsActive() const { return Session.IsSet(); }
+
+private:
+	struct FSession
+	{
+		FString Id;
+		FString Name;
+		TWeakPtr<FMCPClientConnection, ESPMode::ThreadSafe> Owner;
+		double IdleSeconds = 0.0;
+		double StartTime = 0.0;
+		double LastActivity = 0.0;
+		FMCPMutationSessionStats Stats;
+	};
+
+	/** Commands that must not run inside a session transaction. */
+	static bool IsBarrier(const FString& CommandType);
+
+	bool IsMember(const FString& SessionId, const FMCPClientConnection* Origin) const;
+
+	void OpenTransaction();
+
+	/** End the open transaction; an empty one is cancelled instead of left on the undo stack. */
+	void CloseTransaction();
+
+	/** Bytes recorded so far by the open transaction. */
+	int64 GetOpenTransactionBytes() const;
+
+	/** Bytes held by every entry of the editor's undo buffer, the open transaction included. */
+	int64 GetUndoBufferBytes() const;
+
+	/** Drop the oldest undo entries until the buffer fits MaxUndoBytes (no transaction open). */
+	void TrimUndoBuffer();
+
+	void EndSession(const TCHAR* Reason);
+
+	bool Tick(float DeltaTime);
+	void OnPreBeginPIE(bool bIsSimulating);
+	void OnAssetsPreDelete(const TArray<UObject*>& Objects);
+
+	/** Someone other than a session command is about to edit (user input) or has edited an object. */
+	void OnOutsideEdit();
+	void OnObjectModified(UObject* Object);
+	void OnObjectPropertyChanged(UObject* Object, FPropertyChangedEvent& Event);
+
+	TOptional<FSession> Session;
+
+	/** Index of the open session transaction in the undo queue; INDEX_NONE when none is open. */
+	int32 TransactionIndex = INDEX_NONE;
+
+	/** The open transaction was started by the command now running, so it can be cancelled if that command recorded nothing. */
+	bool bOpenedByCommand = false;
+	bool bInCommand = false;
+
+	/** Cap on the whole undo buffer while a session runs, not just on the session's own transaction. */
+	int64 MaxUndoBytes = 0;
+	double DefaultIdleSeconds = 0.0;
+
+	FTSTicker::FDelegateHandle TickerHandle;
+	FDelegateHandle PreBeginPIEHandle;
+	FDelegateHandle MapLoadHandle;
+	FDelegateHandle AssetsPreDeleteHandle;
+	FDelegateHandle ObjectModifiedHandle;
+	FDelegateHandle ObjectPropertyChangedHandle;
+	TSharedPtr<IInputProcessor> InputWatcher;
+	bool bInitialized = false;
+};
@@ -0,0 +1,160 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/EngineBaseTypes.h"
+#include "HAL/CriticalSection.h"
+#include <atomic>
+
+class APawn;
+class UWorld;
+class FMCPClientConnection;
+
+/** Binary frame types of the pawn control channel (second byte of the frame). */
+enum class EMCPBinaryFrameType : uint8
+{
+	/** Client to editor: one FMCPPawnInput. */
+	PawnInput = 0x01,
+
+	/** Editor to client: one FMCPPawnInputAck. */
+	PawnInputAck = 0x81,
+};
+
+/** Held buttons of a pawn input frame; a change applies the press or release. */
+enum class EMCPPawnButtons : uint16
+{
+	None = 0,
+	Jump = 1 << 0,
+	Crouch = 1 << 1,
+};
+ENUM_CLASS_FLAGS(EMCPPawnButtons);
+
+/**
+ * One control frame, decoded from a 32-byte little-endian payload:
+ *
+ *   uint16 channel, uint16 buttons, uint32 sequence,
+ *   float move_x, move_y, move_z, float yaw_rate, pitch_rate,
+ *   uint16 ttl_ms, uint16 reserved
+ *
+ * Move is a world-space direction whose length is the input scale. Look rates
+ * are degrees per second applied to the controller's rotation.
+ */
+struct FMCPPawnInput
+{
+	static constexpr int32 PayloadBytes = 32;
+
+	uint16 Channel = 0;
+	EMCPPawnButtons Buttons = EMCPPawnButtons::None;
+	uint32 Sequence = 0;
+	FVector3f Move = FVector3f::ZeroVector;
+	float YawRate = 0.0f;
+	float PitchRate = 0.0f;
+
+	/** How long the frame keeps being applied without a newer one; 0 uses the channel default. */
+	uint16 TtlMs = 0;
+
+	/** Seconds (FPlatformTime) when the server thread received the frame. */
+	double ReceivedTime = 0.0;
+
+	static bool Decode(const uint8* Payload, int32 Num, FMCPPawnInput& OutInput);
+};
+
+/** Counters of one channel, reported when it closes. */
+struct FMCPPawnControlStats
+{
+	int32 Received = 0;
+	int32 Applied = 0;
+
+	/** Frames older than one already received (reordered or duplicated). */
+	int32 Stale = 0;
+
+	/** Frames replaced by a newer one before a tick could apply them. */
+	int32 Superseded = 0;
+	int32 Malformed = 0;
+
+	/** Acks replaced by a newer one because the client was not reading them. */
+	int32 AcksDropped = 0;
+};
+
+/**
+ * Fire-and-forget pawn input over a persistent socket.
+ *
+ * open_pawn_control binds a channel to a pawn and to the connection that opened
+ * it. The client then writes binary PawnInput frames on that connection; the
+ * server thread decodes them and hands them straight to the channel without a
+ * response or a game-thread round trip. At the start of every PIE world tick
+ * each channel applies its newest frame: movement and look input every tick
+ * until the frame's ttl runs out (so a stalled agent stops its pawn), button
+ * changes once. Frames that arrive out of order are dropped, and of several
+ * frames arriving between two ticks only the newest is applied.
+ *
+ * The first tick that applies a frame answers with a binary PawnInputAck
+ * (44 bytes: uint16 channel, uint16 status, uint32 sequence, uint64 engine
+ * frame, uint32 dropped, float location xyz, float velocity xyz), so the agent
+ * can line its observations up with the tick its action took effect. Acks are
+ * written by a background task with a non-blocking send; each channel keeps at
+ * most one unsent ack, the newest, so a client that never reads them costs
+ * nothing but the dropped count.
+ */
+class UNREALMCP_API FMCPPawnControl
+{
+public:
+	static FMCPPawnControl& Get();
+
+	/** Hook the world tick and PIE delegates; called by the bridge subsystem. */
+	void Initialize();
+	void Shutdown();
+
+	/** Bind a channel to Pawn (game thread). Returns the channel id. */
+	uint16 Open(APawn* Pawn, const TSharedPtr<FMCPClientConnection, ESPMode::ThreadSafe>& Connection, uint16 DefaultTtlMs);
+
+	/** Close a channel (game thread). Returns false for an unknown id. */
+	bool Close(uint16 Channel, FMCPPawnControlStats& OutStats);
+
+	/** Route one binary frame from Connection (server thread). Frames of unknown types are ignored. */
+	void Submit(FMCPClientConnection& Connection, const TArray<uint8>& Frame);
+
+private:
+	struct FChannel
+	{
+		uint16 Id = 0;
+		TWeakObjectPtr<APawn> Pawn;
+		TWeakPtr<FMCPClientConnection, ESPMode::ThreadSafe> Connection;
+		const FMCPClientConnection* ConnectionKey = nullptr;
+		uint16 DefaultTtlMs = 0;
+
+		// Guarded by Lock: written by the server thread, taken by the tick
+		TOptional<FMCPPawnInput> Pending;
+		uint32 NewestSequence = 0;
+		bool bHasSequence = false;
+		FMCPPawnControlStats Stats;
+
+		// Game thread only
+		TOptional<FMCPPawnInput> Current;
+		EMCPPawnButtons HeldButtons = EMCPPawnButtons::None;
+
+		// Newest ack not yet taken by the socket, and whether a task is sending
+		FCriticalSection AckLock;
+		TArray<uint8> PendingAck;
+		std::atomic<bool> bAckSending{ false };
+		std::atomic<int32> AcksDropped{ 0 };
+	};
+
+	void OnWorldTickStart(UWorld* World, ELevelTick TickType, float DeltaSeconds);
+	void OnEndPIE(bool bIsSimulating);
+
+	/** Apply one channel's input for this tick; queues an ack when a new frame took effect. */
+	void ApplyInput(FChannel& Channel, APawn& Pawn, float DeltaSeconds, bool bNewFrame, uint32 Dropped);
+
+	static void QueueAck(FChannel& Channel, uint16 Status, uint32 Sequence, uint32 Dropped, const APawn* Pawn);
+
+	/** Start a send of the channel's pending ack unless one is already running. Never waits. */
+	static void FlushAck(const TSharedRef<FChannel, ESPMode::ThreadSafe>& Channel, const TSharedPtr<FMCPClientConnection, ESPMode::ThreadSafe>& Connection);
+
+	FCriticalSection Lock;
+	TMap<uint16, TSharedRef<FChannel, ESPMode::ThreadSafe>> Channels;
+	uint16 NextChannelId = 1;
+
+	FDelegateHandle WorldTickStartHandle;
+	FDelegateHandle EndPIEHandle;
+	bool bInitialized = false;
+};
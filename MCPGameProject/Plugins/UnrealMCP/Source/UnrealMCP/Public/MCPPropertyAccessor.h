@@ -0,0 +1,89 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Dom/JsonValue.h"
+#include "UObject/ObjectKey.h"
+#include "UObject/UObjectGlobals.h"
+
+class UClass;
+class UObject;
+class FProperty;
+class FObjectPropertyBase;
+
+/** Typed store of a JSON value into a resolved property; returns false with a message when the value does not fit. */
+typedef bool (*FMCPPropertySetter)(FProperty* Property, void* ValueAddr, const TSharedPtr<FJsonValue>& Value, const FString& PropertyName, FString& OutError);
+
+/**
+ * A property path ("Intensity", "LightColor.R", "StaticMeshComponent.StaticMesh")
+ * compiled against one class.
+ *
+ * Struct members are walked by offset. A path that continues through an object
+ * reference (typically a component) stops at ObjectHop, and the rest of the
+ * path is compiled against the referenced object's own class, since the
+ * referenced object may be a subclass of the declared type.
+ */
+struct FMCPPropertyAccessor
+{
+	TArray<FProperty*, TInlineAllocator<4>> StructHops;
+	FProperty* Leaf = nullptr;
+	FMCPPropertySetter Setter = nullptr;
+
+	FObjectPropertyBase* ObjectHop = nullptr;
+	FString RemainingPath;
+
+	/** Set when the path does not resolve or its property type cannot be set; cached like a success. */
+	FString Error;
+};
+
+/**
+ * Cache of compiled property accessors keyed by (class, path), so a repeated
+ * set is a pointer walk plus a direct store instead of a property lookup and a
+ * type dispatch. Unresolvable paths are cached too, which keeps fallbacks that
+ * probe several objects (set_actor_property trying each component) cheap.
+ *
+ * Classes are keyed by TObjectKey, so a collected class never matches a new
+ * one at the same address; the whole cache is still dropped on blueprint
+ * compile, reinstancing and hot reload, when FProperty pointers of live classes
+ * can change. Game thread only.
+ */
+class UNREALMCP_API FMCPPropertyAccessorCache
+{
+public:
+	static FMCPPropertyAccessorCache& Get();
+
+	/** Hook the recompile / reload delegates; called by the bridge subsystem. */
+	void Initialize();
+	void Shutdown();
+
+	/** Accessor for Path on Class, compiled on first use. */
+	const FMCPPropertyAccessor& Find(UClass* Class, const FString& Path);
+
+	/** Set the property at Path on Object (calling Modify on the object that owns the leaf). */
+	bool SetValue(UObject* Object, const FString& Path, const TSharedPtr<FJsonValue>& Value, FString& OutError);
+
+	/** Drop every compiled accessor. */
+	void Invalidate();
+
+private:
+	struct FAccessorKey
+	{
+		TObjectKey<UClass> Class;
+		FString Path;
+
+		bool operator==(const FAccessorKey& Other) const { return Class == Other.Class && Path == Other.Path; }
+		friend uint32 GetTypeHash(const FAccessorKey& Key) { return HashCombine(GetTypeHash(Key.Class), GetTypeHash(Key.Path)); }
+	};
+
+	static void Compile(UClass* Class, const FString& Path, FMCPPropertyAccessor& OutAccessor);
+
+	void OnBlueprintCompiled();
+	void OnObjectsReinstanced(const TMap<UObject*, UObject*>& OldToNew);
+	void OnReloadComplete(EReloadCompleteReason Reason);
+
+	TMap<FAccessorKey, FMCPPropertyAccessor> Accessors;
+
+	FDelegateHandle BlueprintCompiledHandle;
+	FDelegateHandle ObjectsReinstancedHandle;
+	FDelegateHandle ReloadCompleteHandle;
+	bool bInitialized = false;
+};
@@ -0,0 +1,125 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "MCPImageEncoder.h"
+#include "PixelFormat.h"
+#include <atomic>
+
+class FViewport;
+class FRHIGPUTextureReadback;
+class IImageWrapperModule;
+
+/** What to do with a captured frame. */
+struct FMCPScreenshotRequest
+{
+	FString FilePath;
+	EMCPImageFormat Format = EMCPImageFormat::Png;
+
+	/** Longest side of the output; 0 keeps the viewport size. */
+	int32 MaxSize = 0;
+	int32 Quality = 85;
+
+	/** Keep the encoded bytes so get_screenshot can return them inline. */
+	bool bKeepData = false;
+};
+
+enum class EMCPScreenshotState : uint8
+{
+	Pending,
+	Done,
+	Failed
+};
+
+/** Outcome of one capture, as get_screenshot reports it. */
+struct FMCPScreenshotResult
+{
+	EMCPScreenshotState State = EMCPScreenshotState::Pending;
+	FString FilePath;
+	FIntPoint SourceSize = FIntPoint::ZeroValue;
+	FIntPoint Size = FIntPoint::ZeroValue;
+	EMCPImageFormat Format = EMCPImageFormat::Png;
+	int64 Bytes = 0;
+	TArray64<uint8> Data;
+	FString Error;
+
+	/** Time from the capture request to the file being written. */
+	double ElapsedMs = 0.0;
+};
+
+/** Receives read-back viewport pixels on the render thread; Error is empty on success. */
+typedef TFunction<void(TArray<FColor>&& Pixels, FIntPoint Size, const FString& Error)> FMCPPixelsCallback;
+
+/**
+ * Viewport captures that never stall the game thread.
+ *
+ * Start queues a GPU copy of the viewport's render target on the render thread
+ * and returns a ticket. A core ticker polls the copy; once the GPU has finished
+ * it, the pixels are mapped and copied on the render thread, and the opaque
+ * fix-up, downscale, compression and file write run on a background task.
+ * Tickets are looked up with GetResult; the most recent ones are kept.
+ */
+class UNREALMCP_API FMCPScreenshotCapture
+{
+public:
+	static FMCPScreenshotCapture& Get();
+
+	/** Load the image wrappers and start the poll ticker; called by the bridge subsystem. */
+	void Initialize();
+	void Shutdown();
+
+	/** Queue a capture of Viewport (game thread). Returns the ticket, or INDEX_NONE with OutError set. */
+	int32 Start(FViewport* Viewport, const FMCPScreenshotRequest& Request, FString& OutError);
+
+	/**
+	 * Queue a GPU copy of Viewport and hand the pixels to OnPixels once the GPU has
+	 * produced them, without encoding anything (game thread). The callback runs on
+	 * the render thread and should move heavy work to a task.
+	 */
+	bool ReadViewport(FViewport* Viewport, FMCPPixelsCallback OnPixels, FString& OutError);
+
+	/** The viewport captures are taken from: the PIE game view while playing, else the active level viewport (game thread). */
+	static FViewport* FindViewport(FString& OutSource, bool& bOutIsPIE);
+
+	/** Copy the state of a ticket; false for an unknown or expired ticket. Any thread. */
+	bool GetResult(int32 Ticket, FMCPScreenshotResult& OutResult, bool bIncludeData) const;
+
+private:
+	struct FCapture
+	{
+		FIntPoint SourceSize = FIntPoint::ZeroValue;
+		TUniquePtr<FRHIGPUTextureReadback> Readback;
+		FMCPPixelsCallback OnPixels;
+
+		/** Format of the captured texture, recorded on the render thread with the copy. */
+		EPixelFormat PixelFormat = PF_Unknown;
+
+		/** Set while a render-thread poll for this capture is queued. */
+		std::atomic<bool> bPollQueued{ false };
+
+		/** Set once the pixels have been read back (or the capture failed); the ticker then drops it. */
+		std::atomic<bool> bDone{ false };
+	};
+
+	bool Tick(float DeltaTime);
+
+	/** Render thread: map the finished readback into BGRA8 pixels. */
+	static bool ReadPixels(FRHIGPUTextureReadback& Readback, FIntPoint Size, EPixelFormat PixelFormat, TArray<FColor>& OutPixels, FString& OutError);
+
+	/** Background task: fix up, resample, encode and write one frame. */
+	void Encode(int32 Ticket, const FMCPScreenshotRequest& Request, FIntPoint SourceSize, double StartTime, TArray<FColor> Pixels);
+
+	void Complete(int32 Ticket, FMCPScreenshotResult&& Result);
+
+	TArray<TSharedRef<FCapture, ESPMode::ThreadSafe>> Pending;
+
+	// Finished and in-flight results by ticket, oldest first; bounded to the most recent captures
+	mutable FCriticalSection ResultsLock;
+	TMap<int32, FMCPScreenshotResult> Results;
+	TArray<int32> ResultOrder;
+
+	IImageWrapperModule* ImageWrapperModule = nullptr;
+	FTSTicker::FDelegateHandle TickerHandle;
+	int32 NextTicket = 1;
+	bool bInitialized = false;
+};
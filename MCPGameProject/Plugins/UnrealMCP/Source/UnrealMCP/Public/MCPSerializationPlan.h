@@ -0,0 +1,82 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Dom/JsonObject.h"
+#include "UObject/ObjectKey.h"
+#include "UObject/UObjectGlobals.h"
+
+class UClass;
+class UObject;
+class FProperty;
+class FMCPJsonWriter;
+
+/** How one property type becomes JSON, picked once when a plan is built. */
+struct FMCPPropertyWriter
+{
+	TSharedPtr<FJsonValue> (*ToJson)(const FProperty* Property, const void* ValuePtr);
+	void (*Write)(FMCPJsonWriter& Writer, const FProperty* Property, const void* ValuePtr);
+};
+
+/** One serialized property: where its value lives in the object and how to write it. */
+struct FMCPSerializedProperty
+{
+	const FProperty* Property = nullptr;
+	int32 Offset = 0;
+	FString Name;
+
+	/** Name as escaped "name": bytes for FMCPJsonWriter::WriteEncodedKey. */
+	TArray<uint8> EncodedKey;
+	const FMCPPropertyWriter* Writer = nullptr;
+};
+
+/**
+ * The editor-visible properties of one class (Edit, EditConst or BlueprintVisible,
+ * not deprecated or transient) flattened into (offset, typed writer) entries, so
+ * dumping an object is a loop over the entries without property iteration, flag
+ * checks or a per-value type dispatch.
+ */
+struct UNREALMCP_API FMCPSerializationPlan
+{
+	TArray<FMCPSerializedProperty> Properties;
+
+	/** Write every property as a member of the object the writer is currently inside. */
+	void WriteProperties(FMCPJsonWriter& Writer, const UObject* Object) const;
+
+	/** Add every property to OutObject. */
+	void ToJsonObject(const UObject* Object, FJsonObject& OutObject) const;
+};
+
+/**
+ * Serialization plans per class, built on first use. Plans are dropped on
+ * blueprint compile, object reinstancing and hot reload, which can change a
+ * class's layout. Game thread only.
+ */
+class UNREALMCP_API FMCPSerializationPlanCache
+{
+public:
+	static FMCPSerializationPlanCache& Get();
+
+	/** Hook the recompile / reload delegates; called by the bridge subsystem. */
+	void Initialize();
+	void Shutdown();
+
+	/** Plan for Class; the reference stays valid until the cache is invalidated. */
+	const FMCPSerializationPlan& Find(const UClass* Class);
+
+	/** Drop every plan. */
+	void Invalidate();
+
+private:
+	static void Build(const UClass* Class, FMCPSerializationPlan& OutPlan);
+
+	void OnBlueprintCompiled();
+	void OnObjectsReinstanced(const TMap<UObject*, UObject*>& OldToNew);
+	void OnReloadComplete(EReloadCompleteReason Reason);
+
+	TMap<TObjectKey<UClass>, TUniquePtr<FMCPSerializationPlan>> Plans;
+
+	FDelegateHandle BlueprintCompiledHandle;
+	FDelegateHandle ObjectsReinstancedHandle;
+	FDelegateHandle ReloadCompleteHandle;
+	bool bInitialized = false;
+};
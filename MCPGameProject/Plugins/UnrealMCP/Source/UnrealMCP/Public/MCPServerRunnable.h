@@ -4,11 +4,30 @@
 #include "HAL/Runnable.h"
 #include "Sockets.h"
 #include "Interfaces/IPv4/IPv4Address.h"
+#include "MCPJsonDocument.h"
 
 class UUnrealMCPBridge;
+class FMCPClientConnection;
+class FMCPJsonWriter;
+
+/** A request after parsing on a worker thread, ready for game-thread dispatch. Params points into Document. */
+struct FMCPParsedRequest
+{
+	FString CommandType;
+	TSharedPtr<FMCPJsonDocument, ESPMode::ThreadSafe> Document;
+	FMCPJsonObjectView Params;
+	FString IdempotencyKey;
+
+	/** Mutation session the request belongs to ("mutation_session" in the envelope); empty when none. */
+	FString MutationSession;
+};
 
 /**
- * Runnable class for the MCP server thread
+ * Runnable class for the MCP server thread.
+ *
+ * The server thread only accepts sockets, reads bytes and cuts them into frames.
+ * Parsing, validation and the wait for the game thread happen on the bridge's
+ * worker pool, one drain at a time per connection so responses keep request order.
  */
 class FMCPServerRunnable : public FRunnable
 {
@@ -22,13 +41,25 @@ public:
 	virtual void Stop() override;
 	virtual void Exit() override;
 
+	/** Parse a raw request frame into an arena document that takes ownership of the bytes. On failure OutError describes the problem. */
+	static bool ParseRequest(TArray<uint8>&& Frame, FMCPParsedRequest& OutRequest, FString& OutError);
+
+	/** Serialize a protocol-level error in the standard response envelope (UTF-8). */
+	static TArray<uint8> MakeErrorResponse(const FString& Message);
+	static void WriteErrorResponse(FMCPJsonWriter& Writer, const FString& Message);
+
 protected:
-	void HandleClientConnection(TSharedPtr<FSocket> ClientSocket);
-	void ProcessMessage(TSharedPtr<FSocket> Client, const FString& Message);
+	void AcceptPendingConnections();
+	void ScheduleDrain(const TSharedPtr<FMCPClientConnection, ESPMode::ThreadSafe>& Connection);
+
+	// Worker-pool side; static so queued work never references the runnable
+	static void DrainConnection(UUnrealMCPBridge* Bridge, const TSharedPtr<FMCPClientConnection, ESPMode::ThreadSafe>& Connection);
+	static void ProcessFrame(UUnrealMCPBridge* Bridge, FMCPClientConnection& Connection, TArray<uint8>&& Frame);
 
 private:
 	UUnrealMCPBridge* Bridge;
 	TSharedPtr<FSocket> ListenerSocket;
-	TSharedPtr<FSocket> ClientSocket;
+	TArray<TSharedPtr<FMCPClientConnection, ESPMode::ThreadSafe>> Connections;
+	int32 NextConnectionId;
 	bool bRunning;
-}; 
\ No newline at end of file
+};
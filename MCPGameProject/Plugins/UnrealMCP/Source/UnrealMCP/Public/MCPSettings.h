@@ -30,6 +30,36 @@ public:
 		meta = (ToolTip = "Automatically start the MCP server when the editor opens."))
 	bool bAutoStart = true;
 
+	/** Number of recent idempotency keys whose responses are kept for retried requests */
+	UPROPERTY(config, EditAnywhere, Category = "MCP|Network",
+		meta = (ClampMin = "0", ClampMax = "65536",
+			ToolTip = "Responses kept for requests carrying an idempotency_key. A retried key returns the cached response instead of re-running the command. 0 disables."))
+	int32 IdempotencyCacheSize = 256;
+
+	/** Worker threads that parse requests and wait on the game thread, one per busy connection */
+	UPROPERTY(config, EditAnywhere, Category = "MCP|Network",
+		meta = (ClampMin = "1", ClampMax = "64",
+			ToolTip = "Threads used to parse and validate incoming requests before they are queued on the game thread. Restart required after changing."))
+	int32 WorkerThreads = 4;
+
+	/** Actor changes kept for get_level_changes */
+	UPROPERTY(config, EditAnywhere, Category = "MCP|General",
+		meta = (ClampMin = "0", ClampMax = "1048576",
+			ToolTip = "Recent actor changes retained for get_level_changes. Clients that fall further behind are told to resync with a full listing. 0 disables. Restart required after changing."))
+	int32 LevelJournalCapacity = 16384;
+
+	/** Undo-buffer memory a mutation session lets the editor hold */
+	UPROPERTY(config, EditAnywhere, Category = "MCP|General",
+		meta = (ClampMin = "1", ClampMax = "65536",
+			ToolTip = "Megabytes the editor's whole undo buffer may hold while a mutation session runs. Past it the session's transaction is ended, the oldest undo entries are dropped down to the cap, and the session continues in a new transaction. Restart required after changing."))
+	int32 MutationSessionUndoLimitMB = 256;
+
+	/** Seconds without commands after which a mutation session ends */
+	UPROPERTY(config, EditAnywhere, Category = "MCP|General",
+		meta = (ClampMin = "0.5", ClampMax = "3600",
+			ToolTip = "A mutation session with no commands for this long ends on its own, releasing its open transaction. begin_mutation_session can override it per session. Restart required after changing."))
+	float MutationSessionIdleSeconds = 10.0f;
+
 	// UDeveloperSettings interface
 	virtual FName GetCategoryName() const override { return TEXT("Plugins"); }
 	virtual FName GetSectionName() const override { return TEXT("MCP Settings"); }
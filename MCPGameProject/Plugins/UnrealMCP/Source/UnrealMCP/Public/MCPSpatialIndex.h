@@ -0,0 +1,130 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Math/GenericOctree.h"
+#include "Components/SceneComponent.h"
+#include "UObject/ObjectKey.h"
+
+class AActor;
+class UWorld;
+class ULevel;
+struct FConvexVolume;
+
+/** One actor in the octree: its bounds (grown to contain its location) and location at the last update. */
+struct FMCPSpatialElement
+{
+	TObjectKey<AActor> ActorKey;
+	TWeakObjectPtr<AActor> Actor;
+	FBoxCenterAndExtent Bounds;
+	FVector Location = FVector::ZeroVector;
+};
+
+struct FMCPSpatialOctreeSemantics
+{
+	enum { MaxElementsPerLeaf = 16 };
+	enum { MinInclusiveElementsPerNode = 7 };
+	enum { MaxNodeDepth = 12 };
+
+	typedef TInlineAllocator<MaxElementsPerLeaf> ElementAllocator;
+
+	static const FBoxCenterAndExtent& GetBoundingBox(const FMCPSpatialElement& Element) { return Element.Bounds; }
+	static bool AreElementsEqual(const FMCPSpatialElement& A, const FMCPSpatialElement& B) { return A.Actor == B.Actor; }
+	static void SetElementId(TOctree2<FMCPSpatialElement, FMCPSpatialOctreeSemantics>& Octree, const FMCPSpatialElement& Element, FOctreeElementId2 Id);
+};
+
+/** Octree that also tracks where each actor's element lives, so moves and deletes are O(log n). */
+class FMCPSpatialOctree : public TOctree2<FMCPSpatialElement, FMCPSpatialOctreeSemantics>
+{
+public:
+	FMCPSpatialOctree(const FVector& Origin, FVector::FReal Extent)
+		: TOctree2<FMCPSpatialElement, FMCPSpatialOctreeSemantics>(Origin, Extent)
+	{
+	}
+
+	TMap<TObjectKey<AActor>, FOctreeElementId2> ElementIds;
+};
+
+/** A query result; Distance is from the query point to the actor's location (0 for box queries). */
+struct FMCPSpatialHit
+{
+	AActor* Actor;
+	double Distance;
+};
+
+/**
+ * Per-world loose octree of actor bounds for geometric queries.
+ *
+ * A world is built by one scan the first time it is queried. After that, each
+ * indexed actor's root component reports transform changes through its
+ * TransformUpdated event; moves only mark the actor dirty, and dirty actors are
+ * re-inserted at the start of the next query, so a PIE world full of moving
+ * actors costs a set insert per move rather than an octree update per frame.
+ * Actor add/delete is tracked from the editor delegates; level streaming, undo
+ * and world teardown drop the world, which is rebuilt lazily. Game thread only.
+ */
+class UNREALMCP_API FMCPSpatialIndex
+{
+public:
+	static FMCPSpatialIndex& Get();
+
+	void Initialize();
+	void Shutdown();
+
+	/** Actors whose location lies inside Box. */
+	void QueryBox(UWorld* World, const FBox& Box, TArray<FMCPSpatialHit>& OutHits);
+
+	/** Actors whose location is within Radius of Center, nearest first. */
+	void QuerySphere(UWorld* World, const FVector& Center, double Radius, TArray<FMCPSpatialHit>& OutHits);
+
+	/** Up to Count actors nearest to Point (by location), nearest first, no farther than MaxDistance. */
+	void QueryNearest(UWorld* World, const FVector& Point, int32 Count, double MaxDistance, TArray<FMCPSpatialHit>& OutHits);
+
+	/** Actors whose bounds intersect Frustum and lie within MaxDistance of Origin, nearest first. */
+	void QueryFrustum(UWorld* World, const FConvexVolume& Frustum, const FVector& Origin, double MaxDistance, TArray<FMCPSpatialHit>& OutHits);
+
+	/** Drop every world; each is rebuilt on its next query. */
+	void Invalidate();
+
+private:
+	struct FTrackedActor
+	{
+		TWeakObjectPtr<USceneComponent> Root;
+		FDelegateHandle TransformHandle;
+	};
+
+	struct FWorldIndex
+	{
+		TUniquePtr<FMCPSpatialOctree> Octree;
+		TMap<TObjectKey<AActor>, FTrackedActor> Tracked;
+		TSet<TObjectKey<AActor>> Dirty;
+	};
+
+	FWorldIndex* GetIndex(UWorld* World);
+	void BuildIndex(UWorld* World, FWorldIndex& Index);
+	void AddActor(FWorldIndex& Index, AActor* Actor);
+	void RemoveActor(FWorldIndex& Index, const TObjectKey<AActor>& ActorKey);
+	void FlushDirty(FWorldIndex& Index);
+	void ReleaseWorld(FWorldIndex& Index);
+	void InvalidateWorld(UWorld* World);
+
+	static bool MakeElement(AActor* Actor, FMCPSpatialElement& OutElement);
+
+	void OnActorAdded(AActor* Actor);
+	void OnActorDeleted(AActor* Actor);
+	void OnActorMoved(AActor* Actor);
+	void OnRootTransformUpdated(USceneComponent* Component, EUpdateTransformFlags UpdateFlags, ETeleportType Teleport);
+	void OnLevelChanged(ULevel* Level, UWorld* World);
+	void OnWorldCleanup(UWorld* World, bool bSessionEnded, bool bCleanupResources);
+	void OnUndoRedo();
+
+	TMap<TObjectKey<UWorld>, FWorldIndex> Worlds;
+
+	FDelegateHandle ActorAddedHandle;
+	FDelegateHandle ActorDeletedHandle;
+	FDelegateHandle ActorMovedHandle;
+	FDelegateHandle LevelAddedHandle;
+	FDelegateHandle LevelRemovedHandle;
+	FDelegateHandle WorldCleanupHandle;
+	FDelegateHandle UndoRedoHandle;
+	bool bInitialized = false;
+};
@@ -0,0 +1,111 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "MCPImageEncoder.h"
+#include <atomic>
+
+class FMCPClientConnection;
+class IImageWrapperModule;
+
+/** Settings of one viewport stream, from start_viewport_stream. */
+struct FMCPViewportStreamConfig
+{
+	double Fps = 10.0;
+
+	/** Longest side of the streamed frames; 0 keeps the viewport size. */
+	int32 MaxSize = 512;
+	EMCPImageFormat Format = EMCPImageFormat::Jpeg;
+	int32 Quality = 70;
+
+	/** Side of the square tiles compared between frames. */
+	int32 TileSize = 64;
+
+	/** Largest fraction of changed tiles still sent as a delta rather than a full frame. */
+	double DeltaThreshold = 0.3;
+
+	/** A full frame goes out at least this often, so a client that lost track of deltas recovers. */
+	int32 KeyframeInterval = 60;
+};
+
+/** Counters of one stream, reported when it stops. */
+struct FMCPViewportStreamStats
+{
+	int32 Sent = 0;
+	int32 Deltas = 0;
+	int32 Duplicates = 0;
+	int32 Skipped = 0;
+};
+
+/**
+ * Viewport frames pushed over a client's own connection at a fixed rate.
+ *
+ * Each stream is bound to the connection that started it. On every due tick the
+ * viewport is read back through FMCPScreenshotCapture; downscaling, hashing,
+ * tile comparison, encoding and the socket write run on a background task. A
+ * stream has at most one frame in flight, so when the encoder falls behind the
+ * due frames are skipped instead of queued; a frame the client's socket cannot
+ * take right away is skipped too, so a client that stops reading never holds a
+ * worker. A frame identical to the previous one is dropped, and one where few
+ * tiles changed is sent as just those tiles. Nothing touches the disk.
+ *
+ * Frames are newline-terminated JSON messages, interleaved with responses:
+ *
+ *   {"type": "viewport_frame", "stream_id": 1, "seq": 7, "kind": "key",
+ *    "width": 512, "height": 288, "format": "jpeg", "skipped": 0, "data": "<base64>"}
+ *   {"type": "viewport_frame", ..., "kind": "delta",
+ *    "tiles": [{"x": 64, "y": 0, "w": 64, "h": 64, "data": "<base64>"}]}
+ *
+ * Streams end with stop_viewport_stream or when their connection closes.
+ */
+class UNREALMCP_API FMCPViewportStream
+{
+public:
+	static FMCPViewportStream& Get();
+
+	/** Start the frame ticker; called by the bridge subsystem. */
+	void Initialize();
+	void Shutdown();
+
+	/** Start streaming to Connection (game thread). Returns the stream id. */
+	int32 Start(const TSharedPtr<FMCPClientConnection, ESPMode::ThreadSafe>& Connection, const FMCPViewportStreamConfig& Config);
+
+	/** Stop a stream (game thread). Returns false for an unknown id. */
+	bool Stop(int32 StreamId, FMCPViewportStreamStats& OutStats);
+
+private:
+	struct FStream
+	{
+		int32 Id = 0;
+		FMCPViewportStreamConfig Config;
+		TWeakPtr<FMCPClientConnection, ESPMode::ThreadSafe> Connection;
+		double NextFrameTime = 0.0;
+
+		/** Set from capture until the frame is sent or dropped; a due frame is skipped while set. */
+		std::atomic<bool> bBusy{ false };
+		std::atomic<bool> bClosed{ false };
+
+		// Owned by the frame task, which runs at most once at a time per stream
+		int64 Sequence = 0;
+		uint64 LastHash = 0;
+		TArray<FColor> LastPixels;
+		FIntPoint LastSize = FIntPoint::ZeroValue;
+		int32 FramesSinceKey = 0;
+
+		std::atomic<int32> Sent{ 0 };
+		std::atomic<int32> Deltas{ 0 };
+		std::atomic<int32> Duplicates{ 0 };
+		std::atomic<int32> Skipped{ 0 };
+	};
+
+	bool Tick(float DeltaTime);
+
+	/** Background task: prepare, compare, encode and send one frame. */
+	void ProcessFrame(FStream& Stream, TArray<FColor> Pixels, FIntPoint SourceSize);
+
+	TMap<int32, TSharedRef<FStream, ESPMode::ThreadSafe>> Streams;
+	IImageWrapperModule* ImageWrapperModule = nullptr;
+	FTSTicker::FDelegateHandle TickerHandle;
+	int32 NextStreamId = 1;
+	bool bInitialized = false;
+};
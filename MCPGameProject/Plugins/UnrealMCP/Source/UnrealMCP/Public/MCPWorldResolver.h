@@ -0,0 +1,67 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/World.h"
+
+/**
+ * The worlds MCP commands act on, resolved once and cached.
+ *
+ * The target world is the running PIE world when there is one and the editor
+ * world otherwise. Resolving walks the engine's world contexts, so the result is
+ * kept until something that can change it happens: PIE beginning or ending, a
+ * map change, or a world being initialized or cleaned up. A cached PIE world is
+ * still checked on every call (not being destroyed, initialized), so a missed
+ * notification costs one re-resolve rather than a dying world.
+ *
+ * Handlers get their world here (or through FUnrealMCPCommonUtils::GetTargetWorld)
+ * so that PIE and editor targeting agree across commands. Game thread only.
+ */
+class UNREALMCP_API FMCPWorldResolver
+{
+public:
+	static FMCPWorldResolver& Get();
+
+	/** Hook the PIE / map / world delegates; called by the bridge subsystem. Until then nothing is cached. */
+	void Initialize();
+	void Shutdown();
+
+	/** The PIE world while one is running, the editor world otherwise. */
+	UWorld* GetTargetWorld();
+
+	/** The editor world, also while PIE runs. */
+	UWorld* GetEditorWorld();
+
+	/** The running PIE world, or null. */
+	UWorld* GetPIEWorld();
+
+	/** Forget the cached worlds; the next call resolves them again. */
+	void Invalidate();
+
+private:
+	void EnsureResolved();
+	void Resolve();
+
+	/** Editor or PIE world; changes to other worlds (previews, thumbnails) do not affect the cache. */
+	static bool IsTargetType(const UWorld* World);
+
+	/** A world commands may act on: not being destroyed and fully initialized. */
+	static bool IsUsable(const UWorld* World);
+
+	void OnPIEEvent(bool bIsSimulating);
+	void OnMapChange(uint32 MapChangeFlags);
+	void OnWorldInitialized(UWorld* World, const UWorld::InitializationValues Values);
+	void OnWorldCleanup(UWorld* World, bool bSessionEnded, bool bCleanupResources);
+
+	TWeakObjectPtr<UWorld> EditorWorld;
+	TWeakObjectPtr<UWorld> PIEWorld;
+	bool bResolved = false;
+
+	FDelegateHandle BeginPIEHandle;
+	FDelegateHandle PostPIEStartedHandle;
+	FDelegateHandle EndPIEHandle;
+	FDelegateHandle ShutdownPIEHandle;
+	FDelegateHandle MapChangeHandle;
+	FDelegateHandle WorldInitHandle;
+	FDelegateHandle WorldCleanupHandle;
+	bool bInitialized = false;
+};
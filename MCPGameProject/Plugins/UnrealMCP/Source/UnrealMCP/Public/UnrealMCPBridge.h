@@ -6,6 +6,7 @@
 #include "SocketSubsystem.h"
 #include "Http.h"
 #include "Json.h"
+#include "Containers/LruCache.h"
 #include "Interfaces/IPv4/IPv4Address.h"
 #include "Interfaces/IPv4/IPv4Endpoint.h"
 #include "Commands/UnrealMCPEditorCommands.h"
@@ -18,9 +19,15 @@
 #include "Commands/UnrealMCPAssetCommands.h"
 #include "Commands/UnrealMCPGameplayCommands.h"
 #include "Commands/UnrealMCPAnimBlueprintCommands.h"
+#include "Commands/UnrealMCPSpatialCommands.h"
+#include "MCPJsonDocument.h"
+#include "MCPJsonWriter.h"
+#include <atomic>
 #include "UnrealMCPBridge.generated.h"
 
 class FMCPServerRunnable;
+class FMCPClientConnection;
+class FQueuedThreadPool;
 
 /** Delegate type for external command handlers registered via the extension system. */
 DECLARE_DELEGATE_RetVal_TwoParams(TSharedPtr<FJsonObject>, FMCPCommandHandler,
@@ -45,28 +52,96 @@ public:
 	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
 	virtual void Deinitialize() override;
 
+	/**
+	 * Set up and tear down the caches, indexes and sessions commands rely on.
+	 * Initialize/Deinitialize call these; a commandlet hosting its own bridge
+	 * object (no editor subsystem) must call them itself. Safe to call twice.
+	 */
+	void InitializeServices();
+	void ShutdownServices();
+
+	/**
+	 * The bridge whose services are running: the editor subsystem, or the object
+	 * the headless commandlet hosts. Null outside InitializeServices/ShutdownServices.
+	 */
+	static UUnrealMCPBridge* Get();
+
 	// Server functions
 	void StartServer();
 	void StopServer();
 	bool IsRunning() const { return bIsRunning; }
 
-	// Command execution
-	FString ExecuteCommand(const FString& CommandType, const TSharedPtr<FJsonObject>& Params);
+	/** Override the bind address and port read from UMCPSettings. Takes effect on the next StartServer(). */
+	void SetServerEndpoint(const FString& BindAddress, int32 InPort);
+
+	/** Headless mode rejects viewport-dependent commands instead of dereferencing a missing viewport. */
+	void SetHeadless(bool bInHeadless) { bHeadless = bInHeadless; }
+	bool IsHeadless() const;
+
+	/** Pool that parses requests and drains connections; null while the server is stopped. */
+	FQueuedThreadPool* GetWorkerPool() const { return WorkerPool; }
+
+	/** Identity and load metrics reported by get_instance_info, used by the Python pool router. */
+	const FGuid& GetInstanceId() const { return InstanceId; }
+	int32 GetInFlightCommandCount() const { return InFlightCommands.GetValue(); }
+
+	// Command execution. A non-empty IdempotencyKey returns the cached response of an earlier
+	// request with the same key instead of executing the command again.
+	FString ExecuteCommand(const FString& CommandType, const TSharedPtr<FJsonObject>& Params, const FString& IdempotencyKey = FString());
+
+	// Socket path: Params is a view into Document, which is kept alive until the command completes.
+	// Returns the UTF-8 response envelope without a frame terminator. Origin is the connection the
+	// request arrived on, for commands that keep pushing to it after they answer. MutationSession
+	// is the session id the request carried, if any (see FMCPMutationSessions).
+	TArray<uint8> ExecuteCommand(const FString& CommandType, const FMCPJsonDocumentRef& Document, const FMCPJsonObjectView& Params, const FString& IdempotencyKey,
+		const TSharedPtr<FMCPClientConnection, ESPMode::ThreadSafe>& Origin = nullptr, const FString& MutationSession = FString());
+
+	// Connection the command being dispatched arrived on; null for in-process calls. Game thread only, set while a handler runs.
+	const TSharedPtr<FMCPClientConnection, ESPMode::ThreadSafe>& GetCommandConnection() const { return CommandConnection; }
 
 	// Extension system — allows other plugins to register custom command handlers
 	void RegisterExtensionHandler(const FString& CommandPrefix, FMCPCommandHandler Handler);
 	void UnregisterExtensionHandler(const FString& CommandPrefix);
 
+	// Exact-name handlers that read parameters from the request document without building an FJsonObject
+	void RegisterNativeHandler(const FString& CommandType, FMCPNativeCommandHandler Handler);
+
+	// Exact-name handlers that write their result directly into the response buffer
+	void RegisterStreamingHandler(const FString& CommandType, FMCPStreamingCommandHandler Handler);
+
 private:
+	// Returns true for commands that require a level editor viewport or Slate
+	static bool RequiresViewport(const FString& CommandType);
+
+	// Builds the get_instance_info result (game thread)
+	TSharedPtr<FJsonObject> BuildInstanceInfo() const;
+
+	// Idempotency cache lookup/store (any thread)
+	bool TryGetCachedResponse(const FString& IdempotencyKey, const FString& CommandType, TArray<uint8>& OutResponse);
+	void CacheResponse(const FString& IdempotencyKey, const FString& CommandType, const TArray<uint8>& Response);
+
 	// Server state
-	bool bIsRunning;
+	bool bIsRunning = false;
+	bool bHeadless = false;
+	bool bServicesInitialized = false;
 	TSharedPtr<FSocket> ListenerSocket;
 	TSharedPtr<FSocket> ConnectionSocket;
-	FRunnableThread* ServerThread;
+	FRunnableThread* ServerThread = nullptr;
+	FQueuedThreadPool* WorkerPool = nullptr;
 
 	// Server configuration
 	FIPv4Address ServerAddress;
-	uint16 Port;
+	uint16 Port = 0;
+
+	// Instance identity for multi-editor pools (-McpInstanceId= overrides the generated GUID)
+	FGuid InstanceId;
+	FString InstanceLabel;
+	double StartTimeSeconds = 0.0;
+
+	// Load metrics: commands waiting for or running on the game thread, and game-thread cost
+	FThreadSafeCounter InFlightCommands;
+	FThreadSafeCounter64 CommandsExecuted;
+	double AverageGameThreadMs = 0.0;
 
 	// Command handler instances
 	TSharedPtr<FUnrealMCPEditorCommands> EditorCommands;
@@ -79,7 +154,40 @@ private:
 	TSharedPtr<FUnrealMCPAssetCommands> AssetCommands;
 	TSharedPtr<FUnrealMCPGameplayCommands> GameplayCommands;
 	TSharedPtr<FUnrealMCPAnimBlueprintCommands> AnimBlueprintCommands;
+	TSharedPtr<FUnrealMCPSpatialCommands> SpatialCommands;
 
 	// Extension handlers: prefix -> delegate
 	TMap<FString, FMCPCommandHandler> ExtensionHandlers;
+
+	// Origin of the command currently on the game thread
+	TSharedPtr<FMCPClientConnection, ESPMode::ThreadSafe> CommandConnection;
+
+	// Native handlers: command type -> delegate, checked before the FJsonObject routing
+	TMap<FString, FMCPNativeCommandHandler> NativeHandlers;
+	TMap<FString, FMCPStreamingCommandHandler> StreamingHandlers;
+
+	// Idempotency key -> response of the first execution, bounded by UMCPSettings::IdempotencyCacheSize
+	struct FCachedResponse
+	{
+		FString CommandType;
+		TArray<uint8> Response;
+	};
+	TLruCache<FString, FCachedResponse> IdempotencyCache;
+	FCriticalSection IdempotencyLock;
+
+	// A worker waiting for its command's game-thread task. Settled exactly once: by
+	// the task, or by StopServer so the worker pool can be destroyed without it
+	struct FPendingCommand
+	{
+		TPromise<TArray<uint8>> Promise;
+		std::atomic<bool> bSettled{ false };
+
+		bool IsSettled() const { return bSettled.load(); }
+		void Settle(TArray<uint8>&& Response);
+	};
+	TSet<TSharedPtr<FPendingCommand, ESPMode::ThreadSafe>> PendingCommands;
+	FCriticalSection PendingCommandsLock;
+
+	/** Answer every command still waiting for the game thread with an error. */
+	void CancelPendingCommands();
 };
\ No newline at end of file
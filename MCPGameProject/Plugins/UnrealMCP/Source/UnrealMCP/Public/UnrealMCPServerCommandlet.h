@@ -0,0 +1,31 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "UnrealMCPServerCommandlet.generated.h"
+
+/**
+ * Headless MCP server for CI and batch automation.
+ *
+ * Runs the same command router as the editor subsystem, but without Slate or a
+ * level editor viewport. The commandlet pumps the game-thread task graph and
+ * the core ticker itself, so commands queued by the server thread still execute
+ * on the game thread.
+ *
+ * Usage:
+ *   UnrealEditor-Cmd <Project>.uproject -run=UnrealMCPServer -nullrhi [-McpPort=55557] [-McpBind=127.0.0.1]
+ *
+ * Commands that need a viewport (screenshots, viewport camera, editor utility
+ * tabs, PIE) return an error instead of running.
+ */
+UCLASS()
+class UNREALMCP_API UUnrealMCPServerCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UUnrealMCPServerCommandlet();
+
+	// UCommandlet interface
+	virtual int32 Main(const FString& Params) override;
+};
@@ -53,6 +53,8 @@ public class UnrealMCP : ModuleRules
 				"BlueprintGraph",
 				"Projects",
 				"AssetRegistry",
+				"RHI",                      // GPU readback for screenshots
+				"ImageWrapper",             // PNG / JPEG encoding of captured frames
 				"LevelEditor",              // Level management, PIE control
 				"MaterialEditor",           // Material creation and editing
 				"AssetTools",               // Asset importing
@@ -0,0 +1,274 @@
+"""
+Client-side router for a pool of Unreal Editor instances.
+
+One editor's game thread executes every command serially, so throughput is
+capped per editor. A pool spreads commands across several editors (usually
+headless UnrealMCPServer commandlets on different ports):
+
+  - Read-only commands (get_*, find_*, list_*, ...) go to the least-loaded
+    healthy endpoint. Load is the router's own in-flight count plus the
+    in_flight / avg_game_thread_ms metrics reported by get_instance_info.
+  - Mutations are routed by an affinity key (a level, asset or package
+    path) with rendezvous hashing, so every edit of the same package lands
+    on the same editor even when endpoints come and go.
+  - Mutations with no such key (actor edits, settings) act on whatever level
+    is loaded, so they all go to one "current level" editor: the one that
+    last ran load_level / new_level, else the first healthy endpoint.
+  - Once this router has sent a mutation, reads of the same state follow it:
+    reads with that path key go to its affinity editor, and reads without a
+    key go to the current level editor. Other reads stay load-balanced.
+
+Usage:
+    UNREAL_POOL=127.0.0.1:55557,127.0.0.1:55558,127.0.0.1:55559
+
+    import mcp_pool
+    mcp_pool.set_connection_factory(UnrealConnection)
+    mcp_pool.configure_from_env()
+    if mcp_pool.pool_enabled():
+        response = mcp_pool.send_command("get_actors_in_level", {})
+"""
+
+import hashlib
+import logging
+import os
+import time
+from threading import Lock
+from typing import Any, Callable, Dict, List, Optional, Tuple
+
+logger = logging.getLogger("UnrealMCP")
+
+# Commands whose name starts with one of these never modify editor state
+READ_ONLY_PREFIXES = ("get_", "find_", "list_", "does_", "is_", "inspect_", "analyze_", "describe_")
+READ_ONLY_COMMANDS = {"ping"}
+
+# Params checked (in order) for a command's affinity key. Only package paths:
+# object names (actors, components) live in whatever level is loaded.
+AFFINITY_PARAMS = ("level_path", "asset_path", "package_path", "path")
+
+# Commands that change which level an editor has loaded
+LEVEL_COMMANDS = {"load_level", "new_level"}
+
+METRICS_REFRESH_SECONDS = 2.0    # how often get_instance_info is polled per endpoint
+FAILURE_COOLDOWN_SECONDS = 5.0   # how long a failed endpoint is skipped
+
+
+class PoolEndpoint:
+    """One editor in the pool, with router-side and editor-reported load."""
+
+    def __init__(self, host: str, port: int):
+        self.host = host
+        self.port = port
+        self.in_flight = 0                 # commands this router has outstanding
+        self.remote_in_flight = 0          # reported by get_instance_info
+        self.avg_game_thread_ms = 0.0      # reported by get_instance_info
+        self.instance_id: Optional[str] = None
+        self.metrics_at = 0.0
+        self.failed_until = 0.0
+        self.commands_sent = 0
+
+    @property
+    def key(self) -> str:
+        return f"{self.host}:{self.port}"
+
+    def healthy(self, now: float) -> bool:
+        return now >= self.failed_until
+
+    def load_score(self) -> Tuple[int, float]:
+        return (self.in_flight + self.remote_in_flight, self.avg_game_thread_ms)
+
+    def to_dict(self) -> Dict[str, Any]:
+        return {
+            "endpoint": self.key,
+            "instance_id": self.instance_id,
+            "healthy": self.healthy(time.monotonic()),
+            "in_flight": self.in_flight,
+            "remote_in_flight": self.remote_in_flight,
+            "avg_game_thread_ms": round(self.avg_game_thread_ms, 3),
+            "commands_sent": self.commands_sent,
+        }
+
+
+_endpoints: List[PoolEndpoint] = []
+_lock = Lock()
+
+# Routing state built up by mutations (guarded by _lock)
+_level_endpoint: Optional[PoolEndpoint] = None   # editor holding the "current level"
+_level_mutated = False                           # an unkeyed mutation has been sent
+_mutated_keys: set = set()                       # affinity keys that have been mutated
+_connection_factory: Optional[Callable[..., Any]] = None
+
+
+def set_connection_factory(factory: Callable[..., Any]) -> None:
+    """Set the callable used to open a connection: factory(host=..., port=...)."""
+    global _connection_factory
+    _connection_factory = factory
+
+
+def parse_endpoints(spec: str) -> List[Tuple[str, int]]:
+    """Parse 'host:port,host:port' (a bare port means 127.0.0.1)."""
+    result = []
+    for item in spec.split(","):
+        item = item.strip()
+        if not item:
+            continue
+        if ":" in item:
+            host, port = item.rsplit(":", 1)
+        else:
+            host, port = "127.0.0.1", item
+        result.append((host, int(port)))
+    return result
+
+
+def configure(endpoints: List[Tuple[str, int]]) -> None:
+    """Replace the pool. An empty list disables pooling."""
+    global _endpoints, _level_endpoint, _level_mutated
+    with _lock:
+        _endpoints = [PoolEndpoint(h, p) for h, p in endpoints]
+        _level_endpoint = None
+        _level_mutated = False
+        _mutated_keys.clear()
+    logger.info(f"Pool: configured {len(endpoints)} endpoint(s): {[f'{h}:{p}' for h, p in endpoints]}")
+
+
+def configure_from_env() -> None:
+    """Configure the pool from UNREAL_POOL if it is set."""
+    spec = os.environ.get("UNREAL_POOL", "").strip()
+    if spec:
+        configure(parse_endpoints(spec))
+
+
+def pool_enabled() -> bool:
+    """Pooling is active when more than one endpoint is configured."""
+    return len(_endpoints) > 1
+
+
+def is_read_only(command: str) -> bool:
+    return command in READ_ONLY_COMMANDS or command.startswith(READ_ONLY_PREFIXES)
+
+
+def affinity_key(params: Optional[Dict[str, Any]]) -> str:
+    """Return the package-ish key a mutation should be pinned by ('' if none)."""
+    if not params:
+        return ""
+    for name in AFFINITY_PARAMS:
+        value = params.get(name)
+        # Package paths are rooted (/Game/...); anything else is not a package
+        if isinstance(value, str) and value.startswith("/"):
+            # Route by package, not by object, so /Game/Maps/A.A and /Game/Maps/A agree
+            return value.split(".", 1)[0]
+    return ""
+
+
+def _rendezvous_weight(key: str, endpoint: PoolEndpoint) -> int:
+    digest = hashlib.blake2b(f"{key}|{endpoint.key}".encode("utf-8"), digest_size=8).digest()
+    return int.from_bytes(digest, "big")
+
+
+def _current_level_endpoint(healthy: List[PoolEndpoint]) -> PoolEndpoint:
+    """The editor unkeyed edits go to; sticky while it stays healthy. Caller holds _lock."""
+    global _level_endpoint
+    if _level_endpoint not in healthy:
+        _level_endpoint = healthy[0]
+    return _level_endpoint
+
+
+def _select(command: str, params: Optional[Dict[str, Any]]) -> Optional[PoolEndpoint]:
+    """Pick an endpoint for a command. Caller holds _lock."""
+    global _level_endpoint, _level_mutated
+    now = time.monotonic()
+    healthy = [e for e in _endpoints if e.healthy(now)]
+    if not healthy:
+        return None
+
+    key = affinity_key(params)
+    if is_read_only(command):
+        # Reads of state this router changed must see the change
+        if key and key in _mutated_keys:
+            return max(healthy, key=lambda e: _rendezvous_weight(key, e))
+        if not key and _level_mutated:
+            return _current_level_endpoint(healthy)
+        return min(healthy, key=lambda e: e.load_score())
+
+    if not key:
+        # Actor edits and settings act on the loaded level, so keep them on one editor
+        _level_mutated = True
+        return _current_level_endpoint(healthy)
+
+    _mutated_keys.add(key)
+    endpoint = max(healthy, key=lambda e: _rendezvous_weight(key, e))
+    if command in LEVEL_COMMANDS:
+        # Later actor edits belong to the level this editor just opened
+        _level_endpoint = endpoint
+        _level_mutated = True
+    return endpoint
+
+
+def _refresh_metrics(endpoint: PoolEndpoint) -> None:
+    """Poll get_instance_info if the endpoint's metrics are stale."""
+    if time.monotonic() - endpoint.metrics_at < METRICS_REFRESH_SECONDS:
+        return
+    endpoint.metrics_at = time.monotonic()
+    conn = _connection_factory(host=endpoint.host, port=endpoint.port)
+    response = conn.send_command("get_instance_info", {})
+    if not response or response.get("status") != "success":
+        return
+    info = response.get("result", {})
+    load = info.get("load", {})
+    with _lock:
+        endpoint.instance_id = info.get("instance_id")
+        endpoint.remote_in_flight = int(load.get("in_flight", 0))
+        endpoint.avg_game_thread_ms = float(load.get("avg_game_thread_ms", 0.0))
+
+
+def send_command(command: str, params: Optional[Dict[str, Any]] = None) -> Optional[Dict[str, Any]]:
+    """Route a command to a pool endpoint and return its response."""
+    if _connection_factory is None:
+        raise RuntimeError("mcp_pool.set_connection_factory() was not called")
+
+    with _lock:
+        endpoint = _select(command, params)
+        if endpoint is None:
+            return {"status": "error", "error": "No healthy editor in the pool"}
+        endpoint.in_flight += 1
+        endpoint.commands_sent += 1
+
+    try:
+        if is_read_only(command):
+            _refresh_metrics(endpoint)
+        conn = _connection_factory(host=endpoint.host, port=endpoint.port)
+        response = conn.send_command(command, params)
+        if response is None:
+            # Connection failed; skip this endpoint for a while
+            with _lock:
+                endpoint.failed_until = time.monotonic() + FAILURE_COOLDOWN_SECONDS
+            logger.warning(f"Pool: {endpoint.key} unreachable, cooling down")
+        elif isinstance(response, dict):
+            response.setdefault("_endpoint", endpoint.key)
+        return response
+    finally:
+        with _lock:
+            endpoint.in_flight -= 1
+
+
+def pool_status() -> Dict[str, Any]:
+    """Snapshot of every endpoint's health and load."""
+    with _lock:
+        return {
+            "enabled": pool_enabled(),
+            "endpoints": [e.to_dict() for e in _endpoints],
+        }
+
+
+class PooledConnection:
+    """Drop-in stand-in for UnrealConnection that routes through the pool."""
+
+    connected = True
+
+    def connect(self) -> bool:
+        return pool_enabled()
+
+    def disconnect(self) -> None:
+        pass
+
+    def send_command(self, command: str, params: Dict[str, Any] = None) -> Optional[Dict[str, Any]]:
+        return send_command(command, params)
@@ -4,6 +4,7 @@ Editor Tools for Unreal MCP.
 This module provides tools for controlling the Unreal Editor viewport and other editor functionality.
 """
 
+import json
 import logging
 import time
 import os
@@ -16,13 +17,103 @@ from mcp_cache import cache_get, cache_set, cache_invalidate, TTL_ACTORS
 # Get logger
 logger = logging.getLogger("UnrealMCP")
 
+def _capture_screenshot(unreal, filepath: str, max_size: int = 0, image_format: str = "png",
+                        timeout: float = 10.0) -> Dict[str, Any]:
+    """
+    Run take_screenshot and wait for its ticket.
+
+    The editor only queues a GPU copy and returns a ticket; the readback, downscale and
+    encode finish off the game thread, so this polls get_screenshot until the file exists.
+    """
+    params = {"filepath": filepath, "format": image_format}
+    if max_size > 0:
+        params["max_size"] = max_size
+    response = unreal.send_command("take_screenshot", params) or {}
+    if response.get("status") == "error":
+        raise RuntimeError(response.get("error", "Screenshot failed"))
+    result = response.get("result", response)
+    capture = result.get("data", result)
+    ticket = capture.get("ticket")
+    if ticket is None:
+        raise RuntimeError("Screenshot did not return a ticket")
+
+    deadline = time.monotonic() + timeout
+    delay = 0.01
+    while True:
+        response = unreal.send_command("get_screenshot", {"ticket": ticket}) or {}
+        if response.get("status") == "error":
+            raise RuntimeError(response.get("error", "Screenshot failed"))
+        result = response.get("result", response)
+        state = result.get("data", result)
+        if state.get("status") == "done":
+            return state
+        if time.monotonic() > deadline:
+            raise RuntimeError(f"Screenshot {ticket} did not finish within {timeout}s")
+        time.sleep(delay)
+        delay = min(delay * 2, 0.1)
+
 def register_editor_tools(mcp: FastMCP):
     """Register editor tools with the MCP server."""
     
+    def _actor_query_params(
+        class_name: str,
+        tags: Optional[List[str]],
+        folder: str,
+        level: str,
+        mobility: str,
+        label: str,
+        fields: Optional[List[str]]
+    ) -> Dict[str, Any]:
+        """Build the server-side filter / projection block shared by actor listings."""
+        actor_filter = {}
+        if class_name:
+            actor_filter["class"] = class_name
+        if tags:
+            actor_filter["tags"] = tags
+        if folder:
+            actor_filter["folder"] = folder
+        if level:
+            actor_filter["level"] = level
+        if mobility:
+            actor_filter["mobility"] = mobility
+        if label:
+            actor_filter["label"] = label
+
+        params = {}
+        if actor_filter:
+            params["filter"] = actor_filter
+        if fields:
+            params["fields"] = fields
+        return params
+
     @mcp.tool()
-    def get_actors_in_level(ctx: Context) -> List[Dict[str, Any]]:
-        """Get a list of all actors in the current level."""
-        cache_key = "actors:all"
+    def get_actors_in_level(
+        ctx: Context,
+        class_name: str = "",
+        tags: List[str] = None,
+        folder: str = "",
+        level: str = "",
+        mobility: str = "",
+        label: str = "",
+        fields: List[str] = None
+    ) -> List[Dict[str, Any]]:
+        """
+        Get a list of actors in the current level, filtered on the server.
+
+        Args:
+            class_name: Only actors of this class or a subclass (e.g. "StaticMeshActor" or a Blueprint name)
+            tags: Only actors that have all of these tags
+            folder: Only actors in this World Outliner folder or its subfolders
+            level: Only actors in this streaming level (package name)
+            mobility: Only actors whose root has this mobility ("Static", "Stationary", "Movable")
+            label: Only actors whose label matches this wildcard (e.g. "Rock_*")
+            fields: Fields to return per actor: name, label, class, location, rotation,
+                    scale, tags, folder, level, mobility, path, properties (all
+                    editor-visible properties, as get_actor_properties returns them)
+                    (default: name, class, location, rotation, scale)
+        """
+        params = _actor_query_params(class_name, tags, folder, level, mobility, label, fields)
+        cache_key = f"actors:all:{json.dumps(params, sort_keys=True)}" if params else "actors:all"
         cached = cache_get(cache_key)
         if cached is not None:
             return cached
@@ -35,7 +126,7 @@ def register_editor_tools(mcp: FastMCP):
                 logger.warning("Failed to connect to Unreal Engine")
                 return []
 
-            response = unreal.send_command("get_actors_in_level", {})
+            response = unreal.send_command("get_actors_in_level", params)
 
             if not response:
                 logger.warning("No response from Unreal Engine")
@@ -64,9 +155,27 @@ def register_editor_tools(mcp: FastMCP):
             return []
 
     @mcp.tool()
-    def find_actors_by_name(ctx: Context, pattern: str) -> List[str]:
-        """Find actors by name pattern."""
-        cache_key = f"actors:by_name:{pattern}"
+    def find_actors_by_name(
+        ctx: Context,
+        pattern: str,
+        class_name: str = "",
+        tags: List[str] = None,
+        folder: str = "",
+        level: str = "",
+        mobility: str = "",
+        label: str = "",
+        fields: List[str] = None
+    ) -> List[str]:
+        """
+        Find actors by name pattern.
+
+        Args:
+            pattern: Substring matched against actor names and labels
+            class_name, tags, folder, level, mobility, label, fields: Optional server-side
+                filter and field projection, as for get_actors_in_level
+        """
+        params = _actor_query_params(class_name, tags, folder, level, mobility, label, fields)
+        cache_key = f"actors:by_name:{pattern}:{json.dumps(params, sort_keys=True)}" if params else f"actors:by_name:{pattern}"
         cached = cache_get(cache_key)
         if cached is not None:
             return cached
@@ -79,9 +188,8 @@ def register_editor_tools(mcp: FastMCP):
                 logger.warning("Failed to connect to Unreal Engine")
                 return []
 
-            response = unreal.send_command("find_actors_by_name", {
-                "pattern": pattern
-            })
+            params["pattern"] = pattern
+            response = unreal.send_command("find_actors_by_name", params)
 
             if not response:
                 return []
@@ -165,6 +273,34 @@ def register_editor_tools(mcp: FastMCP):
             logger.error(error_msg)
             return {"success": False, "message": error_msg}
 
+    @mcp.tool()
+    def spawn_actors(ctx: Context, actors: List[Dict[str, Any]]) -> Dict[str, Any]:
+        """
+        Spawn many actors in one request and one undo transaction.
+
+        Much faster than repeated spawn_actor / set_actor_property / set_actor_material
+        calls: mesh, material, transform, tags and folder are applied during the spawn.
+        Nothing is spawned if any spec is invalid.
+
+        Args:
+            actors: List of actor specs, each with optional keys:
+                type (default "StaticMeshActor"), name, label, location [X, Y, Z],
+                rotation [Pitch, Yaw, Roll], scale [X, Y, Z], mesh (asset path),
+                material (asset path), material_slot, tags (list), folder
+        """
+        from unreal_mcp_server import get_unreal_connection
+        try:
+            unreal = get_unreal_connection()
+            if not unreal:
+                return {"success": False, "message": "Failed to connect to Unreal Engine"}
+            response = unreal.send_command("spawn_actors", {"actors": actors}) or {}
+            if response.get("status") == "success":
+                cache_invalidate("actors:")
+            return response
+        except Exception as e:
+            logger.error(f"Error spawning actors: {e}")
+            return {"success": False, "message": str(e)}
+
     @mcp.tool()
     def delete_actor(ctx: Context, name: str) -> Dict[str, Any]:
         """Delete an actor by name."""
@@ -217,6 +353,92 @@ def register_editor_tools(mcp: FastMCP):
             logger.error(f"Error setting transform: {e}")
             return {}
     
+    @mcp.tool()
+    def set_actor_transforms(
+        ctx: Context,
+        transforms: List[Dict[str, Any]],
+        mode: str = "absolute"
+    ) -> Dict[str, Any]:
+        """
+        Set the transforms of many actors in one request and one undo transaction.
+
+        Each actor is moved once, so render and physics state update once per actor
+        instead of once per call. Nothing moves if any item is invalid; actors that
+        cannot be found are skipped and listed under "missing".
+
+        Args:
+            transforms: List of items with keys: actor (name or label), and optional
+                location [X, Y, Z], rotation [Pitch, Yaw, Roll], scale [X, Y, Z],
+                mode ("absolute" or "relative", overrides the request's mode)
+            mode: "absolute" sets the given values; "relative" offsets location,
+                rotates on top of the current rotation and multiplies scale
+        """
+        from unreal_mcp_server import get_unreal_connection
+        try:
+            unreal = get_unreal_connection()
+            if not unreal:
+                return {"success": False, "message": "Failed to connect to Unreal Engine"}
+            response = unreal.send_command("set_actor_transforms", {"transforms": transforms, "mode": mode}) or {}
+            if response.get("status") == "success":
+                cache_invalidate("actors:")
+            return response
+        except Exception as e:
+            logger.error(f"Error setting actor transforms: {e}")
+            return {"success": False, "message": str(e)}
+
+    @mcp.tool()
+    def begin_mutation_session(
+        ctx: Context,
+        name: str = "MCP Edits",
+        idle_timeout: float = 0.0
+    ) -> Dict[str, Any]:
+        """
+        Fold the following edits into a single undo transaction.
+
+        Use before a long run of mutations (bulk property sets, many transforms) so
+        they become one undo step and each object is recorded in the undo buffer
+        once, instead of one transaction per command. Commands sent by this server
+        belong to the session until end_mutation_session is called or the session
+        goes idle. Editor undo is unavailable while the session's transaction is open.
+
+        Args:
+            name: Label shown in the editor's undo history
+            idle_timeout: Seconds without commands before the session ends on its
+                own (0 uses the editor's MCP Settings default)
+        """
+        from unreal_mcp_server import get_unreal_connection, set_mutation_session
+        try:
+            unreal = get_unreal_connection()
+            if not unreal:
+                return {"success": False, "message": "Failed to connect to Unreal Engine"}
+            response = unreal.send_command("begin_mutation_session", {"name": name, "idle_timeout": idle_timeout}) or {}
+            if response.get("status") == "success":
+                set_mutation_session(response.get("result", {}).get("session_id"))
+            return response
+        except Exception as e:
+            logger.error(f"Error beginning mutation session: {e}")
+            return {"success": False, "message": str(e)}
+
+    @mcp.tool()
+    def end_mutation_session(ctx: Context) -> Dict[str, Any]:
+        """
+        Close the open mutation session and report how many commands, undo
+        transactions and undo-buffer bytes it used.
+        """
+        import unreal_mcp_server
+        try:
+            session_id = unreal_mcp_server._mutation_session
+            if not session_id:
+                return {"success": False, "message": "No mutation session is open"}
+            unreal_mcp_server.set_mutation_session(None)
+            unreal = unreal_mcp_server.get_unreal_connection()
+            if not unreal:
+                return {"success": False, "message": "Failed to connect to Unreal Engine"}
+            return unreal.send_command("end_mutation_session", {"session_id": session_id}) or {}
+        except Exception as e:
+            logger.error(f"Error ending mutation session: {e}")
+            return {"success": False, "message": str(e)}
+
     @mcp.tool()
     def get_actor_properties(ctx: Context, name: str) -> Dict[str, Any]:
         """Get all properties of an actor."""
@@ -249,7 +471,8 @@ def register_editor_tools(mcp: FastMCP):
         
         Args:
             name: Name of the actor
-            property_name: Name of the property to set
+            property_name: Name of the property to set, or a dotted path such as
+                "StaticMeshComponent.StaticMesh" or "LightColor.R"
             property_value: Value to set the property to
             
         Returns:
@@ -694,20 +917,26 @@ def register_editor_tools(mcp: FastMCP):
     @mcp.tool()
     def take_screenshot(
         ctx: Context,
-        filepath: str = ""
+        filepath: str = "",
+        max_size: int = 1024,
+        image_format: str = "png"
     ) -> Image:
         """
         Take a screenshot of the current viewport (editor or PIE game view).
         Returns the image directly so the AI can see what's happening.
 
+        The capture does not stall the editor: the frame is read back from the GPU
+        and downscaled and compressed on a worker thread.
+
         IMPORTANT: After spawning or modifying actors, wait at least 2 seconds
         before taking a screenshot. The editor viewport needs time to render
         newly created geometry — screenshots taken immediately will show empty space.
 
         Args:
-            filepath: Optional file path to save the PNG. If empty, uses a temp file.
+            filepath: Optional file path to save the image. If empty, uses a temp file.
+            max_size: Longest side of the returned image in pixels (0 = full viewport size)
+            image_format: "png" or "jpeg"
         """
-        from PIL import Image as PILImage
         from unreal_mcp_server import get_unreal_connection
         try:
             unreal = get_unreal_connection()
@@ -716,36 +945,12 @@ def register_editor_tools(mcp: FastMCP):
 
             # Use a temp file if no path specified
             if not filepath:
-                temp_dir = tempfile.gettempdir()
-                filepath = os.path.join(temp_dir, "unreal_mcp_screenshot.png")
+                extension = "jpg" if image_format.lower() in ("jpeg", "jpg") else "png"
+                filepath = os.path.join(tempfile.gettempdir(), f"unreal_mcp_screenshot.{extension}")
 
-            response = unreal.send_command("take_screenshot", {
-                "filepath": filepath
-            })
-            data = response.get("result", response)
-
-            if response.get("status") == "error":
-                raise RuntimeError(response.get("error", "Screenshot failed"))
-
-            saved_path = data.get("filepath", filepath)
-
-            # Fix alpha channel: UE viewport ReadPixels returns A=0 (fully
-            # transparent) which makes the PNG appear white. Force alpha to 255.
-            # Also cap resolution so the image fits within LLM token budgets.
-            MAX_WIDTH = 1024
-            img = PILImage.open(saved_path)
-            if img.mode == "RGBA":
-                r, g, b, a = img.split()
-                img = PILImage.merge("RGB", (r, g, b))
-            if img.width > MAX_WIDTH:
-                scale = MAX_WIDTH / img.width
-                img = img.resize(
-                    (MAX_WIDTH, int(img.height * scale)),
-                    PILImage.LANCZOS,
-                )
-            img.save(saved_path)
-
-            return Image(path=saved_path)
+            # Opaque alpha and the size cap are applied by the editor before encoding
+            data = _capture_screenshot(unreal, filepath, max_size, image_format)
+            return Image(path=data.get("filepath", filepath))
         except Exception as e:
             raise RuntimeError(f"Screenshot failed: {e}")
 
@@ -786,12 +991,10 @@ def register_editor_tools(mcp: FastMCP):
             # Capture frames
             for i in range(count):
                 frame_path = os.path.join(temp_dir, f"unreal_mcp_frame_{i:03d}.png")
-                response = unreal.send_command("take_screenshot", {
-                    "filepath": frame_path
-                })
-                data = response.get("result", response)
-                if response.get("status") == "error":
-                    logger.warning(f"Frame {i} failed: {response.get('error')}")
+                try:
+                    data = _capture_screenshot(unreal, frame_path, max_size=320)
+                except RuntimeError as e:
+                    logger.warning(f"Frame {i} failed: {e}")
                     continue
                 frame_paths.append(data.get("filepath", frame_path))
 
@@ -951,4 +1154,139 @@ def register_editor_tools(mcp: FastMCP):
             logger.error(f"Error finding editor utility widget: {e}")
             return {"success": False, "message": str(e)}
 
+    @mcp.tool()
+    def get_actors_in_box(
+        ctx: Context,
+        min: List[float],
+        max: List[float],
+        limit: int = 0
+    ) -> Dict[str, Any]:
+        """
+        List actors whose location lies inside an axis-aligned box.
+
+        Args:
+            min: [X, Y, Z] minimum corner of the box
+            max: [X, Y, Z] maximum corner of the box
+            limit: Maximum number of actors to return (0 = no limit)
+        """
+        from unreal_mcp_server import get_unreal_connection
+        try:
+            unreal = get_unreal_connection()
+            if not unreal:
+                return {"success": False, "message": "Failed to connect to Unreal Engine"}
+            params = {"min": min, "max": max}
+            if limit:
+                params["limit"] = limit
+            response = unreal.send_command("get_actors_in_box", params)
+            return response or {}
+        except Exception as e:
+            logger.error(f"Error querying actors in box: {e}")
+            return {"success": False, "message": str(e)}
+
+    @mcp.tool()
+    def get_actors_in_radius(
+        ctx: Context,
+        center: List[float],
+        radius: float,
+        limit: int = 0
+    ) -> Dict[str, Any]:
+        """
+        List actors within a radius of a point, nearest first.
+
+        Args:
+            center: [X, Y, Z] center of the sphere
+            radius: Sphere radius in world units
+            limit: Maximum number of actors to return (0 = no limit)
+        """
+        from unreal_mcp_server import get_unreal_connection
+        try:
+            unreal = get_unreal_connection()
+            if not unreal:
+                return {"success": False, "message": "Failed to connect to Unreal Engine"}
+            params = {"center": center, "radius": radius}
+            if limit:
+                params["limit"] = limit
+            response = unreal.send_command("get_actors_in_radius", params)
+            return response or {}
+        except Exception as e:
+            logger.error(f"Error querying actors in radius: {e}")
+            return {"success": False, "message": str(e)}
+
+    @mcp.tool()
+    def get_nearest_actors(
+        ctx: Context,
+        location: List[float],
+        count: int = 10,
+        max_distance: float = None
+    ) -> Dict[str, Any]:
+        """
+        List the actors nearest to a point.
+
+        Args:
+            location: [X, Y, Z] query point
+            count: Number of actors to return
+            max_distance: Optional cutoff distance (default 20000)
+        """
+        from unreal_mcp_server import get_unreal_connection
+        try:
+            unreal = get_unreal_connection()
+            if not unreal:
+                return {"success": False, "message": "Failed to connect to Unreal Engine"}
+            params = {"location": location, "count": count}
+            if max_distance is not None:
+                params["max_distance"] = max_distance
+            response = unreal.send_command("get_nearest_actors", params)
+            return response or {}
+        except Exception as e:
+            logger.error(f"Error querying nearest actors: {e}")
+            return {"success": False, "message": str(e)}
+
+    @mcp.tool()
+    def get_actors_in_frustum(
+        ctx: Context,
+        location: List[float] = None,
+        rotation: List[float] = None,
+        fov: float = None,
+        aspect_ratio: float = None,
+        max_distance: float = None,
+        limit: int = 0
+    ) -> Dict[str, Any]:
+        """
+        List actors visible to a camera frustum, nearest first.
+
+        Any camera value left out is taken from the PIE player camera while
+        PIE is running, otherwise from the editor viewport camera.
+
+        Args:
+            location: Optional [X, Y, Z] camera location
+            rotation: Optional [Pitch, Yaw, Roll] camera rotation in degrees
+            fov: Optional horizontal field of view in degrees
+            aspect_ratio: Optional width / height
+            max_distance: Optional far distance (default 20000)
+            limit: Maximum number of actors to return (0 = no limit)
+        """
+        from unreal_mcp_server import get_unreal_connection
+        try:
+            unreal = get_unreal_connection()
+            if not unreal:
+                return {"success": False, "message": "Failed to connect to Unreal Engine"}
+            params = {}
+            if location is not None:
+                params["location"] = location
+            if rotation is not None:
+                params["rotation"] = rotation
+            if fov is not None:
+                params["fov"] = fov
+            if aspect_ratio is not None:
+                params["aspect_ratio"] = aspect_ratio
+            if max_distance is not None:
+                params["max_distance"] = max_distance
+            if limit:
+                params["limit"] = limit
+            response = unreal.send_command("get_actors_in_frustum", params)
+            return response or {}
+        except Exception as e:
+            logger.error(f"Error querying actors in frustum: {e}")
+            return {"success": False, "message": str(e)}
+
     logger.info("Editor tools registered successfully")
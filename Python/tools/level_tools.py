@@ -268,4 +268,123 @@ def register_level_tools(mcp: FastMCP):
             logger.error(f"Error executing Python: {e}")
             return {"success": False, "message": str(e)}
 
+    @mcp.tool()
+    def consolidate_to_instances(
+        ctx: Context,
+        scope: str = "",
+        filter: Dict[str, Any] = None,
+        min_group_size: int = 2,
+        hierarchical: bool = True,
+        name_prefix: str = "Instances",
+        dry_run: bool = False
+    ) -> Dict[str, Any]:
+        """
+        Replace groups of identical StaticMeshActors with one instanced mesh actor per group.
+
+        Actors are grouped by mesh, materials, collision profile, mobility, level and the
+        rendering settings the instanced component takes over (visibility, hidden in game,
+        shadow casting, max draw distance, light map resolution); each group becomes a single
+        actor with an HISM (or ISM) component holding the transforms. Untagged, unattached
+        plain StaticMeshActors only; actors whose mesh component has any other setting changed
+        from its defaults (custom primitive data, min draw distance, painted vertex colors,
+        physics overrides, ...) are left alone and counted in skipped_actors. The change is
+        one undo step.
+
+        Args:
+            scope: "selection" or "level" (default: selection, or level when filter is given)
+            filter: Optional actor filter, e.g. {"folder": "Generated", "label": "Block_*"}
+            min_group_size: Smallest group worth converting
+            hierarchical: Use HISM (True) or plain ISM (False)
+            name_prefix: Label prefix for the created actors
+            dry_run: Only report the groups and the actor / draw-call reduction
+        """
+        from unreal_mcp_server import get_unreal_connection
+        try:
+            unreal = get_unreal_connection()
+            if not unreal:
+                return {"success": False, "message": "Failed to connect to Unreal Engine"}
+            params = {
+                "min_group_size": min_group_size,
+                "hierarchical": hierarchical,
+                "name_prefix": name_prefix,
+                "dry_run": dry_run,
+            }
+            if scope:
+                params["scope"] = scope
+            if filter:
+                params["filter"] = filter
+            response = unreal.send_command("consolidate_to_instances", params)
+            return response or {}
+        except Exception as e:
+            logger.error(f"Error consolidating actors: {e}")
+            return {"success": False, "message": str(e)}
+
+    @mcp.tool()
+    def get_level_changes(
+        ctx: Context,
+        since_version: int,
+        journal_id: str = ""
+    ) -> Dict[str, Any]:
+        """
+        Get the actors changed since a level journal version, instead of re-listing the level.
+
+        get_actors_in_level returns "version" and "journal_id"; pass them here, then pass
+        each response's "version" to the next call. Each change entry is one actor with
+        its current state and the kinds of change ("added", "removed", "transform",
+        "renamed", "property"). When "resync_required" is true the journal cannot
+        describe the gap (it wrapped, an undo or level load happened, or the editor
+        restarted): call get_actors_in_level again.
+
+        Args:
+            since_version: Version of the client's last full listing or delta
+            journal_id: journal_id that version came from (recommended)
+        """
+        from unreal_mcp_server import get_unreal_connection
+        try:
+            unreal = get_unreal_connection()
+            if not unreal:
+                return {"success": False, "message": "Failed to connect to Unreal Engine"}
+            params = {"since_version": since_version}
+            if journal_id:
+                params["journal_id"] = journal_id
+            response = unreal.send_command("get_level_changes", params)
+            return response or {}
+        except Exception as e:
+            logger.error(f"Error getting level changes: {e}")
+            return {"success": False, "message": str(e)}
+
+    @mcp.tool()
+    def get_level_stats(
+        ctx: Context,
+        filter: Dict[str, Any] = None,
+        grid_size: int = 8,
+        top: int = 20
+    ) -> Dict[str, Any]:
+        """
+        Report what makes the current level heavy, to decide what to optimize.
+
+        Returns actor and component counts per class, static mesh instance counts
+        with LOD0 triangle and vertex totals (meshes ranked by triangles drawn across
+        all instances), lights by mobility (static / stationary / movable), ticking
+        actors and components, and an XY density grid with its busiest cells.
+
+        Args:
+            filter: Optional actor filter, e.g. {"level": "Sublevel_A"} or {"folder": "Props"}
+            grid_size: Cells per side of the density grid (1-64)
+            top: Entries kept in each ranked list
+        """
+        from unreal_mcp_server import get_unreal_connection
+        try:
+            unreal = get_unreal_connection()
+            if not unreal:
+                return {"success": False, "message": "Failed to connect to Unreal Engine"}
+            params = {"grid_size": grid_size, "top": top}
+            if filter:
+                params["filter"] = filter
+            response = unreal.send_command("get_level_stats", params)
+            return response or {}
+        except Exception as e:
+            logger.error(f"Error getting level stats: {e}")
+            return {"success": False, "message": str(e)}
+
     logger.info("Level tools registered successfully")
@@ -32,6 +32,9 @@ _IS_CONTAINER = os.environ.get("MCP_TRANSPORT") == "sse" and platform.system() !
 _cached_editor_path: Optional[str] = None
 _cached_project_path: Optional[str] = None
 
+# Headless editors launched by start_editor_pool: port -> Popen
+_pool_processes: Dict[int, subprocess.Popen] = {}
+
 
 def _get_mcp_host_port() -> tuple:
     """Get the MCP host and port from environment or defaults."""
@@ -215,6 +218,50 @@ def _find_ue_editor() -> Optional[str]:
     return None
 
 
+def _find_ue_editor_cmd(editor_path: Optional[str]) -> Optional[str]:
+    """Return the UnrealEditor-Cmd executable next to an UnrealEditor executable."""
+    if not editor_path:
+        return None
+    directory, name = os.path.split(editor_path)
+    base, ext = os.path.splitext(name)
+    if base.endswith("-Cmd"):
+        return editor_path
+    candidate = os.path.join(directory, f"{base}-Cmd{ext}")
+    return candidate if os.path.exists(candidate) else None
+
+
+def _launch_detached(args: list) -> subprocess.Popen:
+    """Launch a process that outlives this server, without a console window."""
+    if platform.system() == "Windows":
+        return subprocess.Popen(
+            args,
+            stdout=subprocess.DEVNULL, stderr=subprocess.DEVNULL,
+            creationflags=subprocess.DETACHED_PROCESS | subprocess.CREATE_NEW_PROCESS_GROUP
+        )
+    return subprocess.Popen(
+        args,
+        stdout=subprocess.DEVNULL, stderr=subprocess.DEVNULL,
+        start_new_session=True
+    )
+
+
+def _stop_pool_processes(ports: list) -> list:
+    """Terminate the pool editors on the given ports (kill after 30s). Returns the ports stopped."""
+    stopped = []
+    for port in ports:
+        proc = _pool_processes.pop(port, None)
+        if proc is None:
+            continue
+        if proc.poll() is None:
+            proc.terminate()
+            try:
+                proc.wait(timeout=30)
+            except subprocess.TimeoutExpired:
+                proc.kill()
+        stopped.append(port)
+    return stopped
+
+
 def _reset_tcp_connection():
     """Reset the cached TCP connection so the next tool call reconnects."""
     try:
@@ -486,6 +533,120 @@ def register_process_tools(mcp: FastMCP):
 
         return result
 
+    @mcp.tool()
+    def start_editor_pool(
+        ctx: Context,
+        count: int = 4,
+        base_port: int = 55560,
+        project_path: str = "",
+        editor_path: str = "",
+        timeout: int = 300
+    ) -> Dict[str, Any]:
+        """
+        Launch several headless editors (UnrealMCPServer commandlet) on consecutive
+        ports and route subsequent tool calls across them. Read-only commands are
+        balanced by load; edits to the same level/asset always go to the same editor.
+
+        Args:
+            count: Number of headless editors to start (at least 2; one editor needs no pool)
+            base_port: Port of the first editor; others use base_port+1, +2, ...
+            project_path: Path to the .uproject file (auto-discovered if empty)
+            editor_path: Path to UnrealEditor or UnrealEditor-Cmd (auto-discovered if empty)
+            timeout: Max seconds to wait for all editors to accept connections
+        """
+        if _IS_CONTAINER:
+            return {
+                "success": False,
+                "message": "start_editor_pool is not available in container mode. "
+                           "Start the headless editors on the host and set UNREAL_POOL instead."
+            }
+        if count < 2:
+            return {"success": False, "message": "count must be at least 2; a single editor is used directly without a pool"}
+
+        resolved_project = project_path or _cached_project_path or _find_uproject_file()
+        if not resolved_project or not os.path.exists(resolved_project):
+            return {"success": False, "message": "Could not find .uproject file. Provide project_path explicitly."}
+
+        resolved_cmd = _find_ue_editor_cmd(editor_path or _cached_editor_path or _find_ue_editor())
+        if not resolved_cmd:
+            return {"success": False, "message": "Could not find UnrealEditor-Cmd. Provide editor_path explicitly."}
+
+        host, _ = _get_mcp_host_port()
+        ports = [base_port + i for i in range(count)]
+        launched = []
+        for port in ports:
+            existing = _pool_processes.get(port)
+            if existing and existing.poll() is None:
+                continue
+            if _is_port_open(host=host, port=port, timeout=0.5):
+                return {"success": False, "message": f"Port {port} is already in use"}
+            args = [
+                resolved_cmd, resolved_project,
+                "-run=UnrealMCPServer", "-nullrhi", "-unattended", "-nosplash", "-nopause",
+                f"-McpPort={port}", "-McpBind=127.0.0.1", f"-McpInstanceId=pool-{port}",
+            ]
+            try:
+                _pool_processes[port] = _launch_detached(args)
+                launched.append(port)
+                logger.info(f"Launched headless editor on port {port}")
+            except Exception as e:
+                _stop_pool_processes(launched)
+                return {"success": False, "message": f"Failed to launch editor on port {port}: {e}"}
+
+        start_time = time.time()
+        pending = set(ports)
+        while pending and time.time() - start_time < timeout:
+            for port in list(pending):
+                if _is_port_open(host=host, port=port, timeout=1.0):
+                    pending.discard(port)
+                elif _pool_processes.get(port) and _pool_processes[port].poll() is not None:
+                    _stop_pool_processes(launched)
+                    return {"success": False, "message": f"Headless editor on port {port} exited during startup"}
+            if pending:
+                time.sleep(2)
+
+        if pending:
+            _stop_pool_processes(launched)
+            return {
+                "success": False,
+                "message": f"Editors on ports {sorted(pending)} not ready after {timeout}s; stopped the {len(launched)} launched",
+            }
+
+        import mcp_pool
+        mcp_pool.configure([(host, port) for port in ports])
+        _reset_tcp_connection()
+        return {
+            "success": True,
+            "message": f"Editor pool of {count} ready; tool calls are now routed across it",
+            "ports": ports,
+            "startup_time_seconds": round(time.time() - start_time, 1)
+        }
+
+    @mcp.tool()
+    def stop_editor_pool(ctx: Context) -> Dict[str, Any]:
+        """
+        Stop every headless editor started by start_editor_pool and route tool
+        calls back to the single editor at UNREAL_HOST:UNREAL_PORT.
+        """
+        import mcp_pool
+        stopped = _stop_pool_processes(list(_pool_processes.keys()))
+
+        mcp_pool.configure([])
+        mcp_pool.configure_from_env()
+        _reset_tcp_connection()
+        return {"success": True, "stopped_ports": sorted(stopped)}
+
+    @mcp.tool()
+    def get_editor_pool_status(ctx: Context) -> Dict[str, Any]:
+        """
+        Return the editor pool's endpoints with their instance id, health and load
+        (router in-flight count plus the editor-reported game-thread metrics).
+        """
+        import mcp_pool
+        status = mcp_pool.pool_status()
+        status["managed_ports"] = sorted(p for p, proc in _pool_processes.items() if proc.poll() is None)
+        return status
+
     @mcp.tool()
     def clear_mcp_cache(ctx: Context) -> Dict[str, Any]:
         """
@@ -1,8 +1,8 @@
 """
 World Building tools for Unreal MCP.
 
-Pure Python composition tools that use existing spawn_actor and set_actor_transform
-commands to build complex structures from primitive shapes.
+Pure Python composition tools that lay out primitive shapes and spawn them through
+the batched spawn_actors command to build complex structures.
 
 Scope: worldbuilding (inactive by default)
 """
@@ -21,40 +21,52 @@ SPHERE_MESH = "/Engine/BasicShapes/Sphere.Sphere"
 PLANE_MESH = "/Engine/BasicShapes/Plane.Plane"
 
 
-def _spawn_block(unreal, name: str, location: List[float], scale: List[float],
+# Actor specs sent per spawn_actors request
+SPAWN_BATCH_SIZE = 1000
+
+
+class _BlockBatch:
+    """Collects block specs and spawns them with as few spawn_actors round trips as possible."""
+
+    def __init__(self, unreal):
+        self.unreal = unreal
+        self.specs = []
+        self.spawned = 0
+        self.errors = []
+
+    def add(self, spec: dict) -> None:
+        self.specs.append(spec)
+        if len(self.specs) >= SPAWN_BATCH_SIZE:
+            self.flush()
+
+    def flush(self) -> None:
+        if not self.specs:
+            return
+        specs, self.specs = self.specs, []
+        response = self.unreal.send_command("spawn_actors", {"actors": specs}) or {}
+        if response.get("status") == "error":
+            self.errors.append(response.get("error", "spawn_actors failed"))
+            return
+        result = response.get("result", response)
+        self.spawned += result.get("count", 0)
+
+
+def _spawn_block(batch: _BlockBatch, name: str, location: List[float], scale: List[float],
                  rotation: List[float] = None, mesh: str = CUBE_MESH,
-                 material_path: str = None) -> dict:
-    """Spawn a StaticMeshActor block and optionally apply a material."""
-    params = {
+                 material_path: str = None) -> None:
+    """Queue a StaticMeshActor block, optionally with a material."""
+    spec = {
         "name": name,
         "type": "StaticMeshActor",
         "location": location,
+        "scale": scale,
+        "mesh": mesh,
     }
     if rotation:
-        params["rotation"] = rotation
-    result = unreal.send_command("spawn_actor", params)
-
-    # Set the mesh
-    unreal.send_command("set_actor_property", {
-        "name": name,
-        "property_name": "StaticMeshComponent.StaticMesh",
-        "property_value": mesh,
-    })
-
-    # Set scale
-    unreal.send_command("set_actor_transform", {
-        "name": name,
-        "scale": scale,
-    })
-
-    # Apply material if provided
+        spec["rotation"] = rotation
     if material_path:
-        unreal.send_command("set_actor_material", {
-            "name": name,
-            "material_path": material_path,
-        })
-
-    return result
+        spec["material"] = material_path
+    batch.add(spec)
 
 
 def register_worldbuilding_tools(mcp):
@@ -95,6 +107,7 @@ def register_worldbuilding_tools(mcp):
             unreal = get_unreal_connection()
             if not unreal:
                 return {"success": False, "message": "Failed to connect to Unreal Engine"}
+            batch = _BlockBatch(unreal)
 
             loc = location or [0, 0, 0]
             st = structure_type.lower()
@@ -112,7 +125,7 @@ def register_worldbuilding_tools(mcp):
                             name = f"{name_prefix}_Pyr_{idx}"
                             x = loc[0] + col * block_size - offset
                             y = loc[1] + row * block_size - offset
-                            _spawn_block(unreal, name, [x, y, z],
+                            _spawn_block(batch, name, [x, y, z],
                                          [scale, scale, scale],
                                          material_path=material_path)
                             spawned.append(name)
@@ -126,7 +139,7 @@ def register_worldbuilding_tools(mcp):
                         name = f"{name_prefix}_Wall_{idx}"
                         x = loc[0] + col * block_size
                         z = loc[2] + row * block_size
-                        _spawn_block(unreal, name, [x, loc[1], z],
+                        _spawn_block(batch, name, [x, loc[1], z],
                                      [scale, scale * 0.2, scale],
                                      material_path=material_path)
                         spawned.append(name)
@@ -149,7 +162,7 @@ def register_worldbuilding_tools(mcp):
                             pos = [loc[0] - offset, loc[1], z]
                         else:
                             pos = [loc[0], loc[1] - offset, z]
-                        _spawn_block(unreal, name, pos,
+                        _spawn_block(batch, name, pos,
                                      [scale * 0.2, scale * (width / 100), scale * 2],
                                      rotation=[0, angle, 0],
                                      material_path=material_path)
@@ -163,7 +176,7 @@ def register_worldbuilding_tools(mcp):
                     name = f"{name_prefix}_Stair_{idx}"
                     x = loc[0] + s * step_depth
                     z = loc[2] + s * step_height
-                    _spawn_block(unreal, name, [x, loc[1], z],
+                    _spawn_block(batch, name, [x, loc[1], z],
                                  [scale, scale * (width / 100), scale * 0.3],
                                  material_path=material_path)
                     spawned.append(name)
@@ -177,7 +190,7 @@ def register_worldbuilding_tools(mcp):
                     x = loc[0] + radius * math.cos(angle)
                     z = loc[2] + radius * math.sin(angle)
                     rot_deg = math.degrees(angle) - 90
-                    _spawn_block(unreal, name, [x, loc[1], z],
+                    _spawn_block(batch, name, [x, loc[1], z],
                                  [scale, scale * 0.3, scale],
                                  rotation=[0, 0, rot_deg],
                                  material_path=material_path)
@@ -190,7 +203,7 @@ def register_worldbuilding_tools(mcp):
                 for s in range(segs):
                     name = f"{name_prefix}_Col_{idx}"
                     z = loc[2] + s * block_size
-                    _spawn_block(unreal, name, [loc[0], loc[1], z],
+                    _spawn_block(batch, name, [loc[0], loc[1], z],
                                  [scale * 0.5, scale * 0.5, scale],
                                  mesh=CYLINDER_MESH,
                                  material_path=material_path)
@@ -204,7 +217,7 @@ def register_worldbuilding_tools(mcp):
                     name = f"{name_prefix}_Pillar_{idx}"
                     x = loc[0] + radius * math.cos(angle)
                     y = loc[1] + radius * math.sin(angle)
-                    _spawn_block(unreal, name, [x, y, loc[2]],
+                    _spawn_block(batch, name, [x, y, loc[2]],
                                  [scale * 0.4, scale * 0.4, scale * (height / 100)],
                                  mesh=CYLINDER_MESH,
                                  material_path=material_path)
@@ -215,10 +228,15 @@ def register_worldbuilding_tools(mcp):
                         "message": f"Unknown structure_type '{structure_type}'. "
                                    "Use: pyramid, wall, tower, staircase, arch, column, pillar_ring"}
 
+            batch.flush()
+            if batch.errors:
+                return {"success": False, "message": "; ".join(batch.errors),
+                        "actors_spawned": batch.spawned}
+
             return {
                 "success": True,
                 "structure_type": structure_type,
-                "actors_spawned": len(spawned),
+                "actors_spawned": batch.spawned,
                 "actor_names": spawned[:20],
                 "total_actors": len(spawned),
                 "note": "Wait ~2s before taking a screenshot — the viewport needs time to render new geometry.",
@@ -259,6 +277,7 @@ def register_worldbuilding_tools(mcp):
             unreal = get_unreal_connection()
             if not unreal:
                 return {"success": False, "message": "Failed to connect to Unreal Engine"}
+            batch = _BlockBatch(unreal)
 
             loc = location or [0, 0, 0]
             bt = building_type.lower()
@@ -272,7 +291,7 @@ def register_worldbuilding_tools(mcp):
             def add_floor_slab(floor_z, prefix):
                 nonlocal idx
                 name = f"{name_prefix}_{prefix}_Floor_{idx}"
-                _spawn_block(unreal, name,
+                _spawn_block(batch, name,
                              [loc[0], loc[1], floor_z],
                              [w / 100, d / 100, wall_thickness / 100],
                              material_path=material_path)
@@ -290,7 +309,7 @@ def register_worldbuilding_tools(mcp):
                 ]
                 for wall_loc, wall_scale in walls:
                     name = f"{name_prefix}_{prefix}_Wall_{idx}"
-                    _spawn_block(unreal, name, wall_loc, wall_scale,
+                    _spawn_block(batch, name, wall_loc, wall_scale,
                                  material_path=material_path)
                     spawned.append(name)
                     idx += 1
@@ -306,7 +325,7 @@ def register_worldbuilding_tools(mcp):
                 roof_z = loc[2] + floors * fh + fh * 0.3
                 for side, angle in [(1, 20), (-1, -20)]:
                     name = f"{name_prefix}_RoofPanel_{idx}"
-                    _spawn_block(unreal, name,
+                    _spawn_block(batch, name,
                                  [loc[0], loc[1] + side * d * 0.25, roof_z],
                                  [w / 100 * 1.1, d / 100 * 0.6, wall_thickness / 100],
                                  rotation=[angle, 0, 0],
@@ -331,7 +350,7 @@ def register_worldbuilding_tools(mcp):
                     ([loc[0], loc[1] - d / 2, parapet_z], [w / 100 * 1.05, wall_thickness / 100, parapet_h / 100]),
                 ]:
                     name = f"{name_prefix}_Parapet_{idx}"
-                    _spawn_block(unreal, name, wall_loc, wall_scale,
+                    _spawn_block(batch, name, wall_loc, wall_scale,
                                  material_path=material_path)
                     spawned.append(name)
                     idx += 1
@@ -354,7 +373,7 @@ def register_worldbuilding_tools(mcp):
                     for tf in range(tower_floors):
                         name = f"{name_prefix}_Tower{corner}_F{tf}_{idx}"
                         tz = loc[2] + tf * fh
-                        _spawn_block(unreal, name,
+                        _spawn_block(batch, name,
                                      [loc[0] + cx, loc[1] + cy, tz + fh / 2],
                                      [tower_r / 100, tower_r / 100, fh / 100],
                                      mesh=CYLINDER_MESH,
@@ -366,11 +385,16 @@ def register_worldbuilding_tools(mcp):
                         "message": f"Unknown building_type '{building_type}'. "
                                    "Use: house, tower_building, fortress"}
 
+            batch.flush()
+            if batch.errors:
+                return {"success": False, "message": "; ".join(batch.errors),
+                        "actors_spawned": batch.spawned}
+
             return {
                 "success": True,
                 "building_type": building_type,
                 "floors": floors,
-                "actors_spawned": len(spawned),
+                "actors_spawned": batch.spawned,
                 "actor_names": spawned[:20],
                 "total_actors": len(spawned),
                 "note": "Wait ~2s before taking a screenshot — the viewport needs time to render new geometry.",
@@ -408,6 +432,7 @@ def register_worldbuilding_tools(mcp):
             unreal = get_unreal_connection()
             if not unreal:
                 return {"success": False, "message": "Failed to connect to Unreal Engine"}
+            batch = _BlockBatch(unreal)
 
             loc = location or [0, 0, 0]
             it = infra_type.lower()
@@ -444,7 +469,7 @@ def register_worldbuilding_tools(mcp):
                             name = f"{name_prefix}_Maze_{idx}"
                             x = loc[0] + col * block
                             y = loc[1] + row * block
-                            _spawn_block(unreal, name,
+                            _spawn_block(batch, name,
                                          [x, y, loc[2] + wall_height / 2],
                                          [scale, scale, wall_height / 100],
                                          material_path=material_path)
@@ -462,7 +487,7 @@ def register_worldbuilding_tools(mcp):
                     x = loc[0] + s * seg_length
                     # Deck
                     name = f"{name_prefix}_BDeck_{idx}"
-                    _spawn_block(unreal, name,
+                    _spawn_block(batch, name,
                                  [x, loc[1], loc[2]],
                                  [seg_length / 100, bridge_width / 100, scale * 0.2],
                                  material_path=material_path)
@@ -472,7 +497,7 @@ def register_worldbuilding_tools(mcp):
                     # Railings (both sides)
                     for side in [1, -1]:
                         name = f"{name_prefix}_BRail_{idx}"
-                        _spawn_block(unreal, name,
+                        _spawn_block(batch, name,
                                      [x, loc[1] + side * bridge_width / 2, loc[2] + rail_height],
                                      [seg_length / 100 * 0.1, scale * 0.1, rail_height / 100],
                                      material_path=material_path)
@@ -486,7 +511,7 @@ def register_worldbuilding_tools(mcp):
                 for p in range(num_pillars):
                     name = f"{name_prefix}_BPillar_{idx}"
                     x = loc[0] + p * pillar_spacing
-                    _spawn_block(unreal, name,
+                    _spawn_block(batch, name,
                                  [x, loc[1], loc[2] - pillar_height / 2],
                                  [scale * 0.8, scale * 0.8, pillar_height / 100],
                                  mesh=CYLINDER_MESH,
@@ -505,7 +530,7 @@ def register_worldbuilding_tools(mcp):
                     # Pillars
                     name = f"{name_prefix}_AqPillar_{idx}"
                     x = loc[0] + a * arch_width
-                    _spawn_block(unreal, name,
+                    _spawn_block(batch, name,
                                  [x, loc[1], loc[2] + pillar_height / 2],
                                  [scale * 0.6, scale * 0.6, pillar_height / 100],
                                  mesh=CYLINDER_MESH,
@@ -517,7 +542,7 @@ def register_worldbuilding_tools(mcp):
                 for a in range(arches):
                     name = f"{name_prefix}_AqBeam_{idx}"
                     x = loc[0] + a * arch_width + arch_width / 2
-                    _spawn_block(unreal, name,
+                    _spawn_block(batch, name,
                                  [x, loc[1], loc[2] + pillar_height + beam_thickness / 2],
                                  [arch_width / 100, scale * 1.5, beam_thickness / 100],
                                  material_path=material_path)
@@ -526,7 +551,7 @@ def register_worldbuilding_tools(mcp):
 
                 # Water channel on top
                 name = f"{name_prefix}_AqChannel_{idx}"
-                _spawn_block(unreal, name,
+                _spawn_block(batch, name,
                              [loc[0] + span / 2, loc[1], loc[2] + pillar_height + beam_thickness],
                              [span / 100, scale * 0.8, beam_thickness / 100 * 0.5],
                              material_path=material_path)
@@ -546,7 +571,7 @@ def register_worldbuilding_tools(mcp):
                     y = loc[1] + radius * math.sin(angle)
                     rot_deg = math.degrees(angle) + 90
                     name = f"{name_prefix}_Arena_{idx}"
-                    _spawn_block(unreal, name,
+                    _spawn_block(batch, name,
                                  [x, y, loc[2] + wall_height / 2],
                                  [seg_width / 100, scale * 0.3, wall_height / 100],
                                  rotation=[0, rot_deg, 0],
@@ -556,7 +581,7 @@ def register_worldbuilding_tools(mcp):
 
                 # Floor
                 name = f"{name_prefix}_ArenaFloor_{idx}"
-                _spawn_block(unreal, name,
+                _spawn_block(batch, name,
                              [loc[0], loc[1], loc[2]],
                              [radius / 100 * 2, radius / 100 * 2, scale * 0.1],
                              mesh=CYLINDER_MESH,
@@ -573,7 +598,7 @@ def register_worldbuilding_tools(mcp):
                 for s in range(segments_count):
                     name = f"{name_prefix}_Road_{idx}"
                     x = loc[0] + s * seg_length
-                    _spawn_block(unreal, name,
+                    _spawn_block(batch, name,
                                  [x, loc[1], loc[2]],
                                  [seg_length / 100, road_width / 100, scale * 0.05],
                                  material_path=material_path)
@@ -584,10 +609,15 @@ def register_worldbuilding_tools(mcp):
                         "message": f"Unknown infra_type '{infra_type}'. "
                                    "Use: maze, bridge, aqueduct, arena, road"}
 
+            batch.flush()
+            if batch.errors:
+                return {"success": False, "message": "; ".join(batch.errors),
+                        "actors_spawned": batch.spawned}
+
             return {
                 "success": True,
                 "infra_type": infra_type,
-                "actors_spawned": len(spawned),
+                "actors_spawned": batch.spawned,
                 "actor_names": spawned[:20],
                 "total_actors": len(spawned),
                 "note": "Wait ~2s before taking a screenshot — the viewport needs time to render new geometry.",
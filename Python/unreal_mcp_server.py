@@ -11,9 +11,11 @@ import socket
 import sys
 import json
 import time
+import uuid
 from contextlib import asynccontextmanager
 from typing import AsyncIterator, Dict, Any, Optional
 from fastmcp import FastMCP, Context
+import mcp_pool
 
 # Configure logging with more detailed format
 logging.basicConfig(
@@ -32,6 +34,12 @@ logger = logging.getLogger("UnrealMCP")
 # Configuration — override via environment variables for Docker
 UNREAL_HOST = os.environ.get("UNREAL_HOST", "127.0.0.1")
 UNREAL_PORT = int(os.environ.get("UNREAL_PORT", "55557"))
+# Retries after a timeout or dropped connection. Mutations carry an idempotency key,
+# so the editor returns the cached response instead of running them twice.
+UNREAL_COMMAND_RETRIES = int(os.environ.get("UNREAL_COMMAND_RETRIES", "1"))
+
+# Mutation session id sent with every request while one is open (begin_mutation_session)
+_mutation_session: Optional[str] = None
 
 # Crash detection state
 _last_successful_connection: float = 0.0  # timestamp of last successful TCP connect
@@ -197,8 +205,10 @@ def _find_recent_crash_log() -> Optional[Dict[str, Any]]:
 class UnrealConnection:
     """Connection to an Unreal Engine instance."""
     
-    def __init__(self):
-        """Initialize the connection."""
+    def __init__(self, host: str = None, port: int = None):
+        """Initialize the connection (defaults to UNREAL_HOST:UNREAL_PORT)."""
+        self.host = host or UNREAL_HOST
+        self.port = port or UNREAL_PORT
         self.socket = None
         self.connected = False
     
@@ -213,7 +223,7 @@ class UnrealConnection:
                     pass
                 self.socket = None
             
-            logger.info(f"Connecting to Unreal at {UNREAL_HOST}:{UNREAL_PORT}...")
+            logger.info(f"Connecting to Unreal at {self.host}:{self.port}...")
             self.socket = socket.socket(socket.AF_INET, socket.SOCK_STREAM)
             self.socket.settimeout(30)  # 30 second connect timeout
 
@@ -225,7 +235,7 @@ class UnrealConnection:
             self.socket.setsockopt(socket.SOL_SOCKET, socket.SO_RCVBUF, 65536)
             self.socket.setsockopt(socket.SOL_SOCKET, socket.SO_SNDBUF, 65536)
             
-            self.socket.connect((UNREAL_HOST, UNREAL_PORT))
+            self.socket.connect((self.host, self.port))
             self.connected = True
             global _last_successful_connection
             _last_successful_connection = time.time()
@@ -293,8 +303,29 @@ class UnrealConnection:
             logger.error(f"Error during receive: {str(e)}")
             raise
     
-    def send_command(self, command: str, params: Dict[str, Any] = None) -> Optional[Dict[str, Any]]:
-        """Send a command to Unreal Engine and get the response."""
+    def send_command(self, command: str, params: Dict[str, Any] = None,
+                     idempotency_key: Optional[str] = None) -> Optional[Dict[str, Any]]:
+        """Send a command to Unreal Engine and get the response.
+
+        Mutating commands get an idempotency key (one per logical call) that is
+        reused across retries, so a retry after a timeout cannot spawn, duplicate
+        or create anything twice.
+        """
+        if idempotency_key is None and not mcp_pool.is_read_only(command):
+            idempotency_key = uuid.uuid4().hex
+
+        response = None
+        for attempt in range(UNREAL_COMMAND_RETRIES + 1):
+            response = self._send_command_once(command, params, idempotency_key)
+            if not (isinstance(response, dict) and response.pop("retryable", False)):
+                break
+            if attempt < UNREAL_COMMAND_RETRIES:
+                logger.warning(f"Retrying {command} (attempt {attempt + 2}, key={idempotency_key})")
+        return response
+
+    def _send_command_once(self, command: str, params: Optional[Dict[str, Any]],
+                           idempotency_key: Optional[str]) -> Optional[Dict[str, Any]]:
+        """Send one request over a fresh connection."""
         # Always reconnect for each command, since Unreal closes the connection after each command
         # This is different from Unity which keeps connections alive
         if self.socket:
@@ -325,11 +356,15 @@ class UnrealConnection:
                 "type": command,  # Use "type" instead of "command"
                 "params": params or {}  # Use Unity's params or {} pattern
             }
+            if idempotency_key:
+                command_obj["idempotency_key"] = idempotency_key
+            if _mutation_session:
+                command_obj["mutation_session"] = _mutation_session
             
-            # Send without newline, exactly like Unity
+            # Newline-terminated frame; the plugin also accepts unterminated objects from older clients
             command_json = json.dumps(command_obj)
             logger.info(f"Sending command: {command_json}")
-            self.socket.sendall(command_json.encode('utf-8'))
+            self.socket.sendall(command_json.encode('utf-8') + b'\n')
             
             # Read response using improved handler
             response_data = self.receive_full_response(self.socket)
@@ -388,15 +423,27 @@ class UnrealConnection:
 
             return {
                 "status": "error",
-                "error": str(e)
+                "error": str(e),
+                "retryable": True
             }
 
 # Global connection state
 _unreal_connection: UnrealConnection = None
 
+# Multi-editor pool (UNREAL_POOL=host:port,...); see mcp_pool.py
+mcp_pool.set_connection_factory(UnrealConnection)
+mcp_pool.configure_from_env()
+
+def set_mutation_session(session_id: Optional[str]) -> None:
+    """Attach session_id to every following request (None detaches)."""
+    global _mutation_session
+    _mutation_session = session_id
+
 def get_unreal_connection() -> Optional[UnrealConnection]:
-    """Get the connection to Unreal Engine."""
+    """Get the connection to Unreal Engine (a pool router when UNREAL_POOL is set)."""
     global _unreal_connection
+    if mcp_pool.pool_enabled():
+        return mcp_pool.PooledConnection()
     try:
         if _unreal_connection is None:
             _unreal_connection = UnrealConnection()